@@ -1,5 +1,8 @@
 #include "AppEngine.h"
+#include "AsyncLog.h"
 #include "MainComponent.h"
+#include "ProjectGenerator.h"
+#include "SandboxWorker.h"
 #include <juce_gui_basics/juce_gui_basics.h>
 #include <melatonin_inspector/melatonin_inspector.h>
 #include <memory>
@@ -10,14 +13,34 @@ public:
     const juce::String getApplicationName() override       { return "GrooveKit"; }
     const juce::String getApplicationVersion() override    { return "1.0.0"; }
 
-    void initialise (const juce::String&) override
+    void initialise (const juce::String& commandLine) override
     {
+        // Start the log's drain thread here, not in whichever audio or MIDI callback logs first
+        AsyncLog::getInstance();
+
+        // Headless: GrooveKit --generate-project <file> [options]
+        int exitCode = 0;
+        if (ProjectGenerator::runFromCommandLine (commandLine, exitCode))
+        {
+            setApplicationReturnValue (exitCode);
+            quit();
+            return;
+        }
+
+        // Plugin sandbox: GrooveKit relaunched by SandboxedPlugin to host one plugin, no window
+        if ((sandboxWorker = SandboxWorker::createFromCommandLine (commandLine)))
+            return;
+
         mainWindow = std::make_unique<MainWindow>(getApplicationName());
     }
 
     void shutdown() override
     {
         mainWindow = nullptr;
+        sandboxWorker = nullptr;
+
+        // Write out queued engine/recorder log lines while juce::Logger is still usable
+        AsyncLog::getInstance().flush();
     }
 
     class MainWindow final : public juce::DocumentWindow
@@ -49,6 +72,7 @@ public:
 
 private:
     std::unique_ptr<MainWindow> mainWindow;
+    std::unique_ptr<SandboxWorker> sandboxWorker;
 };
 
 START_JUCE_APPLICATION (GrooveKitApplication)
@@ -5,6 +5,8 @@
 #include "../UI/Plugins/FourOsc/FourOscGUI.h"
 #include "../PluginManager/PluginEditorWindow.h"
 #include "../UI/Plugins/Synthesizer/MorphSynthRegistration.h"
+#include "../UI/Plugins/MidiFx/MidiFxRegistration.h"
+#include "../PluginManager/SandboxedPlugin.h"
 #include "../UI/Plugins/Synthesizer/MorphSynthView.h"
 #include "../UI/Plugins/Synthesizer/MorphSynthWindow.h"
 #include "GrooveKitUIBehaviour.h"
@@ -79,28 +81,56 @@ namespace
 
 AppEngine::AppEngine()
 {
-    engine = std::make_unique<te::Engine> (
-        "GrooveKitEngine",
-        std::make_unique<GrooveKitUIBehaviour>(),
-        nullptr
-    );
-
-    registerMorphSynthCompat(*engine);
-
-    createOrLoadEdit();
-
-    midiEngine = std::make_unique<MIDIEngine> (*edit);
-    audioEngine = std::make_unique<AudioEngine> (*edit, *engine);
-    trackManager = std::make_unique<TrackManager> (*edit);
-    selectionManager = std::make_unique<te::SelectionManager> (*engine);
-    midiListener = std::make_unique<MidiListener> (this);
-    midiRecorder = std::make_unique<MidiRecorder> (*engine);
-
-    qwertyForwarder_ = std::make_unique<MidiListenerKeyAdapter>(*midiListener);
+    // Only what the first frame needs runs here; devices, plugins and the sample
+    // library are staged in initialise() so the window can appear first.
+    startup.runNow ("Engine", [this]
+    {
+        engine = std::make_unique<te::Engine> (
+            "GrooveKitEngine",
+            std::make_unique<GrooveKitUIBehaviour>(),
+            nullptr
+        );
+
+        registerMorphSynthCompat(*engine);
+        registerMidiFx (*engine);
+        registerSandboxedPlugin (*engine);
+
+        thumbnailService = std::make_unique<AudioThumbnailService> (
+            juce::File::getSpecialLocation (juce::File::userApplicationDataDirectory)
+                .getChildFile ("GrooveKit/Thumbnails"),
+            engine->getAudioFileFormatManager().readFormatManager);
+    });
 
-    editViewState = std::make_unique<EditViewState> (*edit, *selectionManager);
+    startup.runNow ("Empty edit", [this]
+    {
+        createOrLoadEdit();
+
+        tempoMap = std::make_unique<TempoMap> (*edit);
+        midiEngine = std::make_unique<MIDIEngine> (*edit, *tempoMap);
+        audioClipEngine = std::make_unique<AudioClipEngine> (*edit);
+        audioEngine = std::make_unique<AudioEngine> (*edit, *engine);
+        trackManager = std::make_unique<TrackManager> (*edit);
+        clipIndex = std::make_unique<ClipIndex> (*edit);
+        silenceMonitor = std::make_unique<SilenceMonitor> (*edit, *trackManager, *clipIndex);
+        silenceMonitor->setLiveInputTrack (selectedTrackIndex);
+        automationRecorder = std::make_unique<AutomationRecorder> (*edit, *trackManager);
+        midiLearn = std::make_unique<MidiLearn> (*edit, *trackManager);
+        macroControls = std::make_unique<MacroControls> (*edit, *trackManager);
+        selectionManager = std::make_unique<te::SelectionManager> (*engine);
+        midiListener = std::make_unique<MidiListener> (this);
+        midiRecorder = std::make_unique<MidiRecorder> (*engine);
+        audioRecorder = std::make_unique<AudioRecorder> (*engine);
+
+        qwertyForwarder_ = std::make_unique<MidiListenerKeyAdapter>(*midiListener);
+
+        editViewState = std::make_unique<EditViewState> (*edit, *selectionManager);
+    });
+}
 
+void AppEngine::openDevices()
+{
     audioEngine->initialiseDefaults (48000.0, 512);
+    updateAudioInput();
 
     // Setup MIDI input devices using Tracktion's InputDevice system
     // CRITICAL: This must be called BEFORE restartPlayback() to ensure proper MIDI routing
@@ -108,6 +138,9 @@ AppEngine::AppEngine()
 
     // Now restart playback with MIDI devices properly enabled
     edit->restartPlayback();
+
+    // --- Ensure playback graph exists (useful for live monitoring) ---
+    edit->getTransport().ensureContextAllocated();
 }
 
 AppEngine::~AppEngine()
@@ -177,6 +210,12 @@ void AppEngine::newUntitledEdit()
     closeInstrumentWindow();
 
     audioEngine.reset();
+    automationRecorder.reset();
+
+    // Feedback is a property of the hardware, not the edit: it carries over
+    const bool sendControllerFeedback = midiLearn != nullptr && midiLearn->isFeedbackEnabled();
+    midiLearn.reset();
+    macroControls.reset();
 
     auto baseDir = juce::File::getSpecialLocation (juce::File::userDocumentsDirectory)
                        .getChildFile ("GrooveKit");
@@ -185,6 +224,7 @@ void AppEngine::newUntitledEdit()
     auto placeholder = baseDir.getNonexistentChildFile ("Untitled", ".tracktionedit", false);
 
     edit = te::createEmptyEdit (*engine, placeholder);
+    tempoMap->setEdit (*edit);
 
     currentEditFile = juce::File();
 
@@ -195,9 +235,17 @@ void AppEngine::newUntitledEdit()
     for (auto* t : te::getAudioTracks (*edit))
         edit->deleteTrack (t);
 
-    midiEngine = std::make_unique<MIDIEngine> (*edit);
+    midiEngine = std::make_unique<MIDIEngine> (*edit, *tempoMap);
+    audioClipEngine = std::make_unique<AudioClipEngine> (*edit);
     audioEngine = std::make_unique<AudioEngine> (*edit, *engine);
     trackManager = std::make_unique<TrackManager> (*edit);
+    clipIndex = std::make_unique<ClipIndex> (*edit);
+    silenceMonitor = std::make_unique<SilenceMonitor> (*edit, *trackManager, *clipIndex);
+    silenceMonitor->setLiveInputTrack (selectedTrackIndex);
+    automationRecorder = std::make_unique<AutomationRecorder> (*edit, *trackManager);
+    midiLearn = std::make_unique<MidiLearn> (*edit, *trackManager);
+    midiLearn->setFeedbackEnabled (sendControllerFeedback);
+    macroControls = std::make_unique<MacroControls> (*edit, *trackManager);
     selectionManager = std::make_unique<te::SelectionManager> (*engine);
     editViewState = std::make_unique<EditViewState> (*edit, *selectionManager);
 
@@ -207,6 +255,7 @@ void AppEngine::newUntitledEdit()
     markSaved();
 
     audioEngine->initialiseDefaults (48000.0, 512);
+    updateAudioInput();
     audioEngine->setupMidiInputDevices(*edit);
 
     if (onEditLoaded)
@@ -225,6 +274,9 @@ void AppEngine::setArmedTrack (int index)
 
     selectedTrackIndex = index;
 
+    if (silenceMonitor)
+        silenceMonitor->setLiveInputTrack (index);
+
     // Route MIDI to armed track, or clear routing if disarming
     if (index >= 0)
     {
@@ -247,6 +299,8 @@ void AppEngine::setArmedTrack (int index)
         juce::Logger::writeToLog("[AppEngine] Cleared MIDI routing (track disarmed)");
     }
 
+    updateAudioInput();
+
     if (onArmedTrackChanged)
         onArmedTrackChanged();
 
@@ -254,6 +308,40 @@ void AppEngine::setArmedTrack (int index)
         wireAllMidiInputsToTrack (*t);
 }
 
+void AppEngine::setAudioTrackArmed (int index, bool shouldBeArmed)
+{
+    if (! isAudioTrack (index) || trackManager->isAudioTrackArmed (index) == shouldBeArmed)
+        return;
+
+    trackManager->setAudioTrackArmed (index, shouldBeArmed);
+    updateAudioInput();
+
+    if (onArmedTrackChanged)
+        onArmedTrackChanged();
+}
+
+bool AppEngine::isAudioTrackArmed (int index) const
+{
+    return trackManager != nullptr && trackManager->isAudioTrackArmed (index);
+}
+
+bool AppEngine::isRecordingAudioOnTrack (int index) const
+{
+    return isAudioTrack (index) && (trackManager->isAudioTrackArmed (index) || index == selectedTrackIndex);
+}
+
+void AppEngine::updateAudioInput()
+{
+    if (audioEngine == nullptr || trackManager == nullptr)
+        return;
+
+    bool needsInput = false;
+    for (int i = 0; i < trackManager->getNumTracks() && ! needsInput; ++i)
+        needsInput = isRecordingAudioOnTrack (i);
+
+    audioEngine->setInputEnabled (needsInput);
+}
+
 te::AudioTrack* AppEngine::getArmedTrack ()
 {
     return getTrackManager().getTrack (selectedTrackIndex);
@@ -273,24 +361,38 @@ void AppEngine::toggleRecord()
     if (!wasRecording)
     {
         // Start recording
-        if (selectedTrackIndex < 0)
+        const bool recordsMidi = selectedTrackIndex >= 0 && ! isAudioTrack (selectedTrackIndex);
+        bool recordsAudio = false;
+
+        for (int i = 0; i < trackManager->getNumTracks() && ! recordsAudio; ++i)
+            recordsAudio = isRecordingAudioOnTrack (i);
+
+        if (! recordsMidi && ! recordsAudio)
         {
             juce::Logger::writeToLog("[AppEngine] Cannot start recording: no track armed");
             return;
         }
 
-        juce::Logger::writeToLog("[AppEngine] Starting recording on track " + juce::String(selectedTrackIndex));
+        // Audio tracks all record at once, each from its own input; an armed
+        // instrument track records MIDI alongside them
+        if (recordsAudio)
+            startAudioRecording();
 
-        // Start recording with both hardware MIDI and QWERTY keyboard
-        midiRecorder->startRecording(*edit, selectedTrackIndex,
-                                     &midiListener->getMidiKeyboardState());
+        if (recordsMidi)
+        {
+            juce::Logger::writeToLog("[AppEngine] Starting recording on track " + juce::String(selectedTrackIndex));
+
+            // Start recording with both hardware MIDI and QWERTY keyboard
+            midiRecorder->startRecording(*edit, selectedTrackIndex, *clipIndex,
+                                         &midiListener->getMidiKeyboardState());
+        }
     }
     else
     {
         // Stop recording
         juce::Logger::writeToLog("[AppEngine] Stopping recording");
 
-        bool clipCreated = midiRecorder->stopRecording(*edit);
+        bool clipCreated = stopActiveRecording();
 
         if (clipCreated)
         {
@@ -302,14 +404,90 @@ void AppEngine::toggleRecord()
         }
         else
         {
-            juce::Logger::writeToLog("[AppEngine] Recording stopped - no clip created (no MIDI captured)");
+            juce::Logger::writeToLog("[AppEngine] Recording stopped - no clip created (nothing captured)");
         }
     }
 }
 
 bool AppEngine::isRecording() const
 {
-    return midiRecorder && midiRecorder->isRecording();
+    return (midiRecorder && midiRecorder->isRecording())
+        || (audioRecorder && audioRecorder->isRecording());
+}
+
+void AppEngine::startAudioRecording()
+{
+    auto* device = engine->getDeviceManager().deviceManager.getCurrentAudioDevice();
+
+    if (device == nullptr)
+    {
+        juce::Logger::writeToLog("[AppEngine] Cannot record audio: no audio device");
+        return;
+    }
+
+    const int numInputs = device->getActiveInputChannels().countNumberOfSetBits();
+
+    if (numInputs == 0)
+    {
+        juce::Logger::writeToLog ("[AppEngine] Cannot record audio: no active inputs");
+        return;
+    }
+
+    // One stream per recording track. Tracks with a chosen input keep it; the
+    // rest take the following pairs in track order (mono if one channel is left)
+    std::vector<AudioRecorder::Input> inputs;
+    int nextFreeChannel = 0;
+
+    for (int i = 0; i < trackManager->getNumTracks(); ++i)
+    {
+        if (! isRecordingAudioOnTrack (i))
+            continue;
+
+        AudioRecorder::Input input;
+        input.trackIndex = i;
+        input.firstChannel = trackManager->getAudioTrackInput (i);
+
+        if (input.firstChannel < 0)
+            input.firstChannel = nextFreeChannel;
+
+        if (input.firstChannel >= numInputs)
+        {
+            juce::Logger::writeToLog ("[AppEngine] Not recording track " + juce::String (i + 1)
+                                      + ": input " + juce::String (input.firstChannel + 1) + " isn't available");
+            continue;
+        }
+
+        input.numChannels = juce::jmin (2, numInputs - input.firstChannel);
+        nextFreeChannel = juce::jmax (nextFreeChannel, input.firstChannel + input.numChannels);
+        inputs.push_back (input);
+    }
+
+    // Takes live next to the project, or in Documents until it has been saved
+    auto dir = currentEditFile.existsAsFile()
+        ? currentEditFile.getParentDirectory().getChildFile ("Recordings")
+        : juce::File::getSpecialLocation (juce::File::userDocumentsDirectory).getChildFile ("GrooveKit/Recordings");
+
+    audioRecorder->startRecording (*edit, inputs, dir, device->getCurrentSampleRate());
+}
+
+bool AppEngine::stopActiveRecording()
+{
+    bool clipCreated = false;
+
+    if (audioRecorder->isRecording())
+    {
+        for (auto& take : audioRecorder->stopRecording())
+        {
+            // No tempo metadata in a fresh take, so it's placed unwarped
+            if (audioClipEngine->insertAudioClip (take.trackIndex, take.file, take.start) != nullptr)
+                clipCreated = true;
+        }
+    }
+
+    if (midiRecorder->isRecording())
+        clipCreated = midiRecorder->stopRecording(*edit) || clipCreated;
+
+    return clipCreated;
 }
 
 tracktion::TimeRange AppEngine::getRecordingPreviewBounds() const
@@ -331,7 +509,7 @@ void AppEngine::stop()
     if (isRecording())
     {
         juce::Logger::writeToLog("[AppEngine] Stopping recording due to transport stop");
-        midiRecorder->stopRecording(*edit);
+        stopActiveRecording();
 
         if (onRecordingStopped)
             onRecordingStopped();
@@ -431,6 +609,25 @@ juce::Array<te::MidiClip*> AppEngine::getMidiClipsFromTrack (int trackIndex)
     return midiEngine->getMidiClipsFromTrack (trackIndex);
 }
 
+bool AppEngine::wouldClipOverlap (int trackIndex, t::TimeRange range, const te::Clip* ignore)
+{
+    auto tracks = te::getAudioTracks (*edit);
+    if (! juce::isPositiveAndBelow (trackIndex, tracks.size()))
+        return false;
+
+    return clipIndex->overlaps (*tracks.getUnchecked (trackIndex), range, ignore);
+}
+
+std::optional<t::TimePosition> AppEngine::getNextClipStart (int trackIndex, t::TimePosition position,
+                                                            const te::Clip* ignore)
+{
+    auto tracks = te::getAudioTracks (*edit);
+    if (! juce::isPositiveAndBelow (trackIndex, tracks.size()))
+        return std::nullopt;
+
+    return clipIndex->getNextClipStart (*tracks.getUnchecked (trackIndex), position, ignore);
+}
+
 int AppEngine::getNumTracks() { return trackManager ? trackManager->getNumTracks() : 0; }
 
 EditViewState& AppEngine::getEditViewState() { return *editViewState; }
@@ -447,6 +644,36 @@ int AppEngine::addDrumTrack()
     return trackManager->addDrumTrack();
 }
 
+int AppEngine::addAudioTrack()
+{
+    jassert (trackManager != nullptr);
+    return trackManager->addAudioTrack();
+}
+
+bool AppEngine::isAudioTrack (int i) const { return trackManager ? trackManager->isAudioTrack (i) : false; }
+
+te::WaveAudioClip* AppEngine::insertAudioClip (int trackIndex, const juce::File& file, t::TimePosition start)
+{
+    if (! isAudioTrack (trackIndex))
+        return nullptr;
+
+    return audioClipEngine->insertAudioClip (trackIndex, file, start);
+}
+
+juce::Array<te::WaveAudioClip*> AppEngine::getAudioClipsFromTrack (int trackIndex)
+{
+    return audioClipEngine->getAudioClipsFromTrack (trackIndex);
+}
+
+bool AppEngine::deleteAudioClip (te::WaveAudioClip* clip)
+{
+    if (clip == nullptr || edit == nullptr)
+        return false;
+
+    clip->removeFromParent();
+    return true;
+}
+
 int AppEngine::addInstrumentTrack()
 {
     jassert (trackManager != nullptr);
@@ -490,18 +717,9 @@ double AppEngine::getBpm () const { return edit->tempoSequence.getTempo (0)->get
 
 void AppEngine::setBpm (double newBpm)
 {
-    // Capture old state before changing BPM
-    const double oldBpm = getBpm();
-    const auto oldLoopRange = edit->getTransport().getLoopRange();
-    const auto oldPlayheadPos = edit->getTransport().getPosition();
-
-    // GrooveKit does not have tempo changes, so just get the first one
-    edit->tempoSequence.getTempo (0)->setBpm (newBpm);
-
-    // Notify listeners of BPM change with original values
-    // (Tracktion may have already adjusted loop range/playhead by this point)
-    if (onBpmChanged)
-        onBpmChanged(oldBpm, newBpm, oldLoopRange, oldPlayheadPos);
+    // Clips, loop range and playhead keep their beats (see TempoMap), which moves
+    // every clip; views listening to the tempo map refresh themselves.
+    getTempoMap().setTempoChangeBpm (0, newBpm);
 }
 
 void AppEngine::initialise()
@@ -516,74 +734,44 @@ void AppEngine::initialise()
    #endif
     appSupport.createDirectory();
 
-    // --- Your app-level plugin manager (keep as-is) ---
-    PluginManager::Settings pmSettings;
-    pmSettings.appDataDir      = appSupport;
-    pmSettings.scanAudioUnits  = true;
-    pmSettings.scanVST3        = true;
-
-    pluginManager = std::make_unique<PluginManager>(*edit, pmSettings);
-    trackManager->setPluginManager(pluginManager.get());
-
-    // --- NEW: Initialise Tracktion Engine's PluginManager too ---
-    auto& tePM = engine->getPluginManager();
+    // --- Sample library: independent of the engine, so off the message thread ---
+    startup.runInBackground ("Sample library", [] { DefaultSampleLibrary::ensureInstalled(); });
 
-    // Add formats we intend to host (guarded by JUCE host flags)
-   #if JUCE_PLUGINHOST_AU
-    tePM.pluginFormatManager.addFormat(std::make_unique<juce::AudioUnitPluginFormat>());
-  #endif
-  #if JUCE_PLUGINHOST_VST3
-    tePM.pluginFormatManager.addFormat(std::make_unique<juce::VST3PluginFormat>());
-  #endif
+    // --- Devices: JUCE/TE want these on the message thread, so run after the first frame ---
+    startup.runDeferred ("Audio/MIDI devices", [this] { openDevices(); });
 
-    // Do a quick blocking scan once so TE's knownPluginList is populated.
-    // ExternalPlugin resolves/instantiates using *this* list+formats.
+    // --- Plugin catalogue ---
+    // PluginManager works directly on the engine's knownPluginList/format manager,
+    // so there is one catalogue. It is loaded from the on-disk cache here (no
+    // plugin is probed); the scan below refreshes it on a background thread.
+    startup.runDeferred ("Plugin catalogue", [this, appSupport]
     {
-        juce::FileSearchPath searchPaths;
-       #if JUCE_MAC
-        // AU locations (Components) — TE will use these only for AU formats
-        searchPaths.add(juce::File("/Library/Audio/Plug-Ins/Components"));
-        searchPaths.add(juce::File("~/Library/Audio/Plug-Ins/Components"));
+        PluginManager::Settings pmSettings;
+        pmSettings.appDataDir      = appSupport;
+        pmSettings.scanAudioUnits  = true;
+        pmSettings.scanVST3        = true;
 
-        // VST3 locations
-        searchPaths.add(juce::File("/Library/Audio/Plug-Ins/VST3"));
-        searchPaths.add(juce::File("~/Library/Audio/Plug-Ins/VST3"));
-       #endif
+        pluginManager = std::make_unique<PluginManager>(*edit, pmSettings);
+        trackManager->setPluginManager(pluginManager.get());
 
-        static juce::File teDeadMans = appSupport.getChildFile("TE_ScanDeadMans.txt");
-
-        for (int i = 0; i < tePM.pluginFormatManager.getNumFormats(); ++i)
+        pluginManager->onPluginLoadFailed = [this] (te::AudioTrack& track, const juce::String& name, const juce::String& error)
         {
-            auto* fmt = tePM.pluginFormatManager.getFormat(i);
-            if (!fmt) continue;
-
-            DBG("[TE-PM] Scan started for format: " + fmt->getName()
-                + " paths: " + searchPaths.toString());
-
-            juce::PluginDirectoryScanner scanner(tePM.knownPluginList,
-                                                 *fmt,
-                                                 searchPaths,
-                                                 /*recursive*/ true,
-                                                 teDeadMans,
-                                                 /*allowAsync*/ false);
-
-            juce::String err;
-            while (scanner.scanNextFile(true, err))
-                ; // pump scan
-
-            if (err.isNotEmpty())
-                DBG("[TE-PM] Scanner reported: " + err);
-        }
-
-        DBG("[TE-PM] Scan finished. TE known types: "
-            + juce::String(tePM.knownPluginList.getNumTypes()));
-    }
+            if (trackManager && onInstrumentLabelChanged)
+                for (int i = 0; i < trackManager->getNumTracks(); ++i)
+                    if (trackManager->getTrack (i) == &track)
+                        onInstrumentLabelChanged (i);
+
+            juce::AlertWindow::showMessageBoxAsync (
+                juce::AlertWindow::WarningIcon,
+                "Plugin Failed to Load",
+                name + " could not be loaded and was removed from the track.\n\n" + error);
+        };
 
-    // You can still keep your async scan/UI for your own list
-    pluginManager->scanForPluginsAsync();
+        DBG("[PluginManager] Cached catalogue: "
+            + juce::String(pluginManager->getKnownList().getNumTypes()) + " plugins");
 
-    // --- Ensure playback graph exists (useful for live monitoring) ---
-    edit->getTransport().ensureContextAllocated();
+        pluginManager->scanForPluginsAsync();
+    });
 }
 
 // Metronome/Click Track controls
@@ -660,9 +848,21 @@ bool AppEngine::writeEditToFile (const juce::File& file)
             {
                 ext->flushPluginStateToValueTree();
             }
+            else if (auto* sandboxed = dynamic_cast<SandboxedPlugin*> (p))
+            {
+                sandboxed->flushPluginStateToValueTree();
+            }
         }
     }
 
+    // Macro values moved without a drag gesture (wheel, keys) since the last one ended
+    if (macroControls)
+        macroControls->saveValues();
+
+    // Inserts suspended for silence are saved as running (they suspend again on the next tick)
+    if (silenceMonitor)
+        silenceMonitor->resumeAll();
+
     // 2) Now serialize the edit
     if (auto xml = edit->state.createXml())
     {
@@ -797,7 +997,15 @@ bool AppEngine::loadEditFromFile (const juce::File& file)
         return false;
 
     audioEngine.reset();
+    automationRecorder.reset();
+
+    // Feedback is a property of the hardware, not the edit: it carries over
+    const bool sendControllerFeedback = midiLearn != nullptr && midiLearn->isFeedbackEnabled();
+    midiLearn.reset();
+    macroControls.reset();
 
+    // Views hold on to the TempoMap: it moves to the new edit rather than being replaced
+    tempoMap->setEdit (*newEdit);
     edit = std::move (newEdit);
     currentEditFile = file;
     edit->editFileRetriever = [f = currentEditFile] { return f; };
@@ -808,7 +1016,16 @@ bool AppEngine::loadEditFromFile (const juce::File& file)
     markSaved();
 
     trackManager = std::make_unique<TrackManager> (*edit);
-    midiEngine = std::make_unique<MIDIEngine> (*edit);
+
+    clipIndex = std::make_unique<ClipIndex> (*edit);
+    silenceMonitor = std::make_unique<SilenceMonitor> (*edit, *trackManager, *clipIndex);
+    silenceMonitor->setLiveInputTrack (selectedTrackIndex);
+    automationRecorder = std::make_unique<AutomationRecorder> (*edit, *trackManager);
+    midiLearn = std::make_unique<MidiLearn> (*edit, *trackManager);
+    midiLearn->setFeedbackEnabled (sendControllerFeedback);
+    macroControls = std::make_unique<MacroControls> (*edit, *trackManager);
+    midiEngine = std::make_unique<MIDIEngine> (*edit, *tempoMap);
+    audioClipEngine = std::make_unique<AudioClipEngine> (*edit);
     selectionManager = std::make_unique<te::SelectionManager> (*engine);
     editViewState = std::make_unique<EditViewState> (*edit, *selectionManager);
 
@@ -818,6 +1035,7 @@ bool AppEngine::loadEditFromFile (const juce::File& file)
 
     audioEngine = std::make_unique<AudioEngine> (*edit, *engine);
     audioEngine->initialiseDefaults (48000.0, 512);
+    updateAudioInput();
     audioEngine->setupMidiInputDevices(*edit);
 
     edit->restartPlayback();  // Rebuild playback graph with MIDI devices enabled
@@ -872,6 +1090,14 @@ void AppEngine::openInstrumentEditor (int trackIndex)
                 return;
             }
 
+            // Sandboxed: the editor opens in the plugin's worker process
+            if (auto* sandboxed = dynamic_cast<SandboxedPlugin*>(plug))
+            {
+                sandboxed->showEditor();
+                edit->getTransport().ensureContextAllocated();
+                return;
+            }
+
             if (auto* ext = dynamic_cast<te::ExternalPlugin*>(plug))
             {
                 if (instrumentWindow_) { instrumentWindow_->toFront(true); return; }
@@ -935,8 +1161,10 @@ void AppEngine::showInstrumentChooser (int trackIndex)
 
     builtIn.addItem (kBuiltMorph, "Morph Synth");
 
-    // --- External instruments (scanned)
-    auto owned = pluginManager->getInstrumentDescriptions();   // OwnedArray<PluginDescription>
+    // --- External instruments (scanned; the catalogue may still be loading at startup)
+    juce::OwnedArray<juce::PluginDescription> owned;
+    if (pluginManager)
+        owned = pluginManager->getInstrumentDescriptions();
     juce::Array<juce::PluginDescription> descs;
     for (int i = 0; i < owned.size(); ++i)
         descs.add (*owned[i]);
@@ -971,6 +1199,10 @@ void AppEngine::showInstrumentChooser (int trackIndex)
             {
                 trackManager->clearInstrumentSlot0 (trackIndex);
                 inserted = trackManager->insertExternalInstrument (trackIndex, descs.getReference (idx));
+
+                // Ready for piano-roll auditions before the first one
+                if (inserted != nullptr && trackManager->getMidiFxOnTrack (trackIndex) == nullptr)
+                    insertPassThroughMidiFx (trackIndex);
             }
         }
 
@@ -1007,6 +1239,12 @@ void AppEngine::onFxInsertSlotClicked (int trackIndex,
     if (pluginIndex >= 0 && pluginIndex < track->pluginList.size())
         existing = track->pluginList[pluginIndex];
 
+    if (auto* sandboxed = dynamic_cast<SandboxedPlugin*> (existing))
+    {
+        sandboxed->showEditor();
+        return;
+    }
+
     if (auto* ext = dynamic_cast<te::ExternalPlugin*> (existing))
     {
         // 🔁 Same pattern as the ExternalPlugin branch in openInstrumentEditor
@@ -1195,6 +1433,9 @@ void AppEngine::showFxInsertMenu (int trackIndex,
             onSlotLabelChange (fxDescs.getReference (idx).name);
 
         // 2) Open the plugin editor right away (same pattern as instruments)
+        if (auto* sandboxed = dynamic_cast<SandboxedPlugin*> (plugin))
+            sandboxed->showEditor();
+
         if (auto* ext = dynamic_cast<te::ExternalPlugin*> (plugin))
         {
             if (instrumentWindow_)
@@ -1227,18 +1468,182 @@ juce::String AppEngine::getInstrumentLabelForTrack (int trackIndex) const
     if (!trackManager)
         return "Instrument";
 
+    if (trackManager->isAudioTrack (trackIndex))
+        return "Audio";
+
+    juce::String label = "Instrument";
+
     if (auto* plug = trackManager->getInstrumentPluginOnTrack (trackIndex))
     {
         // Prefer external plugin name if it is one, else generic plugin name
         if (auto* ext = dynamic_cast<te::ExternalPlugin*> (plug))
-            return ext->getName();
+            label = ext->getName();
+        else if (plug->getName().isNotEmpty())
+            label = plug->getName();
+    }
 
-        auto name = plug->getName();
-        if (name.isNotEmpty())
-            return name;
+    if (auto* fx = trackManager->getMidiFxOnTrack (trackIndex); fx != nullptr && ! fx->isPassThrough())
+        label = fx->getSummary() + " > " + label;
+
+    return label;
+}
+
+void AppEngine::auditionNote (int trackIndex, int note, int velocity, double lengthSeconds, bool stopOthers)
+{
+    if (!trackManager || trackManager->isAudioTrack (trackIndex) || ! juce::isPositiveAndBelow (note, 128))
+        return;
+
+    auto* track = trackManager->getTrack (trackIndex);
+    if (track == nullptr)
+        return;
+
+    // Plugins only render once the transport has a playback context
+    track->edit.getTransport().ensureContextAllocated();
+
+    if (auto* queue = getAuditionQueue (trackIndex, true))
+    {
+        queue->post (note, velocity, lengthSeconds, stopOthers);
+
+        // After the post: any block rendered from here on has the note in it
+        if (silenceMonitor)
+            silenceMonitor->wake (trackIndex);
     }
+}
 
-    return "Instrument";
+void AppEngine::stopAudition (int trackIndex)
+{
+    if (auto* queue = getAuditionQueue (trackIndex, false))
+        queue->stopAll();
+}
+
+AuditionQueue* AppEngine::getAuditionQueue (int trackIndex, bool createRoute)
+{
+    if (!trackManager)
+        return nullptr;
+
+    if (auto* synth = dynamic_cast<MorphSynthPlugin*> (trackManager->getInstrumentPluginOnTrack (trackIndex)))
+        return &synth->getAuditionQueue();
+
+    // Other instruments hear it from the MIDI FX slot ahead of them
+    if (auto* fx = trackManager->getMidiFxOnTrack (trackIndex))
+        return &fx->getAuditionQueue();
+
+    if (! createRoute || trackManager->getInstrumentPluginOnTrack (trackIndex) == nullptr)
+        return nullptr;
+
+    auto* fx = insertPassThroughMidiFx (trackIndex);
+    return fx != nullptr ? &fx->getAuditionQueue() : nullptr;
+}
+
+MidiFxPlugin* AppEngine::insertPassThroughMidiFx (int trackIndex)
+{
+    auto* fx = trackManager->insertMidiFx (trackIndex);
+    if (fx == nullptr)
+        return nullptr;
+
+    fx->modeParam->setParameter ((float) MidiFxProcessor::Mode::off, juce::sendNotification);
+    fx->chordParam->setParameter ((float) MidiFxProcessor::Chord::off, juce::sendNotification);
+
+    if (auto* track = trackManager->getTrack (trackIndex))
+        wireAllMidiInputsToTrack (*track);
+
+    return fx;
+}
+
+void AppEngine::showMidiFxMenu (int trackIndex)
+{
+    if (!trackManager || trackManager->isAudioTrack (trackIndex))
+        return;
+
+    auto* fx = trackManager->getMidiFxOnTrack (trackIndex);
+    const auto settings = fx != nullptr ? fx->getSettings() : MidiFxProcessor::Settings {};
+    using Mode = MidiFxProcessor::Mode;
+
+    // A pass-through slot only carries audition notes: to the user it is "Off"
+    const bool isOff = fx == nullptr || fx->isPassThrough();
+    const bool isChordOnly = ! isOff && settings.mode == Mode::off;
+
+    juce::PopupMenu root, rateMenu, patternMenu, chordMenu, octaveMenu, gateMenu;
+
+    // --- Mode
+    root.addItem (1, "Off", true, isOff);
+    root.addItem (2, "Arpeggiator", true, fx != nullptr && settings.mode == Mode::arpeggiator);
+    root.addItem (3, "Chord", true, isChordOnly);
+    root.addItem (4, "Note Repeat", true, fx != nullptr && settings.mode == Mode::noteRepeat);
+
+    // --- Settings (only meaningful once the effect exists)
+    const auto rates = MidiFxProcessor::getRateNames();
+    for (int i = 0; i < rates.size(); ++i)
+        rateMenu.addItem (100 + i, rates[i], true,
+                          fx != nullptr && juce::roundToInt (fx->rateParam->getCurrentValue()) == i);
+
+    const auto patterns = MidiFxProcessor::getPatternNames();
+    for (int i = 0; i < patterns.size(); ++i)
+        patternMenu.addItem (200 + i, patterns[i], true, fx != nullptr && (int) settings.pattern == i);
+
+    const auto chords = MidiFxProcessor::getChordNames();
+    for (int i = 0; i < chords.size(); ++i)
+        chordMenu.addItem (300 + i, chords[i], true, fx != nullptr && (int) settings.chord == i);
+
+    for (int i = 1; i <= MidiFxProcessor::maxOctaves; ++i)
+        octaveMenu.addItem (400 + i, juce::String (i), true, fx != nullptr && settings.octaves == i);
+
+    static constexpr float gates[] = { 0.25f, 0.5f, 0.75f, 1.0f };
+    for (int i = 0; i < (int) std::size (gates); ++i)
+        gateMenu.addItem (500 + i, juce::String (juce::roundToInt (gates[i] * 100.0f)) + "%", true,
+                          fx != nullptr && std::abs (settings.gate - gates[i]) < 0.01f);
+
+    root.addSeparator();
+    root.addSubMenu ("Rate", std::move (rateMenu), fx != nullptr);
+    root.addSubMenu ("Pattern", std::move (patternMenu), fx != nullptr);
+    root.addSubMenu ("Chord Type", std::move (chordMenu), fx != nullptr);
+    root.addSubMenu ("Octaves", std::move (octaveMenu), fx != nullptr);
+    root.addSubMenu ("Gate", std::move (gateMenu), fx != nullptr);
+
+    root.showMenuAsync ({}, [this, trackIndex] (int result)
+    {
+        if (result == 0 || !trackManager)
+            return;
+
+        if (result == 1)
+        {
+            // Instruments without their own audition queue keep the slot, passing through
+            auto* instrument = trackManager->getInstrumentPluginOnTrack (trackIndex);
+
+            if (instrument == nullptr || dynamic_cast<MorphSynthPlugin*> (instrument) != nullptr)
+                trackManager->removeMidiFx (trackIndex);
+            else
+                insertPassThroughMidiFx (trackIndex);
+        }
+        else
+        {
+            auto* fx = trackManager->insertMidiFx (trackIndex);
+            if (fx == nullptr)
+                return;
+
+            auto set = [] (te::AutomatableParameter::Ptr& p, float v) { p->setParameter (v, juce::sendNotification); };
+
+            if (result == 2)      set (fx->modeParam, (float) Mode::arpeggiator);
+            else if (result == 4) set (fx->modeParam, (float) Mode::noteRepeat);
+            else if (result == 3)
+            {
+                set (fx->modeParam, (float) Mode::off);
+                if (fx->getSettings().chord == MidiFxProcessor::Chord::off)
+                    set (fx->chordParam, (float) MidiFxProcessor::Chord::major);
+            }
+            else if (result >= 500) set (fx->gateParam, gates[juce::jlimit (0, (int) std::size (gates) - 1, result - 500)]);
+            else if (result >= 400) set (fx->octavesParam, (float) (result - 400));
+            else if (result >= 300) set (fx->chordParam, (float) (result - 300));
+            else if (result >= 200) set (fx->patternParam, (float) (result - 200));
+            else if (result >= 100) set (fx->rateParam, (float) (result - 100));
+        }
+
+        if (auto* track = trackManager->getTrack (trackIndex))
+            wireAllMidiInputsToTrack (*track);
+
+        if (onInstrumentLabelChanged)
+            onInstrumentLabelChanged (trackIndex);
+    });
 }
 
 juce::String AppEngine::getInsertSlotLabel (int trackIndex, int slotIndex) const
@@ -1352,7 +1757,7 @@ bool AppEngine::pasteClipboardAt (const int trackIndex, const double startBeats)
 
     // Resolve target track and time from beats
     const auto targetTrack = te::Track::Ptr (audioTracks[static_cast<size_t> (trackIndex)]);
-    const auto time = edit->tempoSequence.toTime (t::BeatPosition::fromBeats (startBeats));
+    const auto time = getTempoMap().toTime (t::BeatPosition::fromBeats (startBeats));
 
     ip.setNextInsertPoint (time, targetTrack);
 
@@ -1392,24 +1797,18 @@ bool AppEngine::duplicateMidiClip (te::MidiClip* clip)
         if (audioTrackIndex >= 0)
         {
             // Check for overlap before duplicating (Written by Claude Code)
-            const auto destStartTime = edit->tempoSequence.toTime (t::BeatPosition::fromBeats (destBeats));
-            const auto destEndTime = edit->tempoSequence.toTime (t::BeatPosition::fromBeats (destBeats + lenBeats));
+            const auto destStartTime = getTempoMap().toTime (t::BeatPosition::fromBeats (destBeats));
+            const auto destEndTime = getTempoMap().toTime (t::BeatPosition::fromBeats (destBeats + lenBeats));
             const t::TimeRange destRange (destStartTime, destEndTime);
 
             // Check if any clip on the track would overlap with the duplicate
-            auto clipsOnTrack = getMidiClipsFromTrack (audioTrackIndex);
-            for (auto* existingClip : clipsOnTrack)
+            const auto inTheWay = clipIndex->getOverlapping (*clipTrack, destRange, clip);
+            if (! inTheWay.isEmpty())
             {
-                if (existingClip == clip) continue; // Skip source clip
-
-                auto existingRange = existingClip->getPosition().time;
-                if (destRange.overlaps (existingRange))
-                {
-                    // Would overlap - don't duplicate
-                    DBG ("Cannot duplicate clip - would overlap with existing clip at "
-                         << existingRange.getStart().inSeconds() << "s");
-                    return false;
-                }
+                // Would overlap - don't duplicate
+                DBG ("Cannot duplicate clip - would overlap with existing clip at "
+                     << inTheWay.getFirst()->getPosition().getStart().inSeconds() << "s");
+                return false;
             }
 
             // No overlap - proceed with duplicate
@@ -1432,6 +1831,91 @@ bool AppEngine::deleteMidiClip (te::MidiClip* clip)
     return true;
 }
 
+//==============================================================================
+// Quantize & groove
+
+int AppEngine::quantizeMidiClips (const juce::Array<te::MidiClip*>& clips, const QuantizeEngine::Settings& settings)
+{
+    if (edit == nullptr || clips.isEmpty())
+        return 0;
+
+    auto& um = edit->getUndoManager();
+    um.beginNewTransaction ("Quantize");
+    return QuantizeEngine::quantizeClips (clips, settings, &um);
+}
+
+int AppEngine::quantizeAllMidiClips (const QuantizeEngine::Settings& settings)
+{
+    if (edit == nullptr)
+        return 0;
+
+    juce::Array<te::MidiClip*> clips;
+    for (int i = 0; i < getNumTracks(); ++i)
+        clips.addArray (getMidiClipsFromTrack (i));
+
+    return quantizeMidiClips (clips, settings);
+}
+
+bool AppEngine::extractGrooveFromClip (te::Clip& clip, double lengthBeats, double gridBeats)
+{
+    QuantizeEngine::GrooveTemplate candidate;
+
+    if (auto* midiClip = dynamic_cast<te::MidiClip*> (&clip))
+    {
+        candidate = QuantizeEngine::GrooveTemplate::fromMidiClip (*midiClip, lengthBeats, gridBeats);
+    }
+    else if (auto* waveClip = dynamic_cast<te::WaveAudioClip*> (&clip))
+    {
+        std::vector<double> seconds;
+        std::vector<float> weights;
+        if (! QuantizeEngine::detectOnsets (waveClip->getOriginalFile(),
+                                            engine->getAudioFileFormatManager().readFormatManager,
+                                            seconds, weights))
+            return false;
+
+        // Source seconds -> edit beats, following how the clip is laid out
+        const auto position = waveClip->getPosition();
+        const double sourceBpm = AudioClipEngine::getSourceBpm (*waveClip);
+        const bool followsTempo = waveClip->getAutoTempo() && sourceBpm > 0.0;
+        const double clipStartBeat = waveClip->getStartBeat().inBeats();
+        const double clipEndBeat = waveClip->getEndBeat().inBeats();
+
+        std::vector<double> beats;
+        std::vector<float> visibleWeights;
+
+        for (size_t i = 0; i < seconds.size(); ++i)
+        {
+            double beat = 0.0;
+
+            if (followsTempo)
+            {
+                beat = clipStartBeat - waveClip->getOffsetInBeats().inBeats() + seconds[i] * sourceBpm / 60.0;
+            }
+            else
+            {
+                const double editSeconds = position.getStart().inSeconds()
+                                         + (seconds[i] - position.getOffset().inSeconds()) / waveClip->getSpeedRatio();
+                beat = getTempoMap().toBeats (t::TimePosition::fromSeconds (editSeconds)).inBeats();
+            }
+
+            // Only onsets inside the clip's visible range count
+            if (beat >= clipStartBeat && beat < clipEndBeat)
+            {
+                beats.push_back (beat);
+                visibleWeights.push_back (weights[i]);
+            }
+        }
+
+        candidate = QuantizeEngine::GrooveTemplate::fromOnsets (beats, visibleWeights, lengthBeats, gridBeats);
+    }
+
+    if (! candidate.isValid())
+        return false;
+
+    groove = std::move (candidate);
+    return true;
+}
+
 void AppEngine::importMidiClipViaChooser (int trackIndex,
                                           t::TimePosition destStart,
                                           std::function<void()> onSuccess)
@@ -1454,19 +1938,75 @@ void AppEngine::importMidiClipViaChooser (int trackIndex,
                 return;
             }
 
-            const bool ok = midiEngine->importMidiFileToTrack (file, trackIndex, destStart);
+            auto import = [this, file, trackIndex, destStart, onSuccess] (bool withTempoMap)
+            {
+                const bool ok = midiEngine->importMidiFileToTrack (file, trackIndex, destStart, withTempoMap);
+
+                if (! ok)
+                {
+                    juce::AlertWindow::showMessageBoxAsync (
+                        juce::AlertWindow::WarningIcon,
+                        "MIDI Import Failed",
+                        "Could not import the MIDI file into this track.");
+                }
+                else
+                {
+                    if (onSuccess)
+                        onSuccess();
+                }
+            };
+
+            // Only ask when the file actually carries tempo changes
+            juce::MidiFile mf;
+            juce::FileInputStream in (file);
+            if (! (in.openedOk() && mf.readFrom (in) && TempoMap::countTempoEvents (mf) > 1))
+            {
+                import (false);
+                return;
+            }
+
+            juce::AlertWindow::showOkCancelBox (
+                juce::AlertWindow::QuestionIcon,
+                "Import Tempo Map?",
+                "This MIDI file contains tempo changes. Import them into the project's tempo track?",
+                "Import Tempo Map",
+                "Keep Project Tempo",
+                nullptr,
+                juce::ModalCallbackFunction::create ([import] (int result) { import (result != 0); }));
+        }
+    );
+}
+
+void AppEngine::importAudioClipViaChooser (int trackIndex,
+                                           t::TimePosition destStart,
+                                           std::function<void()> onSuccess)
+{
+    auto chooser = std::make_shared<juce::FileChooser> (
+        "Import Audio File",
+        juce::File(),
+        engine->getAudioFileFormatManager().readFormatManager.getWildcardForAllFormats()
+    );
+
+    chooser->launchAsync (
+        juce::FileBrowserComponent::openMode
+        | juce::FileBrowserComponent::canSelectFiles,
+        [this, chooser, trackIndex, destStart, onSuccess] (const juce::FileChooser& fc)
+        {
+            auto file = fc.getResult();
 
-            if (! ok)
+            if (! file.existsAsFile())
+                return;
+
+            if (insertAudioClip (trackIndex, file, destStart) == nullptr)
             {
                 juce::AlertWindow::showMessageBoxAsync (
                     juce::AlertWindow::WarningIcon,
-                    "MIDI Import Failed",
-                    "Could not import the MIDI file into this track.");
+                    "Audio Import Failed",
+                    "Could not place the audio file on this track.");
             }
-            else
+            else if (onSuccess)
             {
-                if (onSuccess)
-                    onSuccess();
+                onSuccess();
             }
         }
     );
@@ -1484,6 +2024,10 @@ bool AppEngine::canPasteToTrack (int trackIndex) const
     if (!hasClipboardContent())
         return false;
 
+    // The clipboard only ever holds MIDI clips
+    if (isAudioTrack (trackIndex))
+        return false;
+
     // If we don't have type info, allow paste (backwards compatibility)
     if (!hasClipboardTypeInfo)
         return true;
@@ -1493,7 +2037,7 @@ bool AppEngine::canPasteToTrack (int trackIndex) const
     return lastCopiedClipWasDrum == targetIsDrum;
 }
 
-bool AppEngine::exportAudio (const juce::File& destFile)
+bool AppEngine::exportAudio (const juce::File& destFile, double sampleRate)
 {
     if (edit == nullptr)
         return false;
@@ -1524,13 +2068,33 @@ bool AppEngine::exportAudio (const juce::File& destFile)
     DBG ("[Export] Rendering audio to: " << destFile.getFullPathName());
     DBG ("[Export] Edit length (seconds): " << length.inSeconds());
 
-    const bool ok = te::Renderer::renderToFile ("Export audio",
-                                                destFile,
-                                                *edit,
-                                                range,
-                                                tracksToDo,
-                                                usePlugins,
-                                                useThread);
+    bool ok = false;
+
+    if (sampleRate > 0.0)
+    {
+        // Fixed-rate render, independent of whatever device happens to be open
+        te::Renderer::Parameters params (*edit);
+        params.destFile           = destFile;
+        params.audioFormat        = engine->getAudioFileFormatManager().getWavFormat();
+        params.bitDepth           = 24;
+        params.sampleRateForAudio = sampleRate;
+        params.time               = range;
+        params.tracksToDo         = tracksToDo;
+        params.usePlugins         = usePlugins;
+        params.useMasterPlugins   = usePlugins;
+
+        ok = te::Renderer::renderToFile (params).existsAsFile();
+    }
+    else
+    {
+        ok = te::Renderer::renderToFile ("Export audio",
+                                         destFile,
+                                         *edit,
+                                         range,
+                                         tracksToDo,
+                                         usePlugins,
+                                         useThread);
+    }
 
     te::TransportControl::restartAllTransports (*engine, true);
     if (wasPlaying && ok)
@@ -1540,3 +2104,82 @@ bool AppEngine::exportAudio (const juce::File& destFile)
 
     return ok;
 }
+
+MemoryReport AppEngine::collectMemoryReport()
+{
+    MemoryReport report;
+
+    if (edit == nullptr)
+        return report;
+
+    trackManager->addMemoryUsage (report);
+
+    auto& um = edit->getUndoManager();
+    report.add ("Undo", "Edit undo history",
+                (juce::int64) um.getNumberOfUnitsTakenUpByStoredCommands(),
+                um.getUndoDescriptions().size());
+
+    report.add ("Caches", "Audio file cache", engine->getAudioFileManager().cache.getBytesInUse());
+
+    // Edit-level state outside the tracks (tempo, markers, settings); tracks are reported above
+    auto editBytes = MemoryAccounting::estimateValueTreeBytes (edit->state);
+    for (auto* track : te::getAudioTracks (*edit))
+        editBytes -= MemoryAccounting::estimateValueTreeBytes (track->state);
+    report.add ("Edit", "Tempo, markers and settings", juce::jmax<juce::int64> (0, editBytes));
+
+    memoryAccounting.collect (report);
+    return report;
+}
+
+bool AppEngine::writeMemoryReport (const juce::File& file)
+{
+    return file.replaceWithText (collectMemoryReport().toJSONString());
+}
+
+std::vector<SilenceMonitor::TrackStats> AppEngine::getSilenceStats() const
+{
+    return silenceMonitor ? silenceMonitor->getStats() : std::vector<SilenceMonitor::TrackStats> {};
+}
+
+void AppEngine::resetSilenceStats()
+{
+    if (silenceMonitor)
+        silenceMonitor->resetStats();
+}
+
+void AppEngine::setSilenceSuspensionEnabled (bool shouldBeEnabled)
+{
+    if (silenceMonitor)
+        silenceMonitor->setEnabled (shouldBeEnabled);
+}
+
+bool AppEngine::isSilenceSuspensionEnabled() const
+{
+    return silenceMonitor == nullptr || silenceMonitor->isEnabled();
+}
+
+void AppEngine::setPluginSandboxingEnabled (bool shouldSandbox)
+{
+    if (pluginManager)
+        pluginManager->setSandboxingEnabled (shouldSandbox);
+}
+
+bool AppEngine::isPluginSandboxingEnabled() const
+{
+    return pluginManager != nullptr && pluginManager->isSandboxingEnabled();
+}
+
+std::vector<AppEngine::SandboxTrackStats> AppEngine::getSandboxStats() const
+{
+    std::vector<SandboxTrackStats> result;
+    if (edit == nullptr)
+        return result;
+
+    auto tracks = te::getAudioTracks (*edit);
+    for (int i = 0; i < (int) tracks.size(); ++i)
+        for (auto* p : tracks[(size_t) i]->pluginList)
+            if (auto* sandboxed = dynamic_cast<SandboxedPlugin*> (p))
+                result.push_back ({ i, sandboxed->getStats() });
+
+    return result;
+}
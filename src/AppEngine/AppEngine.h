@@ -1,14 +1,28 @@
 #pragma once
 
 #include "../AudioEngine/AudioEngine.h"
+#include "../AudioEngine/AudioClipEngine.h"
+#include "../AudioEngine/AudioThumbnailService.h"
 #include "../MIDIEngine/MIDIEngine.h"
+#include "../MIDIEngine/QuantizeEngine.h"
 #include "../PluginManager/PluginManager.h"
+#include "../PluginManager/SandboxedPlugin.h"
 #include "../UI/TrackView/TrackHeaderComponent.h"
 #include "TrackManager.h"
 #include "MidiListener.h"
 #include "MidiRecorder.h"
+#include "AudioRecorder.h"
+#include "ClipIndex.h"
+#include "AutomationRecorder.h"
+#include "MidiLearn.h"
+#include "MacroControls.h"
+#include "MemoryAccounting.h"
+#include "SilenceMonitor.h"
+#include "StartupOrchestrator.h"
 #include <tracktion_engine/tracktion_engine.h>
 struct MidiListenerKeyAdapter;
+class AuditionQueue;
+class MidiFxPlugin;
 namespace IDs
 {
 #define DECLARE_ID(name)  const juce::Identifier name (#name);
@@ -95,8 +109,19 @@ public:
     AppEngine();
     ~AppEngine() override;
 
+    /**
+     * @brief Starts the deferred startup stages.
+     *
+     * The constructor only creates the engine and an empty edit. This queues
+     * the rest: audio/MIDI device open and the plugin catalogue run on the
+     * message thread after the UI is up, and the sample library installs on a
+     * background thread. Headless users (tests, tools) can skip it.
+     */
     void initialise();
 
+    /** Stage timings and time-to-interactive for this session's startup. */
+    StartupOrchestrator& getStartup() { return startup; }
+
     void createOrLoadEdit();
     void play();
     void stop();
@@ -120,6 +145,41 @@ public:
     te::MidiClip* getMidiClipFromTrack (int trackIndex);
     juce::Array<te::MidiClip*> getMidiClipsFromTrack (int trackIndex);
 
+    /** Per-track clip ranges for overlap and placement queries. */
+    ClipIndex& getClipIndex()             { return *clipIndex; }
+
+    /** True if @p range overlaps a clip on the track other than @p ignore (false for a bad index). */
+    bool wouldClipOverlap (int trackIndex, t::TimeRange range, const te::Clip* ignore = nullptr);
+
+    /** Start of the first clip on the track starting after @p position, other than @p ignore. */
+    std::optional<t::TimePosition> getNextClipStart (int trackIndex, t::TimePosition position,
+                                                     const te::Clip* ignore = nullptr);
+
+    //==============================================================================
+    // Audio Tracks and Clips
+
+    int addAudioTrack();
+    bool isAudioTrack (int index) const;
+
+    /**
+     * @brief Places an audio file on an audio track (see AudioClipEngine::insertAudioClip()).
+     *
+     * @return The new clip, or nullptr if the file can't be read or the track isn't an audio track
+     */
+    te::WaveAudioClip* insertAudioClip (int trackIndex, const juce::File& file, t::TimePosition start);
+    juce::Array<te::WaveAudioClip*> getAudioClipsFromTrack (int trackIndex);
+    bool deleteAudioClip (te::WaveAudioClip* clip);
+
+    /** Opens a file chooser and places the chosen audio file on the given track. */
+    void importAudioClipViaChooser (int trackIndex,
+                                    t::TimePosition destStart,
+                                    std::function<void()> onSuccess = {});
+
+    AudioClipEngine& getAudioClipEngine() { return *audioClipEngine; }
+
+    /** App-wide waveform cache used by audio clip views. */
+    AudioThumbnailService& getThumbnailService() { return *thumbnailService; }
+
     void setTrackMuted (int index, bool mute) { trackManager->setTrackMuted (index, mute); }
     bool isTrackMuted (int index) const { return trackManager->isTrackMuted (index); }
 
@@ -136,9 +196,25 @@ public:
     //==============================================================================
     // Transport and Tempo
 
+    /** Project tempo: the BPM of the first tempo change. */
     double getBpm() const;
+
+    /**
+     * @brief Sets the project tempo (the first tempo change).
+     *
+     * Clips, the loop range and a stopped playhead keep their bar/beat positions;
+     * nothing is rewritten per note. Cheap enough to call on every BPM slider step.
+     */
     void setBpm (double newBpm);
 
+    /**
+     * @brief Tempo changes and beat/time conversion for the current edit.
+     *
+     * Use this instead of edit.tempoSequence for conversions. The same object
+     * follows every edit that gets loaded, so it is safe to keep a reference.
+     */
+    TempoMap& getTempoMap() { return *tempoMap; }
+
     //==============================================================================
     // Metronome Control
 
@@ -218,6 +294,16 @@ public:
      */
     te::AudioTrack* getArmedTrack();
 
+    /**
+     * @brief Arms or disarms an audio track for multitrack audio recording.
+     *
+     * Unlike setArmedTrack(), any number of audio tracks can be armed at once; each
+     * records its own input pair (see TrackManager::setAudioTrackInput()). The
+     * audio input device is opened only while an audio track is armed.
+     */
+    void setAudioTrackArmed (int index, bool shouldBeArmed);
+    bool isAudioTrackArmed (int index) const;
+
     /**
      * @brief Callback invoked when the armed track changes.
      *
@@ -230,7 +316,8 @@ public:
      * @brief Toggles the recording state.
      *
      * If not recording:
-     *  - Starts recording on the currently armed track (if any)
+     *  - Records MIDI on the armed instrument track (if any), and audio on every
+     *    armed audio track at once, each from its own input pair
      *  - Automatically starts transport if not already playing
      *  - Positions at loop start if looping is enabled
      *
@@ -270,6 +357,9 @@ public:
      */
     std::function<void()> onRecordingStopped;
 
+    /** Audio input recorder, for FIFO fill / overrun monitoring while recording. */
+    const AudioRecorder& getAudioRecorder() const { return *audioRecorder; }
+
     TrackManager& getTrackManager()       { return *trackManager; }
     TrackManager* getTrackManagerPtr()    { return trackManager.get(); }
 
@@ -342,6 +432,24 @@ public:
      */
     juce::StringArray listMidiInputDevices()         const { return audioEngine->listMidiInputDevices(); }
 
+    /**
+     * @brief Plays a note on a track's instrument for feedback while editing (piano roll).
+     *
+     * MorphSynth takes the note through its own AuditionQueue at the next block
+     * boundary. Other instruments take it from the track's MIDI FX slot, which is
+     * inserted as a pass-through the first time it's needed.
+     *
+     * @param trackIndex    Track whose instrument plays the note
+     * @param note          MIDI note number
+     * @param velocity      Velocity (1..127)
+     * @param lengthSeconds Time until the note-off
+     * @param stopOthers    Ends the track's other audition notes first (monophonic drag)
+     */
+    void auditionNote (int trackIndex, int note, int velocity, double lengthSeconds = 0.25, bool stopOthers = false);
+
+    /** Ends every audition note on a track. */
+    void stopAudition (int trackIndex);
+
     bool saveEdit();
     void saveEditAsAsync (std::function<void (bool success)> onDone = {});
 
@@ -352,8 +460,17 @@ public:
 
     void openEditAsync (std::function<void (bool success)> onDone = {});
     bool loadEditFromFile (const juce::File& file);
+
+    /**
+     * @brief Flushes plugin state and serialises the current edit to a file.
+     *
+     * Does not change currentEditFile or the saved/dirty state (see saveEdit()).
+     *
+     * @param file Destination .tracktionedit file.
+     * @return true if the file was written.
+     */
+    bool writeEditToFile (const juce::File& file);
     std::function<void()> onEditLoaded;
-    std::function<void(double oldBpm, double newBpm, t::TimeRange oldLoopRange, t::TimePosition oldPlayheadPos)> onBpmChanged;
 
     void newUntitledEdit();
 
@@ -382,6 +499,35 @@ public:
     void importMidiClipViaChooser (int trackIndex,
                                t::TimePosition destStart,
                                std::function<void()> onSuccess = {});
+    //==============================================================================
+    // Quantize & groove
+
+    /**
+     * @brief Quantizes every note of @p clips as one undo step (see QuantizeEngine).
+     *
+     * @return Number of notes that changed
+     */
+    int quantizeMidiClips (const juce::Array<te::MidiClip*>& clips, const QuantizeEngine::Settings& settings);
+
+    /** Quantizes every MIDI clip on every track as one undo step. @return notes changed */
+    int quantizeAllMidiClips (const QuantizeEngine::Settings& settings);
+
+    /**
+     * @brief Makes a MIDI clip's or audio clip's timing the current groove template.
+     *
+     * MIDI clips use their note starts and velocities. Audio clips use onsets
+     * detected in the source file, mapped onto the edit's beats through the clip's
+     * position and the tempo map.
+     *
+     * @param lengthBeats Groove period in beats
+     * @param gridBeats   Groove slot spacing in beats
+     * @return true if the clip produced a usable groove
+     */
+    bool extractGrooveFromClip (te::Clip& clip, double lengthBeats = 4.0, double gridBeats = 0.25);
+
+    /** The last extracted groove, or nullptr if there is none. */
+    const QuantizeEngine::GrooveTemplate* getGroove() const { return groove.isValid() ? &groove : nullptr; }
+
     // Check if clipboard has content (Junie)
     bool hasClipboardContent() const;
     // Check if clipboard content can be pasted to a specific track (Junie)
@@ -391,6 +537,14 @@ public:
 
     void showInstrumentChooser (int trackIndex);
 
+    /**
+     * @brief Shows the MIDI FX menu (arpeggiator / chord / note repeat) for a track.
+     *
+     * Picking a mode adds the effect ahead of the instrument; "Off" removes it.
+     * Calls onInstrumentLabelChanged, since the header label shows the effect.
+     */
+    void showMidiFxMenu (int trackIndex);
+
     void onFxInsertSlotClicked (int trackIndex,
                             int slotIndex,
                             std::function<void (const juce::String&)> onSlotLabelChange);
@@ -402,24 +556,119 @@ public:
     juce::String getInstrumentLabelForTrack (int trackIndex) const;
     juce::String getInsertSlotLabel       (int trackIndex, int slotIndex) const;
 
-    PluginManager& getPluginManager() { return *pluginManager; }
+    /** The plugin catalogue, or nullptr until the deferred "Plugin catalogue" startup stage has run. */
+    PluginManager* getPluginManager() noexcept  { return pluginManager.get(); }
 
-    bool exportAudio (const juce::File& destFile);
+    /**
+     * @brief Renders the whole edit offline to a WAV file.
+     *
+     * @param destFile   Output file (parent directory is created if needed).
+     * @param sampleRate Render rate; 0 uses the current device rate. Pass an explicit
+     *                   rate when the output must be reproducible (e.g. golden tests).
+     * @return true if the render succeeded.
+     */
+    bool exportAudio (const juce::File& destFile, double sampleRate = 0.0);
+
+    //==============================================================================
+    // Diagnostics
+
+    /** Hook registry for subsystems AppEngine doesn't own (editors, windows, on-demand caches). */
+    MemoryAccounting& getMemoryAccounting() { return memoryAccounting; }
+
+    /**
+     * @brief Collects memory estimates for the current session.
+     *
+     * Covers tracks/MIDI clips, drum samplers, MorphSynth instances, other plugin
+     * state, undo history and engine caches, then every registered provider.
+     */
+    MemoryReport collectMemoryReport();
+
+    /** Writes collectMemoryReport() to @p file as JSON. */
+    bool writeMemoryReport (const juce::File& file);
+
+    /**
+     * @brief Per-track silence counters: how long each MorphSynth skipped rendering
+     *        and its FX inserts were suspended (see SilenceGate).
+     */
+    std::vector<SilenceMonitor::TrackStats> getSilenceStats() const;
+    void resetSilenceStats();
+
+    /** Turns automatic insert suspension on or off (on by default). */
+    void setSilenceSuspensionEnabled (bool shouldBeEnabled);
+    bool isSilenceSuspensionEnabled() const;
+
+    /** Writes knob moves made while recording to the instruments' curves, thinned. */
+    AutomationRecorder& getAutomationRecorder() { return *automationRecorder; }
+
+    /** Hardware controller mappings for the current edit. */
+    MidiLearn& getMidiLearn()                   { return *midiLearn; }
+
+    /** Per-track macro knobs and their parameter targets. */
+    MacroControls& getMacroControls()           { return *macroControls; }
+
+    /** Hosts external plugins inserted from now on in worker processes (see SandboxedPlugin). Off by default. */
+    void setPluginSandboxingEnabled (bool shouldSandbox);
+    bool isPluginSandboxingEnabled() const;
+
+    /** Overhead and health of one sandboxed plugin. */
+    struct SandboxTrackStats
+    {
+        int trackIndex = -1;
+        SandboxedPlugin::Stats stats;
+    };
+
+    /** Every sandboxed plugin in the edit, in track order. */
+    std::vector<SandboxTrackStats> getSandboxStats() const;
 
 
 private:
+    /** Opens the default audio device and MIDI inputs, then rebuilds playback. */
+    void openDevices();
+
+    /** Starts AudioRecorder with one stream per recording audio track. */
+    void startAudioRecording();
+
+    /** True if @p index is an audio track armed for recording (either way of arming). */
+    bool isRecordingAudioOnTrack (int index) const;
+
+    /** Opens the audio input while an audio track is armed, and closes it otherwise. */
+    void updateAudioInput();
+
+    /** Stops whichever recorder is running and places its clips. Returns true if a clip was made. */
+    bool stopActiveRecording();
+
+    /**
+     * The queue that reaches a track's instrument: MorphSynth's own, else the MIDI FX slot's.
+     * With @p createRoute, a track with another instrument and no slot gets a pass-through one.
+     */
+    AuditionQueue* getAuditionQueue (int trackIndex, bool createRoute);
+
+    /** Inserts (or resets) the MIDI FX slot with mode and chord off, so it only carries audition notes. */
+    MidiFxPlugin* insertPassThroughMidiFx (int trackIndex);
+
+    MemoryAccounting memoryAccounting;
+
     std::unique_ptr<tracktion::engine::Engine> engine;
     std::unique_ptr<tracktion::engine::Edit> edit;
     std::unique_ptr<te::SelectionManager> selectionManager;
 
     std::unique_ptr<EditViewState> editViewState;
 
+    std::unique_ptr<TempoMap> tempoMap;     ///< Lives as long as AppEngine; follows the current edit
     std::unique_ptr<MIDIEngine> midiEngine;
+    std::unique_ptr<AudioClipEngine> audioClipEngine;
     std::unique_ptr<AudioEngine> audioEngine;
+    std::unique_ptr<AudioThumbnailService> thumbnailService;
     std::unique_ptr<TrackManager> trackManager;
+    std::unique_ptr<ClipIndex> clipIndex;
+    std::unique_ptr<SilenceMonitor> silenceMonitor;     ///< Reads clipIndex
+    std::unique_ptr<AutomationRecorder> automationRecorder;
+    std::unique_ptr<MidiLearn> midiLearn;
+    std::unique_ptr<MacroControls> macroControls;
     std::unique_ptr<PluginManager> pluginManager;
     std::unique_ptr<MidiListener> midiListener;
     std::unique_ptr<MidiRecorder> midiRecorder;
+    std::unique_ptr<AudioRecorder> audioRecorder;
     std::unique_ptr<MidiListenerKeyAdapter> qwertyForwarder_;
 
     // Map from track index to its controller listener (TrackComponent) (Junie)
@@ -437,7 +686,6 @@ private:
 
 
 
-    bool writeEditToFile (const juce::File& file);
     void markSaved();
     int currentUndoTxn() const;
 
@@ -452,5 +700,10 @@ private:
     bool hasClipboardTypeInfo = false;
     double lastCopiedClipLengthBeats = 0.0; // Length in beats (Written by Claude Code)
 
+    QuantizeEngine::GrooveTemplate groove;  ///< Current groove template (see extractGrooveFromClip())
+
+    // Declared last so it is destroyed first: background stages finish before anything they touch goes away
+    StartupOrchestrator startup;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AppEngine)
 };
\ No newline at end of file
@@ -0,0 +1,381 @@
+#include "AudioRecorder.h"
+#include "../AudioEngine/AsyncLog.h"
+
+using namespace juce;
+namespace te = tracktion::engine;
+namespace t = tracktion;
+
+//==============================================================================
+// Construction / Destruction
+
+AudioRecorder::Stream::Stream (const Input& in, int fifoSize)
+    : input (in),
+      fifo (fifoSize),
+      fifoBuffer (in.numChannels, fifoSize)
+{
+    fifoBuffer.clear();
+}
+
+AudioRecorder::AudioRecorder (te::Engine& eng)
+    : juce::Thread ("GrooveKit Audio Recorder"),
+      engine (eng)
+{
+}
+
+AudioRecorder::~AudioRecorder()
+{
+    if (recording)
+        closeStreams();
+}
+
+//==============================================================================
+// Recording Control
+
+bool AudioRecorder::startRecording (te::Edit& edit, const std::vector<Input>& inputs,
+                                    const juce::File& directory, double sampleRate)
+{
+    if (recording)
+    {
+        GROOVEKIT_LOG (info, "AudioRecorder", "Already recording");
+        return false;
+    }
+
+    GROOVEKIT_LOG (info, "AudioRecorder", "========== START RECORDING ==========");
+
+    // Everything that allocates or touches the disk happens here, before the
+    // device ever sees the streams
+    if (! openStreams (inputs, directory, sampleRate))
+    {
+        GROOVEKIT_LOG (warning, "AudioRecorder", "No streams could be opened");
+        return false;
+    }
+
+    auto& transport = edit.getTransport();
+    transport.ensureContextAllocated();
+
+    if (! transport.isPlaying())
+    {
+        if (transport.looping)
+            transport.setPosition (transport.getLoopRange().getStart());
+
+        transport.play (false);
+    }
+
+    // The take is stamped by the audio callback, once the playhead is moving
+    playbackContext = transport.getCurrentPlaybackContext();
+    beginCapture (true);
+
+    GROOVEKIT_LOG (info, "AudioRecorder", "Recording " << (int) streams.size() << " stream(s) at "
+                                          << sampleRate << " Hz, input latency "
+                                          << inputLatencySamples.load() << " samples");
+    return true;
+}
+
+bool AudioRecorder::startExternalRecording (const std::vector<Input>& inputs,
+                                            const juce::File& directory, double sampleRate)
+{
+    if (recording || ! openStreams (inputs, directory, sampleRate))
+        return false;
+
+    playbackContext = nullptr;
+    beginCapture (false);
+    return true;
+}
+
+void AudioRecorder::beginCapture (bool fromDevice)
+{
+    takeStartSeconds = 0.0;
+    takeStarted = false;
+    lastPlayheadSeconds = -1.0;
+
+    startThread (juce::Thread::Priority::high);
+
+    // Publishes the fields above to the audio thread
+    capturing = true;
+    recording = true;
+
+    if (fromDevice)
+    {
+        engine.getDeviceManager().deviceManager.addAudioCallback (this);
+        callbackRegistered = true;
+    }
+}
+
+std::vector<AudioRecorder::Take> AudioRecorder::stopRecording()
+{
+    if (! recording)
+        return {};
+
+    GROOVEKIT_LOG (info, "AudioRecorder", "========== STOP RECORDING ==========");
+
+    auto takes = closeStreams();
+
+    GROOVEKIT_LOG (info, "AudioRecorder", "Finished " << (int) takes.size() << " take(s)");
+    return takes;
+}
+
+std::vector<int> AudioRecorder::getRecordingTrackIndices() const
+{
+    std::vector<int> indices;
+
+    if (recording)
+        for (auto& s : streams)
+            indices.push_back (s->input.trackIndex);
+
+    return indices;
+}
+
+//==============================================================================
+// Monitoring
+
+std::vector<AudioRecorder::StreamStatus> AudioRecorder::getStreamStatus() const
+{
+    std::vector<StreamStatus> result;
+    result.reserve (streams.size());
+
+    for (auto& s : streams)
+    {
+        StreamStatus st;
+        st.trackIndex     = s->input.trackIndex;
+        st.fillLevel      = (float) s->fifo.getNumReady() / (float) s->fifo.getTotalSize();
+        st.peakFillLevel  = s->peakFill.load();
+        st.samplesWritten = s->samplesWritten.load();
+        st.overruns       = s->overruns.load();
+        result.push_back (st);
+    }
+
+    return result;
+}
+
+float AudioRecorder::getMaxFillLevel() const
+{
+    float maxFill = 0.0f;
+
+    for (auto& s : streams)
+        maxFill = jmax (maxFill, (float) s->fifo.getNumReady() / (float) s->fifo.getTotalSize());
+
+    return maxFill;
+}
+
+//==============================================================================
+// Capture
+
+void AudioRecorder::pushInputBlock (const float* const* inputs, int numInputs, int numSamples) noexcept
+{
+    for (auto& s : streams)
+    {
+        auto& fifo = s->fifo;
+
+        // Never wait for the writer: drop the block and report it instead
+        if (fifo.getFreeSpace() < numSamples)
+        {
+            s->overruns.fetch_add (1, std::memory_order_relaxed);
+            continue;
+        }
+
+        int start1, size1, start2, size2;
+        fifo.prepareToWrite (numSamples, start1, size1, start2, size2);
+
+        for (int c = 0; c < s->input.numChannels; ++c)
+        {
+            const int deviceChannel = s->input.firstChannel + c;
+            const float* src = deviceChannel < numInputs ? inputs[deviceChannel] : nullptr;
+
+            if (src != nullptr)
+            {
+                s->fifoBuffer.copyFrom (c, start1, src, size1);
+                if (size2 > 0)
+                    s->fifoBuffer.copyFrom (c, start2, src + size1, size2);
+            }
+            else
+            {
+                s->fifoBuffer.clear (c, start1, size1);
+                if (size2 > 0)
+                    s->fifoBuffer.clear (c, start2, size2);
+            }
+        }
+
+        fifo.finishedWrite (size1 + size2);
+
+        // Only this thread writes the peak, so a plain compare/store is enough
+        const float fill = (float) fifo.getNumReady() / (float) fifo.getTotalSize();
+        if (fill > s->peakFill.load (std::memory_order_relaxed))
+            s->peakFill.store (fill, std::memory_order_relaxed);
+    }
+}
+
+void AudioRecorder::audioDeviceIOCallbackWithContext (const float* const* inputChannelData,
+                                                      int numInputChannels,
+                                                      float* const* outputChannelData,
+                                                      int numOutputChannels,
+                                                      int numSamples,
+                                                      const juce::AudioIODeviceCallbackContext&)
+{
+    // Input-only callback: the device manager mixes our outputs in, so keep them silent
+    for (int i = 0; i < numOutputChannels; ++i)
+        if (outputChannelData[i] != nullptr)
+            FloatVectorOperations::clear (outputChannelData[i], numSamples);
+
+    if (capturing.load (std::memory_order_acquire) && playheadStarted())
+        pushInputBlock (inputChannelData, numInputChannels, numSamples);
+}
+
+bool AudioRecorder::playheadStarted() noexcept
+{
+    if (takeStarted)
+        return true;
+
+    if (playbackContext != nullptr)
+    {
+        // The audible position is what the performer hears now, output latency included
+        const double now = playbackContext->getAudibleTimelineTime().inSeconds();
+
+        // Until the transport has really started, its start-up delay isn't part of the take
+        if (lastPlayheadSeconds < 0.0 || now <= lastPlayheadSeconds)
+        {
+            lastPlayheadSeconds = now;
+            return false;
+        }
+
+        // This block's first sample was played input-latency ago
+        takeStartSeconds.store (jmax (0.0, now - inputLatencySamples.load (std::memory_order_relaxed) / takeSampleRate),
+                                std::memory_order_relaxed);
+    }
+
+    takeStarted = true;
+    return true;
+}
+
+void AudioRecorder::audioDeviceAboutToStart (juce::AudioIODevice* device)
+{
+    inputLatencySamples = device != nullptr ? device->getInputLatencyInSamples() : 0;
+}
+
+//==============================================================================
+// Writer Thread
+
+void AudioRecorder::run()
+{
+    while (! threadShouldExit())
+    {
+        int written = 0;
+
+        for (auto& s : streams)
+            written += drain (*s);
+
+        if (written == 0)
+            wait (writerIntervalMs);
+    }
+
+    // Capture has stopped by now; flush whatever is left
+    for (auto& s : streams)
+        drain (*s);
+}
+
+int AudioRecorder::drain (Stream& stream)
+{
+    const int numReady = stream.fifo.getNumReady();
+    if (numReady == 0)
+        return 0;
+
+    int start1, size1, start2, size2;
+    stream.fifo.prepareToRead (numReady, start1, size1, start2, size2);
+
+    if (stream.writer != nullptr)
+    {
+        if (size1 > 0)
+            stream.writer->writeFromAudioSampleBuffer (stream.fifoBuffer, start1, size1);
+        if (size2 > 0)
+            stream.writer->writeFromAudioSampleBuffer (stream.fifoBuffer, start2, size2);
+    }
+
+    stream.fifo.finishedRead (size1 + size2);
+    stream.samplesWritten.fetch_add (size1 + size2, std::memory_order_relaxed);
+
+    return size1 + size2;
+}
+
+//==============================================================================
+// Stream Setup / Teardown
+
+bool AudioRecorder::openStreams (const std::vector<Input>& inputs, const juce::File& directory, double sampleRate)
+{
+    streams.clear();
+
+    if (inputs.empty() || sampleRate <= 0.0 || ! directory.createDirectory())
+        return false;
+
+    takeSampleRate = sampleRate;
+    const int fifoSize = (int) std::ceil (sampleRate * fifoSeconds);
+    const auto stamp = Time::getCurrentTime().formatted ("%Y%m%d-%H%M%S");
+
+    WavAudioFormat wav;
+
+    for (const auto& in : inputs)
+    {
+        if (in.numChannels <= 0 || in.firstChannel < 0)
+            continue;
+
+        auto stream = std::make_unique<Stream> (in, fifoSize);
+        stream->file = directory.getNonexistentChildFile ("Track " + String (in.trackIndex + 1) + " " + stamp, ".wav");
+
+        auto out = std::make_unique<FileOutputStream> (stream->file);
+        if (out->failedToOpen())
+        {
+            GROOVEKIT_LOG (warning, "AudioRecorder", "Can't create " << stream->file.getFullPathName());
+            continue;
+        }
+
+        // 24-bit WAV; JUCE writes RF64 headers by itself once a take passes 4 GB
+        stream->writer.reset (wav.createWriterFor (out.get(), sampleRate, (unsigned int) in.numChannels,
+                                                   24, {}, 0));
+        if (stream->writer == nullptr)
+        {
+            out.reset();
+            stream->file.deleteFile();
+            continue;
+        }
+
+        out.release(); // now owned by the writer
+        streams.push_back (std::move (stream));
+    }
+
+    return ! streams.empty();
+}
+
+std::vector<AudioRecorder::Take> AudioRecorder::closeStreams()
+{
+    capturing = false;
+
+    // After removeAudioCallback returns the device can no longer be inside pushInputBlock
+    if (callbackRegistered)
+    {
+        engine.getDeviceManager().deviceManager.removeAudioCallback (this);
+        callbackRegistered = false;
+    }
+
+    stopThread (10000);
+
+    const auto takeStart = t::TimePosition::fromSeconds (takeStartSeconds.load());
+    playbackContext = nullptr;
+
+    std::vector<Take> takes;
+
+    for (auto& s : streams)
+    {
+        s->writer.reset(); // finalises the header
+
+        if (s->samplesWritten.load() > 0)
+            takes.push_back ({ s->input.trackIndex, s->file, takeStart });
+        else
+            s->file.deleteFile();
+
+        if (s->overruns.load() > 0)
+            GROOVEKIT_LOG (warning, "AudioRecorder", "Track " << s->input.trackIndex << ": "
+                                                     << s->overruns.load() << " dropped block(s)");
+    }
+
+    streams.clear();
+    recording = false;
+    return takes;
+}
@@ -0,0 +1,229 @@
+#pragma once
+
+#include <juce_audio_devices/juce_audio_devices.h>
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <tracktion_engine/tracktion_engine.h>
+
+#include <atomic>
+#include <vector>
+
+namespace te = tracktion::engine;
+
+/**
+ * @brief Records audio inputs to disk on one or more tracks at once.
+ *
+ * The counterpart of MidiRecorder for audio tracks. It sits beside Tracktion's
+ * playback graph as an extra juce::AudioIODeviceCallback, so recording doesn't
+ * depend on Tracktion's input/record routing.
+ *
+ * Data path:
+ *  - Audio thread: each recorded track (a "stream") has a lock-free
+ *    juce::AbstractFifo sized for fifoSeconds of audio. The callback only copies
+ *    input channels into those FIFOs; it never allocates, locks or touches a file.
+ *  - Writer thread: a dedicated thread drains every FIFO and streams it to a
+ *    24-bit WAV per track. Files and writers are opened before capture starts.
+ *    JUCE's WAV writer switches to RF64 by itself past 4 GB, so long takes are fine.
+ *  - If a FIFO is ever full, the block is dropped and counted as an overrun
+ *    instead of blocking the audio thread.
+ *
+ * Monitoring: getStreamStatus() reports per-stream FIFO fill (current and peak),
+ * samples written and overruns. All values are atomics, safe to poll from the UI.
+ *
+ * Usage:
+ *  1. startRecording() with the tracks and input channels to capture
+ *  2. stopRecording() to finish the files; the caller places the returned takes
+ *     (AppEngine does this through AudioClipEngine)
+ */
+class AudioRecorder : private juce::AudioIODeviceCallback,
+                      private juce::Thread
+{
+public:
+    //==============================================================================
+    // Types
+
+    /** One track to record and the device inputs that feed it. */
+    struct Input
+    {
+        int trackIndex = -1;        ///< Audio track to place the take on.
+        int firstChannel = 0;       ///< First device input channel (0-based).
+        int numChannels = 2;        ///< 1 = mono, 2 = stereo.
+    };
+
+    /** Live state of one stream, for meters and diagnostics. */
+    struct StreamStatus
+    {
+        int trackIndex = -1;
+        float fillLevel = 0.0f;         ///< Current FIFO fill, 0..1.
+        float peakFillLevel = 0.0f;     ///< Highest fill since recording started, 0..1.
+        juce::int64 samplesWritten = 0; ///< Samples (per channel) written to disk.
+        int overruns = 0;               ///< Blocks dropped because the FIFO was full.
+    };
+
+    /** A finished recording, ready to be placed as a clip. */
+    struct Take
+    {
+        int trackIndex = -1;
+        juce::File file;
+        tracktion::TimePosition start;
+    };
+
+    //==============================================================================
+    // Construction / Destruction
+
+    /**
+     * @brief Constructs the AudioRecorder.
+     *
+     * @param engine Reference to the Tracktion Engine instance (for its device manager).
+     */
+    explicit AudioRecorder (te::Engine& engine);
+
+    /** Destructor. Stops any recording in progress (files are kept, no clips made). */
+    ~AudioRecorder() override;
+
+    //==============================================================================
+    // Recording Control
+
+    /**
+     * @brief Opens one file per input and starts capturing.
+     *
+     * Starts the transport if it isn't already playing. Capture waits for the
+     * playhead to move, so the transport's start-up delay isn't recorded. The takes
+     * start where the playhead was heard when the first captured sample was
+     * played: the playback context's audible position at that block, less the
+     * device's input latency.
+     *
+     * @param edit       The edit whose transport the takes are aligned to.
+     * @param inputs     Tracks to record and their input channels.
+     * @param directory  Where the take files are written (created if needed).
+     * @param sampleRate Device sample rate the takes are written at.
+     * @return false if nothing could be opened (no inputs, bad directory).
+     */
+    bool startRecording (te::Edit& edit, const std::vector<Input>& inputs,
+                         const juce::File& directory, double sampleRate);
+
+    /**
+     * @brief As startRecording(), but the audio comes from pushInputBlock() instead
+     *        of the device, and no transport is involved (takes start at 0).
+     *
+     * For capturing other sources, and for throughput benchmarks.
+     */
+    bool startExternalRecording (const std::vector<Input>& inputs,
+                                 const juce::File& directory, double sampleRate);
+
+    /**
+     * @brief Stops capturing and finishes the files.
+     *
+     * Everything already queued is written before the files are closed. Streams
+     * that captured nothing are deleted rather than returned.
+     *
+     * @return One take per stream that recorded audio.
+     */
+    std::vector<Take> stopRecording();
+
+    /** Returns whether recording is currently active. */
+    bool isRecording() const { return recording; }
+
+    /** Tracks being recorded to (empty when not recording). */
+    std::vector<int> getRecordingTrackIndices() const;
+
+    /**
+     * @brief Queues one block of input into every stream's FIFO.
+     *
+     * The device callback calls this. During startExternalRecording() the caller
+     * does, from one thread at a time. Real-time safe: copies only. A stream
+     * whose FIFO is full drops the block and counts an overrun.
+     */
+    void pushInputBlock (const float* const* inputs, int numInputs, int numSamples) noexcept;
+
+    //==============================================================================
+    // Monitoring
+
+    /** Per-stream FIFO fill, peak, written samples and overruns. */
+    std::vector<StreamStatus> getStreamStatus() const;
+
+    /** Highest current fill across all streams, 0..1 (for a single meter). */
+    float getMaxFillLevel() const;
+
+    /** Seconds of audio each stream's FIFO can hold before the writer must catch up. */
+    static constexpr double fifoSeconds = 2.0;
+
+    /** Writer sleep when every FIFO is empty. The audio thread never signals it (no locks). */
+    static constexpr int writerIntervalMs = 5;
+
+private:
+    //==============================================================================
+    // Internal Types
+
+    /** One track's FIFO and file writer. */
+    struct Stream
+    {
+        Stream (const Input& in, int fifoSize);
+
+        Input input;
+        juce::File file;
+        std::unique_ptr<juce::AudioFormatWriter> writer;
+
+        juce::AbstractFifo fifo;
+        juce::AudioBuffer<float> fifoBuffer;        ///< numChannels x fifoSize ring
+
+        std::atomic<juce::int64> samplesWritten { 0 };
+        std::atomic<int> overruns { 0 };
+        std::atomic<float> peakFill { 0.0f };
+    };
+
+    //==============================================================================
+    // Capture (audio thread)
+
+    // juce::AudioIODeviceCallback
+
+    void audioDeviceIOCallbackWithContext (const float* const* inputChannelData,
+                                           int numInputChannels,
+                                           float* const* outputChannelData,
+                                           int numOutputChannels,
+                                           int numSamples,
+                                           const juce::AudioIODeviceCallbackContext& context) override;
+    void audioDeviceAboutToStart (juce::AudioIODevice*) override;
+    void audioDeviceStopped() override {}
+
+    /** Audio thread: true once the playhead moves (always, without a transport); stamps the take. */
+    bool playheadStarted() noexcept;
+
+    //==============================================================================
+    // Writer Thread
+
+    void run() override;
+
+    /** Moves everything currently queued in @p stream to its file. Returns samples written. */
+    int drain (Stream& stream);
+
+    /** Starts the writer, then lets blocks in (from the device if @p fromDevice). */
+    void beginCapture (bool fromDevice);
+
+    /** Opens streams/files; nothing is registered with the device yet. */
+    bool openStreams (const std::vector<Input>& inputs, const juce::File& directory, double sampleRate);
+
+    /** Stops capture and the writer, then closes files (everything queued is written). */
+    std::vector<Take> closeStreams();
+
+    //==============================================================================
+    // Member Variables
+
+    te::Engine& engine;                                  ///< Reference to Tracktion Engine (not owned).
+
+    std::vector<std::unique_ptr<Stream>> streams;        ///< Built before capture, torn down after it.
+    std::atomic<bool> recording { false };               ///< Whether recording is currently active.
+    std::atomic<bool> capturing { false };               ///< Audio callback gate.
+    bool callbackRegistered = false;
+
+    double takeSampleRate = 48000.0;
+
+    te::EditPlaybackContext* playbackContext = nullptr;  ///< The transport's, while recording from the device
+    std::atomic<int> inputLatencySamples { 0 };          ///< Reported by the device when it starts
+    std::atomic<double> takeStartSeconds { 0.0 };        ///< Written by the audio thread at the first captured block
+
+    // Audio thread only
+    bool takeStarted = false;
+    double lastPlayheadSeconds = -1.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioRecorder)
+};
@@ -0,0 +1,188 @@
+#include "AutomationRecorder.h"
+#include "TrackManager.h"
+
+#include <cmath>
+#include <utility>
+
+//==============================================================================
+// Construction
+
+AutomationRecorder::AutomationRecorder (te::Edit& e, TrackManager& tm)
+    : edit (e), trackManager (tm)
+{
+    // Takes are written here, thinned; the engine's recorder would write every change
+    edit.getAutomationRecordManager().setWritingAutomation (false);
+
+    updateWatchedParameters();
+    startTimerHz (10);
+}
+
+AutomationRecorder::~AutomationRecorder()
+{
+    stopTimer();
+
+    for (auto* param : watched)
+        param->removeListener (this);
+}
+
+//==============================================================================
+// Thinning
+
+std::vector<AutomationRecorder::Point> AutomationRecorder::simplify (const std::vector<Point>& points, float tolerance)
+{
+    if (points.size() <= 2)
+        return points;
+
+    std::vector<bool> keep (points.size(), false);
+    keep.front() = keep.back() = true;
+
+    // Explicit stack: a long take would recurse once per kept point
+    std::vector<std::pair<size_t, size_t>> spans { { 0, points.size() - 1 } };
+
+    while (! spans.empty())
+    {
+        const auto [first, last] = spans.back();
+        spans.pop_back();
+
+        const auto& a = points[first];
+        const auto& b = points[last];
+        const double span = b.time - a.time;
+
+        float worstError = -1.0f;
+        size_t worst = first;
+
+        for (size_t i = first + 1; i < last; ++i)
+        {
+            // Value playback would give at this point's time if it were dropped
+            const double proportion = span > 0.0 ? (points[i].time - a.time) / span : 0.0;
+            const auto line = (float) (a.value + (b.value - a.value) * proportion);
+            const float error = std::abs (points[i].value - line);
+
+            if (error > worstError)
+            {
+                worstError = error;
+                worst = i;
+            }
+        }
+
+        if (worstError > tolerance)
+        {
+            keep[worst] = true;
+            spans.push_back ({ first, worst });
+            spans.push_back ({ worst, last });
+        }
+    }
+
+    std::vector<Point> result;
+    for (size_t i = 0; i < points.size(); ++i)
+        if (keep[i])
+            result.push_back (points[i]);
+
+    return result;
+}
+
+//==============================================================================
+// Recording
+
+void AutomationRecorder::parameterChanged (te::AutomatableParameter& param, float newValue)
+{
+    auto& transport = edit.getTransport();
+    if (! transport.isRecording())
+        return;
+
+    const double now = transport.getPosition().inSeconds();
+    auto& take = takes[&param];
+
+    // The transport looped back: what came before is a take of its own
+    if (! take.points.empty() && now < take.points.back().time)
+        writeTake (param, take);
+
+    // Several changes between two position updates: the last one wins
+    if (! take.points.empty() && now == take.points.back().time)
+        take.points.back().value = newValue;
+    else
+        take.points.push_back ({ now, newValue });
+
+    take.lastChangeMs = juce::Time::getMillisecondCounter();
+    ++numRecorded;
+}
+
+void AutomationRecorder::timerCallback()
+{
+    // Instruments come and go with the chooser; a second's delay is fine for that
+    if (--ticksUntilRescan <= 0)
+        updateWatchedParameters();
+
+    const bool recording = edit.getTransport().isRecording();
+    const auto now = juce::Time::getMillisecondCounter();
+
+    for (auto* param : watched)
+    {
+        auto it = takes.find (param);
+        if (it == takes.end() || it->second.points.empty())
+            continue;
+
+        if (! recording || now - it->second.lastChangeMs >= (juce::uint32) settleMs)
+            writeTake (*param, it->second);
+    }
+}
+
+void AutomationRecorder::writeTake (te::AutomatableParameter& param, Take& take)
+{
+    const auto range = param.getValueRange();
+    const auto points = simplify (take.points, range.getLength() * toleranceFraction);
+    take.points.clear();
+
+    if (points.empty())
+        return;
+
+    auto& curve = param.getCurve();
+    auto* um = &edit.getUndoManager();
+
+    // The take replaces what was there; a lone point just sets the value from there on
+    const auto start = t::TimePosition::fromSeconds (points.front().time);
+    const auto end   = t::TimePosition::fromSeconds (points.back().time);
+
+    if (end > start)
+        curve.removePointsInRegion (t::TimeRange (start, end), um);
+
+    for (const auto& p : points)
+        curve.addPoint (t::TimePosition::fromSeconds (p.time), p.value, 0.0f, um);
+
+    numWritten += (int) points.size();
+}
+
+void AutomationRecorder::updateWatchedParameters()
+{
+    ticksUntilRescan = 10;
+
+    juce::ReferenceCountedArray<te::AutomatableParameter> current;
+
+    for (int i = 0; i < trackManager.getNumTracks(); ++i)
+        if (auto* instrument = trackManager.getInstrumentPluginOnTrack (i))
+            for (auto* param : instrument->getAutomatableParameters())
+                current.add (param);
+
+    for (auto* param : watched)
+    {
+        if (current.contains (param))
+            continue;
+
+        // Gone with its plugin: keep what was recorded
+        if (auto it = takes.find (param); it != takes.end())
+        {
+            if (! it->second.points.empty())
+                writeTake (*param, it->second);
+
+            takes.erase (it);
+        }
+
+        param->removeListener (this);
+    }
+
+    for (auto* param : current)
+        if (! watched.contains (param))
+            param->addListener (this);
+
+    watched.swapWith (current);
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <tracktion_engine/tracktion_engine.h>
+
+#include <map>
+#include <vector>
+
+namespace te = tracktion::engine;
+namespace t = tracktion;
+
+class TrackManager;
+
+/**
+ * @brief Records knob moves on instrument parameters as thinned automation.
+ *
+ * While the transport records, every change made from a plugin view (MorphSynth,
+ * FourOsc) is captured with the transport position. Such a take can hold a point
+ * per mouse event, which bloats the edit file and the curve the engine reads
+ * every block. So once the knob rests, or recording stops, the take is simplified
+ * with Ramer-Douglas-Peucker and only then written to the parameter's curve,
+ * replacing what was there over the same span.
+ *
+ * The error measured is vertical: how far the linear segment between the kept
+ * points strays from a dropped point's value. That is exactly what playback
+ * would get wrong, since curves interpolate linearly between points.
+ *
+ * Tracktion's own automation writing is turned off for the edit, so changes are
+ * not recorded twice.
+ *
+ * Thread safety: message thread only. Recreated with TrackManager for each edit.
+ */
+class AutomationRecorder : private te::AutomatableParameter::Listener,
+                           private juce::Timer
+{
+public:
+    /** One recorded value. */
+    struct Point
+    {
+        double time = 0.0;          ///< Seconds
+        float value = 0.0f;
+    };
+
+    /** Largest error a thinned take may have, as a fraction of the parameter's range. */
+    static constexpr float toleranceFraction = 0.005f;
+    /** How long a knob must rest before its take is written. */
+    static constexpr int settleMs = 300;
+
+    AutomationRecorder (te::Edit& edit, TrackManager& trackManager);
+    ~AutomationRecorder() override;
+
+    /**
+     * @brief Ramer-Douglas-Peucker: keeps the points needed for no dropped point to be
+     *        more than @p tolerance off the simplified curve.
+     *
+     * The first and last points are always kept. Points must be in time order.
+     */
+    static std::vector<Point> simplify (const std::vector<Point>& points, float tolerance);
+
+    /** Points captured and points written to curves so far (the thinning ratio), for diagnostics. */
+    int getNumPointsRecorded() const noexcept   { return numRecorded; }
+    int getNumPointsWritten() const noexcept    { return numWritten; }
+
+private:
+    struct Take
+    {
+        std::vector<Point> points;
+        juce::uint32 lastChangeMs = 0;
+    };
+
+    // te::AutomatableParameter::Listener
+    void curveHasChanged (te::AutomatableParameter&) override {}
+    void parameterChanged (te::AutomatableParameter&, float newValue) override;
+
+    void timerCallback() override;
+
+    /** Listens to the parameters of every track's instrument. */
+    void updateWatchedParameters();
+
+    /** Thins @p take and writes it to @p param's curve. */
+    void writeTake (te::AutomatableParameter& param, Take& take);
+
+    te::Edit& edit;
+    TrackManager& trackManager;
+
+    juce::ReferenceCountedArray<te::AutomatableParameter> watched;
+    std::map<te::AutomatableParameter*, Take> takes;
+    int ticksUntilRescan = 0;
+    int numRecorded = 0, numWritten = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AutomationRecorder)
+};
@@ -0,0 +1,181 @@
+#include "ClipIndex.h"
+
+#include <algorithm>
+#include <limits>
+
+//==============================================================================
+// Construction
+
+ClipIndex::ClipIndex (te::Edit& edit)
+    : state (edit.state)
+{
+    state.addListener (this);
+}
+
+ClipIndex::~ClipIndex()
+{
+    state.removeListener (this);
+}
+
+//==============================================================================
+// Edit changes
+
+void ClipIndex::valueTreePropertyChanged (juce::ValueTree& tree, const juce::Identifier& property)
+{
+    if ((property == te::IDs::start || property == te::IDs::length) && te::Clip::isClipState (tree))
+        invalidate();
+}
+
+void ClipIndex::valueTreeChildAdded (juce::ValueTree&, juce::ValueTree& child)
+{
+    if (te::Clip::isClipState (child) || te::TrackList::isTrack (child))
+        invalidate();
+}
+
+void ClipIndex::valueTreeChildRemoved (juce::ValueTree&, juce::ValueTree& child, int)
+{
+    if (te::TrackList::isTrack (child))
+    {
+        // Drops the removed track's entries along with everyone else's
+        tracks.clear();
+        invalidate();
+    }
+    else if (te::Clip::isClipState (child))
+    {
+        invalidate();
+    }
+}
+
+//==============================================================================
+// Entries
+
+const ClipIndex::TrackEntries& ClipIndex::getEntries (const te::ClipTrack& track)
+{
+    auto& e = tracks[track.itemID.getRawID()];
+
+    if (e.generation == generation)
+        return e;
+
+    e.generation = generation;
+    e.entries.clear();
+    e.maxEnd.clear();
+
+    for (auto* clip : track.getClips())
+    {
+        if (clip == nullptr)
+            continue;
+
+        const auto range = clip->getPosition().time;
+        e.entries.push_back ({ range.getStart().inSeconds(), range.getEnd().inSeconds(), clip });
+    }
+
+    std::stable_sort (e.entries.begin(), e.entries.end(),
+                      [] (const Entry& a, const Entry& b) { return a.start < b.start; });
+
+    double latest = -std::numeric_limits<double>::infinity();
+    e.maxEnd.reserve (e.entries.size());
+    for (const auto& entry : e.entries)
+        e.maxEnd.push_back (latest = std::max (latest, entry.end));
+
+    return e;
+}
+
+template <typename Visitor>
+void ClipIndex::forEachOverlapping (const TrackEntries& e, double start, double end,
+                                    const te::Clip* ignore, Visitor&& visit)
+{
+    // Clips before the first whose running max end passes start all end too early
+    const auto first = (size_t) std::distance (e.maxEnd.begin(),
+                                               std::upper_bound (e.maxEnd.begin(), e.maxEnd.end(), start));
+
+    for (auto i = first; i < e.entries.size() && e.entries[i].start < end; ++i)
+    {
+        const auto& entry = e.entries[i];
+
+        if (entry.end > start && entry.clip != ignore)
+            if (! visit (entry))
+                return;
+    }
+}
+
+//==============================================================================
+// Queries
+
+bool ClipIndex::overlaps (const te::ClipTrack& track, t::TimeRange range, const te::Clip* ignore)
+{
+    bool found = false;
+
+    forEachOverlapping (getEntries (track), range.getStart().inSeconds(), range.getEnd().inSeconds(), ignore,
+                        [&] (const Entry&) { found = true; return false; });
+
+    return found;
+}
+
+juce::Array<te::Clip*> ClipIndex::getOverlapping (const te::ClipTrack& track, t::TimeRange range,
+                                                  const te::Clip* ignore)
+{
+    juce::Array<te::Clip*> result;
+
+    forEachOverlapping (getEntries (track), range.getStart().inSeconds(), range.getEnd().inSeconds(), ignore,
+                        [&] (const Entry& entry) { result.add (entry.clip); return true; });
+
+    return result;
+}
+
+te::Clip* ClipIndex::getClipAt (const te::ClipTrack& track, t::TimePosition position)
+{
+    const auto& e = getEntries (track);
+    const double pos = position.inSeconds();
+
+    // Walk back from the last clip starting at or before pos while anything can still reach it
+    auto i = (size_t) std::distance (e.entries.begin(),
+                                     std::upper_bound (e.entries.begin(), e.entries.end(), pos,
+                                                       [] (double p, const Entry& entry) { return p < entry.start; }));
+
+    while (i > 0 && e.maxEnd[i - 1] > pos)
+    {
+        --i;
+        if (e.entries[i].end > pos)
+            return e.entries[i].clip;
+    }
+
+    return nullptr;
+}
+
+std::optional<t::TimePosition> ClipIndex::getNextClipStart (const te::ClipTrack& track, t::TimePosition position,
+                                                            const te::Clip* ignore)
+{
+    const auto& e = getEntries (track);
+    const double pos = position.inSeconds();
+
+    auto it = std::upper_bound (e.entries.begin(), e.entries.end(), pos,
+                                [] (double p, const Entry& entry) { return p < entry.start; });
+
+    for (; it != e.entries.end(); ++it)
+        if (it->clip != ignore)
+            return t::TimePosition::fromSeconds (it->start);
+
+    return std::nullopt;
+}
+
+t::TimePosition ClipIndex::findFreeSlot (const te::ClipTrack& track, t::TimePosition from, t::TimeDuration length,
+                                         const te::Clip* ignore)
+{
+    const auto& e = getEntries (track);
+    const double len = length.inSeconds();
+    double start = from.inSeconds();
+
+    // Each pass jumps past everything in the way, so no clip is visited twice
+    for (;;)
+    {
+        double blockedUntil = start;
+
+        forEachOverlapping (e, start, start + len, ignore,
+                            [&] (const Entry& entry) { blockedUntil = std::max (blockedUntil, entry.end); return true; });
+
+        if (blockedUntil <= start)
+            return t::TimePosition::fromSeconds (start);
+
+        start = blockedUntil;
+    }
+}
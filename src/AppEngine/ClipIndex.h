@@ -0,0 +1,96 @@
+#pragma once
+
+#include <tracktion_engine/tracktion_engine.h>
+
+#include <map>
+#include <optional>
+#include <vector>
+
+namespace te = tracktion::engine;
+namespace t = tracktion;
+
+/**
+ * @brief Per-track interval index of clip ranges for overlap and placement queries.
+ *
+ * Drag, resize, paste, duplicate and recording all need to know which clips a
+ * range touches. Scanning every clip (or every clip component) per query made
+ * dragging on busy tracks stutter. Here each track's clips are kept sorted by
+ * start, together with the running maximum of their ends. Every query then
+ * binary-searches to the first clip that can reach the range and visits only the
+ * clips that really overlap it: O(log n) on GrooveKit's non-overlapping tracks.
+ *
+ * The index listens to the edit's state. Adding, removing, moving or resizing a
+ * clip (including undo and tempo edits, which rewrite clip positions) marks it
+ * stale, and a track's entry is rebuilt on the next query against that track.
+ * Nothing changes in the edit while a drag is in progress, so the many queries a
+ * drag makes all hit the same index.
+ *
+ * Ranges are half-open, as in t::TimeRange::overlaps(): clips that only touch
+ * don't overlap.
+ *
+ * Thread safety: message thread only. Recreated with TrackManager for each edit.
+ */
+class ClipIndex : private juce::ValueTree::Listener
+{
+public:
+    explicit ClipIndex (te::Edit& edit);
+    ~ClipIndex() override;
+
+    /** True if @p range overlaps a clip on @p track other than @p ignore. */
+    bool overlaps (const te::ClipTrack& track, t::TimeRange range, const te::Clip* ignore = nullptr);
+
+    /** Clips on @p track overlapping @p range (except @p ignore), in start order. */
+    juce::Array<te::Clip*> getOverlapping (const te::ClipTrack& track, t::TimeRange range,
+                                           const te::Clip* ignore = nullptr);
+
+    /** The clip covering @p position (the latest-starting one if clips overlap), or nullptr. */
+    te::Clip* getClipAt (const te::ClipTrack& track, t::TimePosition position);
+
+    /** Start of the first clip starting after @p position (except @p ignore): how far a clip there can grow. */
+    std::optional<t::TimePosition> getNextClipStart (const te::ClipTrack& track, t::TimePosition position,
+                                                     const te::Clip* ignore = nullptr);
+
+    /** The earliest start at or after @p from where a clip of @p length fits without overlapping. */
+    t::TimePosition findFreeSlot (const te::ClipTrack& track, t::TimePosition from, t::TimeDuration length,
+                                  const te::Clip* ignore = nullptr);
+
+private:
+    struct Entry
+    {
+        double start = 0.0, end = 0.0;
+        te::Clip* clip = nullptr;
+    };
+
+    struct TrackEntries
+    {
+        juce::uint32 generation = 0;
+        std::vector<Entry> entries;             ///< Sorted by start
+        std::vector<double> maxEnd;             ///< maxEnd[i]: latest end among entries[0..i]
+    };
+
+    /** The up-to-date entries for @p track. */
+    const TrackEntries& getEntries (const te::ClipTrack& track);
+
+    /**
+     * Calls @p visit for each entry overlapping [start, end), in start order, until it
+     * returns false.
+     */
+    template <typename Visitor>
+    void forEachOverlapping (const TrackEntries& e, double start, double end, const te::Clip* ignore, Visitor&& visit);
+
+    void invalidate() noexcept                  { ++generation; }
+
+    void valueTreePropertyChanged (juce::ValueTree&, const juce::Identifier&) override;
+    void valueTreeChildAdded (juce::ValueTree&, juce::ValueTree&) override;
+    void valueTreeChildRemoved (juce::ValueTree&, juce::ValueTree&, int) override;
+    void valueTreeChildOrderChanged (juce::ValueTree&, int, int) override {}
+    void valueTreeParentChanged (juce::ValueTree&) override {}
+    void valueTreeRedirected (juce::ValueTree&) override { invalidate(); }
+
+    juce::ValueTree state;                      ///< The edit's; listened to for clip changes
+
+    juce::uint32 generation = 1;
+    std::map<juce::uint64, TrackEntries> tracks;   ///< By track EditItemID
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ClipIndex)
+};
@@ -0,0 +1,327 @@
+#include "MacroControls.h"
+#include "TrackManager.h"
+#include "../UI/Plugins/Synthesizer/MorphSynthPlugin.h"
+
+#include <algorithm>
+
+namespace
+{
+    const juce::Identifier macrosId ("GK_MACROS");
+    const juce::Identifier targetId ("TARGET");
+    const juce::Identifier macroId ("macro");
+    const juce::Identifier pluginId ("plugin");
+    const juce::Identifier paramId ("param");
+    const juce::Identifier startId ("start");
+    const juce::Identifier endId ("end");
+    const juce::Identifier curveId ("curve");
+
+    juce::Identifier valueId (int macro)    { return "value" + juce::String (macro); }
+
+    constexpr int tickHz = 30;
+}
+
+//==============================================================================
+// Construction
+
+MacroControls::MacroControls (te::Edit& e, TrackManager& tm)
+    : edit (e), trackManager (tm)
+{
+    // Saved macros drive their targets from the start
+    for (int i = 0; i < trackManager.getNumTracks(); ++i)
+        getTrackMacros (i);
+
+    startTimerHz (tickHz);
+}
+
+MacroControls::~MacroControls()
+{
+    stopTimer();
+}
+
+//==============================================================================
+// Macros
+
+void MacroControls::setMacroValue (int trackIndex, int macro, float value)
+{
+    auto* tm = getTrackMacros (trackIndex);
+    if (tm == nullptr || macro < 0 || macro >= numMacros)
+        return;
+
+    value = juce::jlimit (0.0f, 1.0f, value);
+    tm->values[(size_t) macro] = value;
+    tm->fallback.setMacroValue (macro, value);
+
+    if (auto* synth = dynamic_cast<MorphSynthPlugin*> (tm->synth.get()))
+        synth->getMacroBank().setMacroValue (macro, value);
+
+    tm->moved = true;
+    tm->valuesUnsaved = true;
+}
+
+float MacroControls::getMacroValue (int trackIndex, int macro)
+{
+    auto* tm = getTrackMacros (trackIndex);
+    return tm != nullptr && macro >= 0 && macro < numMacros ? tm->values[(size_t) macro] : 0.0f;
+}
+
+void MacroControls::saveValues()
+{
+    for (auto& tm : tracks)
+    {
+        if (! tm->valuesUnsaved)
+            continue;
+
+        tm->valuesUnsaved = false;
+
+        auto state = tm->track->state.getOrCreateChildWithName (macrosId, nullptr);
+        for (int m = 0; m < numMacros; ++m)
+            state.setProperty (valueId (m), tm->values[(size_t) m], nullptr);
+    }
+}
+
+//==============================================================================
+// Assignments
+
+bool MacroControls::assign (int trackIndex, int macro, te::AutomatableParameter& param,
+                            float start, float end, Curve curve)
+{
+    auto* tm = getTrackMacros (trackIndex);
+    if (tm == nullptr || macro < 0 || macro >= numMacros)
+        return false;
+
+    auto* plugin = param.getPlugin();
+    if (plugin == nullptr || plugin->getOwnerTrack() != tm->track.get())
+        return false;
+
+    auto& list = tm->assignments;
+    list.erase (std::remove_if (list.begin(), list.end(),
+                                [&] (const Assignment& a) { return a.macro == macro && a.param.get() == &param; }),
+                list.end());
+
+    if ((int) list.size() >= MacroBank::maxTargets)
+        return false;
+
+    list.push_back ({ macro, &param, juce::jlimit (0.0f, 1.0f, start), juce::jlimit (0.0f, 1.0f, end), curve });
+    compile (*tm);
+    save (*tm);
+    return true;
+}
+
+bool MacroControls::assign (int trackIndex, int macro, te::AutomatableParameter& param)
+{
+    const float from = param.getCurrentNormalisedValue();
+    return assign (trackIndex, macro, param, from, from < 0.5f ? 1.0f : 0.0f);
+}
+
+void MacroControls::unassign (int trackIndex, int macro, te::AutomatableParameter& param)
+{
+    auto* tm = getTrackMacros (trackIndex);
+    if (tm == nullptr)
+        return;
+
+    auto& list = tm->assignments;
+    list.erase (std::remove_if (list.begin(), list.end(),
+                                [&] (const Assignment& a) { return a.macro == macro && a.param.get() == &param; }),
+                list.end());
+
+    compile (*tm);
+    save (*tm);
+}
+
+bool MacroControls::isAssigned (int trackIndex, int macro, const te::AutomatableParameter& param)
+{
+    auto* tm = getTrackMacros (trackIndex);
+    if (tm == nullptr)
+        return false;
+
+    return std::any_of (tm->assignments.begin(), tm->assignments.end(),
+                        [&] (const Assignment& a) { return a.macro == macro && a.param.get() == &param; });
+}
+
+std::vector<MacroControls::Assignment> MacroControls::getAssignments (int trackIndex)
+{
+    auto* tm = getTrackMacros (trackIndex);
+    return tm != nullptr ? tm->assignments : std::vector<Assignment> {};
+}
+
+//==============================================================================
+// Compiling
+
+MacroControls::TrackMacros* MacroControls::getTrackMacros (int trackIndex)
+{
+    auto* track = trackManager.getTrack (trackIndex);
+    if (track == nullptr)
+        return nullptr;
+
+    for (auto& tm : tracks)
+        if (tm->track.get() == track)
+            return tm.get();
+
+    auto tm = std::make_unique<TrackMacros>();
+    tm->track = track;
+    load (*tm);
+    compile (*tm);
+
+    tracks.push_back (std::move (tm));
+    return tracks.back().get();
+}
+
+void MacroControls::compile (TrackMacros& tm)
+{
+    te::Plugin::Ptr synthPlugin = tm.track->pluginList.findFirstPluginOfType<MorphSynthPlugin>();
+
+    // The instrument was swapped: the old synth stops following the macros
+    if (tm.synth != nullptr && tm.synth != synthPlugin)
+        if (auto* old = dynamic_cast<MorphSynthPlugin*> (tm.synth.get()))
+            old->getMacroBank().setTargets ({});
+
+    tm.synth = synthPlugin;
+    auto* synth = dynamic_cast<MorphSynthPlugin*> (synthPlugin.get());
+
+    std::vector<MacroBank::Target> synthTargets, fallbackTargets;
+    tm.fallbackParams.clear();
+
+    for (const auto& a : tm.assignments)
+    {
+        const int slot = synth != nullptr && a.param->getPlugin() == synth ? synth->getParamIndex (*a.param) : -1;
+
+        if (slot >= 0)
+        {
+            // The voices read plain values: fold the parameter's range into the table
+            synthTargets.push_back ({ a.macro, slot, a.start, a.end, a.curve,
+                                      [range = a.param->valueRange] (float v) { return range.convertFrom0to1 (v); } });
+        }
+        else
+        {
+            fallbackTargets.push_back ({ a.macro, tm.fallbackParams.size(), a.start, a.end, a.curve, {} });
+            tm.fallbackParams.add (a.param);
+        }
+    }
+
+    for (int m = 0; m < numMacros; ++m)
+    {
+        tm.fallback.setMacroValue (m, tm.values[(size_t) m]);
+        if (synth != nullptr)
+            synth->getMacroBank().setMacroValue (m, tm.values[(size_t) m]);
+    }
+
+    if (synth != nullptr)
+        synth->getMacroBank().setTargets (synthTargets);
+
+    tm.fallback.setTargets (fallbackTargets);
+    tm.moved = true;
+}
+
+//==============================================================================
+// Tick
+
+void MacroControls::timerCallback()
+{
+    // Tracks and instruments come and go; a second's delay is fine for that
+    if (--ticksUntilRescan <= 0)
+        rescan();
+
+    for (auto& tm : tracks)
+    {
+        // Compiled sets replaced while the synth was evaluating one
+        if (auto* synth = dynamic_cast<MorphSynthPlugin*> (tm->synth.get()))
+            synth->getMacroBank().collect();
+
+        tm->fallback.collect();
+
+        if (! tm->moved)
+            continue;
+
+        tm->moved = false;
+
+        tm->fallback.evaluate ([&tm] (int slot, float value)
+        {
+            auto* param = tm->fallbackParams.getObjectPointer (slot);
+            if (param != nullptr && param->getCurrentNormalisedValue() != value)
+                param->setNormalisedParameter (value, juce::sendNotificationSync);
+        });
+    }
+}
+
+void MacroControls::rescan()
+{
+    ticksUntilRescan = tickHz;
+
+    juce::Array<te::AudioTrack*> current;
+    for (int i = 0; i < trackManager.getNumTracks(); ++i)
+        current.add (trackManager.getTrack (i));
+
+    tracks.erase (std::remove_if (tracks.begin(), tracks.end(),
+                                  [&] (const auto& tm) { return ! current.contains (tm->track.get()); }),
+                  tracks.end());
+
+    for (auto& tm : tracks)
+    {
+        // Assignments go with their plugin
+        auto& list = tm->assignments;
+        const auto numBefore = list.size();
+        list.erase (std::remove_if (list.begin(), list.end(),
+                                    [&tm] (const Assignment& a)
+                                    {
+                                        auto* plugin = a.param->getPlugin();
+                                        return plugin == nullptr || plugin->getOwnerTrack() != tm->track.get();
+                                    }),
+                    list.end());
+
+        const bool synthChanged = tm->synth.get() != tm->track->pluginList.findFirstPluginOfType<MorphSynthPlugin>().get();
+
+        if (list.size() != numBefore || synthChanged)
+        {
+            compile (*tm);
+            save (*tm);
+        }
+    }
+}
+
+//==============================================================================
+// Persistence
+
+void MacroControls::save (TrackMacros& tm)
+{
+    auto state = tm.track->state.getOrCreateChildWithName (macrosId, nullptr);
+    state.removeAllChildren (nullptr);
+    tm.valuesUnsaved = false;
+
+    for (int m = 0; m < numMacros; ++m)
+        state.setProperty (valueId (m), tm.values[(size_t) m], nullptr);
+
+    for (const auto& a : tm.assignments)
+    {
+        juce::ValueTree v (targetId);
+        v.setProperty (macroId, a.macro, nullptr);
+        v.setProperty (pluginId, a.param->getPlugin()->itemID.toVar(), nullptr);
+        v.setProperty (paramId, a.param->paramID, nullptr);
+        v.setProperty (startId, a.start, nullptr);
+        v.setProperty (endId, a.end, nullptr);
+        v.setProperty (curveId, (int) a.curve, nullptr);
+        state.appendChild (v, nullptr);
+    }
+}
+
+void MacroControls::load (TrackMacros& tm)
+{
+    const auto state = tm.track->state.getChildWithName (macrosId);
+    if (! state.isValid())
+        return;
+
+    for (int m = 0; m < numMacros; ++m)
+        tm.values[(size_t) m] = juce::jlimit (0.0f, 1.0f, (float) state.getProperty (valueId (m), 0.0f));
+
+    for (const auto& v : state)
+    {
+        auto* plugin = edit.getPluginCache().getPluginFor (te::EditItemID::fromVar (v[pluginId])).get();
+        auto* param = plugin != nullptr ? plugin->getAutomatableParameterByID (v[paramId].toString()).get() : nullptr;
+
+        if (param == nullptr || plugin->getOwnerTrack() != tm.track.get() || (int) tm.assignments.size() == MacroBank::maxTargets)
+            continue;
+
+        tm.assignments.push_back ({ juce::jlimit (0, numMacros - 1, (int) v[macroId]), param,
+                                    (float) v[startId], (float) v[endId],
+                                    (Curve) juce::jlimit (0, (int) Curve::sCurve, (int) v[curveId]) });
+    }
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <tracktion_engine/tracktion_engine.h>
+#include "../MIDIEngine/MacroBank.h"
+
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace te = tracktion::engine;
+
+class TrackManager;
+
+/**
+ * @brief Per-track macro knobs, each driving any number of the track's parameters.
+ *
+ * Assignments on the track's MorphSynth are compiled into the synth's MacroBank
+ * and evaluated by the synth on the audio thread, once per control slice: moving
+ * a macro stores one atomic value, and no parameter listener or notification is
+ * involved. The synth's knobs keep showing their own values while a macro drives
+ * them, and take over again when the assignment is removed.
+ *
+ * Other plugins' parameters (FourOsc, external instruments) can't be written
+ * from the audio thread, so their targets go through a second bank that the
+ * message-thread tick applies after a macro moved.
+ *
+ * Assignments are stored in the track's state as they change. Macro values are
+ * written there by saveValues(), at the end of a gesture and before a save, so a
+ * sweep doesn't notify state listeners or dirty the edit on every move.
+ *
+ * Thread safety: message thread only. Recreated with TrackManager for each edit.
+ */
+class MacroControls : private juce::Timer
+{
+public:
+    using Curve = MacroBank::Curve;
+    static constexpr int numMacros = MacroBank::numMacros;
+
+    struct Assignment
+    {
+        int macro = 0;
+        te::AutomatableParameter::Ptr param;
+        float start = 0.0f, end = 1.0f;             ///< Normalised values at macro 0 and 1
+        Curve curve = Curve::linear;
+    };
+
+    MacroControls (te::Edit& edit, TrackManager& trackManager);
+    ~MacroControls() override;
+
+    /** Sets a macro (0..1). The synth follows at its next control slice. */
+    void setMacroValue (int trackIndex, int macro, float value);
+    float getMacroValue (int trackIndex, int macro);
+
+    /** Writes the macro values moved since the last call into their tracks' state. */
+    void saveValues();
+
+    /**
+     * @brief Makes @p macro sweep @p param from @p start to @p end (normalised),
+     *        replacing any assignment of that macro to that parameter.
+     *
+     * @return false for an invalid track or macro, a parameter not on the track,
+     *         or a track that already has MacroBank::maxTargets assignments
+     */
+    bool assign (int trackIndex, int macro, te::AutomatableParameter& param,
+                 float start, float end, Curve curve = Curve::linear);
+
+    /** As above, from the parameter's current value to the far end of its range. */
+    bool assign (int trackIndex, int macro, te::AutomatableParameter& param);
+
+    void unassign (int trackIndex, int macro, te::AutomatableParameter& param);
+    bool isAssigned (int trackIndex, int macro, const te::AutomatableParameter& param);
+    std::vector<Assignment> getAssignments (int trackIndex);
+
+private:
+    struct TrackMacros
+    {
+        te::AudioTrack::Ptr track;
+        std::array<float, numMacros> values {};
+        std::vector<Assignment> assignments;
+
+        te::Plugin::Ptr synth;                      ///< MorphSynth the targets were compiled into
+        MacroBank fallback;                         ///< Targets on other plugins, applied by the tick
+        juce::ReferenceCountedArray<te::AutomatableParameter> fallbackParams;  ///< By slot
+        bool moved = false;                         ///< Since the last tick
+        bool valuesUnsaved = false;                 ///< Moved since written to the track's state
+    };
+
+    /** The track's macros, read from its state the first time. */
+    TrackMacros* getTrackMacros (int trackIndex);
+
+    /** Splits the assignments between the synth's bank and the fallback, and rebuilds both. */
+    void compile (TrackMacros& tm);
+
+    void save (TrackMacros& tm);
+    void load (TrackMacros& tm);
+
+    void timerCallback() override;
+
+    /** Drops deleted tracks, and assignments whose plugin was removed; recompiles if the synth changed. */
+    void rescan();
+
+    te::Edit& edit;
+    TrackManager& trackManager;
+
+    std::vector<std::unique_ptr<TrackMacros>> tracks;
+    int ticksUntilRescan = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MacroControls)
+};
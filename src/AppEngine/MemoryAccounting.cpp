@@ -0,0 +1,171 @@
+#include "MemoryAccounting.h"
+
+#include <algorithm>
+
+namespace
+{
+    // Approximate per-object costs for ValueTree internals (SharedObject, NamedValue, var).
+    constexpr juce::int64 valueTreeNodeBytes  = 96;
+    constexpr juce::int64 namedValueBytes     = 32;
+
+    juce::int64 varPayloadBytes (const juce::var& v)
+    {
+        if (v.isString())
+            return (juce::int64) v.toString().getNumBytesAsUTF8() + 16;
+
+        if (auto* block = v.getBinaryData())
+            return (juce::int64) block->getSize() + 16;
+
+        if (auto* array = v.getArray())
+        {
+            juce::int64 sum = 16;
+            for (const auto& element : *array)
+                sum += (juce::int64) sizeof (juce::var) + varPayloadBytes (element);
+            return sum;
+        }
+
+        return 0;
+    }
+
+    void sortBySize (std::vector<MemoryReport::Entry>& list)
+    {
+        std::stable_sort (list.begin(), list.end(),
+                          [] (const auto& a, const auto& b) { return a.bytes > b.bytes; });
+    }
+}
+
+//==============================================================================
+void MemoryReport::add (const juce::String& subsystem, const juce::String& item, juce::int64 bytes, int count)
+{
+    for (auto& e : entries)
+    {
+        if (e.subsystem == subsystem && e.item == item)
+        {
+            e.bytes += bytes;
+            e.count += count;
+            return;
+        }
+    }
+
+    entries.push_back ({ subsystem, item, bytes, count });
+}
+
+juce::int64 MemoryReport::getTotalBytes() const
+{
+    juce::int64 total = 0;
+    for (const auto& e : entries)
+        total += e.bytes;
+    return total;
+}
+
+std::vector<MemoryReport::Entry> MemoryReport::getSubsystemTotals() const
+{
+    std::vector<Entry> totals;
+
+    for (const auto& e : entries)
+    {
+        auto it = std::find_if (totals.begin(), totals.end(),
+                                [&e] (const Entry& t) { return t.subsystem == e.subsystem; });
+
+        if (it == totals.end())
+            totals.push_back ({ e.subsystem, {}, e.bytes, e.count });
+        else
+        {
+            it->bytes += e.bytes;
+            it->count += e.count;
+        }
+    }
+
+    sortBySize (totals);
+    return totals;
+}
+
+std::vector<MemoryReport::Entry> MemoryReport::getEntriesBySize() const
+{
+    auto sorted = entries;
+    sortBySize (sorted);
+    return sorted;
+}
+
+juce::var MemoryReport::toJSON() const
+{
+    auto* root = new juce::DynamicObject();
+    root->setProperty ("totalBytes", getTotalBytes());
+    root->setProperty ("timestamp", juce::Time::getCurrentTime().toISO8601 (true));
+
+    juce::Array<juce::var> subsystems;
+    const auto sorted = getEntriesBySize();
+
+    for (const auto& total : getSubsystemTotals())
+    {
+        auto* sub = new juce::DynamicObject();
+        sub->setProperty ("name",  total.subsystem);
+        sub->setProperty ("bytes", total.bytes);
+        sub->setProperty ("count", total.count);
+
+        juce::Array<juce::var> items;
+        for (const auto& e : sorted)
+        {
+            if (e.subsystem != total.subsystem)
+                continue;
+
+            auto* item = new juce::DynamicObject();
+            item->setProperty ("name",  e.item);
+            item->setProperty ("bytes", e.bytes);
+            item->setProperty ("count", e.count);
+            items.add (juce::var (item));
+        }
+
+        sub->setProperty ("items", items);
+        subsystems.add (juce::var (sub));
+    }
+
+    root->setProperty ("subsystems", subsystems);
+    return juce::var (root);
+}
+
+juce::String MemoryReport::toJSONString() const
+{
+    return juce::JSON::toString (toJSON());
+}
+
+//==============================================================================
+int MemoryAccounting::addProvider (Provider provider)
+{
+    const int id = nextProviderId++;
+    providers[id] = std::move (provider);
+    return id;
+}
+
+void MemoryAccounting::removeProvider (int providerId)
+{
+    providers.erase (providerId);
+}
+
+void MemoryAccounting::collect (MemoryReport& report) const
+{
+    for (const auto& [id, provider] : providers)
+        if (provider)
+            provider (report);
+}
+
+juce::int64 MemoryAccounting::estimateValueTreeBytes (const juce::ValueTree& tree)
+{
+    if (! tree.isValid())
+        return 0;
+
+    juce::int64 bytes = valueTreeNodeBytes;
+
+    for (int i = 0; i < tree.getNumProperties(); ++i)
+        bytes += namedValueBytes + varPayloadBytes (tree.getProperty (tree.getPropertyName (i)));
+
+    for (const auto& child : tree)
+        bytes += (juce::int64) sizeof (void*) + estimateValueTreeBytes (child);
+
+    return bytes;
+}
+
+juce::String MemoryAccounting::formatBytes (juce::int64 bytes)
+{
+    return juce::File::descriptionOfSizeInBytes (bytes);
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <juce_data_structures/juce_data_structures.h>
+
+#include <functional>
+#include <map>
+#include <vector>
+
+/**
+ * @brief A snapshot of estimated memory use, broken down by subsystem and item.
+ *
+ * Values are estimates from the owning subsystem (decoded sample sizes, ValueTree
+ * footprints, reserved buffers, ...), not allocator-exact figures. They are meant
+ * for finding the biggest consumers, not for leak hunting.
+ */
+struct MemoryReport
+{
+    struct Entry
+    {
+        juce::String subsystem;  ///< e.g. "Drum samplers", "Undo", "UI"
+        juce::String item;       ///< e.g. a track name or cache name
+        juce::int64 bytes = 0;   ///< Estimated bytes held.
+        int count = 0;           ///< Number of objects accounted (notes, voices, sounds...).
+    };
+
+    /** Records @p bytes / @p count for an item. Entries with the same subsystem+item accumulate. */
+    void add (const juce::String& subsystem, const juce::String& item, juce::int64 bytes, int count = 1);
+
+    juce::int64 getTotalBytes() const;
+
+    /** One entry per subsystem (item empty), largest first. */
+    std::vector<Entry> getSubsystemTotals() const;
+
+    /** All entries, largest first. */
+    std::vector<Entry> getEntriesBySize() const;
+
+    /** { "totalBytes", "subsystems": [ { "name", "bytes", "count", "items": [...] } ] } */
+    juce::var toJSON() const;
+    juce::String toJSONString() const;
+
+    std::vector<Entry> entries;
+};
+
+/**
+ * @brief Registry of memory-accounting hooks.
+ *
+ * Subsystems that are not owned by AppEngine (UI editors, windows, caches created
+ * on demand) register a provider for their lifetime; AppEngine::collectMemoryReport()
+ * runs its own built-in accounting and then every registered provider.
+ *
+ * Message thread only.
+ */
+class MemoryAccounting
+{
+public:
+    using Provider = std::function<void (MemoryReport&)>;
+
+    /** Registers a provider; returns an id for removeProvider(). */
+    int addProvider (Provider provider);
+    void removeProvider (int providerId);
+
+    /** Runs every registered provider into @p report. */
+    void collect (MemoryReport& report) const;
+
+    /**
+     * @brief Rough in-memory footprint of a ValueTree, including all descendants.
+     *
+     * Counts node/property overhead plus string payloads; used for edit state
+     * such as MIDI note lists.
+     */
+    static juce::int64 estimateValueTreeBytes (const juce::ValueTree& tree);
+
+    /** Human readable size, e.g. "12.4 MB". */
+    static juce::String formatBytes (juce::int64 bytes);
+
+private:
+    std::map<int, Provider> providers;
+    int nextProviderId = 1;
+};
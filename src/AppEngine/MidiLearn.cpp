@@ -0,0 +1,371 @@
+#include "MidiLearn.h"
+#include "TrackManager.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    const juce::Identifier mappingsId ("GK_MIDI_MAPPINGS");
+    const juce::Identifier mappingId ("MAPPING");
+    const juce::Identifier channelId ("channel");
+    const juce::Identifier controllerId ("controller");
+    const juce::Identifier pluginId ("plugin");
+    const juce::Identifier paramId ("param");
+
+    constexpr int tickHz = 60;
+}
+
+//==============================================================================
+// Construction
+
+MidiLearn::MidiLearn (te::Edit& e, TrackManager& tm)
+    : edit (e), trackManager (tm)
+{
+    updateWatched();
+    loadMappings();
+    startTimerHz (tickHz);
+}
+
+MidiLearn::~MidiLearn()
+{
+    stopTimer();
+
+    for (auto* in : edit.getAllInputDevices())
+        if (inputs.contains (in))
+            in->removeConsumer (this);
+
+    for (auto* param : watched)
+        param->removeListener (this);
+}
+
+//==============================================================================
+// Learn / feedback
+
+void MidiLearn::setLearning (bool shouldLearn)
+{
+    touched = nullptr;
+    lastLearnSlot.store (-1);
+    learning.store (shouldLearn);
+}
+
+void MidiLearn::setFeedbackEnabled (bool shouldSend)
+{
+    if (shouldSend == isFeedbackEnabled())
+        return;
+
+    if (! shouldSend)
+    {
+        feedbackOutput.reset();
+        return;
+    }
+
+    feedbackOutput = juce::MidiOutput::openDevice (juce::MidiOutput::getDefaultDevice().identifier);
+
+    if (feedbackOutput == nullptr)
+        DBG ("[MidiLearn] No MIDI output for controller feedback");
+
+    // Bring the hardware in line with the current values
+    for (auto& t : targets)
+        t.lastSent = -1;
+}
+
+//==============================================================================
+// Mappings
+
+bool MidiLearn::addMapping (int channel, int controller, te::AutomatableParameter& param)
+{
+    if (channel < 1 || channel > numChannels || controller < 0 || controller >= numControllers)
+        return false;
+
+    // One CC drives one parameter, and a parameter follows one CC
+    mappings.erase (std::remove_if (mappings.begin(), mappings.end(),
+                                    [&] (const Mapping& m)
+                                    {
+                                        return m.param.get() == &param
+                                            || (m.channel == channel && m.controller == controller);
+                                    }),
+                    mappings.end());
+
+    if ((int) mappings.size() >= maxMappings)
+        return false;
+
+    mappings.push_back ({ channel, controller, &param });
+    publish();
+    saveMappings();
+    return true;
+}
+
+void MidiLearn::removeMapping (te::AutomatableParameter& param)
+{
+    mappings.erase (std::remove_if (mappings.begin(), mappings.end(),
+                                    [&] (const Mapping& m) { return m.param.get() == &param; }),
+                    mappings.end());
+    publish();
+    saveMappings();
+}
+
+void MidiLearn::clearMappings()
+{
+    mappings.clear();
+    publish();
+    saveMappings();
+}
+
+void MidiLearn::publish()
+{
+    auto next = std::make_unique<Table>();
+    next->slots.fill (-1);
+
+    for (auto& r : next->received)
+        r.store (-1.0f);
+
+    for (size_t i = 0; i < mappings.size(); ++i)
+    {
+        next->slots[(size_t) slotIndex (mappings[i].channel, mappings[i].controller)] = (juce::int16) i;
+
+        // Indices may have moved: start each target from where its parameter is
+        targets[i] = { mappings[i].param->getCurrentNormalisedValue(), false, -1, 0 };
+    }
+
+    table.publish (std::move (next));
+}
+
+//==============================================================================
+// Controller input
+
+void MidiLearn::handleIncomingMidiMessage (const juce::MidiMessage& message, te::MPESourceID)
+{
+    if (message.isController())
+        handleController (message.getChannel(), message.getControllerNumber(), message.getControllerValue());
+}
+
+void MidiLearn::handleController (int channel, int controller, int value) noexcept
+{
+    if (channel < 1 || channel > numChannels || controller < 0 || controller >= numControllers)
+        return;
+
+    const int slot = slotIndex (channel, controller);
+
+    if (learning.load (std::memory_order_relaxed))
+        lastLearnSlot.store (slot, std::memory_order_relaxed);
+
+    const auto t = table.read();
+
+    if (t)
+        if (const int target = t->slots[(size_t) slot]; target >= 0)
+            t->received[(size_t) target].store (juce::jlimit (0, 127, value) / 127.0f, std::memory_order_relaxed);
+}
+
+//==============================================================================
+// Tick
+
+void MidiLearn::timerCallback()
+{
+    // Tracks and plugins come and go; a second's delay is fine for that
+    if (--ticksUntilRescan <= 0)
+        updateWatched();
+
+    if (learning.load())
+    {
+        const int slot = lastLearnSlot.exchange (-1);
+
+        if (slot >= 0 && touched != nullptr)
+        {
+            auto param = touched;
+            touched = nullptr;
+
+            if (addMapping (slot / numControllers + 1, slot % numControllers, *param) && onMappingLearned)
+                onMappingLearned (mappings.back());
+        }
+    }
+
+    applyControllerValues();
+
+    if (feedbackOutput != nullptr)
+        sendFeedback();
+
+    // Tables replaced while a controller message was being handled
+    table.collect();
+}
+
+void MidiLearn::applyControllerValues()
+{
+    const auto now = juce::Time::getMillisecondCounter();
+    const auto coefficient = (float) (1.0 - std::exp (-1000.0 / (smoothingMs * tickHz)));
+
+    const juce::ScopedValueSetter<bool> svs (applying, true);
+    const auto* t = table.getCurrent();
+
+    for (size_t i = 0; i < mappings.size(); ++i)
+    {
+        auto& param = *mappings[i].param;
+        auto& target = targets[i];
+
+        if (const float value = t != nullptr ? t->received[i].exchange (-1.0f, std::memory_order_relaxed) : -1.0f;
+            value >= 0.0f)
+        {
+            target.goal = value;
+            target.moving = true;
+            target.lastReceivedMs = now;
+        }
+
+        if (! target.moving)
+            continue;
+
+        const float currentValue = param.getCurrentNormalisedValue();
+        float next = target.goal;
+
+        if (! param.isDiscrete())
+        {
+            next = currentValue + (target.goal - currentValue) * coefficient;
+
+            // Close enough to land on the value the controller sent
+            if (std::abs (target.goal - next) < 1.0e-4f)
+                next = target.goal;
+        }
+
+        if (next == target.goal)
+            target.moving = false;
+
+        if (next != currentValue)
+            param.setNormalisedParameter (next, juce::sendNotificationSync);
+    }
+}
+
+void MidiLearn::sendFeedback()
+{
+    const auto now = juce::Time::getMillisecondCounter();
+
+    for (size_t i = 0; i < mappings.size(); ++i)
+    {
+        auto& target = targets[i];
+
+        // The controller is being moved: it already shows this value
+        if (target.moving || now - target.lastReceivedMs < (juce::uint32) feedbackHoldMs)
+            continue;
+
+        const int value = juce::roundToInt (mappings[i].param->getCurrentNormalisedValue() * 127.0f);
+
+        if (value == target.lastSent)
+            continue;
+
+        feedbackOutput->sendMessageNow (juce::MidiMessage::controllerEvent (mappings[i].channel,
+                                                                           mappings[i].controller, value));
+        target.lastSent = value;
+    }
+}
+
+void MidiLearn::parameterChanged (te::AutomatableParameter& param, float)
+{
+    // The tick's own writes are not touches
+    if (applying || ! learning.load())
+        return;
+
+    touched = &param;
+}
+
+//==============================================================================
+// Watching
+
+void MidiLearn::updateWatched()
+{
+    ticksUntilRescan = tickHz;
+
+    // Every parameter a controller may drive
+    juce::ReferenceCountedArray<te::AutomatableParameter> all;
+
+    const auto addPlugin = [&all] (te::Plugin* plugin)
+    {
+        if (plugin != nullptr)
+            for (auto* param : plugin->getAutomatableParameters())
+                all.add (param);
+    };
+
+    for (int i = 0; i < trackManager.getNumTracks(); ++i)
+        if (auto* track = trackManager.getTrack (i))
+            for (auto* plugin : track->pluginList)
+                addPlugin (plugin);
+
+    addPlugin (edit.getMasterVolumePlugin().get());
+
+    for (auto* param : watched)
+        if (! all.contains (param))
+            param->removeListener (this);
+
+    for (auto* param : all)
+        if (! watched.contains (param))
+            param->addListener (this);
+
+    watched.swapWith (all);
+
+    // Mappings whose plugin was removed go with it
+    const auto numBefore = mappings.size();
+    mappings.erase (std::remove_if (mappings.begin(), mappings.end(),
+                                    [this] (const Mapping& m) { return ! watched.contains (m.param.get()); }),
+                    mappings.end());
+
+    if (mappings.size() != numBefore)
+    {
+        publish();
+        saveMappings();
+    }
+
+    // Hardware inputs only. Instances are recreated with the playback context; those that went are dropped
+    juce::Array<te::InputDeviceInstance*> current;
+
+    for (auto* in : edit.getAllInputDevices())
+    {
+        if (in == nullptr || in->getInputDevice().getDeviceType() != te::InputDevice::physicalMidiDevice)
+            continue;
+
+        if (! inputs.contains (in))
+            in->addConsumer (this);
+
+        current.add (in);
+    }
+
+    inputs.swapWith (current);
+}
+
+//==============================================================================
+// Persistence
+
+void MidiLearn::saveMappings()
+{
+    auto state = edit.state.getOrCreateChildWithName (mappingsId, nullptr);
+    state.removeAllChildren (nullptr);
+
+    for (const auto& m : mappings)
+    {
+        juce::ValueTree v (mappingId);
+        v.setProperty (channelId, m.channel, nullptr);
+        v.setProperty (controllerId, m.controller, nullptr);
+        if (auto* plugin = m.param->getPlugin())
+            v.setProperty (pluginId, plugin->itemID.toVar(), nullptr);
+
+        v.setProperty (paramId, m.param->paramID, nullptr);
+        state.appendChild (v, nullptr);
+    }
+}
+
+void MidiLearn::loadMappings()
+{
+    const auto state = edit.state.getChildWithName (mappingsId);
+
+    for (const auto& v : state)
+    {
+        auto* plugin = edit.getPluginCache().getPluginFor (te::EditItemID::fromVar (v[pluginId])).get();
+        auto* param = plugin != nullptr ? plugin->getAutomatableParameterByID (v[paramId].toString()).get() : nullptr;
+
+        if (param == nullptr)
+            continue;
+
+        mappings.push_back ({ (int) v[channelId], (int) v[controllerId], param });
+
+        if ((int) mappings.size() == maxMappings)
+            break;
+    }
+
+    publish();
+}
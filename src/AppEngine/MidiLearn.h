@@ -0,0 +1,177 @@
+#pragma once
+
+#include <tracktion_engine/tracktion_engine.h>
+#include "../MIDIEngine/SharedSnapshot.h"
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace te = tracktion::engine;
+
+class TrackManager;
+
+/**
+ * @brief Maps hardware controllers (MIDI CCs) to GrooveKit parameters.
+ *
+ * Covers every parameter on every track's plugins (MorphSynth, FourOsc, inserts)
+ * plus the track and master volume/pan, so mixer faders and instrument knobs are
+ * learned the same way: arm learn, touch a parameter on screen, move a knob.
+ *
+ * The mappings are compiled into a flat 16 x 128 table (one slot per channel and
+ * controller, holding a target index or -1) and published as a SharedSnapshot.
+ * Controller messages arrive on MIDI input threads, where handling one is a table
+ * lookup and an atomic store into that table's slot for the target: a sweep never
+ * allocates, locks or walks the mapping list. Because the received values live in
+ * the table, a message that raced a remap lands on the old table's targets, never
+ * on whichever mapping took its index.
+ *
+ * Tracktion parameters are not safe to write from that thread, so values are
+ * applied from a 60 Hz message-thread tick. Each target moves toward its
+ * controller's value with one-pole smoothing, which hides the 7-bit stepping of
+ * CCs; discrete parameters (switches, choices) jump instead.
+ *
+ * Optional feedback sends a target's value back out on its CC, for motorised
+ * faders and LED rings. It is throttled to at most one message per target per
+ * tick, only when the 7-bit value changed, and held off while the controller
+ * itself is moving so the fader doesn't fight the hand on it.
+ *
+ * Mappings are stored in the edit, by plugin and parameter ID.
+ *
+ * Thread safety: handleController() on any thread; everything else on the
+ * message thread. Recreated with TrackManager for each edit.
+ */
+class MidiLearn : private te::AutomatableParameter::Listener,
+                  private te::InputDeviceInstance::Consumer,
+                  private juce::Timer
+{
+public:
+    static constexpr int numChannels = 16;
+    static constexpr int numControllers = 128;
+    static constexpr int maxMappings = 128;
+    /** Time for a smoothed target to cover ~63% of a jump. */
+    static constexpr double smoothingMs = 30.0;
+    /** How long after its last controller move a target may send feedback again. */
+    static constexpr int feedbackHoldMs = 250;
+
+    /** One CC driving one parameter. Channels are 1-16. */
+    struct Mapping
+    {
+        int channel = 1;
+        int controller = 0;
+        te::AutomatableParameter::Ptr param;
+    };
+
+    MidiLearn (te::Edit& edit, TrackManager& trackManager);
+    ~MidiLearn() override;
+
+    //==============================================================================
+    /**
+     * @brief While learning, the next CC received is mapped to the parameter last
+     *        touched on screen.
+     *
+     * Each mapping needs a fresh touch, so several can be learned in a row.
+     */
+    void setLearning (bool shouldLearn);
+    bool isLearning() const noexcept    { return learning.load(); }
+
+    /** Called on the message thread whenever learn adds a mapping. */
+    std::function<void (const Mapping&)> onMappingLearned;
+
+    /** Sends feedback to the default MIDI output. Opens the device when enabled. */
+    void setFeedbackEnabled (bool shouldSend);
+    bool isFeedbackEnabled() const noexcept     { return feedbackOutput != nullptr; }
+
+    //==============================================================================
+    /**
+     * @brief Maps a CC to @p param, replacing whatever the CC or the parameter was
+     *        mapped to before.
+     *
+     * @return false if the channel or controller is out of range, or maxMappings is reached
+     */
+    bool addMapping (int channel, int controller, te::AutomatableParameter& param);
+    void removeMapping (te::AutomatableParameter& param);
+    void clearMappings();
+
+    const std::vector<Mapping>& getMappings() const noexcept   { return mappings; }
+
+    //==============================================================================
+    /**
+     * @brief Routes one controller value. Real-time safe: O(1), no allocation or lock.
+     *
+     * @param channel    1-16
+     * @param controller 0-127
+     * @param value      0-127
+     */
+    void handleController (int channel, int controller, int value) noexcept;
+
+    /** Message thread: moves every target toward its controller's value. Called by the tick. */
+    void applyControllerValues();
+
+private:
+    /** Slot for each channel/controller pair: the target index, or -1. */
+    struct Table
+    {
+        std::array<juce::int16, numChannels * numControllers> slots;
+
+        // Written by handleController(), taken by the tick: a normalised value, or -1 for none
+        mutable std::array<std::atomic<float>, maxMappings> received;
+    };
+
+    /** Message-thread state for one mapping's parameter. */
+    struct Target
+    {
+        float goal = 0.0f;
+        bool moving = false;
+        int lastSent = -1;
+        juce::uint32 lastReceivedMs = 0;
+    };
+
+    static int slotIndex (int channel, int controller) noexcept
+    {
+        return (channel - 1) * numControllers + controller;
+    }
+
+    // te::AutomatableParameter::Listener
+    void curveHasChanged (te::AutomatableParameter&) override {}
+    void parameterChanged (te::AutomatableParameter&, float) override;
+
+    // te::InputDeviceInstance::Consumer
+    void handleIncomingMidiMessage (const juce::MidiMessage&, te::MPESourceID) override;
+
+    void timerCallback() override;
+
+    /** Builds a table from the mappings and swaps it in. */
+    void publish();
+
+    void sendFeedback();
+
+    /** Listens to every mappable parameter and consumes every MIDI input. */
+    void updateWatched();
+
+    void saveMappings();
+    void loadMappings();
+
+    te::Edit& edit;
+    TrackManager& trackManager;
+
+    std::vector<Mapping> mappings;
+    std::array<Target, maxMappings> targets;
+
+    SharedSnapshot<Table> table;
+
+    std::atomic<bool> learning { false };
+    std::atomic<int> lastLearnSlot { -1 };      ///< Slot of the last CC received while learning
+    te::AutomatableParameter::Ptr touched;      ///< Last parameter touched while learning
+    bool applying = false;                      ///< Set while the tick writes parameters
+
+    juce::ReferenceCountedArray<te::AutomatableParameter> watched;
+    juce::Array<te::InputDeviceInstance*> inputs;
+    int ticksUntilRescan = 0;
+
+    std::unique_ptr<juce::MidiOutput> feedbackOutput;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MidiLearn)
+};
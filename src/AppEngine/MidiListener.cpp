@@ -47,9 +47,8 @@ void MidiListener::injectNoteMessage(const juce::MidiMessage& msg)
     // Ensure the Tracktion Edit has an allocated playback context before injecting live MIDI
     track->edit.getTransport().ensureContextAllocated();
 
-    // Use a fixed MPESourceID for live input; this keeps voices grouped if using MPE instruments
-    const te::MPESourceID source((juce::uint8)2);
-    track->injectLiveMidiMessage(te::MidiMessageWithSource(msg, source));
+    // Tag with this listener's own MPESourceID so MPE-aware instruments keep its voices together
+    track->injectLiveMidiMessage(te::MidiMessageWithSource(msg, liveSourceID));
 }
 
 bool MidiListener::handleKeyStateChanged(bool isKeyDown)
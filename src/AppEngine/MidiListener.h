@@ -145,4 +145,8 @@ private:
     };
 
     int keyboardBaseOctave = 4;                    ///< Base octave for QWERTY mapping (adjusted with Z/X keys).
+
+    /** Source ID for injected notes, unique per listener so it never collides with
+        other injectors (MPE-aware instruments group voices by source). */
+    const te::MPESourceID liveSourceID { te::createUniqueMPESourceID() };
 };
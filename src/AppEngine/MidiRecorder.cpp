@@ -1,4 +1,5 @@
 #include "MidiRecorder.h"
+#include "../AudioEngine/AsyncLog.h"
 
 using namespace juce;
 namespace te = tracktion::engine;
@@ -23,19 +24,20 @@ MidiRecorder::~MidiRecorder()
 //==============================================================================
 // Recording Control
 
-void MidiRecorder::startRecording(te::Edit& edit, int trackIndex,
+void MidiRecorder::startRecording(te::Edit& edit, int trackIndex, ClipIndex& clips,
                                   juce::MidiKeyboardState* qwertyKeyboardState)
 {
     if (recording)
     {
-        Logger::writeToLog("[MidiRecorder] Already recording, stopping previous recording first");
+        GROOVEKIT_LOG (info, "MidiRecorder", "Already recording, stopping previous recording first");
         stopRecording(edit);
     }
 
-    Logger::writeToLog("[MidiRecorder] ========== START RECORDING ==========");
-    Logger::writeToLog("[MidiRecorder] Target track index: " + String(trackIndex));
+    GROOVEKIT_LOG (info, "MidiRecorder", "========== START RECORDING ==========");
+    GROOVEKIT_LOG (info, "MidiRecorder", "Target track index: " << trackIndex);
 
     currentEdit = &edit;
+    clipIndex = &clips;
     targetTrackIndex = trackIndex;
 
     // Mute all clips on the track to prevent playback during recording
@@ -53,8 +55,8 @@ void MidiRecorder::startRecording(te::Edit& edit, int trackIndex,
             clip->setMuted(true);
         }
 
-        Logger::writeToLog("[MidiRecorder] Muted " + String(clipsToRestore.size()) +
-                          " clip(s) on track during recording");
+        GROOVEKIT_LOG (info, "MidiRecorder", "Muted " << clipsToRestore.size()
+                                             << " clip(s) on track during recording");
     }
 
     // Clear previous recording buffer
@@ -72,7 +74,7 @@ void MidiRecorder::startRecording(te::Edit& edit, int trackIndex,
     {
         qwertyKeyboardState->addListener(this);
         attachedSources.push_back(qwertyKeyboardState);
-        Logger::writeToLog("[MidiRecorder] Attached to QWERTY keyboard state");
+        GROOVEKIT_LOG (info, "MidiRecorder", "Attached to QWERTY keyboard state");
     }
 
     // Record start time and position
@@ -83,14 +85,14 @@ void MidiRecorder::startRecording(te::Edit& edit, int trackIndex,
     if (transport.looping)
     {
         recordingStartPosition = transport.getLoopRange().getStart();
-        Logger::writeToLog("[MidiRecorder] Loop recording - using loop start position: " +
-                          String(recordingStartPosition.inSeconds()) + " seconds");
+        GROOVEKIT_LOG (info, "MidiRecorder", "Loop recording - using loop start position: "
+                                             << recordingStartPosition.inSeconds() << " seconds");
     }
     else
     {
         recordingStartPosition = transport.getPosition();
-        Logger::writeToLog("[MidiRecorder] Recording start position: " +
-                          String(recordingStartPosition.inSeconds()) + " seconds");
+        GROOVEKIT_LOG (info, "MidiRecorder", "Recording start position: "
+                                             << recordingStartPosition.inSeconds() << " seconds");
     }
 
     // Initialize last recorded position for loop detection
@@ -103,22 +105,22 @@ void MidiRecorder::startRecording(te::Edit& edit, int trackIndex,
             transport.setPosition(transport.getLoopRange().getStart());
 
         transport.play(false);
-        Logger::writeToLog("[MidiRecorder] Started transport playback");
+        GROOVEKIT_LOG (info, "MidiRecorder", "Started transport playback");
     }
 
     recording = true;
-    Logger::writeToLog("[MidiRecorder] Recording ACTIVE - ready to capture MIDI");
+    GROOVEKIT_LOG (info, "MidiRecorder", "Recording ACTIVE - ready to capture MIDI");
 }
 
 bool MidiRecorder::stopRecording(te::Edit& edit)
 {
     if (!recording)
     {
-        Logger::writeToLog("[MidiRecorder] Not currently recording");
+        GROOVEKIT_LOG (info, "MidiRecorder", "Not currently recording");
         return false;
     }
 
-    Logger::writeToLog("[MidiRecorder] ========== STOP RECORDING ==========");
+    GROOVEKIT_LOG (info, "MidiRecorder", "========== STOP RECORDING ==========");
 
     recording = false;
 
@@ -132,8 +134,7 @@ bool MidiRecorder::stopRecording(te::Edit& edit)
 
     if (!heldNotes.empty())
     {
-        Logger::writeToLog("[MidiRecorder] Synthesizing note-offs for " +
-                          String(heldNotes.size()) + " held note(s)");
+        GROOVEKIT_LOG (info, "MidiRecorder", "Synthesizing note-offs for " << heldNotes.size() << " held note(s)");
 
         auto& transport = edit.getTransport();
         auto currentPosition = transport.getPosition();
@@ -151,7 +152,7 @@ bool MidiRecorder::stopRecording(te::Edit& edit)
                 recordedSequence.addEvent(noteOffMessage);
             }
 
-            Logger::writeToLog("[MidiRecorder] Synthesized note-off for note " + String(noteNumber));
+            GROOVEKIT_LOG (debug, "MidiRecorder", "Synthesized note-off for note " << noteNumber);
         }
     }
 
@@ -178,8 +179,7 @@ bool MidiRecorder::stopRecording(te::Edit& edit)
     {
         clip->setMuted(wasMuted);
     }
-    Logger::writeToLog("[MidiRecorder] Restored mute state for " +
-                      String(clipsToRestore.size()) + " clip(s)");
+    GROOVEKIT_LOG (info, "MidiRecorder", "Restored mute state for " << clipsToRestore.size() << " clip(s)");
     clipsToRestore.clear();
 
     // Detach from all sources
@@ -192,11 +192,11 @@ bool MidiRecorder::stopRecording(te::Edit& edit)
         noteCount = recordedSequence.getNumEvents();
     }
 
-    Logger::writeToLog("[MidiRecorder] Captured " + String(noteCount) + " MIDI events");
+    GROOVEKIT_LOG (info, "MidiRecorder", "Captured " << noteCount << " MIDI events");
 
     if (noteCount == 0)
     {
-        Logger::writeToLog("[MidiRecorder] No MIDI events recorded - skipping clip creation");
+        GROOVEKIT_LOG (info, "MidiRecorder", "No MIDI events recorded - skipping clip creation");
         return false;
     }
 
@@ -204,9 +204,9 @@ bool MidiRecorder::stopRecording(te::Edit& edit)
     bool success = createClipFromRecording(edit);
 
     if (success)
-        Logger::writeToLog("[MidiRecorder] Successfully created MIDI clip from recording");
+        GROOVEKIT_LOG (info, "MidiRecorder", "Successfully created MIDI clip from recording");
     else
-        Logger::writeToLog("[MidiRecorder] Failed to create MIDI clip");
+        GROOVEKIT_LOG (warning, "MidiRecorder", "Failed to create MIDI clip");
 
     return success;
 }
@@ -261,9 +261,8 @@ void MidiRecorder::handleNoteOn(juce::MidiKeyboardState* source, int midiChannel
         activeNotes.insert(midiNoteNumber);
     }
 
-    Logger::writeToLog("[MidiRecorder] NOTE ON:  Note=" + String(midiNoteNumber) +
-                      " Velocity=" + String(velocity, 2) +
-                      " Channel=" + String(midiChannel));
+    GROOVEKIT_LOG (debug, "MidiRecorder", "NOTE ON:  Note=" << midiNoteNumber << " Velocity="
+                                          << AsyncLog::fixed (velocity, 2) << " Channel=" << midiChannel);
 }
 
 void MidiRecorder::handleNoteOff(juce::MidiKeyboardState* source, int midiChannel,
@@ -282,8 +281,8 @@ void MidiRecorder::handleNoteOff(juce::MidiKeyboardState* source, int midiChanne
 
     if (!hasMatchingNoteOn)
     {
-        Logger::writeToLog("[MidiRecorder] Discarding orphaned NOTE OFF (no matching note-on): Note=" +
-                          String(midiNoteNumber));
+        GROOVEKIT_LOG (debug, "MidiRecorder", "Discarding orphaned NOTE OFF (no matching note-on): Note="
+                                              << midiNoteNumber);
         return;
     }
 
@@ -296,9 +295,8 @@ void MidiRecorder::handleNoteOff(juce::MidiKeyboardState* source, int midiChanne
         activeNotes.erase(midiNoteNumber);
     }
 
-    Logger::writeToLog("[MidiRecorder] NOTE OFF: Note=" + String(midiNoteNumber) +
-                      " Velocity=" + String(velocity, 2) +
-                      " Channel=" + String(midiChannel));
+    GROOVEKIT_LOG (debug, "MidiRecorder", "NOTE OFF: Note=" << midiNoteNumber << " Velocity="
+                                          << AsyncLog::fixed (velocity, 2) << " Channel=" << midiChannel);
 }
 
 //==============================================================================
@@ -316,11 +314,11 @@ void MidiRecorder::attachToHardwareMidiDevices(te::Edit& edit)
             attachedSources.push_back(&midiIn->keyboardState);
             deviceCount++;
 
-            Logger::writeToLog("[MidiRecorder] Attached to MIDI device: " + midiIn->getName());
+            GROOVEKIT_LOG (info, "MidiRecorder", "Attached to MIDI device: " << midiIn->getName());
         }
     }
 
-    Logger::writeToLog("[MidiRecorder] Attached to " + String(deviceCount) + " hardware MIDI device(s)");
+    GROOVEKIT_LOG (info, "MidiRecorder", "Attached to " << deviceCount << " hardware MIDI device(s)");
 }
 
 void MidiRecorder::detachFromAllSources()
@@ -331,7 +329,7 @@ void MidiRecorder::detachFromAllSources()
     }
 
     attachedSources.clear();
-    Logger::writeToLog("[MidiRecorder] Detached from all MIDI sources");
+    GROOVEKIT_LOG (info, "MidiRecorder", "Detached from all MIDI sources");
 }
 
 bool MidiRecorder::createClipFromRecording(te::Edit& edit)
@@ -340,12 +338,12 @@ bool MidiRecorder::createClipFromRecording(te::Edit& edit)
 
     if (targetTrackIndex < 0 || targetTrackIndex >= tracks.size())
     {
-        Logger::writeToLog("[MidiRecorder] Invalid target track index: " + String(targetTrackIndex));
+        GROOVEKIT_LOG (warning, "MidiRecorder", "Invalid target track index: " << targetTrackIndex);
         return false;
     }
 
     auto* track = tracks[targetTrackIndex];
-    Logger::writeToLog("[MidiRecorder] Creating clip on track: " + track->getName());
+    GROOVEKIT_LOG (info, "MidiRecorder", "Creating clip on track: " << track->getName());
 
     // Use the EXACT preview bounds: from recording start to current transport position
     // This ensures the created clip matches the preview clip perfectly
@@ -353,27 +351,19 @@ bool MidiRecorder::createClipFromRecording(te::Edit& edit)
     auto clipStart = recordingStartPosition;
     auto clipEnd = transport.getPosition();
 
-    Logger::writeToLog("[MidiRecorder] Clip position: " +
-                      String(clipStart.inSeconds(), 3) + "s to " +
-                      String(clipEnd.inSeconds(), 3) + "s");
+    GROOVEKIT_LOG (info, "MidiRecorder", "Clip position: " << AsyncLog::fixed (clipStart.inSeconds(), 3)
+                                         << "s to " << AsyncLog::fixed (clipEnd.inSeconds(), 3) << "s");
 
     // Find ALL clips that overlap with our recording range and delete them
     auto clipRange = t::TimeRange(clipStart, clipEnd);
     std::vector<te::Clip*> clipsToDelete;
 
-    for (auto* clip : track->getClips())
+    for (auto* clip : clipIndex->getOverlapping(*track, clipRange))
     {
         if (auto* midiClip = dynamic_cast<te::MidiClip*>(clip))
         {
-            auto clipPos = midiClip->getPosition();
-            auto existingRange = t::TimeRange(clipPos.getStart(), clipPos.getEnd());
-
-            // Check if the recording range overlaps with this clip
-            if (existingRange.overlaps(clipRange))
-            {
-                clipsToDelete.push_back(midiClip);
-                Logger::writeToLog("[MidiRecorder] Found overlapping clip to delete: " + midiClip->getName());
-            }
+            clipsToDelete.push_back(midiClip);
+            GROOVEKIT_LOG (info, "MidiRecorder", "Found overlapping clip to delete: " << midiClip->getName());
         }
     }
 
@@ -385,31 +375,17 @@ bool MidiRecorder::createClipFromRecording(te::Edit& edit)
 
     if (!clipsToDelete.empty())
     {
-        Logger::writeToLog("[MidiRecorder] Deleted " + String(clipsToDelete.size()) +
-                          " overlapping clip(s)");
+        GROOVEKIT_LOG (info, "MidiRecorder", "Deleted " << clipsToDelete.size() << " overlapping clip(s)");
     }
 
     // Create a new clip for the recording
-    Logger::writeToLog("[MidiRecorder] Creating new MIDI clip");
-    track->insertMIDIClip(track->getName() + " Recording", clipRange, nullptr);
-
-    // Find the newly created clip
-    te::MidiClip* targetClip = nullptr;
-    for (auto* clip : track->getClips())
-    {
-        if (auto* midiClip = dynamic_cast<te::MidiClip*>(clip))
-        {
-            if (midiClip->getPosition().getStart() == clipStart)
-            {
-                targetClip = midiClip;
-                break;
-            }
-        }
-    }
+    GROOVEKIT_LOG (info, "MidiRecorder", "Creating new MIDI clip");
+    auto newClip = track->insertMIDIClip(track->getName() + " Recording", clipRange, nullptr);
+    auto* targetClip = newClip.get();
 
     if (!targetClip)
     {
-        Logger::writeToLog("[MidiRecorder] ERROR: Failed to create MIDI clip");
+        GROOVEKIT_LOG (error, "MidiRecorder", "Failed to create MIDI clip");
         return false;
     }
 
@@ -468,7 +444,7 @@ bool MidiRecorder::createClipFromRecording(te::Edit& edit)
         }
     }
 
-    Logger::writeToLog("[MidiRecorder] Added " + String(notesAdded) + " notes to clip");
+    GROOVEKIT_LOG (info, "MidiRecorder", "Added " << notesAdded << " notes to clip");
 
     // Clear recorded sequence for next recording
     {
@@ -483,7 +459,7 @@ bool MidiRecorder::createClipFromRecording(te::Edit& edit)
 
 void MidiRecorder::handleLoopWraparound()
 {
-    Logger::writeToLog("[MidiRecorder] Loop wraparound detected - clearing recording buffer");
+    GROOVEKIT_LOG (info, "MidiRecorder", "Loop wraparound detected - clearing recording buffer");
 
     // Clear the buffer to start a fresh recording pass
     const ScopedLock sl(recordingLock);
@@ -3,6 +3,7 @@
 #include <juce_audio_basics/juce_audio_basics.h>
 #include <juce_audio_devices/juce_audio_devices.h>
 #include <tracktion_engine/tracktion_engine.h>
+#include "ClipIndex.h"
 
 namespace te = tracktion::engine;
 
@@ -51,9 +52,10 @@ public:
      *
      * @param edit The edit containing the target track.
      * @param trackIndex The 0-based index of the track to record to.
+     * @param clips The edit's clip index, used to clear the recorded range when stopping.
      * @param qwertyKeyboardState Optional QWERTY keyboard state to also record from.
      */
-    void startRecording(te::Edit& edit, int trackIndex,
+    void startRecording(te::Edit& edit, int trackIndex, ClipIndex& clips,
                        juce::MidiKeyboardState* qwertyKeyboardState = nullptr);
 
     /**
@@ -168,6 +170,7 @@ private:
 
     te::Engine& engine;                                      ///< Reference to Tracktion Engine (not owned).
     te::Edit* currentEdit = nullptr;                         ///< Edit being recorded to (not owned).
+    ClipIndex* clipIndex = nullptr;                          ///< currentEdit's clip index (not owned).
 
     std::atomic<bool> recording{false};                      ///< Whether recording is currently active.
     int targetTrackIndex = -1;                               ///< Index of track being recorded to.
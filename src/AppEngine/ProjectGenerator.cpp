@@ -0,0 +1,321 @@
+#include "ProjectGenerator.h"
+
+#include "AppEngine.h"
+#include "../DrumSamplerEngine/DefaultSampleLibrary.h"
+#include "../DrumSamplerEngine/DrumSamplerEngineAdapter.h"
+#include "../UI/Plugins/Synthesizer/MorphSynthPlugin.h"
+
+namespace t = tracktion;
+
+namespace
+{
+    /** Built-in effects cycled through when Spec::fxPerTrack > 0. */
+    const char* const fxTypes[] = {
+        te::EqualiserPlugin::xmlTypeName,
+        te::CompressorPlugin::xmlTypeName,
+        te::DelayPlugin::xmlTypeName,
+        te::ReverbPlugin::xmlTypeName,
+    };
+
+    /** Pitch range per preset so generated parts look like real parts in the piano roll. */
+    juce::Range<int> noteRangeFor (ProjectGenerator::Preset preset)
+    {
+        using P = ProjectGenerator::Preset;
+        switch (preset)
+        {
+            case P::bass:  return { 28, 52 };
+            case P::lead:  return { 60, 88 };
+            case P::pad:   return { 48, 76 };
+            case P::pluck: return { 55, 84 };
+            default:       return { 48, 84 };
+        }
+    }
+
+    /** First sample per category, in path order, so kits are identical across runs. */
+    juce::Array<juce::File> defaultKit()
+    {
+        DefaultSampleLibrary::ensureInstalled();
+
+        auto files = DefaultSampleLibrary::listAll();
+        files.sort();
+
+        juce::Array<juce::File> kit;
+        for (const auto* category : { "Kicks", "Snares", "HiHats", "Toms" })
+            for (const auto& f : files)
+                if (f.getParentDirectory().getFileName() == category)
+                {
+                    kit.add (f);
+                    break;
+                }
+
+        return kit;
+    }
+
+    void setParam (MorphSynthPlugin& synth, const char* paramID, float value)
+    {
+        if (auto* p = synth.getParameterFromID (paramID))
+            p->setParameter (value, juce::dontSendNotification);
+    }
+
+    void fillDrumClip (te::MidiClip& clip, int numNotes, double lengthBeats, int numPads, juce::Random& rng)
+    {
+        auto& seq = clip.getSequence();
+        const double step = lengthBeats / juce::jmax (1, numNotes);
+
+        for (int n = 0; n < numNotes; ++n)
+        {
+            // Kick/snare on the beat grid, everything else scattered across the kit
+            const int pad = (n % 4 == 0) ? 0 : (n % 4 == 2 ? 1 : 2 + rng.nextInt (juce::jmax (1, numPads - 2)));
+            seq.addNote (padToMidiNote (pad),
+                         t::BeatPosition::fromBeats (n * step),
+                         t::BeatDuration::fromBeats (juce::jmin (0.25, step)),
+                         60 + rng.nextInt (60), 0, nullptr);
+        }
+    }
+
+    void fillInstrumentClip (te::MidiClip& clip, int numNotes, double lengthBeats,
+                             juce::Range<int> range, juce::Random& rng)
+    {
+        auto& seq = clip.getSequence();
+        const double step = lengthBeats / juce::jmax (1, numNotes);
+
+        for (int n = 0; n < numNotes; ++n)
+        {
+            const double length = step * (0.25 + 0.75 * rng.nextDouble());
+            seq.addNote (range.getStart() + rng.nextInt (range.getLength()),
+                         t::BeatPosition::fromBeats (n * step),
+                         t::BeatDuration::fromBeats (length),
+                         40 + rng.nextInt (87), 0, nullptr);
+        }
+    }
+}
+
+//==============================================================================
+ProjectGenerator::Spec ProjectGenerator::Spec::customerScale()
+{
+    Spec s;
+    s.numTracks       = 200;
+    s.drumTrackRatio  = 0.25f;
+    s.clipsPerTrack   = 16;
+    s.clipLengthBeats = 16.0;
+    s.clipGapBeats    = 4.0;
+    s.notesPerClip    = 32;
+    s.fxPerTrack      = 1;
+    return s;
+}
+
+ProjectGenerator::Spec ProjectGenerator::Spec::fromCommandLine (const juce::ArgumentList& args)
+{
+    Spec s = args.containsOption ("--scale") && args.getValueForOption ("--scale") == "customer"
+                 ? customerScale() : Spec();
+
+    auto intOpt = [&args] (const char* opt, int& target)
+    {
+        if (args.containsOption (opt))
+            target = juce::jmax (0, args.getValueForOption (opt).getIntValue());
+    };
+
+    auto doubleOpt = [&args] (const char* opt, double& target)
+    {
+        if (args.containsOption (opt))
+            target = juce::jmax (0.0, args.getValueForOption (opt).getDoubleValue());
+    };
+
+    intOpt ("--tracks", s.numTracks);
+    intOpt ("--clips",  s.clipsPerTrack);
+    intOpt ("--notes",  s.notesPerClip);
+    intOpt ("--fx",     s.fxPerTrack);
+    doubleOpt ("--clip-beats", s.clipLengthBeats);
+    doubleOpt ("--gap-beats",  s.clipGapBeats);
+    doubleOpt ("--bpm",        s.bpm);
+
+    if (args.containsOption ("--drum-ratio"))
+        s.drumTrackRatio = juce::jlimit (0.0f, 1.0f, args.getValueForOption ("--drum-ratio").getFloatValue());
+
+    if (args.containsOption ("--seed"))
+        s.seed = args.getValueForOption ("--seed").getLargeIntValue();
+
+    if (args.containsOption ("--no-samples"))
+        s.loadDrumSamples = false;
+
+    if (args.containsOption ("--cycle-presets"))
+        s.cyclePresets = true;
+
+    s.clipLengthBeats = juce::jmax (1.0, s.clipLengthBeats);
+    s.bpm = juce::jlimit (20.0, 300.0, s.bpm > 0.0 ? s.bpm : 120.0);
+    return s;
+}
+
+juce::String ProjectGenerator::Stats::toString() const
+{
+    return juce::String (tracks) + " tracks (" + juce::String (drumTracks) + " drum, "
+         + juce::String (instrumentTracks) + " instrument), "
+         + juce::String (clips) + " clips, " + juce::String (notes) + " notes, "
+         + juce::String (plugins) + " plugins in " + juce::String (buildSeconds, 2) + " s";
+}
+
+//==============================================================================
+void ProjectGenerator::applyMorphPreset (te::Plugin& plugin, Preset preset)
+{
+    auto* synth = dynamic_cast<MorphSynthPlugin*> (&plugin);
+    if (synth == nullptr)
+        return;
+
+    switch (preset)
+    {
+        case Preset::pad:
+            setParam (*synth, "oscAType", 1.0f);  setParam (*synth, "oscBType", 2.0f);
+            setParam (*synth, "morph", 0.4f);     setParam (*synth, "cutoff", 2500.0f);
+            setParam (*synth, "aA", 0.8f);        setParam (*synth, "rA", 1.5f);
+            setParam (*synth, "sA", 0.9f);
+            setParam (*synth, "lfoTarget", 1.0f); setParam (*synth, "lfoDepth", 0.3f);
+            setParam (*synth, "lfoRate", 0.5f);
+            break;
+
+        case Preset::lead:
+            setParam (*synth, "oscAType", 2.0f);  setParam (*synth, "oscBType", 3.0f);
+            setParam (*synth, "morph", 0.6f);     setParam (*synth, "cutoff", 3000.0f);
+            setParam (*synth, "resonance", 0.9f); setParam (*synth, "glide", 40.0f);
+            setParam (*synth, "lfoTarget", 4.0f); setParam (*synth, "lfoDepth", 0.1f);
+            break;
+
+        case Preset::bass:
+            setParam (*synth, "oscAType", 2.0f);  setParam (*synth, "oscBType", 0.0f);
+            setParam (*synth, "morph", 0.3f);     setParam (*synth, "cutoff", 400.0f);
+            setParam (*synth, "fEnvAmt", 0.7f);   setParam (*synth, "dF", 0.15f);
+            setParam (*synth, "semi", -12.0f);
+            break;
+
+        case Preset::pluck:
+            setParam (*synth, "oscAType", 3.0f);  setParam (*synth, "pulseWidth", 0.25f);
+            setParam (*synth, "sA", 0.0f);        setParam (*synth, "dA", 0.25f);
+            setParam (*synth, "cutoff", 1500.0f); setParam (*synth, "fEnvAmt", 0.9f);
+            break;
+
+        case Preset::init:
+        case Preset::numPresets:
+        default:
+            break;
+    }
+}
+
+ProjectGenerator::Stats ProjectGenerator::generate (AppEngine& app, const Spec& spec)
+{
+    const auto startTime = juce::Time::getMillisecondCounterHiRes();
+
+    Stats stats;
+    juce::Random rng (spec.seed);
+
+    app.newUntitledEdit();
+    app.setBpm (spec.bpm);
+
+    auto& edit = app.getEdit();
+    auto& tm   = app.getTrackManager();
+
+    const auto kit = spec.loadDrumSamples ? defaultKit() : juce::Array<juce::File>();
+    const double clipStride = spec.clipLengthBeats + spec.clipGapBeats;
+
+    for (int trackNum = 0; trackNum < spec.numTracks; ++trackNum)
+    {
+        // Spread drum tracks evenly through the track list rather than bunching them up
+        const bool isDrum = (int) ((trackNum + 1) * spec.drumTrackRatio) > (int) (trackNum * spec.drumTrackRatio);
+
+        const int idx = isDrum ? tm.addDrumTrack() : tm.addInstrumentTrack();
+        if (idx < 0)
+            continue;
+
+        ++stats.tracks;
+        auto preset = Preset::init;
+
+        if (isDrum)
+        {
+            ++stats.drumTracks;
+            ++stats.plugins; // sampler
+
+            if (auto* drums = tm.getDrumAdapter (idx))
+                for (int pad = 0; pad < kit.size(); ++pad)
+                    drums->loadSampleIntoSlot (pad, kit.getReference (pad));
+        }
+        else
+        {
+            ++stats.instrumentTracks;
+
+            const int numPresets = (int) Preset::numPresets;
+            preset = (Preset) (spec.cyclePresets ? trackNum % numPresets : rng.nextInt (numPresets));
+
+            if (auto* synth = tm.insertMorphSynth (idx))
+            {
+                applyMorphPreset (*synth, preset);
+                ++stats.plugins;
+            }
+        }
+
+        if (auto* track = tm.getTrack (idx))
+        {
+            for (int fx = 0; fx < spec.fxPerTrack; ++fx)
+            {
+                const auto* type = fxTypes[(trackNum + fx) % juce::numElementsInArray (fxTypes)];
+                if (auto plugin = edit.getPluginCache().createNewPlugin (type, {}))
+                {
+                    track->pluginList.insertPlugin (std::move (plugin), -1, nullptr);
+                    ++stats.plugins;
+                }
+            }
+        }
+
+        for (int c = 0; c < spec.clipsPerTrack; ++c)
+        {
+            const auto start = app.getTempoMap().toTime (t::BeatPosition::fromBeats (c * clipStride));
+            app.addMidiClipToTrackAt (idx, start, t::BeatDuration::fromBeats (spec.clipLengthBeats));
+        }
+
+        // Fill once all clips exist, so the clip list is fetched once per track
+        for (auto* clip : app.getMidiClipsFromTrack (idx))
+        {
+            if (isDrum)
+                fillDrumClip (*clip, spec.notesPerClip, spec.clipLengthBeats, juce::jmax (3, kit.size()), rng);
+            else
+                fillInstrumentClip (*clip, spec.notesPerClip, spec.clipLengthBeats, noteRangeFor (preset), rng);
+
+            ++stats.clips;
+            stats.notes += spec.notesPerClip;
+        }
+    }
+
+    edit.getUndoManager().clearUndoHistory();
+
+    stats.buildSeconds = (juce::Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+    return stats;
+}
+
+//==============================================================================
+bool ProjectGenerator::runFromCommandLine (const juce::String& commandLine, int& exitCode)
+{
+    const juce::ArgumentList args ("GrooveKit", commandLine);
+
+    if (! args.containsOption ("--generate-project"))
+        return false;
+
+    const auto outPath = args.getValueForOption ("--generate-project");
+    if (outPath.isEmpty())
+    {
+        juce::Logger::writeToLog ("[ProjectGenerator] usage: GrooveKit --generate-project <file.tracktionedit> "
+                                  "[--scale customer] [--tracks N] [--drum-ratio F] [--clips N] [--clip-beats B] "
+                                  "[--gap-beats B] [--notes N] [--fx N] [--no-samples] [--cycle-presets] "
+                                  "[--bpm BPM] [--seed N]");
+        exitCode = 1;
+        return true;
+    }
+
+    const auto outFile = juce::File::getCurrentWorkingDirectory().getChildFile (outPath.unquoted());
+
+    AppEngine app;
+    const auto stats = generate (app, Spec::fromCommandLine (args));
+    const bool ok = app.writeEditToFile (outFile);
+
+    juce::Logger::writeToLog ("[ProjectGenerator] " + stats.toString()
+                              + (ok ? " -> " + outFile.getFullPathName() : juce::String (" -> write FAILED")));
+
+    exitCode = ok ? 0 : 1;
+    return true;
+}
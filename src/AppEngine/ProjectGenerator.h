@@ -0,0 +1,98 @@
+#pragma once
+
+#include <tracktion_engine/tracktion_engine.h>
+
+class AppEngine;
+
+namespace te = tracktion::engine;
+
+/**
+ * @brief Builds reproducible, parameterised synthetic edits for scale testing.
+ *
+ * Tracks, instruments and clips are created through the same AppEngine /
+ * TrackManager calls the UI uses, so a generated edit exercises the real code
+ * paths for save/load, rendering, UI rebuilds and memory measurements. Notes
+ * are written straight into each clip's te::MidiList, on the clip's own beat
+ * grid; going through MIDIEngine would only add a tempo-map conversion per note.
+ *
+ * The same Spec and seed always produce the same edit.
+ *
+ * Usage:
+ *  - Benchmarks/tests: ProjectGenerator::generate (app, ProjectGenerator::Spec::customerScale());
+ *  - CLI: GrooveKit --generate-project <file.tracktionedit> [--tracks N] [--clips N] ...
+ *    (see Spec::fromCommandLine for all options).
+ */
+namespace ProjectGenerator
+{
+    /** MorphSynth patches assigned to generated instrument tracks. */
+    enum class Preset
+    {
+        init,
+        pad,
+        lead,
+        bass,
+        pluck,
+        numPresets
+    };
+
+    /** Shape of the edit to generate. */
+    struct Spec
+    {
+        int    numTracks       = 16;     ///< Total tracks (drum + instrument).
+        float  drumTrackRatio  = 0.25f;  ///< Fraction of tracks that are drum tracks [0, 1].
+        int    clipsPerTrack   = 8;
+        double clipLengthBeats = 16.0;
+        double clipGapBeats    = 0.0;    ///< Empty space between consecutive clips.
+        int    notesPerClip    = 32;
+        int    fxPerTrack      = 0;      ///< Built-in effects appended after the instrument.
+        bool   loadDrumSamples = true;   ///< Load the default kit into drum pads.
+        bool   cyclePresets    = false;  ///< Cycle presets in order instead of picking randomly.
+        double bpm             = 120.0;
+        juce::int64 seed       = 1;
+
+        /** Roughly a large customer session: 200 tracks, 3200 clips, ~100k notes, ~350 plugins. */
+        static Spec customerScale();
+
+        /**
+         * @brief Builds a Spec from command-line options, starting from defaults.
+         *
+         * Recognised options (all optional, "--opt value" or "--opt=value"):
+         *  --scale customer, --tracks, --drum-ratio, --clips, --clip-beats, --gap-beats,
+         *  --notes, --fx, --no-samples, --cycle-presets, --bpm, --seed
+         */
+        static Spec fromCommandLine (const juce::ArgumentList& args);
+    };
+
+    /** What generate() actually created. */
+    struct Stats
+    {
+        int tracks = 0;
+        int drumTracks = 0;
+        int instrumentTracks = 0;
+        int clips = 0;
+        int notes = 0;
+        int plugins = 0;
+        double buildSeconds = 0.0;
+
+        juce::String toString() const;
+    };
+
+    /**
+     * @brief Replaces the app's current edit with a freshly generated one.
+     *
+     * Undo history is cleared afterwards so the edit's footprint matches a
+     * freshly loaded session.
+     */
+    Stats generate (AppEngine& app, const Spec& spec);
+
+    /** Applies one of the built-in presets to a MorphSynthPlugin (no-op for other plugins). */
+    void applyMorphPreset (te::Plugin& synth, Preset preset);
+
+    /**
+     * @brief Handles "--generate-project <file>" for the GrooveKit executable.
+     *
+     * @return true if the option was present (the caller should then quit),
+     *         false if the app should start normally.
+     */
+    bool runFromCommandLine (const juce::String& commandLine, int& exitCode);
+}
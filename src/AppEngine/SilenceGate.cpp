@@ -0,0 +1,133 @@
+#include "SilenceGate.h"
+
+SilenceGate::~SilenceGate()
+{
+    resume();
+}
+
+void SilenceGate::setInserts (const juce::Array<te::Plugin*>& plugins, double tailSeconds, double sampleRate)
+{
+    tailSamples.store ((juce::int64) (juce::jmax (0.0, tailSeconds) * sampleRate));
+    statsSampleRate = sampleRate;
+
+    bool unchanged = plugins.size() == inserts.size();
+    for (int i = 0; unchanged && i < plugins.size(); ++i)
+        unchanged = inserts.getObjectPointerUnchecked (i) == plugins.getUnchecked (i);
+
+    if (unchanged)
+        return;
+
+    // Plugins leaving the list must not stay switched off
+    for (int i = switchedOff.size(); --i >= 0;)
+    {
+        if (! plugins.contains (switchedOff.getObjectPointerUnchecked (i)))
+        {
+            switchedOff.getObjectPointerUnchecked (i)->setProcessingEnabled (true);
+            switchedOff.remove (i);
+        }
+    }
+
+    inserts.clear();
+    for (auto* p : plugins)
+        inserts.add (p);
+
+    // Inserts added to a suspended chain are suspended with it
+    if (suspended.load())
+        setProcessing (false);
+
+    numInserts.store (inserts.size());
+}
+
+void SilenceGate::instrumentBlock (bool producedSound, int numSamples) noexcept
+{
+    renderedSamples.fetch_add (numSamples, std::memory_order_relaxed);
+
+    if (restartSilence.exchange (false, std::memory_order_relaxed))
+    {
+        silentRun = 0;
+        wantsSuspended.store (false, std::memory_order_relaxed);
+    }
+
+    if (producedSound || ! enabled.load (std::memory_order_relaxed))
+    {
+        silentRun = 0;
+        wantsSuspended.store (false, std::memory_order_relaxed);
+        return;
+    }
+
+    idleSamples.fetch_add (numSamples, std::memory_order_relaxed);
+    silentRun += numSamples;
+
+    if (suspended.load (std::memory_order_relaxed))
+        suspendedSamples.fetch_add (numSamples, std::memory_order_relaxed);
+
+    if (numInserts.load (std::memory_order_relaxed) > 0 && silentRun > tailSamples.load (std::memory_order_relaxed))
+        wantsSuspended.store (true, std::memory_order_relaxed);
+}
+
+void SilenceGate::applyState (bool soundExpected)
+{
+    const bool shouldSuspend = ! soundExpected && wantsSuspended.load() && enabled.load() && ! inserts.isEmpty();
+
+    if (shouldSuspend == suspended.load())
+        return;
+
+    setProcessing (! shouldSuspend);
+    suspended.store (shouldSuspend);
+}
+
+void SilenceGate::resume()
+{
+    // The silence the chain was suspended for is over: the audio thread counts afresh
+    wantsSuspended.store (false);
+    restartSilence.store (true);
+
+    if (suspended.exchange (false))
+        setProcessing (true);
+}
+
+void SilenceGate::setProcessing (bool shouldProcess)
+{
+    if (shouldProcess)
+    {
+        for (auto* p : switchedOff)
+            p->setProcessingEnabled (true);
+
+        switchedOff.clear();
+        return;
+    }
+
+    // Inserts the user switched off stay that way when the chain resumes
+    for (auto* p : inserts)
+    {
+        if (p->isProcessingEnabled() && ! switchedOff.contains (p))
+        {
+            p->setProcessingEnabled (false);
+            switchedOff.add (p);
+        }
+    }
+}
+
+SilenceGate::Stats SilenceGate::getStats() const
+{
+    Stats s;
+    s.numInserts = numInserts.load();
+    s.suspended = suspended.load();
+
+    const auto rendered = renderedSamples.load();
+    if (rendered > 0)
+    {
+        s.seconds = (double) rendered / statsSampleRate;
+        s.idleFraction = (double) idleSamples.load() / (double) rendered;
+        s.suspendedFraction = (double) suspendedSamples.load() / (double) rendered;
+    }
+
+    return s;
+}
+
+void SilenceGate::resetStats() noexcept
+{
+    renderedSamples.store (0);
+    idleSamples.store (0);
+    suspendedSamples.store (0);
+}
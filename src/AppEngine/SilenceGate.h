@@ -0,0 +1,104 @@
+#pragma once
+
+#include <tracktion_engine/tracktion_engine.h>
+
+#include <atomic>
+
+namespace te = tracktion::engine;
+
+/**
+ * @brief Suspends a track's FX inserts while its instrument is silent.
+ *
+ * The instrument owns a gate and calls instrumentBlock() at the top of every
+ * render. That only counts: once the instrument has been silent for longer than
+ * the inserts' tail, the gate flags that the chain may be suspended, and the
+ * first block with sound clears the flag again.
+ *
+ * Switching the inserts (te::Plugin::setProcessingEnabled) writes their state, so
+ * it happens on the message thread, in applyState(), which SilenceMonitor calls on
+ * every tick. Waiting for the first sound would let that sound through a bypassed
+ * chain, so the monitor resumes the chain ahead of it instead: it passes
+ * soundExpected for notes the transport is about to play, for the track taking live
+ * input and for auditions. Only a note none of those cover (a sound the synth makes
+ * on its own) can start up to one tick before its inserts are back.
+ *
+ * The gate holds a reference to each insert, so a plugin removed from its track is
+ * never touched after it is deleted.
+ *
+ * Thread safety: instrumentBlock() on the audio thread; everything else on the
+ * message thread.
+ */
+class SilenceGate
+{
+public:
+    /** Counters since the last resetStats(), for diagnostics. */
+    struct Stats
+    {
+        int numInserts = 0;
+        bool suspended = false;
+        double seconds = 0.0;               ///< Rendered time covered by the fractions below
+        double idleFraction = 0.0;          ///< Share of that time the instrument was silent (render skipped)
+        double suspendedFraction = 0.0;     ///< Share of that time the inserts were suspended
+    };
+
+    SilenceGate() = default;
+
+    /** Re-enables any inserts this gate switched off. */
+    ~SilenceGate();
+
+    /**
+     * @brief Sets the inserts that follow the instrument and their combined tail.
+     *
+     * Inserts dropped from the list are switched back on.
+     *
+     * @param plugins     Inserts in chain order
+     * @param tailSeconds How long the chain keeps sounding after its input goes silent
+     * @param sampleRate  Current device sample rate
+     */
+    void setInserts (const juce::Array<te::Plugin*>& plugins, double tailSeconds, double sampleRate);
+
+    /** Turning the gate off resumes suspended inserts on the next applyState(). */
+    void setEnabled (bool shouldBeEnabled) noexcept     { enabled.store (shouldBeEnabled); }
+    bool isEnabled() const noexcept                     { return enabled.load(); }
+
+    /** Audio thread: once per block, before rendering. */
+    void instrumentBlock (bool producedSound, int numSamples) noexcept;
+
+    /**
+     * @brief Suspends or resumes the inserts to match what the audio thread last reported.
+     *
+     * @param soundExpected The instrument is about to sound: resume (or stay running)
+     *                      whatever the audio thread reported
+     */
+    void applyState (bool soundExpected = false);
+
+    /**
+     * @brief Switches every insert back on, e.g. before the edit is saved or an audition.
+     *
+     * The chain stays on until the audio thread reports a full tail of silence again.
+     */
+    void resume();
+
+    Stats getStats() const;
+    void resetStats() noexcept;
+
+private:
+    void setProcessing (bool shouldProcess);
+
+    juce::ReferenceCountedArray<te::Plugin> inserts;    ///< Message thread
+    juce::ReferenceCountedArray<te::Plugin> switchedOff; ///< Message thread: inserts this gate suspended
+
+    std::atomic<int> numInserts { 0 };
+    std::atomic<juce::int64> tailSamples { 0 };
+    std::atomic<bool> enabled { true };
+    std::atomic<bool> wantsSuspended { false };         ///< Set by the audio thread
+    std::atomic<bool> suspended { false };              ///< Set by applyState()
+    std::atomic<bool> restartSilence { false };         ///< Set by resume(): the audio thread restarts silentRun
+
+    juce::int64 silentRun = 0;                          ///< Audio thread: samples since the last sound
+
+    std::atomic<juce::int64> renderedSamples { 0 }, idleSamples { 0 }, suspendedSamples { 0 };
+    double statsSampleRate = 44100.0;
+
+    JUCE_DECLARE_NON_COPYABLE (SilenceGate)
+};
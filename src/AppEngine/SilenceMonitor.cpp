@@ -0,0 +1,185 @@
+#include "SilenceMonitor.h"
+#include "TrackManager.h"
+#include "ClipIndex.h"
+#include "../UI/Plugins/Synthesizer/MorphSynthPlugin.h"
+#include "../PluginManager/SandboxedPlugin.h"
+
+namespace
+{
+    /** The MorphSynth in the track's instrument slot, or nullptr. */
+    MorphSynthPlugin* getMorphSynth (te::AudioTrack& track, int instrumentSlot)
+    {
+        return dynamic_cast<MorphSynthPlugin*> (track.pluginList[instrumentSlot]);
+    }
+
+    /** True if a note of @p clip sounds anywhere in @p range. */
+    bool hasNoteIn (te::MidiClip& clip, t::TimeRange range)
+    {
+        // Loops repeat the notes at times the sequence doesn't hold: assume they sound
+        if (clip.isLooping())
+            return true;
+
+        for (auto* note : clip.getSequence().getNotes())
+            if (note->getEditStartTime (clip) < range.getEnd() && note->getEditEndTime (clip) > range.getStart())
+                return true;
+
+        return false;
+    }
+}
+
+SilenceMonitor::SilenceMonitor (te::Edit& e, TrackManager& tm, ClipIndex& ci)
+    : edit (e), trackManager (tm), clipIndex (ci)
+{
+    update();
+    startTimerHz (tickHz);
+}
+
+SilenceMonitor::~SilenceMonitor()
+{
+    stopTimer();
+}
+
+void SilenceMonitor::setEnabled (bool shouldBeEnabled)
+{
+    enabled = shouldBeEnabled;
+    update();
+}
+
+double SilenceMonitor::getTailSeconds (te::Plugin& plugin)
+{
+    const double reported = plugin.getTailLength();
+
+    if (dynamic_cast<te::ExternalPlugin*> (&plugin) != nullptr || dynamic_cast<SandboxedPlugin*> (&plugin) != nullptr)
+        return juce::jmax (reported, externalTailSeconds);
+
+    return juce::jmax (reported, minimumTailSeconds);
+}
+
+void SilenceMonitor::timerCallback()
+{
+    // Chains change rarely; gates flip often and must catch up quickly
+    if (--ticksUntilUpdate <= 0)
+        update();
+
+    auto tracks = te::getAudioTracks (edit);
+
+    for (int i = 0; i < (int) tracks.size(); ++i)
+        if (auto* synth = getMorphSynth (*tracks[(size_t) i], trackManager.getInstrumentSlotIndex (i)))
+            synth->getSilenceGate().applyState (isSoundExpected (*tracks[(size_t) i], i));
+}
+
+bool SilenceMonitor::isSoundExpected (te::AudioTrack& track, int trackIndex)
+{
+    if (trackIndex == liveInputTrack)
+        return true;
+
+    auto& transport = edit.getTransport();
+    if (! transport.isPlaying())
+        return false;
+
+    const auto now = transport.getPosition();
+    auto ahead = t::TimeRange (now, t::TimeDuration::fromSeconds (lookAheadSeconds));
+
+    // Near the loop end, the notes coming up are the ones at the loop start
+    juce::Array<t::TimeRange> windows;
+    if (const auto loop = transport.getLoopRange(); transport.looping && loop.contains (now) && ahead.getEnd() > loop.getEnd())
+    {
+        windows.add ({ now, loop.getEnd() });
+        windows.add (t::TimeRange (loop.getStart(), ahead.getEnd() - loop.getEnd()));
+    }
+    else
+    {
+        windows.add (ahead);
+    }
+
+    for (const auto& window : windows)
+        for (auto* clip : clipIndex.getOverlapping (track, window))
+            if (auto* midiClip = dynamic_cast<te::MidiClip*> (clip))
+                if (hasNoteIn (*midiClip, window))
+                    return true;
+
+    return false;
+}
+
+void SilenceMonitor::wake (int trackIndex)
+{
+    auto tracks = te::getAudioTracks (edit);
+
+    if (juce::isPositiveAndBelow (trackIndex, (int) tracks.size()))
+        if (auto* synth = getMorphSynth (*tracks[(size_t) trackIndex], trackManager.getInstrumentSlotIndex (trackIndex)))
+            synth->getSilenceGate().resume();
+}
+
+void SilenceMonitor::resumeAll()
+{
+    auto tracks = te::getAudioTracks (edit);
+
+    for (int i = 0; i < (int) tracks.size(); ++i)
+        if (auto* synth = getMorphSynth (*tracks[(size_t) i], trackManager.getInstrumentSlotIndex (i)))
+            synth->getSilenceGate().resume();
+}
+
+void SilenceMonitor::update()
+{
+    ticksUntilUpdate = tickHz / updatesPerSecond;
+
+    const double sampleRate = edit.engine.getDeviceManager().getSampleRate();
+    if (sampleRate <= 0.0)
+        return;
+
+    auto tracks = te::getAudioTracks (edit);
+
+    for (int i = 0; i < (int) tracks.size(); ++i)
+    {
+        auto* track = tracks[(size_t) i];
+        auto* synth = getMorphSynth (*track, trackManager.getInstrumentSlotIndex (i));
+        if (synth == nullptr)
+            continue;
+
+        juce::Array<te::Plugin*> inserts;
+        double tail = 0.0;
+
+        // Chained inserts ring out one after another, so their tails add up
+        for (int slot = trackManager.getFxInsertBaseIndex (i); slot < track->pluginList.size(); ++slot)
+        {
+            if (auto* p = track->pluginList[slot])
+            {
+                inserts.add (p);
+                tail += getTailSeconds (*p);
+            }
+        }
+
+        auto& gate = synth->getSilenceGate();
+        gate.setEnabled (enabled);
+        gate.setInserts (inserts, tail, sampleRate);
+    }
+}
+
+std::vector<SilenceMonitor::TrackStats> SilenceMonitor::getStats() const
+{
+    std::vector<TrackStats> result;
+    auto tracks = te::getAudioTracks (edit);
+
+    for (int i = 0; i < (int) tracks.size(); ++i)
+    {
+        auto* track = tracks[(size_t) i];
+        auto* synth = getMorphSynth (*track, trackManager.getInstrumentSlotIndex (i));
+        if (synth == nullptr)
+            continue;
+
+        const auto s = synth->getSilenceGate().getStats();
+        result.push_back ({ i, track->getName(), s.numInserts, s.suspended,
+                            s.seconds, s.idleFraction, s.suspendedFraction });
+    }
+
+    return result;
+}
+
+void SilenceMonitor::resetStats()
+{
+    auto tracks = te::getAudioTracks (edit);
+
+    for (int i = 0; i < (int) tracks.size(); ++i)
+        if (auto* synth = getMorphSynth (*tracks[(size_t) i], trackManager.getInstrumentSlotIndex (i)))
+            synth->getSilenceGate().resetStats();
+}
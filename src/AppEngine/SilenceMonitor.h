@@ -0,0 +1,97 @@
+#pragma once
+
+#include <tracktion_engine/tracktion_engine.h>
+
+#include <vector>
+
+namespace te = tracktion::engine;
+namespace t = tracktion;
+
+class TrackManager;
+class ClipIndex;
+
+/**
+ * @brief Keeps each MorphSynth track's SilenceGate in step with its insert chain.
+ *
+ * Ten times a second, hands every MorphSynth its track's FX inserts (everything
+ * after the meter) and their tail, so insert, remove and reorder edits reach the
+ * gates without hooks in each editing path. Every tick (50 per second) it lets
+ * each gate suspend or resume its inserts, which can only happen on the message
+ * thread (see SilenceGate). Also collects the gates' counters for the diagnostics
+ * window.
+ *
+ * Chains are resumed before the sound that needs them, not after it: a tick looks
+ * lookAheadSeconds past the playhead for notes on the track, the track taking live
+ * input is never suspended, and wake() resumes a track straight away (auditions).
+ *
+ * Tracks with another instrument, or none, are left alone: only MorphSynth
+ * reports its silence.
+ *
+ * Thread safety: message thread only. Recreated with TrackManager for each edit.
+ */
+class SilenceMonitor : private juce::Timer
+{
+public:
+    /** Per-track counters for a gated track. */
+    struct TrackStats
+    {
+        int trackIndex = -1;
+        juce::String name;
+        int numInserts = 0;
+        bool suspended = false;
+        double seconds = 0.0;
+        double idleFraction = 0.0;       ///< Share of time the synth skipped rendering
+        double suspendedFraction = 0.0;  ///< Share of time the inserts were suspended
+    };
+
+    SilenceMonitor (te::Edit& edit, TrackManager& trackManager, ClipIndex& clipIndex);
+    ~SilenceMonitor() override;
+
+    /** Turns suspension on or off for every track (silent synths still skip rendering). */
+    void setEnabled (bool shouldBeEnabled);
+    bool isEnabled() const noexcept { return enabled; }
+
+    std::vector<TrackStats> getStats() const;
+    void resetStats();
+
+    /** Switches every suspended insert back on (before saving, so no insert is stored off). */
+    void resumeAll();
+
+    /** Resumes one track's inserts now, for a sound the transport doesn't know about. */
+    void wake (int trackIndex);
+
+    /** The track live MIDI goes to (-1 for none): its inserts stay on, as a note can come at any time. */
+    void setLiveInputTrack (int trackIndex) noexcept    { liveInputTrack = trackIndex; }
+
+    /** How far ahead of the playhead a note resumes its chain: two ticks plus a large output buffer. */
+    static constexpr double lookAheadSeconds = 0.1;
+
+    /** Floor on any insert's tail, covering plugins that report none. */
+    static constexpr double minimumTailSeconds = 0.25;
+    /** Tail assumed for third-party plugins, which rarely report a real one (reverbs, delays). */
+    static constexpr double externalTailSeconds = 5.0;
+
+    /** Seconds @p plugin may keep sounding after its input goes silent. */
+    static double getTailSeconds (te::Plugin& plugin);
+
+private:
+    static constexpr int tickHz = 50;
+    static constexpr int updatesPerSecond = 10;
+
+    void timerCallback() override;
+
+    /** Publishes every MorphSynth track's inserts and tail to its gate. */
+    void update();
+
+    /** True if track @p trackIndex takes live input, or the playhead reaches one of its notes within lookAheadSeconds. */
+    bool isSoundExpected (te::AudioTrack& track, int trackIndex);
+
+    te::Edit& edit;
+    TrackManager& trackManager;
+    ClipIndex& clipIndex;
+    bool enabled = true;
+    int liveInputTrack = -1;
+    int ticksUntilUpdate = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SilenceMonitor)
+};
@@ -0,0 +1,173 @@
+#include "StartupOrchestrator.h"
+
+namespace
+{
+    const char* describe (StartupOrchestrator::Where where)
+    {
+        switch (where)
+        {
+            case StartupOrchestrator::Where::messageThread: return "sync";
+            case StartupOrchestrator::Where::deferred:      return "deferred";
+            case StartupOrchestrator::Where::background:    return "background";
+        }
+        return "";
+    }
+}
+
+//==============================================================================
+StartupOrchestrator::StartupOrchestrator()
+    : originMs (juce::Time::getMillisecondCounterHiRes())
+{
+    // Create the weak-reference master now; stageFinished() may first need it on a worker thread.
+    juce::WeakReference<StartupOrchestrator> master (this);
+    juce::ignoreUnused (master);
+}
+
+StartupOrchestrator::~StartupOrchestrator()
+{
+    pool.removeAllJobs (true, 30000);
+}
+
+double StartupOrchestrator::nowMs() const
+{
+    return juce::Time::getMillisecondCounterHiRes() - originMs;
+}
+
+//==============================================================================
+void StartupOrchestrator::runNow (const juce::String& name, std::function<void()> work)
+{
+    StageTiming timing { name, Where::messageThread, nowMs(), 0.0 };
+    {
+        std::lock_guard<std::mutex> sl (lock);
+        ++pendingStages;
+    }
+
+    work();
+
+    timing.endMs = nowMs();
+    stageFinished (timing);
+}
+
+void StartupOrchestrator::runDeferred (const juce::String& name, std::function<void()> work)
+{
+    {
+        std::lock_guard<std::mutex> sl (lock);
+        ++pendingStages;
+    }
+
+    juce::WeakReference<StartupOrchestrator> weakThis (this);
+
+    juce::MessageManager::callAsync ([weakThis, name, work = std::move (work)]
+    {
+        if (auto* self = weakThis.get())
+        {
+            StageTiming timing { name, Where::deferred, self->nowMs(), 0.0 };
+            work();
+            timing.endMs = self->nowMs();
+            self->stageFinished (timing);
+        }
+    });
+}
+
+void StartupOrchestrator::runInBackground (const juce::String& name, std::function<void()> work)
+{
+    {
+        std::lock_guard<std::mutex> sl (lock);
+        ++pendingStages;
+    }
+
+    pool.addJob ([this, name, work = std::move (work)]
+    {
+        StageTiming timing { name, Where::background, nowMs(), 0.0 };
+        work();
+        timing.endMs = nowMs();
+        stageFinished (timing);
+    });
+}
+
+void StartupOrchestrator::stageFinished (StageTiming timing)
+{
+    bool allDone = false;
+    {
+        std::lock_guard<std::mutex> sl (lock);
+        timings.push_back (timing);
+        // Only report once the UI is up, otherwise the constructor's sync stages would trigger it
+        allDone = --pendingStages == 0 && interactiveMs >= 0.0;
+    }
+
+    DBG ("[Startup] " << timing.name << " (" << describe (timing.where) << "): "
+         << juce::String (timing.durationMs(), 1) << " ms");
+
+    if (! allDone)
+        return;
+
+    juce::WeakReference<StartupOrchestrator> weakThis (this);
+    juce::MessageManager::callAsync ([weakThis]
+    {
+        if (auto* self = weakThis.get(); self != nullptr && self->isFinished())
+        {
+            juce::Logger::writeToLog (self->getReport());
+
+            if (self->onAllStagesFinished)
+                self->onAllStagesFinished();
+        }
+    });
+}
+
+//==============================================================================
+void StartupOrchestrator::markInteractive()
+{
+    std::lock_guard<std::mutex> sl (lock);
+    if (interactiveMs < 0.0)
+        interactiveMs = nowMs();
+}
+
+double StartupOrchestrator::getTimeToInteractiveMs() const
+{
+    std::lock_guard<std::mutex> sl (lock);
+    return interactiveMs;
+}
+
+bool StartupOrchestrator::isFinished() const
+{
+    std::lock_guard<std::mutex> sl (lock);
+    return pendingStages == 0;
+}
+
+bool StartupOrchestrator::waitForBackgroundStages (int timeoutMs)
+{
+    const auto deadline = juce::Time::getMillisecondCounter() + (juce::uint32) timeoutMs;
+
+    while (pool.getNumJobs() > 0)
+    {
+        if (juce::Time::getMillisecondCounter() > deadline)
+            return false;
+
+        juce::Thread::sleep (1);
+    }
+
+    return true;
+}
+
+std::vector<StartupOrchestrator::StageTiming> StartupOrchestrator::getTimings() const
+{
+    std::lock_guard<std::mutex> sl (lock);
+    return timings;
+}
+
+juce::String StartupOrchestrator::getReport() const
+{
+    const auto snapshot = getTimings();
+    const auto tti = getTimeToInteractiveMs();
+
+    juce::String report ("[Startup] time to interactive: ");
+    report << (tti >= 0.0 ? juce::String (tti, 1) + " ms" : juce::String ("n/a")) << juce::newLine;
+
+    for (const auto& t : snapshot)
+        report << "  " << t.name.paddedRight (' ', 28)
+               << juce::String (describe (t.where)).paddedRight (' ', 12)
+               << juce::String (t.startMs, 1) << " -> " << juce::String (t.endMs, 1)
+               << " ms (" << juce::String (t.durationMs(), 1) << " ms)" << juce::newLine;
+
+    return report;
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <juce_events/juce_events.h>
+
+#include <functional>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief Runs and times GrooveKit's startup stages.
+ *
+ * Stages come in three kinds:
+ *  - runNow():          synchronous, on the calling (message) thread. Only for work
+ *                       the first frame cannot do without (engine, empty edit).
+ *  - runDeferred():     queued on the message thread, so it runs after the window
+ *                       is up (device open, plugin catalogue: JUCE requires these
+ *                       on the message thread).
+ *  - runInBackground(): on a worker thread, concurrently with everything else
+ *                       (sample library install).
+ *
+ * Every stage's start/end time is recorded relative to the orchestrator's creation,
+ * together with a time-to-interactive mark. The timing table is logged once all
+ * stages have finished.
+ *
+ * Thread safety: run*() and markInteractive() are message-thread calls; timings
+ * may be read from any thread.
+ */
+class StartupOrchestrator
+{
+public:
+    enum class Where
+    {
+        messageThread,
+        deferred,
+        background
+    };
+
+    struct StageTiming
+    {
+        juce::String name;
+        Where where = Where::messageThread;
+        double startMs = 0.0;   ///< Relative to orchestrator creation.
+        double endMs = 0.0;
+
+        double durationMs() const { return endMs - startMs; }
+    };
+
+    StartupOrchestrator();
+
+    /** Waits for background stages so they never outlive what they capture. */
+    ~StartupOrchestrator();
+
+    void runNow          (const juce::String& name, std::function<void()> work);
+    void runDeferred     (const juce::String& name, std::function<void()> work);
+    void runInBackground (const juce::String& name, std::function<void()> work);
+
+    /** Records the point where the UI is usable (call once the main view exists). */
+    void markInteractive();
+
+    /** Milliseconds from creation to markInteractive(), or -1 if not reached yet. */
+    double getTimeToInteractiveMs() const;
+
+    /** True once every queued stage has finished. */
+    bool isFinished() const;
+
+    /** Blocks until background stages finish (tests/tools only). */
+    bool waitForBackgroundStages (int timeoutMs);
+
+    /** Completed stages, in completion order. */
+    std::vector<StageTiming> getTimings() const;
+
+    /** Human-readable timing table. */
+    juce::String getReport() const;
+
+    /** Called on the message thread when the last pending stage finishes. */
+    std::function<void()> onAllStagesFinished;
+
+private:
+    double nowMs() const;
+    void stageFinished (StageTiming timing);
+
+    const double originMs;
+    juce::ThreadPool pool { 2 };
+
+    mutable std::mutex lock;
+    std::vector<StageTiming> timings;
+    int pendingStages = 0;
+    double interactiveMs = -1.0;
+
+    JUCE_DECLARE_WEAK_REFERENCEABLE (StartupOrchestrator)
+    JUCE_DECLARE_NON_COPYABLE (StartupOrchestrator)
+};
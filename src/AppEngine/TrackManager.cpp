@@ -2,7 +2,9 @@
 #include <tracktion_engine/tracktion_engine.h>
 #include "../DrumSamplerEngine/DrumSamplerEngineAdapter.h"
 #include "../UI/Plugins/Synthesizer/MorphSynthPlugin.h"
+#include "../UI/Plugins/MidiFx/MidiFxPlugin.h"
 #include "../PluginManager/PluginManager.h"
+#include "../PluginManager/SandboxedPlugin.h"
 
 namespace {
     static int asIndexChecked (int idx, int size) { return (idx >= 0 && idx < size) ? idx : -1; }
@@ -10,6 +12,9 @@ namespace {
 
 namespace GKIDs {
     static const juce::Identifier isDrum ("gk_isDrum");
+    static const juce::Identifier isAudio ("gk_isAudio");
+    static const juce::Identifier recordArmed ("gk_recordArmed");
+    static const juce::Identifier inputChannel ("gk_inputChannel");
 }
 
 TrackManager::TrackManager(te::Edit& editRef)
@@ -44,7 +49,8 @@ void TrackManager::syncBookkeepingToEngine()
         }
         else
         {
-            types[(size_t) i] = TrackType::Instrument;
+            const bool isAudio = (bool) track->state.getProperty(GKIDs::isAudio, false);
+            types[(size_t) i] = isAudio ? TrackType::Audio : TrackType::Instrument;
             // Clear drum adapter if track is not a drum track
             drumEngines[(size_t) i].reset();
         }
@@ -87,13 +93,15 @@ void TrackManager::clearInstrumentSlot0 (int trackIndex)
 
     if (auto* track = getTrack (trackIndex))
     {
-        if (track->pluginList.size() == 0)
+        const int slot = getInstrumentSlotIndex (trackIndex);
+        if (track->pluginList.size() <= slot)
             return;
 
-        if (auto* p = track->pluginList[0])
+        if (auto* p = track->pluginList[slot])
         {
             // Only remove if it’s an instrument we consider “the instrument slot”
             if (dynamic_cast<te::ExternalPlugin*> (p)
+             || dynamic_cast<SandboxedPlugin*> (p)
              || dynamic_cast<MorphSynthPlugin*> (p)
              || dynamic_cast<te::FourOscPlugin*> (p))
             {
@@ -137,6 +145,21 @@ te::Plugin* TrackManager::insertExternalEffect (int trackIndex,
     return nullptr;
 }
 
+int TrackManager::addAudioTrack()
+{
+    const int newIndex = getNumTracks();
+    edit.ensureNumberOfAudioTracks(newIndex + 1);
+
+    auto* track = te::getAudioTracks(edit)[(size_t) newIndex];
+    track->state.setProperty (GKIDs::isDrum, false, nullptr);
+    track->state.setProperty (GKIDs::isAudio, true, nullptr);           // <-- persist
+    track->setName ("Audio " + juce::String (newIndex + 1));
+
+    syncBookkeepingToEngine();
+    edit.getTransport().ensureContextAllocated();
+    return newIndex;
+}
+
 int TrackManager::addTrack()
 {
     return addInstrumentTrack();
@@ -166,6 +189,13 @@ bool TrackManager::isDrumTrack(int index) const
     return types[(size_t) index] == TrackType::Drum;
 }
 
+bool TrackManager::isAudioTrack(int index) const
+{
+    if (index < 0 || index >= getNumTracks() || (int) types.size() <= index)
+        return false;
+    return types[(size_t) index] == TrackType::Audio;
+}
+
 DrumSamplerEngineAdapter* TrackManager::getDrumAdapter(int index)
 {
     if (index < 0 || index >= getNumTracks() || (int) drumEngines.size() <= index)
@@ -220,6 +250,43 @@ bool TrackManager::anyTrackSoloed() const
     return false;
 }
 
+void TrackManager::setAudioTrackArmed(int index, bool armed)
+{
+    if (! isAudioTrack(index))
+        return;
+    if (auto* track = getTrack(index))
+        track->state.setProperty(GKIDs::recordArmed, armed, nullptr);
+}
+
+bool TrackManager::isAudioTrackArmed(int index) const
+{
+    if (! isAudioTrack(index))
+        return false;
+    auto audioTracks = te::getAudioTracks(edit);
+    return (bool) audioTracks[(size_t) index]->state.getProperty(GKIDs::recordArmed, false);
+}
+
+bool TrackManager::anyAudioTrackArmed() const
+{
+    for (int i = 0; i < getNumTracks(); ++i)
+        if (isAudioTrackArmed(i)) return true;
+    return false;
+}
+
+void TrackManager::setAudioTrackInput(int index, int firstChannel)
+{
+    if (auto* track = getTrack(index))
+        track->state.setProperty(GKIDs::inputChannel, juce::jmax(-1, firstChannel), nullptr);
+}
+
+int TrackManager::getAudioTrackInput(int index) const
+{
+    auto audioTracks = te::getAudioTracks(edit);
+    if (index < 0 || index >= (int) audioTracks.size())
+        return -1;
+    return (int) audioTracks[(size_t) index]->state.getProperty(GKIDs::inputChannel, -1);
+}
+
 te::Plugin* TrackManager::getInstrumentPluginOnTrack (int trackIndex)
 {
     if (trackIndex < 0 || trackIndex >= getNumTracks())
@@ -227,11 +294,12 @@ te::Plugin* TrackManager::getInstrumentPluginOnTrack (int trackIndex)
 
     if (auto* track = getTrack (trackIndex))
     {
-        if (track->pluginList.size() == 0)
+        // We only ever treat the instrument slot (0, or 1 after a MIDI FX) as "the instrument"
+        const int slot = getInstrumentSlotIndex (trackIndex);
+        if (track->pluginList.size() <= slot)
             return nullptr;
 
-        // We only ever treat slot 0 as "the instrument"
-        te::Plugin* plug = track->pluginList[0];
+        te::Plugin* plug = track->pluginList[slot];
         if (plug == nullptr)
             return nullptr;
 
@@ -259,11 +327,15 @@ te::Plugin* TrackManager::getInstrumentPluginOnTrack (int trackIndex)
             }
 
             // Instance not created yet, but if we inserted an external instrument
-            // we always put it at index 0, so treat this as the instrument.
+            // we always put it in the instrument slot, so treat this as the instrument.
             return plug;
         }
 
-        // Anything else at slot 0 isn't considered an instrument
+        // External instrument hosted in a worker process
+        if (auto* sandboxed = dynamic_cast<SandboxedPlugin*> (plug))
+            return sandboxed->isSynth() ? plug : nullptr;
+
+        // Anything else in the instrument slot isn't considered an instrument
         return nullptr;
     }
 
@@ -278,7 +350,7 @@ te::Plugin* TrackManager::insertExternalInstrument (int trackIndex, const juce::
 
     if (auto* t = getTrack (trackIndex))
     {
-        if (auto p = pluginManager->addExternalInstrumentToTrack (*t, desc, 0))
+        if (auto p = pluginManager->addExternalInstrumentToTrack (*t, desc, getInstrumentSlotIndex (trackIndex)))
             return p.get();
     }
     return nullptr;
@@ -293,7 +365,7 @@ te::Plugin* TrackManager::insertMorphSynth (int trackIndex)
     {
         if (auto plugin = edit.getPluginCache().createNewPlugin (MorphSynthPlugin::pluginType, {}))
         {
-            t->pluginList.insertPlugin (std::move (plugin), 0, nullptr);
+            t->pluginList.insertPlugin (std::move (plugin), getInstrumentSlotIndex (trackIndex), nullptr);
             for (auto* p : t->pluginList)
                 if (auto* morph = dynamic_cast<MorphSynthPlugin*> (p))
                     return morph;
@@ -302,6 +374,51 @@ te::Plugin* TrackManager::insertMorphSynth (int trackIndex)
     return nullptr;
 }
 
+//==============================================================================
+// MIDI FX slot
+
+MidiFxPlugin* TrackManager::getMidiFxOnTrack (int trackIndex) const
+{
+    if (trackIndex < 0 || trackIndex >= getNumTracks())
+        return nullptr;
+
+    auto* t = te::getAudioTracks (edit)[(size_t) trackIndex];
+    if (t == nullptr || t->pluginList.size() == 0)
+        return nullptr;
+
+    return dynamic_cast<MidiFxPlugin*> (t->pluginList[0]);
+}
+
+int TrackManager::getInstrumentSlotIndex (int trackIndex) const
+{
+    return getMidiFxOnTrack (trackIndex) != nullptr ? 1 : 0;
+}
+
+MidiFxPlugin* TrackManager::insertMidiFx (int trackIndex)
+{
+    if (auto* existing = getMidiFxOnTrack (trackIndex))
+        return existing;
+
+    auto* t = getTrack (trackIndex);
+    if (t == nullptr)
+        return nullptr;
+
+    // Slot 0: MIDI passes through it before reaching the instrument
+    if (auto plugin = edit.getPluginCache().createNewPlugin (MidiFxPlugin::pluginType, {}))
+    {
+        t->pluginList.insertPlugin (std::move (plugin), 0, nullptr);
+        return getMidiFxOnTrack (trackIndex);
+    }
+
+    return nullptr;
+}
+
+void TrackManager::removeMidiFx (int trackIndex)
+{
+    if (auto* fx = getMidiFxOnTrack (trackIndex))
+        fx->deleteFromParent();
+}
+
 
 double TrackManager::getClipStartSeconds (int trackIndex, int clipIndex) const
 {
@@ -375,18 +492,59 @@ int TrackManager::getFxInsertBaseIndex (int trackIndex) const
     if (! t)
         return 0;
 
-    if (t->pluginList.size() == 0)
-        return 0;
+    const int slot = getInstrumentSlotIndex (trackIndex);
+
+    if (t->pluginList.size() <= slot)
+        return slot;
 
-    auto* p0 = t->pluginList[0];
+    auto* p0 = t->pluginList[slot];
 
     const bool isInstrument =
         dynamic_cast<MorphSynthPlugin*> (p0) != nullptr
         || dynamic_cast<te::FourOscPlugin*> (p0) != nullptr
         || (dynamic_cast<te::ExternalPlugin*> (p0) != nullptr
-            && static_cast<te::ExternalPlugin*> (p0)->isSynth());
+            && static_cast<te::ExternalPlugin*> (p0)->isSynth())
+        || (dynamic_cast<SandboxedPlugin*> (p0) != nullptr
+            && static_cast<SandboxedPlugin*> (p0)->isSynth());
 
     // Instrument at [0] ⇒ [1]=volume, [2]=meter, inserts start at [3]
     // No instrument     ⇒ [0]=volume, [1]=meter, inserts start at [2]
-    return isInstrument ? 3 : 2;
+    // A MIDI FX at [0] shifts everything up by one
+    return slot + (isInstrument ? 3 : 2);
+}
+
+void TrackManager::addMemoryUsage (MemoryReport& report) const
+{
+    auto audioTracks = te::getAudioTracks (edit);
+
+    for (int i = 0; i < (int) audioTracks.size(); ++i)
+    {
+        auto* track = audioTracks[i];
+        const auto trackName = juce::String (i + 1) + ": " + track->getName();
+
+        juce::int64 clipBytes = 0;
+        int numNotes = 0;
+        for (auto* clip : track->getClips())
+        {
+            clipBytes += MemoryAccounting::estimateValueTreeBytes (clip->state);
+            if (auto* midiClip = dynamic_cast<te::MidiClip*> (clip))
+                numNotes += midiClip->getSequence().getNumNotes();
+        }
+        report.add ("MIDI clips", trackName, clipBytes, numNotes);
+
+        if (i < (int) drumEngines.size() && drumEngines[(size_t) i] != nullptr)
+        {
+            const auto& drums = *drumEngines[(size_t) i];
+            const int numSounds = drums.getSampler() != nullptr ? drums.getSampler()->getNumSounds() : 0;
+            report.add ("Drum samplers", trackName, drums.getDecodedSampleBytes(), numSounds);
+        }
+
+        for (auto* plugin : track->pluginList)
+        {
+            if (auto* morph = dynamic_cast<MorphSynthPlugin*> (plugin))
+                report.add ("MorphSynth", trackName, morph->getMemoryUsageBytes());
+            else if (dynamic_cast<te::SamplerPlugin*> (plugin) == nullptr)
+                report.add ("Plugins", plugin->getPluginType(), MemoryAccounting::estimateValueTreeBytes (plugin->state));
+        }
+    }
 }
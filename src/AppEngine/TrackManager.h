@@ -3,17 +3,20 @@
 #include "../DrumSamplerEngine/DrumSamplerEngineAdapter.h"
 #include "../MIDIEngine/MIDIEngine.h"
 #include "../PluginManager/PluginManager.h"
+#include "MemoryAccounting.h"
 namespace te = tracktion::engine;
 
 class PluginManager;
+class MidiFxPlugin;
 
 /**
  * @brief Manages track lifecycle, type identification, and mute/solo state for drum and instrument tracks.
  *
  * TrackManager provides a specialized layer on top of Tracktion Engine's AudioTrack system,
- * distinguishing between two track types:
+ * distinguishing between three track types:
  *  - **Drum tracks**: Backed by DrumSamplerEngineAdapter, use `gk_isDrum` property
  *  - **Instrument tracks**: Standard MIDI tracks with plugin instruments
+ *  - **Audio tracks**: Hold audio clips (see AudioClipEngine), use `gk_isAudio` property
  *
  * Architecture:
  *  - Maintains parallel bookkeeping vectors (types[], drumEngines[]) indexed by track position
@@ -38,7 +41,7 @@ public:
     //==============================================================================
     // Type Definitions
 
-    enum class TrackType { Drum, Instrument };
+    enum class TrackType { Drum, Instrument, Audio };
 
     //==============================================================================
     // Construction / Destruction
@@ -90,6 +93,15 @@ public:
      */
     int addInstrumentTrack();
 
+    /**
+     * @brief Creates a new audio track for audio clips.
+     *
+     * Sets `gk_isAudio = true`. No instrument is inserted.
+     *
+     * @return Index of newly created audio track
+     */
+    int addAudioTrack();
+
     /**
      * @brief Creates a new generic track (deprecated, use typed methods).
      *
@@ -119,6 +131,14 @@ public:
      */
     bool isDrumTrack(int index) const;
 
+    /**
+     * @brief Checks if a track is an audio track.
+     *
+     * @param index Track index
+     * @return true if audio track, false otherwise or for an invalid index
+     */
+    bool isAudioTrack(int index) const;
+
     /**
      * @brief Returns the DrumSamplerEngineAdapter for a drum track.
      *
@@ -183,6 +203,39 @@ public:
      */
     bool anyTrackSoloed() const;
 
+    //==============================================================================
+    // Audio Recording
+
+    /**
+     * @brief Arms or disarms an audio track for audio recording.
+     *
+     * Any number of audio tracks can be armed; each records its own input when
+     * recording starts. Stored in the track's `gk_recordArmed` property, so it is
+     * saved with the Edit. Ignored for tracks that aren't audio tracks.
+     *
+     * @param index Track index
+     * @param armed true to arm, false to disarm
+     */
+    void setAudioTrackArmed(int index, bool armed);
+
+    /** Returns whether an audio track is armed for audio recording. */
+    bool isAudioTrackArmed(int index) const;
+
+    /** Returns whether any audio track is armed for audio recording. */
+    bool anyAudioTrackArmed() const;
+
+    /**
+     * @brief Chooses the device input a track records from (`gk_inputChannel`).
+     *
+     * @param index        Track index
+     * @param firstChannel First device input channel (0-based) of the track's pair,
+     *                     or -1 to take the next free pair when recording starts
+     */
+    void setAudioTrackInput(int index, int firstChannel);
+
+    /** The track's first input channel, or -1 if it takes the next free pair. */
+    int getAudioTrackInput(int index) const;
+
     //==============================================================================
     // Plugin / Instrument Access
 
@@ -231,6 +284,39 @@ public:
     void clearFxInsertSlot (int trackIndex, int slotIndex);
     int getFxInsertBaseIndex (int trackIndex) const;
 
+    //==============================================================================
+    // MIDI FX Slot
+
+    /**
+     * @brief Returns the track's MIDI effect (arpeggiator/chord/repeat), or nullptr.
+     *
+     * The MIDI FX slot is pluginList[0], ahead of the instrument, so MIDI reaches
+     * the instrument through it.
+     */
+    MidiFxPlugin* getMidiFxOnTrack (int trackIndex) const;
+
+    /** Adds a MIDI FX in front of the instrument (returns the existing one if present). */
+    MidiFxPlugin* insertMidiFx (int trackIndex);
+
+    /** Removes the track's MIDI FX, if any. */
+    void removeMidiFx (int trackIndex);
+
+    /** pluginList index of the instrument slot: 1 when a MIDI FX occupies slot 0, else 0. */
+    int getInstrumentSlotIndex (int trackIndex) const;
+
+    //==============================================================================
+    // Diagnostics
+
+    /**
+     * @brief Adds per-track memory estimates to a report.
+     *
+     * Reports, per track: MIDI clip state (ValueTree footprint, note count),
+     * decoded drum samples, MorphSynth instances and other plugin state.
+     *
+     * @param report Report to append to
+     */
+    void addMemoryUsage (MemoryReport& report) const;
+
 
 private:
     //==============================================================================
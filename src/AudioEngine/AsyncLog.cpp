@@ -0,0 +1,316 @@
+#include "AsyncLog.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+    // A plain pointer: a thread_local with a destructor would be registered with
+    // __cxa_thread_atexit on first use, which may allocate on the logging thread
+    thread_local void* threadRing = nullptr;
+
+    const char* levelPrefix (AsyncLog::Level level) noexcept
+    {
+        switch (level)
+        {
+            case AsyncLog::Level::warning:  return "WARNING: ";
+            case AsyncLog::Level::error:    return "ERROR: ";
+            case AsyncLog::Level::debug:
+            case AsyncLog::Level::info:
+            case AsyncLog::Level::off:
+            default:                        return "";
+        }
+    }
+}
+
+//==============================================================================
+// Line
+
+AsyncLog::Line::Line (Level level, const char* tag) noexcept
+{
+    record.ticks = juce::Time::getHighResolutionTicks();
+    record.level = level;
+
+    if (tag != nullptr)
+        for (int i = 0; i < maxTagLength - 1 && tag[i] != 0; ++i)
+            record.tag[i] = tag[i];
+}
+
+AsyncLog::Line::~Line()
+{
+    AsyncLog::getInstance().push (record);
+}
+
+void AsyncLog::Line::append (const char* text, size_t length) noexcept
+{
+    const auto space = (size_t) (maxTextLength - 1 - record.length);
+
+    if (length > space)
+    {
+        // Don't cut a UTF-8 sequence in half
+        length = space;
+        while (length > 0 && (text[length] & 0xc0) == 0x80)
+            --length;
+    }
+
+    std::memcpy (record.text + record.length, text, length);
+    record.length += (int) length;
+}
+
+AsyncLog::Line& AsyncLog::Line::operator<< (const char* text) noexcept
+{
+    if (text != nullptr)
+        append (text, std::strlen (text));
+
+    return *this;
+}
+
+AsyncLog::Line& AsyncLog::Line::operator<< (const juce::String& text) noexcept
+{
+    // JUCE stores Strings as UTF-8, so this is a pointer, not a conversion
+    append (text.toRawUTF8(), text.getNumBytesAsUTF8());
+    return *this;
+}
+
+AsyncLog::Line& AsyncLog::Line::operator<< (char c) noexcept
+{
+    append (&c, 1);
+    return *this;
+}
+
+AsyncLog::Line& AsyncLog::Line::operator<< (bool b) noexcept
+{
+    return *this << (b ? "true" : "false");
+}
+
+void AsyncLog::Line::appendInteger (juce::int64 n) noexcept
+{
+    char digits[24];
+    int pos = (int) sizeof (digits);
+
+    // Work with the magnitude as unsigned so INT64_MIN survives
+    const bool negative = n < 0;
+    auto magnitude = negative ? ~(juce::uint64) n + 1 : (juce::uint64) n;
+
+    do
+    {
+        digits[--pos] = (char) ('0' + (magnitude % 10));
+        magnitude /= 10;
+    }
+    while (magnitude != 0);
+
+    if (negative)
+        digits[--pos] = '-';
+
+    append (digits + pos, sizeof (digits) - (size_t) pos);
+}
+
+AsyncLog::Line& AsyncLog::Line::operator<< (Fixed f) noexcept
+{
+    if (std::isnan (f.value))
+        return *this << "nan";
+
+    if (std::isinf (f.value))
+        return *this << (f.value < 0 ? "-inf" : "inf");
+
+    static constexpr juce::int64 scales[] = { 1, 10, 100, 1000, 10000, 100000, 1000000 };
+    const int decimals = juce::jlimit (0, 6, f.decimals);
+    const auto scale = scales[decimals];
+
+    // Past this the integer part alone no longer fits
+    if (std::abs (f.value) >= 9.0e12)
+    {
+        appendInteger ((juce::int64) juce::jlimit (-9.0e18, 9.0e18, f.value));
+        return *this;
+    }
+
+    const auto scaled = (juce::int64) std::llround (std::abs (f.value) * (double) scale);
+
+    if (f.value < 0 && scaled != 0)
+        *this << '-';
+
+    appendInteger (scaled / scale);
+
+    if (decimals > 0)
+    {
+        char fraction[8];
+        auto rest = scaled % scale;
+
+        for (int i = decimals; --i >= 0;)
+        {
+            fraction[i] = (char) ('0' + (rest % 10));
+            rest /= 10;
+        }
+
+        *this << '.';
+        append (fraction, (size_t) decimals);
+    }
+
+    return *this;
+}
+
+//==============================================================================
+// AsyncLog
+
+AsyncLog& AsyncLog::getInstance()
+{
+    static AsyncLog instance;
+    return instance;
+}
+
+AsyncLog::AsyncLog()
+{
+    pending.reserve ((size_t) (maxThreads * ringSize));
+    drainThread = std::thread ([this] { run(); });
+}
+
+AsyncLog::~AsyncLog()
+{
+    shouldExit = true;
+
+    if (drainThread.joinable())
+        drainThread.join();
+
+    drain();
+}
+
+AsyncLog::Ring* AsyncLog::claimRing() noexcept
+{
+    for (auto& ring : rings)
+    {
+        bool expected = false;
+
+        if (ring.claimed.compare_exchange_strong (expected, true, std::memory_order_acquire))
+        {
+            threadRing = &ring;
+            return &ring;
+        }
+    }
+
+    return nullptr;
+}
+
+void AsyncLog::attachThread() noexcept
+{
+    if (threadRing == nullptr)
+        getInstance().claimRing();
+}
+
+void AsyncLog::detachThread() noexcept
+{
+    if (auto* ring = static_cast<Ring*> (threadRing))
+    {
+        threadRing = nullptr;
+
+        // Lines still in the ring are drained as usual; the next owner appends after them
+        ring->claimed.store (false, std::memory_order_release);
+    }
+}
+
+void AsyncLog::push (const Record& record) noexcept
+{
+    auto* ring = static_cast<Ring*> (threadRing);
+
+    if (ring == nullptr)
+        ring = claimRing();
+
+    if (ring == nullptr)
+    {
+        dropped.fetch_add (1, std::memory_order_relaxed);
+        return;
+    }
+
+    const auto scope = ring->fifo.write (1);
+
+    if (scope.blockSize1 == 0)
+    {
+        dropped.fetch_add (1, std::memory_order_relaxed);
+        return;
+    }
+
+    ring->records[(size_t) scope.startIndex1] = record;
+}
+
+void AsyncLog::drain()
+{
+    const std::lock_guard<std::mutex> sl (drainLock);
+
+    pending.clear();
+
+    for (auto& ring : rings)
+    {
+        const auto scope = ring.fifo.read (ring.fifo.getNumReady());
+
+        for (int i = 0; i < scope.blockSize1; ++i)
+            pending.push_back (ring.records[(size_t) (scope.startIndex1 + i)]);
+
+        for (int i = 0; i < scope.blockSize2; ++i)
+            pending.push_back (ring.records[(size_t) (scope.startIndex2 + i)]);
+    }
+
+    if (pending.empty())
+        return;
+
+    std::stable_sort (pending.begin(), pending.end(),
+                      [] (const Record& a, const Record& b) { return a.ticks < b.ticks; });
+
+    for (const auto& r : pending)
+    {
+        const auto line = format (r);
+
+        if (sink)
+            sink (line);
+        else
+            juce::Logger::writeToLog (line);
+    }
+
+    written.fetch_add (pending.size(), std::memory_order_relaxed);
+}
+
+void AsyncLog::run()
+{
+    while (! shouldExit.load())
+    {
+        drain();
+        std::this_thread::sleep_for (std::chrono::milliseconds (drainIntervalMs));
+    }
+}
+
+void AsyncLog::flush()
+{
+    drain();
+}
+
+void AsyncLog::setSink (std::function<void (const juce::String&)> newSink)
+{
+    const std::lock_guard<std::mutex> sl (drainLock);
+    sink = std::move (newSink);
+}
+
+juce::String AsyncLog::format (const Record& record)
+{
+    juce::String line;
+    line.preallocateBytes ((size_t) (maxTagLength + record.length + 16));
+
+    if (record.tag[0] != 0)
+        line << "[" << record.tag << "] ";
+
+    line << levelPrefix (record.level)
+         << juce::String::fromUTF8 (record.text, record.length);
+
+    return line;
+}
+
+AsyncLog::Stats AsyncLog::getStats() const noexcept
+{
+    Stats s;
+    s.written = written.load();
+    s.dropped = dropped.load();
+
+    for (auto& ring : rings)
+        if (ring.claimed.load())
+            ++s.threads;
+
+    return s;
+}
@@ -0,0 +1,213 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <array>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+//==============================================================================
+/**
+ * Lowest level compiled into the binary: 0 debug, 1 info, 2 warning, 3 error.
+ * Anything below it disappears at compile time, arguments included.
+ */
+#ifndef GROOVEKIT_LOG_MIN_LEVEL
+ #if JUCE_DEBUG
+  #define GROOVEKIT_LOG_MIN_LEVEL 0
+ #else
+  #define GROOVEKIT_LOG_MIN_LEVEL 1
+ #endif
+#endif
+
+/**
+ * Logs one line without blocking, e.g.
+ *     GROOVEKIT_LOG (debug, "MidiRecorder", "NOTE ON: Note=" << note << " Velocity=" << AsyncLog::fixed (v, 2));
+ *
+ * The line is formatted into a fixed-size record on the caller's stack and pushed
+ * onto the calling thread's ring; nothing allocates, locks or touches the disk.
+ * Lines below the runtime level (AsyncLog::setLevel) cost one atomic load.
+ */
+#define GROOVEKIT_LOG(level, tag, expression) \
+    do { \
+        if constexpr ((int) AsyncLog::Level::level >= GROOVEKIT_LOG_MIN_LEVEL) \
+            if (AsyncLog::isEnabled (AsyncLog::Level::level)) \
+                AsyncLog::Line (AsyncLog::Level::level, tag) << expression; \
+    } while (false)
+
+//==============================================================================
+/**
+ * @brief Non-blocking log backend for the audio, MIDI and recording paths.
+ *
+ * juce::Logger::writeToLog builds Strings and, with a FileLogger installed, writes
+ * to disk on the calling thread, which is not something a MIDI callback or the
+ * audio thread can afford. Here each thread that logs owns one of maxThreads
+ * single-producer rings. A line is preformatted into a Record on the caller's
+ * stack and copied into that ring.
+ *
+ * A thread gets its ring from attachThread(), called from its non-real-time setup,
+ * and gives it back with detachThread() before it ends (ThreadScope does both for
+ * threads GrooveKit starts). A thread that logs without attaching claims a ring on
+ * its first line, which costs a few atomic operations but never allocates, and
+ * keeps it until it detaches: nothing runs when a thread ends.
+ *
+ * A background thread drains every ring drainIntervalMs, merges the records in
+ * timestamp order and hands them to the sink (juce::Logger::writeToLog unless
+ * setSink() says otherwise). When a ring is full the line is dropped and counted,
+ * never waited for.
+ *
+ * Thread safety: push() and Line are real-time safe from any thread; setSink()
+ * and flush() may be called from any non-real-time thread.
+ */
+class AsyncLog
+{
+public:
+    enum class Level : int
+    {
+        debug = 0,
+        info,
+        warning,
+        error,
+        off
+    };
+
+    static constexpr int maxThreads      = 16;
+    static constexpr int ringSize        = 128;     ///< Records per thread (one slot stays empty)
+    static constexpr int maxTagLength    = 24;
+    static constexpr int maxTextLength   = 216;
+    static constexpr int drainIntervalMs = 20;
+
+    /** One preformatted line. */
+    struct Record
+    {
+        juce::int64 ticks = 0;                  ///< juce::Time::getHighResolutionTicks()
+        Level level = Level::info;
+        int length = 0;
+        char tag[maxTagLength] {};
+        char text[maxTextLength] {};
+    };
+
+    /** A value written with a fixed number of decimals (see Line). */
+    struct Fixed
+    {
+        double value;
+        int decimals;
+    };
+
+    static Fixed fixed (double value, int decimals) noexcept      { return { value, decimals }; }
+
+    //==============================================================================
+    /**
+     * Builds a record with operator<< and pushes it when destroyed. Text past
+     * maxTextLength is cut off. Use through GROOVEKIT_LOG.
+     */
+    class Line
+    {
+    public:
+        Line (Level level, const char* tag) noexcept;
+        ~Line();
+
+        Line& operator<< (const char* text) noexcept;
+        Line& operator<< (const juce::String& text) noexcept;
+        Line& operator<< (char c) noexcept;
+        Line& operator<< (bool b) noexcept;
+        Line& operator<< (float f) noexcept                 { return *this << fixed (f, 3); }
+        Line& operator<< (double d) noexcept                { return *this << fixed (d, 3); }
+        Line& operator<< (Fixed f) noexcept;
+
+        /** Any other integer type (int, size_t, juce::int64...). */
+        template <typename Integer,
+                  std::enable_if_t<std::is_integral_v<Integer> && ! std::is_same_v<Integer, bool>
+                                     && ! std::is_same_v<Integer, char>, int> = 0>
+        Line& operator<< (Integer n) noexcept
+        {
+            appendInteger ((juce::int64) n);
+            return *this;
+        }
+
+    private:
+        void append (const char* text, size_t length) noexcept;
+        void appendInteger (juce::int64 n) noexcept;
+
+        Record record;
+
+        JUCE_DECLARE_NON_COPYABLE (Line)
+    };
+
+    //==============================================================================
+    /** Created on first use, which starts a thread: call it once at startup, off the real-time threads. */
+    static AsyncLog& getInstance();
+
+    static void setLevel (Level newLevel) noexcept          { runtimeLevel.store ((int) newLevel, std::memory_order_relaxed); }
+    static Level getLevel() noexcept                        { return (Level) runtimeLevel.load (std::memory_order_relaxed); }
+    static bool isEnabled (Level level) noexcept            { return (int) level >= runtimeLevel.load (std::memory_order_relaxed); }
+
+    /** Copies @p record into the calling thread's ring. Never blocks. */
+    void push (const Record& record) noexcept;
+
+    /** Claims a ring for the calling thread now, so its first line doesn't have to. */
+    static void attachThread() noexcept;
+
+    /** Gives the calling thread's ring back; call before the thread ends. Lines already pushed are kept. */
+    static void detachThread() noexcept;
+
+    /** Attaches the calling thread for as long as it lives. */
+    struct ThreadScope
+    {
+        ThreadScope() noexcept      { attachThread(); }
+        ~ThreadScope()              { detachThread(); }
+
+        JUCE_DECLARE_NON_COPYABLE (ThreadScope)
+    };
+
+    /** Writes out everything pushed so far before returning. */
+    void flush();
+
+    /** Receives each formatted line on the drain thread. Pass nullptr for juce::Logger. */
+    void setSink (std::function<void (const juce::String&)> newSink);
+
+    struct Stats
+    {
+        juce::uint64 written = 0;
+        juce::uint64 dropped = 0;               ///< Ring full, or more than maxThreads threads logging
+        int threads = 0;                        ///< Rings currently claimed
+    };
+
+    Stats getStats() const noexcept;
+
+    ~AsyncLog();
+
+private:
+    AsyncLog();
+
+    struct Ring
+    {
+        std::atomic<bool> claimed { false };
+        juce::AbstractFifo fifo { ringSize };
+        std::array<Record, ringSize> records;
+    };
+
+    Ring* claimRing() noexcept;
+    void drain();
+    void run();
+
+    static juce::String format (const Record& record);
+
+    inline static std::atomic<int> runtimeLevel { GROOVEKIT_LOG_MIN_LEVEL };
+
+    std::array<Ring, maxThreads> rings;
+    std::atomic<juce::uint64> written { 0 }, dropped { 0 };
+
+    std::mutex drainLock;                       ///< One drain at a time (drain thread or flush())
+    std::function<void (const juce::String&)> sink;
+    std::vector<Record> pending;
+
+    // A std::thread rather than juce::Thread: this object lives until static
+    // destruction, after JUCE's leak checks have run
+    std::atomic<bool> shouldExit { false };
+    std::thread drainThread;
+
+    JUCE_DECLARE_NON_COPYABLE (AsyncLog)
+};
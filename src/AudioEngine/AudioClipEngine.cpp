@@ -0,0 +1,90 @@
+#include "AudioClipEngine.h"
+
+#include <cmath>
+
+AudioClipEngine::AudioClipEngine (te::Edit& editRef)
+    : edit (editRef)
+{
+}
+
+//==============================================================================
+// Audio Clip Creation
+
+te::WaveAudioClip* AudioClipEngine::insertAudioClip (int trackIndex, const juce::File& file, t::TimePosition start)
+{
+    auto audioTracks = te::getAudioTracks (edit);
+    if (trackIndex < 0 || trackIndex >= (int) audioTracks.size() || ! canImport (file))
+        return nullptr;
+
+    const te::AudioFile audioFile (edit.engine, file);
+    if (! audioFile.isValid())
+        return nullptr;
+
+    auto* track = audioTracks[(size_t) trackIndex];
+    const auto length = t::TimeDuration::fromSeconds (audioFile.getLength());
+
+    auto clip = track->insertWaveClip (file.getFileNameWithoutExtension(), file,
+                                       { { start, start + length }, t::TimeDuration() },
+                                       false);
+
+    if (clip == nullptr)
+        return nullptr;
+
+    // Loops carry their tempo; follow the Edit straight away so they land on the grid
+    if (getSourceBpm (*clip) > 0.0)
+        setWarpToTempo (*clip, true);
+
+    return clip.get();
+}
+
+//==============================================================================
+// Audio Clip Retrieval
+
+juce::Array<te::WaveAudioClip*> AudioClipEngine::getAudioClipsFromTrack (int trackIndex)
+{
+    juce::Array<te::WaveAudioClip*> audioClips;
+
+    auto audioTracks = te::getAudioTracks (edit);
+    if (trackIndex < 0 || trackIndex >= (int) audioTracks.size())
+        return audioClips;
+
+    for (auto* c : audioTracks[(size_t) trackIndex]->getClips())
+        if (auto* wc = dynamic_cast<te::WaveAudioClip*> (c))
+            audioClips.add (wc);
+
+    return audioClips;
+}
+
+//==============================================================================
+// Warp-to-tempo
+
+bool AudioClipEngine::setWarpToTempo (te::WaveAudioClip& clip, bool shouldWarp)
+{
+    if (shouldWarp && getSourceBpm (clip) <= 0.0)
+        return false;
+
+    if (shouldWarp)
+    {
+        // Best stretcher this build has; rendered into a proxy on Tracktion's
+        // background thread, never on the audio thread.
+        clip.setTimeStretchMode (te::TimeStretcher::defaultMode);
+        clip.setUsesProxy (true);
+    }
+
+    clip.setAutoTempo (shouldWarp);
+    return true;
+}
+
+double AudioClipEngine::getSourceBpm (te::WaveAudioClip& clip)
+{
+    const auto info = clip.getAudioFile().getInfo();
+    const double bpm = clip.getLoopInfo().getBpm (info);
+
+    return (std::isfinite (bpm) && bpm > 0.0) ? bpm : 0.0;
+}
+
+bool AudioClipEngine::canImport (const juce::File& file) const
+{
+    return file.existsAsFile()
+        && edit.engine.getAudioFileFormatManager().readFormatManager.findFormatForFileExtension (file.getFileExtension()) != nullptr;
+}
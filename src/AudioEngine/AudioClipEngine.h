@@ -0,0 +1,99 @@
+#pragma once
+
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <tracktion_engine/tracktion_engine.h>
+
+namespace te = tracktion::engine;
+namespace t = tracktion;
+
+/**
+ * @brief Audio clip creation, retrieval and warp-to-tempo for audio tracks.
+ *
+ * The audio counterpart of MIDIEngine. Audio clips are Tracktion WaveAudioClips
+ * that reference the source file on disk (nothing is copied or decoded up front).
+ *
+ * Warp-to-tempo:
+ *  - A clip whose file carries tempo metadata (ACID/Apple loop info) can follow
+ *    the Edit's tempo map. Tracktion's auto-tempo does the beat mapping.
+ *  - Clips are set to use proxies: the stretched audio is rendered on Tracktion's
+ *    background render thread and the playback graph streams the result through
+ *    its read-ahead file cache. The audio thread never runs the time-stretcher.
+ *  - Proxy files are keyed on the clip's source, stretch settings and tempo, so a
+ *    tempo that has been heard before re-uses its render, and an edit that goes
+ *    back to an earlier tempo doesn't render again.
+ *
+ * Architecture:
+ *  - Owned by AppEngine, one per Edit (recreated with the Edit, like MIDIEngine)
+ *  - Operates on the same te::AudioTrack list as TrackManager (track indices match)
+ *
+ * Usage:
+ *  - insertAudioClip() to drop a file on a track
+ *  - getAudioClipsFromTrack() for layout/drawing
+ *  - setWarpToTempo() to toggle warping on a clip
+ */
+class AudioClipEngine
+{
+public:
+    //==============================================================================
+    // Construction / Destruction
+
+    /**
+     * @brief Constructs the AudioClipEngine.
+     *
+     * @param editRef Reference to Tracktion Edit for clip operations
+     */
+    explicit AudioClipEngine (te::Edit& editRef);
+
+    /** Default destructor. */
+    ~AudioClipEngine() = default;
+
+    //==============================================================================
+    // Audio Clip Creation
+
+    /**
+     * @brief Places an audio file on a track.
+     *
+     * The clip covers the whole file. If the file has a tempo in its metadata the
+     * clip is warped to the Edit's tempo straight away.
+     *
+     * @param trackIndex Index of track to add clip to (0-based)
+     * @param file       Audio file (any format the engine can read)
+     * @param start      Clip start position in the Edit
+     * @return The new clip, or nullptr if the track index or file is invalid
+     */
+    te::WaveAudioClip* insertAudioClip (int trackIndex, const juce::File& file, t::TimePosition start);
+
+    //==============================================================================
+    // Audio Clip Retrieval
+
+    /**
+     * @brief Returns all audio clips on the given track.
+     *
+     * @param trackIndex Index of track to query
+     * @return Array of WaveAudioClip pointers (empty if none)
+     */
+    juce::Array<te::WaveAudioClip*> getAudioClipsFromTrack (int trackIndex);
+
+    //==============================================================================
+    // Warp-to-tempo
+
+    /**
+     * @brief Turns tempo following on or off for a clip.
+     *
+     * @param clip       Clip to change
+     * @param shouldWarp True to follow the Edit's tempo map
+     * @return false if warping was requested but the file has no known tempo
+     */
+    bool setWarpToTempo (te::WaveAudioClip& clip, bool shouldWarp);
+
+    /** Tempo stored in the clip's source file, or 0 if the file doesn't say. */
+    static double getSourceBpm (te::WaveAudioClip& clip);
+
+    /** True if @p file has an extension the engine can decode. */
+    bool canImport (const juce::File& file) const;
+
+private:
+    te::Edit& edit; ///< Reference to Tracktion Edit (not owned)
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioClipEngine)
+};
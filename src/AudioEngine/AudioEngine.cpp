@@ -1,4 +1,5 @@
 #include "AudioEngine.h"
+#include "AsyncLog.h"
 #include "../UI/Plugins/Synthesizer/MorphSynthPlugin.h"
 using namespace juce;
 
@@ -13,7 +14,6 @@ using namespace t::literals;
 AudioEngine::AudioEngine(te::Edit& editRef, te::Engine& engine)
     : edit(editRef), engine(engine)
 {
-    midiEngine = std::make_unique<MIDIEngine>(edit);
 }
 
 AudioEngine::~AudioEngine() = default;
@@ -60,6 +60,8 @@ void AudioEngine::initialiseDefaults (double sampleRate, int bufferSize)
     AudioDeviceManager::AudioDeviceSetup setup;
     dm.getAudioDeviceSetup (setup);
 
+    // No input until an audio track is armed (setInputEnabled), so launching
+    // doesn't trigger the OS microphone permission prompt
     setup.inputDeviceName.clear();
     setup.useDefaultInputChannels  = false;
     setup.useDefaultOutputChannels = true;
@@ -93,7 +95,7 @@ bool AudioEngine::setOutputDeviceByName (const String& deviceName)
     auto outs = type->getDeviceNames (false);
     if (! outs.contains (deviceName))
     {
-        Logger::writeToLog ("[Audio] Device not found: " + deviceName);
+        GROOVEKIT_LOG (warning, "Audio", "Device not found: " << deviceName);
         return false;
     }
 
@@ -101,9 +103,7 @@ bool AudioEngine::setOutputDeviceByName (const String& deviceName)
     dm.getAudioDeviceSetup (setup);
 
     setup.outputDeviceName          = deviceName;
-    setup.inputDeviceName           = {};
-    setup.useDefaultInputChannels   = false;
-    setup.useDefaultOutputChannels  = true;
+    setup.useDefaultOutputChannels  = true;   // inputs stay as setInputEnabled() left them
 
     if (setup.sampleRate == 0) setup.sampleRate = 48000.0;
     if (setup.bufferSize  == 0) setup.bufferSize  = 512;
@@ -124,6 +124,44 @@ bool AudioEngine::setDefaultOutputDevice()
     return applySetup (setup);
 }
 
+bool AudioEngine::setInputEnabled (bool shouldBeEnabled)
+{
+    auto& dm = adm();
+
+    AudioDeviceManager::AudioDeviceSetup setup;
+    dm.getAudioDeviceSetup (setup);
+
+    if (shouldBeEnabled == setup.inputDeviceName.isNotEmpty())
+        return true;
+
+    setup.useDefaultInputChannels = false;
+    setup.inputChannels.clear();
+
+    if (shouldBeEnabled)
+    {
+        if (auto* type = dm.getCurrentDeviceTypeObject())
+            setup.inputDeviceName = type->getDeviceNames (true)[type->getDefaultDeviceIndex (true)];
+
+        // Every input, not just the default pair: each armed track records its own.
+        // Devices ignore the channels they don't have.
+        setup.inputChannels.setRange (0, maxInputChannels, true);
+    }
+    else
+    {
+        setup.inputDeviceName.clear();
+    }
+
+    GROOVEKIT_LOG (info, "Audio", "Audio input: " << (shouldBeEnabled ? setup.inputDeviceName : String ("closed")));
+    return applySetup (setup);
+}
+
+bool AudioEngine::isInputEnabled() const
+{
+    if (auto* device = adm().getCurrentAudioDevice())
+        return device->getActiveInputChannels().countNumberOfSetBits() > 0;
+    return false;
+}
+
 String AudioEngine::getCurrentOutputDeviceName() const
 {
     auto& dm = const_cast<AudioEngine*>(this)->adm();
@@ -197,11 +235,11 @@ bool AudioEngine::applySetup (const AudioDeviceManager::AudioDeviceSetup& newSet
     auto err = dm.setAudioDeviceSetup (newSetup, true);
     if (err.isNotEmpty())
     {
-        Logger::writeToLog ("[Audio] setAudioDeviceSetup error: " + err);
+        GROOVEKIT_LOG (warning, "Audio", "setAudioDeviceSetup error: " << err);
         return false;
     }
 
-    Logger::writeToLog ("[Audio] Output now: " + getCurrentOutputDeviceName());
+    GROOVEKIT_LOG (info, "Audio", "Output now: " << getCurrentOutputDeviceName());
 
     return true;
 }
@@ -224,19 +262,19 @@ void AudioEngine::logAvailableMidiDevices() const
 {
     auto devices = juce::MidiInput::getAvailableDevices();
 
-    Logger::writeToLog ("[MIDI] Available MIDI Input Devices:");
+    GROOVEKIT_LOG (info, "MIDI", "Available MIDI Input Devices:");
 
     if (devices.isEmpty())
     {
-        Logger::writeToLog ("[MIDI]   No MIDI input devices found");
+        GROOVEKIT_LOG (info, "MIDI", "  No MIDI input devices found");
     }
     else
     {
         for (int i = 0; i < devices.size(); ++i)
         {
             const auto& device = devices[i];
-            Logger::writeToLog ("[MIDI]   [" + String(i) + "] " + device.name +
-                              " (ID: " + device.identifier + ")");
+            GROOVEKIT_LOG (info, "MIDI", "  [" << i << "] " << device.name << " (ID: "
+                                         << device.identifier << ")");
         }
     }
 }
@@ -263,7 +301,7 @@ void AudioEngine::setupMidiInputDevices(te::Edit& editToSetup)
         // Instead, we'll add logging at the Tracktion InputDevice level.
     }
 
-    Logger::writeToLog("[MIDI] Enabled all MIDI input devices via Tracktion InputDevice system");
+    GROOVEKIT_LOG (info, "MIDI", "Enabled all MIDI input devices via Tracktion InputDevice system");
 }
 
 void AudioEngine::setMidiEventLoggingEnabled(bool enable)
@@ -272,12 +310,12 @@ void AudioEngine::setMidiEventLoggingEnabled(bool enable)
 
     if (enable)
     {
-        Logger::writeToLog("[MIDI EVENT LOGGING] ========================================");
-        Logger::writeToLog("[MIDI EVENT LOGGING] ENABLED - will log InputDevice state");
-        Logger::writeToLog("[MIDI EVENT LOGGING] ========================================");
+        GROOVEKIT_LOG (info, "MIDI EVENT LOGGING", "========================================");
+        GROOVEKIT_LOG (info, "MIDI EVENT LOGGING", "ENABLED - will log InputDevice state");
+        GROOVEKIT_LOG (info, "MIDI EVENT LOGGING", "========================================");
 
         // Log current state of all MIDI input device instances
-        Logger::writeToLog("[MIDI EVENT LOGGING] Current MIDI Input Device States:");
+        GROOVEKIT_LOG (info, "MIDI EVENT LOGGING", "Current MIDI Input Device States:");
         for (auto* instance : edit.getAllInputDevices())
         {
             auto& device = instance->getInputDevice();
@@ -285,21 +323,19 @@ void AudioEngine::setMidiEventLoggingEnabled(bool enable)
             if (device.getDeviceType() != te::InputDevice::physicalMidiDevice)
                 continue;
 
-            Logger::writeToLog("[MIDI EVENT LOGGING]   Device: " + device.getName());
-            Logger::writeToLog("[MIDI EVENT LOGGING]     Enabled: " +
-                             String(device.isEnabled() ? "YES" : "NO"));
+            GROOVEKIT_LOG (info, "MIDI EVENT LOGGING", "  Device: " << device.getName());
+            GROOVEKIT_LOG (info, "MIDI EVENT LOGGING", "    Enabled: " << (device.isEnabled() ? "YES" : "NO"));
 
             auto monitorMode = device.getMonitorMode();
             String modeName = (monitorMode == te::InputDevice::MonitorMode::on) ? "ON" :
                             (monitorMode == te::InputDevice::MonitorMode::off) ? "OFF" : "AUTOMATIC";
-            Logger::writeToLog("[MIDI EVENT LOGGING]     Monitor Mode: " + modeName);
+            GROOVEKIT_LOG (info, "MIDI EVENT LOGGING", "    Monitor Mode: " << modeName);
 
             // Check which tracks this device instance is targeting
             auto targetIDs = instance->getTargets();
             if (targetIDs.size() > 0)
             {
-                Logger::writeToLog("[MIDI EVENT LOGGING]     Targeting " +
-                                 String(targetIDs.size()) + " track(s):");
+                GROOVEKIT_LOG (info, "MIDI EVENT LOGGING", "    Targeting " << targetIDs.size() << " track(s):");
 
                 // Find track names
                 auto tracks = te::getAudioTracks(edit);
@@ -309,10 +345,11 @@ void AudioEngine::setMidiEventLoggingEnabled(bool enable)
                     {
                         if (track->itemID == targetID)
                         {
-                            Logger::writeToLog("[MIDI EVENT LOGGING]       - Track: " + track->getName() +
-                                             " (ID: " + targetID.toString() + ")");
-                            Logger::writeToLog("[MIDI EVENT LOGGING]         Recording Enabled: " +
-                                             String(instance->isRecordingEnabled(targetID) ? "YES" : "NO"));
+                            GROOVEKIT_LOG (info, "MIDI EVENT LOGGING", "      - Track: "
+                                                                       << track->getName() << " (ID: "
+                                                                       << targetID.toString() << ")");
+                            GROOVEKIT_LOG (info, "MIDI EVENT LOGGING", "        Recording Enabled: "
+                                                                       << (instance->isRecordingEnabled(targetID) ? "YES" : "NO"));
                         }
                     }
                 }
@@ -321,24 +358,25 @@ void AudioEngine::setMidiEventLoggingEnabled(bool enable)
     }
     else
     {
-        Logger::writeToLog("[MIDI EVENT LOGGING] DISABLED");
+        GROOVEKIT_LOG (info, "MIDI EVENT LOGGING", "DISABLED");
     }
 }
 
 void AudioEngine::routeMidiToTrack(te::Edit& editToRoute, int trackIndex)
 {
-    Logger::writeToLog("[DEBUG] ========== routeMidiToTrack CALLED ==========");
-    Logger::writeToLog("[DEBUG] Target track index: " + String(trackIndex));
+    GROOVEKIT_LOG (debug, "MIDI", "========== routeMidiToTrack CALLED ==========");
+    GROOVEKIT_LOG (debug, "MIDI", "Target track index: " << trackIndex);
 
     auto tracks = te::getAudioTracks(editToRoute);
     if (trackIndex < 0 || trackIndex >= tracks.size())
     {
-        Logger::writeToLog("[MIDI] Invalid track index for routing: " + String(trackIndex));
+        GROOVEKIT_LOG (warning, "MIDI", "Invalid track index for routing: " << trackIndex);
         return;
     }
 
     auto* track = tracks[trackIndex];
-    Logger::writeToLog("[DEBUG] Target track: " + track->getName() + " (itemID: " + track->itemID.toString() + ")");
+    GROOVEKIT_LOG (debug, "MIDI", "Target track: " << track->getName() << " (itemID: "
+                                  << track->itemID.toString() << ")");
 
     // Route all MIDI input devices to this track and pre-arm for recording
     // Following Tracktion's MidiRecordingDemo pattern: set target + enable recording at arm time
@@ -349,11 +387,11 @@ void AudioEngine::routeMidiToTrack(te::Edit& editToRoute, int trackIndex)
         {
             deviceCount++;
             auto& device = instance->getInputDevice();
-            Logger::writeToLog("[DEBUG] Processing MIDI device: " + device.getName());
+            GROOVEKIT_LOG (debug, "MIDI", "Processing MIDI device: " << device.getName());
 
             // Set target track with undo manager for proper state tracking
             auto res = instance->setTarget(track->itemID, true, &editToRoute.getUndoManager(), 0);
-            Logger::writeToLog("[DEBUG]   setTarget() returned: " + String(res ? "TRUE" : "FALSE"));
+            GROOVEKIT_LOG (debug, "MIDI", "  setTarget() returned: " << (res ? "TRUE" : "FALSE"));
 
             // Pre-arm track for recording (following Tracktion demo pattern)
             // This prepares the track to capture MIDI when transport.record() is called
@@ -361,13 +399,13 @@ void AudioEngine::routeMidiToTrack(te::Edit& editToRoute, int trackIndex)
 
             // Verify it was actually set
             bool isEnabled = instance->isRecordingEnabled(track->itemID);
-            Logger::writeToLog("[DEBUG]   setRecordingEnabled() verification: " +
-                             String(isEnabled ? "ENABLED" : "NOT ENABLED"));
+            GROOVEKIT_LOG (debug, "MIDI", "  setRecordingEnabled() verification: "
+                                          << (isEnabled ? "ENABLED" : "NOT ENABLED"));
         }
     }
 
-    Logger::writeToLog("[DEBUG] Processed " + String(deviceCount) + " MIDI input devices");
-    Logger::writeToLog("[DEBUG] ========== routeMidiToTrack END ==========");
+    GROOVEKIT_LOG (debug, "MIDI", "Processed " << deviceCount << " MIDI input devices");
+    GROOVEKIT_LOG (debug, "MIDI", "========== routeMidiToTrack END ==========");
 
     // NOTE: We do NOT call restartPlayback() here (unlike previous implementation).
     // Tracktion's MidiRecordingDemo only calls restartPlayback() during initial setup,
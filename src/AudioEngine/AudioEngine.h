@@ -1,5 +1,6 @@
 #pragma once
 #include "../MIDIEngine/MIDIEngine.h"
+#include "AsyncLog.h"
 #include <juce_audio_devices/juce_audio_devices.h>
 #include <tracktion_engine/tracktion_engine.h>
 
@@ -85,6 +86,21 @@ public:
      */
     bool setDefaultOutputDevice();
 
+    /**
+     * @brief Opens or closes the audio input device used for recording.
+     *
+     * Inputs stay closed until an audio track is armed, so the app doesn't ask
+     * for microphone access at launch. When open, every input channel of the
+     * default input device is enabled.
+     *
+     * @param shouldBeEnabled true to open the default input device, false to close it.
+     * @return True if the device accepted the new setup (or nothing had to change).
+     */
+    bool setInputEnabled (bool shouldBeEnabled);
+
+    /** Returns whether the current device has any input channels open. */
+    bool isInputEnabled() const;
+
     /**
      * @brief Returns the name of the currently active output device.
      *
@@ -103,6 +119,7 @@ public:
      * @brief Initializes the audio device manager with default settings.
      *
      * Sets up CoreAudio (macOS) with the specified sample rate and buffer size.
+     * Inputs are left closed; see setInputEnabled().
      * Logs available MIDI input devices on startup.
      *
      * @param sampleRate Target sample rate (default: 48000 Hz).
@@ -212,6 +229,9 @@ public:
     void logAvailableMidiDevices() const;
 
 private:
+    /** Channels requested when opening "every" input (more than any interface has). */
+    static constexpr int maxInputChannels = 64;
+
     //==============================================================================
     // Internal Methods
 
@@ -237,7 +257,8 @@ private:
      * @brief MIDI event logger for debugging recording issues.
      *
      * Attached to the engine's MIDI device manager to intercept and log all
-     * incoming MIDI messages during recording sessions.
+     * incoming MIDI messages during recording sessions. Runs on the MIDI thread,
+     * so lines go through AsyncLog and getDescription() (which allocates) is avoided.
      */
     class MidiEventLogger : public juce::MidiInputCallback
     {
@@ -248,28 +269,25 @@ private:
                                        const juce::MidiMessage& message) override
         {
             juce::ignoreUnused (source);
-            if (!enabled)
+            if (!enabled || ! AsyncLog::isEnabled (AsyncLog::Level::info))
                 return;
 
-            juce::String desc;
+            AsyncLog::Line line (AsyncLog::Level::info, "MIDI EVENT");
 
             if (message.isNoteOn())
-                desc = "NOTE ON:  Note=" + juce::String(message.getNoteNumber()) +
-                       " Velocity=" + juce::String(message.getVelocity());
+                line << "NOTE ON:  Note=" << message.getNoteNumber() << " Velocity=" << (int) message.getVelocity();
             else if (message.isNoteOff())
-                desc = "NOTE OFF: Note=" + juce::String(message.getNoteNumber()) +
-                       " Velocity=" + juce::String(message.getVelocity());
+                line << "NOTE OFF: Note=" << message.getNoteNumber() << " Velocity=" << (int) message.getVelocity();
             else if (message.isController())
-                desc = "CC:       Controller=" + juce::String(message.getControllerNumber()) +
-                       " Value=" + juce::String(message.getControllerValue());
+                line << "CC:       Controller=" << message.getControllerNumber()
+                     << " Value=" << message.getControllerValue();
             else if (message.isPitchWheel())
-                desc = "PITCH BEND: " + juce::String(message.getPitchWheelValue());
+                line << "PITCH BEND: " << message.getPitchWheelValue();
             else
-                desc = message.getDescription();
+                line << "Status=" << (int) message.getRawData()[0] << " Size=" << message.getRawDataSize();
 
-            juce::Logger::writeToLog("[MIDI EVENT] " + desc +
-                                    " | Time=" + juce::String(message.getTimeStamp(), 3) + "s" +
-                                    " | Channel=" + juce::String(message.getChannel()));
+            line << " | Time=" << AsyncLog::fixed (message.getTimeStamp(), 3) << "s"
+                 << " | Channel=" << message.getChannel();
         }
 
         void setEnabled(bool shouldEnable) { enabled = shouldEnable; }
@@ -282,7 +300,6 @@ private:
     // Member Variables
 
     te::Edit& edit;                            ///< Reference to the Tracktion Edit (not owned).
-    std::unique_ptr<MIDIEngine> midiEngine;    ///< MIDI clip management engine.
     te::Engine& engine;                        ///< Reference to the Tracktion Engine (not owned).
     MidiEventLogger midiEventLogger;           ///< MIDI event logger for debugging.
 };
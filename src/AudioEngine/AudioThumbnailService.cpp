@@ -0,0 +1,56 @@
+#include "AudioThumbnailService.h"
+
+namespace
+{
+    /** Thumbnails kept in memory; older ones fall back to the disk cache. */
+    constexpr int maxThumbsInMemory = 128;
+}
+
+//==============================================================================
+AudioThumbnailService::DiskCache::DiskCache (const juce::File& dir)
+    : juce::AudioThumbnailCache (maxThumbsInMemory),
+      directory (dir)
+{
+    directory.createDirectory();
+}
+
+juce::File AudioThumbnailService::DiskCache::fileForHash (juce::int64 hashCode) const
+{
+    return directory.getChildFile (juce::String::toHexString (hashCode) + ".gkthumb");
+}
+
+void AudioThumbnailService::DiskCache::saveNewlyFinishedThumbnail (const juce::AudioThumbnailBase& thumb, juce::int64 hashCode)
+{
+    juce::FileOutputStream out (fileForHash (hashCode));
+
+    if (out.openedOk())
+    {
+        out.setPosition (0);
+        out.truncate();
+        thumb.saveTo (out);
+    }
+}
+
+bool AudioThumbnailService::DiskCache::loadNewThumb (juce::AudioThumbnailBase& thumb, juce::int64 hashCode)
+{
+    juce::FileInputStream in (fileForHash (hashCode));
+    return in.openedOk() && thumb.loadFrom (in);
+}
+
+//==============================================================================
+AudioThumbnailService::AudioThumbnailService (const juce::File& cacheDirectory, juce::AudioFormatManager& formatManager)
+    : formats (formatManager),
+      cache (cacheDirectory)
+{
+}
+
+AudioThumbnailService::~AudioThumbnailService() = default;
+
+std::unique_ptr<juce::AudioThumbnail> AudioThumbnailService::createThumbnail (const juce::File& file)
+{
+    auto thumb = std::make_unique<juce::AudioThumbnail> (samplesPerThumbSample, formats, cache);
+
+    // FileInputSource hashes path + modification time, which keys both cache levels
+    thumb->setSource (new juce::FileInputSource (file));
+    return thumb;
+}
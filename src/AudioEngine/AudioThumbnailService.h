@@ -0,0 +1,62 @@
+#pragma once
+
+#include <juce_audio_utils/juce_audio_utils.h>
+
+/**
+ * @brief Shared, cached waveform overviews for audio clips.
+ *
+ * All clip views draw from one juce::AudioThumbnailCache, so a file used by many
+ * clips is scanned once. Thumbnails are built on the cache's background thread.
+ * Finished ones are written to a cache directory and loaded from there next
+ * session instead of re-reading the audio.
+ *
+ * Architecture:
+ *  - Owned by AppEngine for the lifetime of the app (not per Edit)
+ *  - Disk entries are named by the source's hash (path + modification time),
+ *    so an edited file gets a new thumbnail
+ *
+ * Thread safety: createThumbnail() on the message thread; the thumbnails are
+ * filled in asynchronously and broadcast a change when more data is ready.
+ */
+class AudioThumbnailService
+{
+public:
+    /**
+     * @param cacheDirectory Where finished thumbnails are stored (created if needed)
+     * @param formatManager  Formats used to read source files (not owned)
+     */
+    AudioThumbnailService (const juce::File& cacheDirectory, juce::AudioFormatManager& formatManager);
+    ~AudioThumbnailService();
+
+    /**
+     * @brief Creates a thumbnail for @p file, backed by the shared cache.
+     *
+     * Cheap if the file has been seen before (in memory or on disk). Listen to
+     * the returned object as a juce::ChangeBroadcaster to repaint while it loads.
+     */
+    std::unique_ptr<juce::AudioThumbnail> createThumbnail (const juce::File& file);
+
+    /** Source samples per thumbnail point (~11 ms at 44.1 kHz; finer than clip lanes ever zoom). */
+    static constexpr int samplesPerThumbSample = 512;
+
+private:
+    /** juce::AudioThumbnailCache that persists finished thumbnails to disk. */
+    class DiskCache : public juce::AudioThumbnailCache
+    {
+    public:
+        explicit DiskCache (const juce::File& dir);
+
+        void saveNewlyFinishedThumbnail (const juce::AudioThumbnailBase&, juce::int64 hashCode) override;
+        bool loadNewThumb (juce::AudioThumbnailBase&, juce::int64 hashCode) override;
+
+    private:
+        juce::File fileForHash (juce::int64 hashCode) const;
+
+        juce::File directory;
+    };
+
+    juce::AudioFormatManager& formats;  ///< Reference to the engine's format manager (not owned)
+    DiskCache cache;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioThumbnailService)
+};
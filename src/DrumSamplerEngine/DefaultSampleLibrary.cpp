@@ -0,0 +1,259 @@
+#include <juce_core/juce_core.h>
+#include "DefaultSampleLibrary.h"
+#include "BinaryData.h"
+
+#include <mutex>
+
+using namespace juce;
+
+namespace DefaultSampleLibrary
+{
+    //==============================================================================
+    File installRoot()
+    {
+        auto root = File::getSpecialLocation (File::userApplicationDataDirectory)
+                        .getChildFile ("GrooveKit")
+                        .getChildFile ("Samples");
+
+        root.createDirectory();
+        return root;
+    }
+
+    //------------------------------------------------------------------------------
+    // Internal helpers (file/path utilities)
+
+    static String baseNameFrom (String s)
+    {
+        s = s.replaceCharacter ('\\', '/');
+
+        if (const int idx = s.lastIndexOfChar ('/'); idx >= 0)
+            return s.substring ((size_t) idx + 1);
+
+        return s;
+    }
+
+    static String categorizeRelative (const String& originalPathOrName)
+    {
+        const auto lower = originalPathOrName.toLowerCase();
+
+        // If original path already contains "/samples/", preserve relative structure.
+        if (const int idx = lower.lastIndexOf ("/samples/"); idx >= 0)
+        {
+            auto rel = originalPathOrName.substring (
+                (size_t) idx + String ("/samples/").length());
+
+            return rel.replaceCharacter ('\\', '/');  // e.g. "Kicks/foo.wav"
+        }
+
+        const auto name = baseNameFrom (originalPathOrName);
+
+        if (lower.contains ("kick")  || lower.contains ("_bd") || lower.contains (" bd")
+            || lower.contains ("bd"))
+            return "Kicks/"   + name;
+
+        if (lower.contains ("snare") || lower.startsWithIgnoreCase ("sd ")
+            || lower.contains ("_sd"))
+            return "Snares/"  + name;
+
+        if (lower.contains ("hihat") || lower.contains ("hi-hat")
+            || lower.contains (" hh"))
+            return "HiHats/"  + name;
+
+        if (lower.contains ("tom"))
+            return "Toms/"    + name;
+
+        // Catch-all for anything else
+        return "UserImports/" + name;
+    }
+
+    static void migrateFlatFiles()
+    {
+        auto root = installRoot();
+
+        // Non-recursive search for wavs sitting directly under the root.
+        Array<File> flat;
+        root.findChildFiles (flat, File::findFiles, false, "*.wav;*.WAV");
+
+        for (auto& f : flat)
+        {
+            const auto rel  = categorizeRelative (f.getFileName());
+            auto dest = root.getChildFile (rel);
+            dest.getParentDirectory().createDirectory();
+
+            if (dest.getFullPathName() == f.getFullPathName())
+                continue;
+
+            if (! dest.existsAsFile())
+                f.moveFileTo (dest);
+            else
+                f.deleteFile();
+        }
+    }
+
+    //==============================================================================
+    File BuiltInSample::getLibraryFile() const
+    {
+        return installRoot().getChildFile (relativePath);
+    }
+
+    const Array<BuiltInSample>& builtInSamples()
+    {
+        // Function-local static: built on first use, thread-safe, pointers stay in BinaryData.
+        static const Array<BuiltInSample> samples = []
+        {
+            Array<BuiltInSample> list;
+
+            for (int i = 0; i < BinaryData::namedResourceListSize; ++i)
+            {
+                const char* resNameC = BinaryData::namedResourceList[i];
+                if (resNameC == nullptr)
+                    continue;
+
+                int dataSize = 0;
+                const void* data = BinaryData::getNamedResource (resNameC, dataSize);
+                if (data == nullptr || dataSize <= 0)
+                    continue;
+
+                const String original (BinaryData::getNamedResourceOriginalFilename (resNameC));
+
+                if (! original.endsWithIgnoreCase (".wav"))
+                    continue;
+
+                list.add ({ categorizeRelative (original), data, (size_t) dataSize });
+            }
+
+            return list;
+        }();
+
+        return samples;
+    }
+
+    const BuiltInSample* findBuiltIn (const File& file)
+    {
+        const auto root = installRoot();
+        if (! file.isAChildOf (root))
+            return nullptr;
+
+        const auto rel = file.getRelativePathFrom (root).replaceCharacter ('\\', '/');
+
+        for (const auto& sample : builtInSamples())
+            if (sample.relativePath == rel)
+                return &sample;
+
+        return nullptr;
+    }
+
+    std::unique_ptr<InputStream> openBuiltIn (const BuiltInSample& sample)
+    {
+        return std::make_unique<MemoryInputStream> (sample.data, sample.size, false);
+    }
+
+    // Hash of the bytes materialise() last wrote for each built-in, by relative path.
+    // A copy that still matches was not edited by the user and may be refreshed.
+    static File manifestFile()
+    {
+        return installRoot().getChildFile (".builtin-manifest");
+    }
+
+    static StringPairArray loadManifest()
+    {
+        StringPairArray manifest;
+        StringArray lines;
+        lines.addLines (manifestFile().loadFileAsString());
+
+        for (const auto& line : lines)
+            if (line.containsChar ('='))
+                manifest.set (line.upToFirstOccurrenceOf ("=", false, false),
+                              line.fromFirstOccurrenceOf ("=", false, false));
+
+        return manifest;
+    }
+
+    static void saveManifest (const StringPairArray& manifest)
+    {
+        String text;
+        for (const auto& key : manifest.getAllKeys())
+            text << key << '=' << manifest[key] << '\n';
+
+        (void) manifestFile().replaceWithText (text);
+    }
+
+    File materialise (const File& file)
+    {
+        const auto* sample = findBuiltIn (file);
+        if (sample == nullptr)
+            return file;
+
+        static std::mutex writeLock;
+        const std::lock_guard<std::mutex> sl (writeLock);
+
+        const auto embedded = MD5 (sample->data, sample->size).toHexString();
+        auto manifest = loadManifest();
+
+        if (file.existsAsFile())
+        {
+            const auto onDisk = MD5 (file).toHexString();
+
+            if (onDisk == embedded)
+            {
+                if (manifest[sample->relativePath] != embedded)
+                {
+                    manifest.set (sample->relativePath, embedded);
+                    saveManifest (manifest);
+                }
+
+                return file;
+            }
+
+            // Edited by the user (or from an install that kept no record): never overwrite
+            if (manifest[sample->relativePath] != onDisk)
+                return file;
+        }
+
+        // Missing, or a stale copy of an older build's sample
+        file.getParentDirectory().createDirectory();
+
+        if (file.replaceWithData (sample->data, sample->size))
+        {
+            manifest.set (sample->relativePath, embedded);
+            saveManifest (manifest);
+        }
+
+        return file;
+    }
+
+    //==============================================================================
+    void ensureInstalled()
+    {
+        // Runs as a background startup stage and from the sample browser; the
+        // first caller installs, everyone else waits for it and returns.
+        static std::mutex installLock;
+        static bool installed = false;
+
+        const std::lock_guard<std::mutex> sl (installLock);
+        if (installed)
+            return;
+
+        // Index the embedded samples; they are read from BinaryData in place and
+        // only written out by materialise() when something needs a real file.
+        builtInSamples();
+
+        // Move any old-style flat files into categorized folders.
+        migrateFlatFiles();
+
+        installed = true;
+    }
+
+    Array<File> listAll()
+    {
+        Array<File> files;
+        auto root = installRoot();
+
+        root.findChildFiles (files, File::findFiles, true, "*.wav");
+
+        for (const auto& sample : builtInSamples())
+            files.addIfNotAlreadyThere (sample.getLibraryFile());
+
+        return files;
+    }
+}
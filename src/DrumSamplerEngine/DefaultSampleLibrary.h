@@ -2,16 +2,37 @@
 
 #include <juce_core/juce_core.h>
 
+#include <memory>
+
 /**
- * @brief Helpers for managing GrooveKit's default sample library on disk.
+ * @brief Helpers for managing GrooveKit's default sample library.
  *
  * This namespace provides:
  *  - A root directory for bundled + user-imported samples.
- *  - A one-time installer that writes BinaryData samples to disk.
- *  - A function to enumerate all installed sample files.
+ *  - An index of the samples embedded in BinaryData, served straight from
+ *    the binary (no disk copy needed to list or read them).
+ *  - On-demand materialisation of a built-in sample to disk, for consumers
+ *    that need a real file (SamplerPlugin, the user editing the file).
+ *  - A function to enumerate every sample in the library.
  */
 namespace DefaultSampleLibrary
 {
+    /**
+     * @brief A sample embedded in the application binary.
+     *
+     * The data pointer refers to BinaryData and is valid for the lifetime of
+     * the process; nothing is copied.
+     */
+    struct BuiltInSample
+    {
+        juce::String relativePath;      ///< Library-relative path, e.g. "Kicks/Kick 01.wav".
+        const void* data = nullptr;     ///< Start of the embedded WAV file.
+        size_t size = 0;                ///< Size of the embedded WAV file in bytes.
+
+        /** Where this sample lives (or would live) under installRoot(). */
+        juce::File getLibraryFile() const;
+    };
+
     /**
      * @brief Returns the root directory where default samples are installed.
      *
@@ -21,18 +42,57 @@ namespace DefaultSampleLibrary
     juce::File installRoot();
 
     /**
-     * @brief Ensures the default sample library is installed.
+     * @brief Returns every embedded WAV, categorized into Kicks, Snares,
+     *        HiHats, Toms or UserImports.
+     *
+     * Built once per process from BinaryData's resource table; no I/O.
+     */
+    const juce::Array<BuiltInSample>& builtInSamples();
+
+    /**
+     * @brief Finds the built-in sample a library file refers to.
+     *
+     * @return The matching sample, or nullptr if @p file is not a built-in.
+     */
+    const BuiltInSample* findBuiltIn (const juce::File& file);
+
+    /**
+     * @brief Opens a built-in sample as a stream over the embedded bytes.
+     *
+     * The returned juce::MemoryInputStream reads BinaryData in place.
+     */
+    std::unique_ptr<juce::InputStream> openBuiltIn (const BuiltInSample& sample);
+
+    /**
+     * @brief Makes sure @p file exists on disk.
+     *
+     * If @p file is a built-in sample that hasn't been written yet it is
+     * written now. A copy left unchanged since it was written, but older than
+     * the embedded sample, is refreshed; one the user edited is left alone.
+     * Other files are returned untouched.
+     *
+     * Thread-safe.
+     *
+     * @return The same file, now present on disk if it was a built-in.
+     */
+    juce::File materialise (const juce::File& file);
+
+    /**
+     * @brief Prepares the sample library directory.
+     *
+     * Builds the built-in index and migrates any "flat" wavs in the root into
+     * categorized subfolders (Kicks, Snares, HiHats, Toms, UserImports).
+     * Built-in samples are no longer copied here; see materialise().
      *
-     * Copies any embedded BinaryData samples to the installRoot() directory,
-     * organizing them into subfolders (Kicks, Snares, HiHats, Toms, UserImports).
-     * Also migrates any "flat" wavs in the root into categorized subfolders.
+     * Thread-safe; only the first call per process does any work.
      */
     void ensureInstalled();
 
     /**
      * @brief Lists all sample files in the default sample library.
      *
-     * Recursively scans installRoot() for .wav files.
+     * Recursively scans installRoot() for .wav files and adds the library
+     * path of every built-in sample that has not been written to disk yet.
      *
      * @return Array of files found under the sample root.
      */
@@ -1,4 +1,5 @@
 #include "DrumSamplerEngineAdapter.h"
+#include "DefaultSampleLibrary.h"
 
 //==============================================================================
 // Construction / Destruction
@@ -33,11 +34,15 @@ DrumSamplerEngineAdapter::DrumSamplerEngineAdapter (te::Engine& eng,
 // DrumSamplerEngine Overrides
 
 void DrumSamplerEngineAdapter::loadSampleIntoSlot (int slot,
-                                                   const juce::File& file)
+                                                   const juce::File& requestedFile)
 {
     if (sampler == nullptr)
         return;
 
+    // SamplerPlugin loads by path, so a built-in sample is written out the first
+    // time it is actually used (no-op for user files and already-written ones).
+    const auto file = DefaultSampleLibrary::materialise (requestedFile);
+
     const int pad   = juce::jlimit (0, 15, slot);
     const int note  = padToMidiNote (pad);
     const auto name = file.getFileNameWithoutExtension();
@@ -168,9 +173,31 @@ double DrumSamplerEngineAdapter::fileLengthSeconds (const juce::File& file)
     juce::AudioFormatManager fm;
     fm.registerBasicFormats();
 
-    std::unique_ptr<juce::AudioFormatReader> reader (fm.createReaderFor (file));
+    // Built-ins: read the header straight from the embedded data instead of the disk copy
+    std::unique_ptr<juce::AudioFormatReader> reader;
+    if (const auto* builtIn = DefaultSampleLibrary::findBuiltIn (file))
+        reader.reset (fm.createReaderFor (DefaultSampleLibrary::openBuiltIn (*builtIn)));
+    else
+        reader.reset (fm.createReaderFor (file));
+
     if (reader == nullptr)
         return 0.0;
 
     return static_cast<double> (reader->lengthInSamples) / reader->sampleRate;
-}
\ No newline at end of file
+}
+
+juce::int64 DrumSamplerEngineAdapter::getDecodedSampleBytes() const
+{
+    if (sampler == nullptr)
+        return 0;
+
+    juce::int64 bytes = 0;
+    for (int i = 0; i < sampler->getNumSounds(); ++i)
+    {
+        const te::AudioFile audioFile (engine, juce::File (sampler->getSoundMedia (i)));
+        const auto info = audioFile.getInfo();
+        bytes += info.lengthInSamples * (juce::int64) info.numChannels * (juce::int64) sizeof (float);
+    }
+
+    return bytes;
+}
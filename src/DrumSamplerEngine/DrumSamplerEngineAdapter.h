@@ -75,7 +75,8 @@ public:
      *
      * Assigns the sample to the pad's corresponding MIDI note (36–51) in the
      * underlying SamplerPlugin. If a sound is already mapped to this note,
-     * it reuses the slot; otherwise a new sound is created.
+     * it reuses the slot; otherwise a new sound is created. Built-in library
+     * samples are written to disk on first use (SamplerPlugin loads by path).
      *
      * @param slot Drum pad index (0–15).
      * @param file WAV file to load into the pad.
@@ -139,6 +140,16 @@ public:
      */
     [[nodiscard]] te::SamplerPlugin* getSampler() const noexcept { return sampler; }
 
+    /**
+     * @brief Estimates the memory held by the sampler's decoded pad samples.
+     *
+     * SamplerPlugin keeps each sound fully decoded as 32-bit float, so this is
+     * samples x channels x 4 bytes per loaded sound.
+     *
+     * @return Estimated bytes of decoded audio across all loaded sounds.
+     */
+    [[nodiscard]] juce::int64 getDecodedSampleBytes() const;
+
 private:
     //==============================================================================
     // Internal Methods
@@ -166,6 +177,7 @@ private:
      * @brief Returns the length of an audio file in seconds.
      *
      * Uses a JUCE AudioFormatReader to obtain the duration from metadata.
+     * Built-in samples are read from their embedded data, not from disk.
      *
      * @param file Audio file to inspect.
      * @return Length in seconds, or 0.0 if the file cannot be read.
@@ -0,0 +1,120 @@
+#include "AuditionQueue.h"
+
+#include <cmath>
+
+//==============================================================================
+// Message thread
+
+bool AuditionQueue::post (int note, int velocity, double lengthSeconds, bool stopOthers) noexcept
+{
+    return post (note, velocity, lengthSeconds, stopOthers, juce::Time::getMillisecondCounterHiRes());
+}
+
+bool AuditionQueue::post (int note, int velocity, double lengthSeconds, bool stopOthers, double timeMs) noexcept
+{
+    const auto scope = fifo.write (1);
+
+    if (scope.blockSize1 == 0)
+        return false;
+
+    events[(size_t) scope.startIndex1] = { timeMs,
+                                           juce::jlimit (-1, 127, note),
+                                           juce::jlimit (1, 127, velocity),
+                                           juce::jmax (0.0, lengthSeconds),
+                                           stopOthers };
+    return true;
+}
+
+void AuditionQueue::stopAll() noexcept
+{
+    post (-1, 1, 0.0, true);
+}
+
+//==============================================================================
+// Audio thread
+
+void AuditionQueue::render (juce::MidiBuffer& output, int startSample, int numSamples, double sampleRate) noexcept
+{
+    if (numSamples <= 0)
+        return;
+
+    const int lastSample = numSamples - 1;
+
+    // Everything posted since the last block, placed at its distance from the first event
+    if (const int numReady = fifo.getNumReady(); numReady > 0)
+    {
+        const auto scope = fifo.read (numReady);
+        const double firstMs = events[(size_t) scope.startIndex1].timeMs;
+        int lastOffset = 0;
+
+        const auto place = [&] (const Event& e)
+        {
+            // Never earlier than the previous event, so a step is never sorted before the one it replaces
+            const int offset = juce::jlimit (lastOffset, lastSample,
+                                             juce::roundToInt ((e.timeMs - firstMs) * 0.001 * sampleRate));
+            handle (e, output, startSample, offset, sampleRate);
+            lastOffset = offset;
+        };
+
+        for (int i = 0; i < scope.blockSize1; ++i)
+            place (events[(size_t) (scope.startIndex1 + i)]);
+
+        for (int i = 0; i < scope.blockSize2; ++i)
+            place (events[(size_t) (scope.startIndex2 + i)]);
+    }
+
+    // Note-offs falling in this block; the rest move on by one block
+    for (int i = 0; i < numSounding;)
+    {
+        if (sounding[(size_t) i].samplesLeft <= lastSample)
+        {
+            noteOff (i, output, startSample, (int) sounding[(size_t) i].samplesLeft);
+        }
+        else
+        {
+            sounding[(size_t) i].samplesLeft -= numSamples;
+            ++i;
+        }
+    }
+}
+
+void AuditionQueue::reset() noexcept
+{
+    numSounding = 0;
+}
+
+void AuditionQueue::handle (const Event& e, juce::MidiBuffer& output, int startSample, int offset, double sampleRate) noexcept
+{
+    // Choked or retriggered notes end here, unless their own note-off comes first
+    for (int i = 0; i < numSounding;)
+    {
+        const auto& s = sounding[(size_t) i];
+
+        if (e.stopOthers || s.note == e.note)
+            noteOff (i, output, startSample, (int) juce::jmin ((juce::int64) offset, s.samplesLeft));
+        else
+            ++i;
+    }
+
+    if (e.note < 0)
+        return;
+
+    if (numSounding == maxSounding)
+        noteOff (0, output, startSample, offset);
+
+    output.addEvent (juce::MidiMessage::noteOn (midiChannel, e.note, (juce::uint8) e.velocity), startSample + offset);
+
+    const auto length = juce::jmax ((juce::int64) 1, (juce::int64) std::llround (e.lengthSeconds * sampleRate));
+    sounding[(size_t) numSounding++] = { e.note, offset + length };
+}
+
+void AuditionQueue::noteOff (int index, juce::MidiBuffer& output, int startSample, int offset) noexcept
+{
+    output.addEvent (juce::MidiMessage::noteOff (midiChannel, sounding[(size_t) index].note), startSample + offset);
+
+    // Keep the rest in posting order, so stealing always takes the oldest
+    for (int i = index + 1; i < numSounding; ++i)
+        sounding[(size_t) (i - 1)] = sounding[(size_t) i];
+
+    --numSounding;
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+#include <array>
+
+/**
+ * @brief Lock-free queue of piano-roll audition notes for one instrument.
+ *
+ * Clicking or dragging a note in the piano roll should sound at once. Sending it
+ * through the live MIDI input from the message thread queues it behind the
+ * device path and adds a timer for the note-off. Here the editor posts note
+ * events, stamped with the time they were made, into a single-producer /
+ * single-consumer FIFO. MorphSynth drains its own at the start of its next block
+ * and writes the notes straight into that block's MIDI; for other instruments the
+ * track's MIDI FX slot (MidiFxPlugin) does the same ahead of them.
+ *
+ * Events drained together keep their spacing: the first lands on the block's
+ * first sample and the rest follow at their posted distance from it (clamped to
+ * the block). A drag across several pitches within one buffer therefore sounds
+ * every step instead of only the last. Each note gets a note-off after its
+ * length, counted down in samples across blocks. Posting a note that is still
+ * sounding retriggers it, and stopOthers chokes every other audition note so a
+ * dragged note plays as a single voice.
+ *
+ * Real-time safety: fixed-size storage only; render() never allocates or locks.
+ * The caller reserves the output buffer (MidiBuffer::ensureSize).
+ *
+ * Thread safety: post() and stopAll() from one thread (the message thread);
+ * render() and reset() from the audio thread.
+ */
+class AuditionQueue
+{
+public:
+    static constexpr int capacity = 64;             ///< Queued events; posts past this are dropped
+    static constexpr int maxSounding = 16;          ///< Audition notes held at once; the oldest is stolen
+    static constexpr int midiChannel = 1;
+
+    AuditionQueue() = default;
+
+    //==============================================================================
+    // Message thread
+
+    /**
+     * @brief Queues a note for the next block.
+     *
+     * @param note          MIDI note number (0..127)
+     * @param velocity      Note-on velocity (1..127)
+     * @param lengthSeconds Time until the automatic note-off
+     * @param stopOthers    Ends every other sounding audition note first
+     * @return false if the queue was full and the note was dropped
+     */
+    bool post (int note, int velocity, double lengthSeconds, bool stopOthers = false) noexcept;
+
+    /** As post(), with an explicit timestamp from juce::Time::getMillisecondCounterHiRes(). */
+    bool post (int note, int velocity, double lengthSeconds, bool stopOthers, double timeMs) noexcept;
+
+    /** Ends every sounding audition note at the next block. */
+    void stopAll() noexcept;
+
+    //==============================================================================
+    // Audio thread
+
+    /**
+     * @brief Adds queued notes and due note-offs to one block.
+     *
+     * @param output      MIDI passed on to the synth; events are added, nothing is cleared
+     * @param startSample Position of the block's first sample in @p output
+     * @param numSamples  Block length in samples
+     * @param sampleRate  Current sample rate
+     */
+    void render (juce::MidiBuffer& output, int startSample, int numSamples, double sampleRate) noexcept;
+
+    /** Forgets sounding notes without sending note-offs (after the synth was stopped). */
+    void reset() noexcept;
+
+    /** True while any audition note is waiting for its note-off. */
+    bool isSounding() const noexcept                { return numSounding > 0; }
+
+private:
+    struct Event
+    {
+        double timeMs = 0.0;
+        int note = -1;                              ///< -1 stops every sounding note
+        int velocity = 0;
+        double lengthSeconds = 0.0;
+        bool stopOthers = false;
+    };
+
+    struct Sounding
+    {
+        int note = 0;
+        juce::int64 samplesLeft = 0;                ///< From the current block's first sample
+    };
+
+    void handle (const Event& e, juce::MidiBuffer& output, int startSample, int offset, double sampleRate) noexcept;
+    void noteOff (int index, juce::MidiBuffer& output, int startSample, int offset) noexcept;
+
+    juce::AbstractFifo fifo { capacity };
+    std::array<Event, (size_t) capacity> events {};
+
+    // Audio thread only
+    std::array<Sounding, (size_t) maxSounding> sounding {};     ///< Oldest first
+    int numSounding = 0;
+
+    JUCE_DECLARE_NON_COPYABLE (AuditionQueue)
+};
@@ -1,12 +1,14 @@
 #include "MIDIEngine.h"
+#include "../AudioEngine/AsyncLog.h"
 
 namespace te = tracktion::engine;
 namespace t = tracktion;
 using namespace std::literals;
 using namespace t::literals;
 
-MIDIEngine::MIDIEngine (te::Edit& editRef)
-    : edit (editRef)
+MIDIEngine::MIDIEngine (te::Edit& editRef, TempoMap& tempoMapRef)
+    : edit (editRef),
+      tempoMap (tempoMapRef)
 {
 }
 
@@ -21,16 +23,16 @@ bool MIDIEngine::addMidiClipToTrackAt(int trackIndex,
     auto* track = tracks.getUnchecked (trackIndex);
 
     const auto startTime = start;
-    const auto startBeat = edit.tempoSequence.toBeats (startTime);
+    const auto startBeat = tempoMap.toBeats (startTime);
     const auto endBeat = startBeat + length;
-    const auto endTime = edit.tempoSequence.toTime (endBeat);
+    const auto endTime = tempoMap.toTime (endBeat);
 
     t::TimeRange range { startTime, endTime };
 
     if (track->insertNewClip (te::TrackItem::Type::midi, "MIDI", range, nullptr))
     {
-        DBG ("Added MIDI clip @" << startTime.inSeconds()
-                                 << "s len(beats)=" << length.inBeats());
+        GROOVEKIT_LOG (debug, "MIDIEngine", "Added MIDI clip @" << startTime.inSeconds()
+                                                                << "s len(beats)=" << length.inBeats());
         return true;
     }
 
@@ -103,41 +105,42 @@ te::MidiClip* MIDIEngine::getMidiClipFromTrack (int trackIndex)
 
 bool MIDIEngine::importMidiFileToTrack (const juce::File& midiFile,
                                         int trackIndex,
-                                        t::TimePosition destStart)
+                                        t::TimePosition destStart,
+                                        bool importTempoMap)
 {
-    DBG ("[MIDIEngine] importMidiFileToTrack: " << midiFile.getFullPathName()
-         << " trackIndex=" << trackIndex
-         << " destStart=" << destStart.inSeconds() << "s");
+    GROOVEKIT_LOG (debug, "MIDIEngine", "importMidiFileToTrack: " << midiFile.getFullPathName()
+                                        << " trackIndex=" << trackIndex
+                                        << " destStart=" << destStart.inSeconds() << "s");
 
     if (! midiFile.existsAsFile())
     {
-        DBG ("[MIDIEngine] File doesn't exist");
+        GROOVEKIT_LOG (debug, "MIDIEngine", "File doesn't exist");
         return false;
     }
 
     auto inputStream = std::unique_ptr<juce::FileInputStream> (midiFile.createInputStream());
     if (inputStream == nullptr || ! inputStream->openedOk())
     {
-        DBG ("[MIDIEngine] Failed to open input stream");
+        GROOVEKIT_LOG (debug, "MIDIEngine", "Failed to open input stream");
         return false;
     }
 
     juce::MidiFile mf;
     if (! mf.readFrom (*inputStream))
     {
-        DBG ("[MIDIEngine] MidiFile::readFrom failed");
+        GROOVEKIT_LOG (debug, "MIDIEngine", "MidiFile::readFrom failed");
         return false;
     }
 
     const int timeFormat = mf.getTimeFormat();
     if (timeFormat <= 0)
     {
-        DBG ("[MIDIEngine] Unsupported time format (SMPTE) or <= 0");
+        GROOVEKIT_LOG (debug, "MIDIEngine", "Unsupported time format (SMPTE) or <= 0");
         return false;
     }
 
-    DBG ("[MIDIEngine] Num tracks in file: " << mf.getNumTracks()
-         << " PPQ=" << timeFormat);
+    GROOVEKIT_LOG (debug, "MIDIEngine", "Num tracks in file: " << mf.getNumTracks()
+                                        << " PPQ=" << timeFormat);
 
     // --- Build merged sequence in ticks (note on/off only) ---
     juce::MidiMessageSequence tickSeq;
@@ -161,7 +164,7 @@ bool MIDIEngine::importMidiFileToTrack (const juce::File& midiFile,
 
     if (tickSeq.getNumEvents() == 0)
     {
-        DBG ("[MIDIEngine] Sequence has no note events");
+        GROOVEKIT_LOG (debug, "MIDIEngine", "Sequence has no note events");
         return false;
     }
 
@@ -178,42 +181,45 @@ bool MIDIEngine::importMidiFileToTrack (const juce::File& midiFile,
     const double endTick = tickSeq.getEndTime();
     if (endTick <= 0.0)
     {
-        DBG ("[MIDIEngine] endTick <= 0");
+        GROOVEKIT_LOG (debug, "MIDIEngine", "endTick <= 0");
         return false;
     }
 
-    // --- Convert ticks -> seconds using the edit tempo ---
-    auto& tempoSeq = edit.tempoSequence;
+    // --- Convert ticks -> beats -> seconds through the edit's tempo map ---
+    const double destBeat    = tempoMap.toBeats (destStart).inBeats();
+    const double lengthBeats = endTick / (double) timeFormat;
 
-    // GrooveKit uses a single global tempo, so just grab the first one.
-    double bpm = 120.0;
-    if (auto* tempo = tempoSeq.getTempo (0))
-        bpm = tempo->getBpm();
+    if (importTempoMap)
+    {
+        const int numTempos = tempoMap.importFromMidiFile (mf, destBeat, firstTick / (double) timeFormat);
+        GROOVEKIT_LOG (debug, "MIDIEngine", "Imported " << numTempos << " tempo change(s)");
+    }
+
+    // Edit times for every event (and the clip end) in one batched, sorted pass
+    const int numEvents = tickSeq.getNumEvents();
+    std::vector<double> eventBeats ((size_t) numEvents + 1);
+    std::vector<double> eventSeconds (eventBeats.size());
 
-    const double secondsPerBeat = 60.0 / bpm;
+    for (int i = 0; i < numEvents; ++i)
+        eventBeats[(size_t) i] = destBeat + tickSeq.getEventTime (i) / (double) timeFormat;
 
-    // ticks -> beats -> seconds
-    const double lengthBeats    = endTick / (double) timeFormat;
-    const double lengthSeconds  = lengthBeats * secondsPerBeat;
+    eventBeats[(size_t) numEvents] = destBeat + lengthBeats;
+    tempoMap.beatsToSeconds (eventBeats.data(), eventSeconds.data(), eventBeats.size());
 
-    DBG ("[MIDIEngine] lengthBeats="   << lengthBeats
-         << " lengthSeconds="          << lengthSeconds
-         << " (endTick="               << endTick
-         << ", bpm="                   << bpm << ")");
+    const double destSeconds   = destStart.inSeconds();
+    const double lengthSeconds = eventSeconds[(size_t) numEvents] - destSeconds;
+
+    GROOVEKIT_LOG (debug, "MIDIEngine", "lengthBeats="   << lengthBeats
+                                        << " lengthSeconds="          << lengthSeconds
+                                        << " (endTick="               << endTick << ")");
 
     // --- Build a sequence whose timestamps are SECONDS from clip start ---
     juce::MidiMessageSequence secondsSeq;
 
-    for (int i = 0; i < tickSeq.getNumEvents(); ++i)
+    for (int i = 0; i < numEvents; ++i)
     {
-        auto* ev  = tickSeq.getEventPointer (i);
-        auto  msg = ev->message;
-
-        const double ticks  = msg.getTimeStamp();
-        const double beats  = ticks / (double) timeFormat;      // quarter-note beats
-        const double secs   = beats * secondsPerBeat;           // seconds from clip start
-
-        msg.setTimeStamp (secs);
+        auto msg = tickSeq.getEventPointer (i)->message;
+        msg.setTimeStamp (eventSeconds[(size_t) i] - destSeconds);
         secondsSeq.addEvent (msg);
     }
 
@@ -221,7 +227,7 @@ bool MIDIEngine::importMidiFileToTrack (const juce::File& midiFile,
 
     if (secondsSeq.getNumEvents() == 0)
     {
-        DBG ("[MIDIEngine] secondsSeq has no events after tick->sec conversion");
+        GROOVEKIT_LOG (debug, "MIDIEngine", "secondsSeq has no events after tick->sec conversion");
         return false;
     }
 
@@ -229,14 +235,14 @@ bool MIDIEngine::importMidiFileToTrack (const juce::File& midiFile,
     auto audioTracks = te::getAudioTracks (edit);
     if (! juce::isPositiveAndBelow (trackIndex, audioTracks.size()))
     {
-        DBG ("[MIDIEngine] trackIndex out of range for audioTracks");
+        GROOVEKIT_LOG (debug, "MIDIEngine", "trackIndex out of range for audioTracks");
         return false;
     }
 
     auto* audioTrack = audioTracks.getUnchecked (trackIndex);
     if (audioTrack == nullptr)
     {
-        DBG ("[MIDIEngine] audioTracks[trackIndex] is null");
+        GROOVEKIT_LOG (debug, "MIDIEngine", "audioTracks[trackIndex] is null");
         return false;
     }
 
@@ -245,9 +251,9 @@ bool MIDIEngine::importMidiFileToTrack (const juce::File& midiFile,
     const auto clipEndTime   = destStart + t::TimeDuration::fromSeconds (lengthSeconds);
     t::TimeRange range { clipStartTime, clipEndTime };
 
-    DBG ("[MIDIEngine] clipStartTime=" << clipStartTime.inSeconds()
-         << " clipEndTime="            << clipEndTime.inSeconds()
-         << " (lenSeconds="            << lengthSeconds << ")");
+    GROOVEKIT_LOG (debug, "MIDIEngine", "clipStartTime=" << clipStartTime.inSeconds()
+                                        << " clipEndTime="            << clipEndTime.inSeconds()
+                                        << " (lenSeconds="            << lengthSeconds << ")");
 
     if (auto* baseClip = audioTrack->insertNewClip (te::TrackItem::Type::midi,
                                                     "MIDI",
@@ -256,24 +262,24 @@ bool MIDIEngine::importMidiFileToTrack (const juce::File& midiFile,
     {
         if (auto* midiClip = dynamic_cast<te::MidiClip*> (baseClip))
         {
-            DBG ("[MIDIEngine] insertNewClip -> MidiClip OK, merging "
-                 << secondsSeq.getNumEvents() << " events (seconds)");
+            GROOVEKIT_LOG (debug, "MIDIEngine", "insertNewClip -> MidiClip OK, merging "
+                                                << secondsSeq.getNumEvents() << " events (seconds)");
 
             midiClip->mergeInMidiSequence (secondsSeq,
                                            te::MidiList::NoteAutomationType::none);
 
-            DBG ("[MIDIEngine] MidiClip import complete. "
-                 << "pos start=" << midiClip->getPosition().time.getStart().inSeconds()
-                 << " end="      << midiClip->getPosition().time.getEnd().inSeconds());
+            GROOVEKIT_LOG (debug, "MIDIEngine", "MidiClip import complete. "
+                                                << "pos start=" << midiClip->getPosition().time.getStart().inSeconds()
+                                                << " end="      << midiClip->getPosition().time.getEnd().inSeconds());
 
             return true;
         }
 
-        DBG ("[MIDIEngine] insertNewClip didn't return a MidiClip");
+        GROOVEKIT_LOG (debug, "MIDIEngine", "insertNewClip didn't return a MidiClip");
     }
     else
     {
-        DBG ("[MIDIEngine] insertNewClip returned null");
+        GROOVEKIT_LOG (debug, "MIDIEngine", "insertNewClip returned null");
     }
 
     return false;
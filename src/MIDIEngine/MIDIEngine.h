@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../AppEngine/TrackManager.h"
+#include "TempoMap.h"
 #include "tracktion_graph/tracktion_graph.h"
 #include <tracktion_engine/tracktion_engine.h>
 
@@ -38,9 +39,10 @@ public:
     /**
      * @brief Constructs the MIDIEngine.
      *
-     * @param editRef Reference to Tracktion Edit for clip operations
+     * @param editRef     Reference to Tracktion Edit for clip operations
+     * @param tempoMapRef AppEngine's TempoMap, already following @p editRef
      */
-    explicit MIDIEngine(te::Edit& editRef);
+    MIDIEngine(te::Edit& editRef, TempoMap& tempoMapRef);
 
     /** Default destructor. */
     ~MIDIEngine() = default;
@@ -101,14 +103,19 @@ public:
     // Track Creation
 
     /** Import a MIDI file as a single MidiClip on the given track.
-        @param midiFile   The .mid file to import
-        @param trackIndex Index of the target track in the Edit's track list
-        @param destStart  Where to place the start of the imported clip in the Edit
+        Notes are placed by beat through the Edit's tempo map, so they land on the
+        right bars whatever tempo changes the Edit has.
+        @param midiFile       The .mid file to import
+        @param trackIndex     Index of the target track in the Edit's track list
+        @param destStart      Where to place the start of the imported clip in the Edit
+        @param importTempoMap Also replace the Edit's tempo changes from destStart on
+                              with the file's tempo events
         @return true on success, false if something failed (bad file, bad track, etc.)
     */
     bool importMidiFileToTrack (const juce::File& midiFile,
                                 int trackIndex,
-                                t::TimePosition destStart);
+                                t::TimePosition destStart,
+                                bool importTempoMap = false);
 
     /**
      * @brief Adds a new MIDI track to the Edit (deprecated).
@@ -120,11 +127,19 @@ public:
      */
     int addMidiTrack();
 
+    //==============================================================================
+    // Tempo
+
+    /** Beat/time conversion and tempo editing for this Edit. */
+    TempoMap& getTempoMap() noexcept { return tempoMap; }
+    const TempoMap& getTempoMap() const noexcept { return tempoMap; }
+
 private:
     //==============================================================================
     // Member Variables
 
     te::Edit& edit; ///< Reference to Tracktion Edit (not owned)
+    TempoMap& tempoMap; ///< Conversion table + tempo editing for edit (owned by AppEngine)
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MIDIEngine)
 };
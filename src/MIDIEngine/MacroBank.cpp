@@ -0,0 +1,70 @@
+#include "MacroBank.h"
+
+MacroBank::MacroBank()
+{
+    for (auto& v : values)
+        v.store (0.0f);
+}
+
+//==============================================================================
+// Message thread
+
+float MacroBank::shape (Curve curve, float x) noexcept
+{
+    x = juce::jlimit (0.0f, 1.0f, x);
+
+    switch (curve)
+    {
+        case Curve::exponential:    return x * x;
+        case Curve::logarithmic:    return 1.0f - (1.0f - x) * (1.0f - x);
+        case Curve::sCurve:         return x * x * (3.0f - 2.0f * x);
+        case Curve::linear:
+        default:                    return x;
+    }
+}
+
+void MacroBank::setTargets (const std::vector<Target>& targets)
+{
+    auto next = std::make_unique<Compiled>();
+
+    for (const auto& t : targets)
+    {
+        if (t.macro < 0 || t.macro >= numMacros)
+            continue;
+
+        if (next->numTargets == maxTargets)
+            break;
+
+        auto& c = next->targets[(size_t) next->numTargets++];
+        c.macro = t.macro;
+        c.slot = t.slot;
+
+        for (int i = 0; i < tableSize; ++i)
+        {
+            const float x = (float) i / (float) (tableSize - 1);
+            const float normalised = t.start + (t.end - t.start) * shape (t.curve, x);
+            c.table[(size_t) i] = t.toValue ? t.toValue (normalised) : normalised;
+        }
+    }
+
+    compiled.publish (std::move (next));
+}
+
+juce::int64 MacroBank::getMemoryUsageBytes() const noexcept
+{
+    return (juce::int64) sizeof (Compiled) * compiled.getNumHeld();
+}
+
+//==============================================================================
+// Any thread
+
+void MacroBank::setMacroValue (int macro, float value) noexcept
+{
+    if (macro >= 0 && macro < numMacros)
+        values[(size_t) macro].store (juce::jlimit (0.0f, 1.0f, value), std::memory_order_relaxed);
+}
+
+float MacroBank::getMacroValue (int macro) const noexcept
+{
+    return macro >= 0 && macro < numMacros ? values[(size_t) macro].load (std::memory_order_relaxed) : 0.0f;
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "SharedSnapshot.h"
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief A track's macro knobs and the parameter targets each one drives.
+ *
+ * One macro sweeps any number of targets, each over its own range and along its
+ * own curve (cutoff opening while resonance backs off, say). Turning a macro
+ * stores one atomic value; nothing else crosses threads per move. The instrument
+ * evaluates every target itself on the audio thread, at control rate, by reading
+ * the macro's value and looking it up in that target's precomputed table.
+ *
+ * Tables are built on the message thread when the targets change: range, curve
+ * and the destination's own value mapping (skew, units) are all folded in, so a
+ * lookup is one linear interpolation between two entries. The compiled set is a
+ * SharedSnapshot: an evaluation holds it for one control slice, and a replaced set
+ * is freed by a later setTargets() or collect() once no evaluation is running.
+ *
+ * What a target's slot means is up to the owner (MorphSynthPlugin uses
+ * MorphVoice::ParamID). When several targets share a slot, the last one wins.
+ *
+ * Real-time safety: evaluate() and setMacroValue() never allocate or lock.
+ *
+ * Thread safety: setTargets() and collect() on the message thread; setMacroValue()
+ * from any thread; evaluate() on the audio thread.
+ */
+class MacroBank
+{
+public:
+    static constexpr int numMacros = 8;
+    static constexpr int maxTargets = 32;
+    static constexpr int tableSize = 129;           ///< 128 segments between macro 0 and 1
+
+    /** How a target follows its macro between the ends of its range. */
+    enum class Curve
+    {
+        linear,
+        exponential,                                ///< Slow start, fast finish
+        logarithmic,                                ///< Fast start, slow finish
+        sCurve                                      ///< Slow at both ends
+    };
+
+    struct Target
+    {
+        int macro = 0;
+        int slot = 0;
+        float start = 0.0f;                         ///< Normalised destination value at macro 0
+        float end = 1.0f;                           ///< Normalised destination value at macro 1 (may be below start)
+        Curve curve = Curve::linear;
+
+        /** Normalised value to the value the destination reads; applied while building the table. */
+        std::function<float (float)> toValue;
+    };
+
+    MacroBank();
+
+    //==============================================================================
+    // Message thread
+
+    /**
+     * @brief Builds a table for each target and swaps them in.
+     *
+     * Targets with a macro out of range are ignored; past maxTargets, the rest are.
+     */
+    void setTargets (const std::vector<Target>& targets);
+
+    /** Frees compiled sets replaced while an evaluation was running. */
+    void collect()                                  { compiled.collect(); }
+
+    /** The shape of @p curve at @p x, both 0..1. */
+    static float shape (Curve curve, float x) noexcept;
+
+    /** Heap held by the compiled tables. */
+    juce::int64 getMemoryUsageBytes() const noexcept;
+
+    //==============================================================================
+    // Any thread
+
+    void setMacroValue (int macro, float value) noexcept;
+    float getMacroValue (int macro) const noexcept;
+
+    //==============================================================================
+    // Audio thread
+
+    /** Calls @p apply (slot, value) for every target at the current macro values. */
+    template <typename Callback>
+    void evaluate (Callback&& apply) const noexcept
+    {
+        const auto c = compiled.read();
+
+        if (c)
+        {
+            for (int i = 0; i < c->numTargets; ++i)
+            {
+                const auto& t = c->targets[(size_t) i];
+                apply (t.slot, lookup (t.table, values[(size_t) t.macro].load (std::memory_order_relaxed)));
+            }
+        }
+    }
+
+private:
+    struct CompiledTarget
+    {
+        int macro = 0;
+        int slot = 0;
+        std::array<float, tableSize> table {};
+    };
+
+    struct Compiled
+    {
+        int numTargets = 0;
+        std::array<CompiledTarget, maxTargets> targets;
+    };
+
+    static float lookup (const std::array<float, tableSize>& table, float macroValue) noexcept
+    {
+        const float position = juce::jlimit (0.0f, 1.0f, macroValue) * (float) (tableSize - 1);
+        const int index = juce::jmin ((int) position, tableSize - 2);
+        const float fraction = position - (float) index;
+        return table[(size_t) index] + (table[(size_t) index + 1] - table[(size_t) index]) * fraction;
+    }
+
+    std::array<std::atomic<float>, numMacros> values;
+
+    SharedSnapshot<Compiled> compiled;
+
+    JUCE_DECLARE_NON_COPYABLE (MacroBank)
+};
@@ -0,0 +1,381 @@
+#include "MidiFxProcessor.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+    constexpr double noEnd = std::numeric_limits<double>::infinity();
+
+    struct ChordShape
+    {
+        int numTones;
+        int intervals[MidiFxProcessor::maxChordTones];
+    };
+
+    /** Intervals (semitones above the played note), indexed by MidiFxProcessor::Chord. */
+    constexpr ChordShape chordShapes[] =
+    {
+        { 1, { 0 } },               // off
+        { 3, { 0, 4, 7 } },         // major
+        { 3, { 0, 3, 7 } },         // minor
+        { 4, { 0, 4, 7, 11 } },     // major 7
+        { 4, { 0, 3, 7, 10 } },     // minor 7
+        { 4, { 0, 4, 7, 10 } },     // dominant 7
+        { 3, { 0, 2, 7 } },         // sus2
+        { 3, { 0, 5, 7 } },         // sus4
+        { 2, { 0, 7 } },            // power
+        { 2, { 0, 12 } },           // octave
+    };
+
+    const ChordShape& shapeFor (MidiFxProcessor::Chord c)
+    {
+        return chordShapes[juce::jlimit (0, (int) std::size (chordShapes) - 1, (int) c)];
+    }
+}
+
+//==============================================================================
+// Names
+
+juce::StringArray MidiFxProcessor::getRateNames()    { return { "1/4", "1/8", "1/8T", "1/16", "1/16T", "1/32" }; }
+juce::StringArray MidiFxProcessor::getModeNames()    { return { "Off", "Arpeggiator", "Note Repeat" }; }
+juce::StringArray MidiFxProcessor::getPatternNames() { return { "Up", "Down", "Up/Down", "As Played", "Random" }; }
+
+juce::StringArray MidiFxProcessor::getChordNames()
+{
+    return { "Off", "Major", "Minor", "Maj7", "Min7", "Dom7", "Sus2", "Sus4", "Power", "Octave" };
+}
+
+double MidiFxProcessor::rateIndexToBeats (int index)
+{
+    constexpr double beats[] = { 1.0, 0.5, 1.0 / 3.0, 0.25, 1.0 / 6.0, 0.125 };
+    return beats[juce::jlimit (0, (int) std::size (beats) - 1, index)];
+}
+
+//==============================================================================
+// Processing
+
+void MidiFxProcessor::reset()
+{
+    numHeld = 0;
+    numSounding = 0;
+    poolSize = 0;
+    poolDirty = true;
+    stepIndex = 0;
+    expectedStartBeat = -1.0;
+}
+
+void MidiFxProcessor::process (const Settings& settings, const juce::MidiBuffer& input, juce::MidiBuffer& output,
+                               int numSamples, double startBeat, double beatsPerSample) noexcept
+{
+    output.clear();
+
+    if (numSamples <= 0)
+        return;
+
+    blockStartBeat = startBeat;
+    blockBeatsPerSample = juce::jmax (0.0, beatsPerSample);
+    blockNumSamples = numSamples;
+
+    applySettings (settings, output);
+
+    // Transport jumped (locate, loop wrap): re-lock to the grid. Going backwards
+    // also ends every generated note, since their end beats are now meaningless.
+    const double tolerance = juce::jmax (1.0e-6, blockBeatsPerSample * 2.0);
+    if (std::abs (startBeat - expectedStartBeat) > tolerance)
+    {
+        if (startBeat < expectedStartBeat)
+            for (int i = numSounding; --i >= 0;)
+                if (sounding[(size_t) i].offBeat != noEnd)
+                {
+                    output.addEvent (juce::MidiMessage::noteOff (sounding[(size_t) i].channel, sounding[(size_t) i].note), 0);
+                    removeSounding (i);
+                }
+
+        nextStepBeat = alignToGrid (startBeat);
+    }
+
+    for (const auto meta : input)
+    {
+        const int sample = juce::jlimit (0, numSamples - 1, meta.samplePosition);
+        advanceTo (sample, output);
+        handleMessage (meta.getMessage(), sample, output);
+    }
+
+    advanceTo (numSamples, output);
+    expectedStartBeat = startBeat + numSamples * blockBeatsPerSample;
+}
+
+void MidiFxProcessor::applySettings (const Settings& s, juce::MidiBuffer& out) noexcept
+{
+    Settings next = s;
+    next.stepBeats = juce::jmax (1.0 / 64.0, s.stepBeats);
+    next.octaves = juce::jlimit (1, maxOctaves, s.octaves);
+    next.gate = juce::jlimit (0.05f, 1.0f, s.gate);
+
+    if (hasSettings)
+    {
+        // Anything that changes which notes are generated: end the old ones cleanly
+        if (next.mode != current.mode || next.chord != current.chord
+            || next.pattern != current.pattern || next.octaves != current.octaves)
+        {
+            stopAllSounding (0, out);
+            poolDirty = true;
+            stepIndex = 0;
+
+            // Chord/passthrough mode: keys that are still down start sounding again
+            if (next.mode == Mode::off)
+            {
+                current = next;
+                const auto& shape = shapeFor (current.chord);
+
+                for (int h = 0; h < numHeld; ++h)
+                    for (int t = 0; t < shape.numTones; ++t)
+                        startNote ({ held[(size_t) h].note + shape.intervals[t], held[(size_t) h].channel, held[(size_t) h].velocity },
+                                   held[(size_t) h].note, noEnd, 0, out);
+            }
+        }
+
+        // New rate: re-lock to the new grid (done by the jump check in process())
+        if (next.stepBeats != current.stepBeats)
+            expectedStartBeat = -1.0;
+    }
+
+    current = next;
+    hasSettings = true;
+}
+
+void MidiFxProcessor::advanceTo (int limitSample, juce::MidiBuffer& out) noexcept
+{
+    for (;;)
+    {
+        // Earliest pending note-off
+        int offIndex = -1;
+        for (int i = 0; i < numSounding; ++i)
+            if (offIndex < 0 || sounding[(size_t) i].offBeat < sounding[(size_t) offIndex].offBeat)
+                offIndex = i;
+
+        const double offPos  = offIndex >= 0 ? samplePosition (sounding[(size_t) offIndex].offBeat) : noEnd;
+        const double stepPos = isStepMode() ? samplePosition (nextStepBeat) : noEnd;
+
+        // Note-offs first on a tie, so a retriggered note ends before it restarts
+        if (offPos < limitSample && offPos <= stepPos)
+        {
+            const auto& s = sounding[(size_t) offIndex];
+            out.addEvent (juce::MidiMessage::noteOff (s.channel, s.note), (int) offPos);
+            removeSounding (offIndex);
+            continue;
+        }
+
+        if (stepPos < limitSample)
+        {
+            if (numHeld > 0)
+                fireStep ((int) stepPos, nextStepBeat, out);
+
+            nextStepBeat += current.stepBeats;
+            continue;
+        }
+
+        break;
+    }
+}
+
+void MidiFxProcessor::handleMessage (const juce::MidiMessage& m, int sample, juce::MidiBuffer& out) noexcept
+{
+    if (m.isNoteOn())
+    {
+        const int note = m.getNoteNumber();
+
+        bool alreadyHeld = false;
+        for (int i = 0; i < numHeld; ++i)
+            alreadyHeld = alreadyHeld || held[(size_t) i].note == note;
+
+        if (! alreadyHeld && numHeld < maxHeldNotes)
+        {
+            if (numHeld == 0)
+                stepIndex = 0;
+
+            held[(size_t) numHeld++] = { note, m.getChannel(), m.getVelocity() };
+            poolDirty = true;
+        }
+
+        if (! isStepMode())
+        {
+            const auto& shape = shapeFor (current.chord);
+            for (int t = 0; t < shape.numTones; ++t)
+                startNote ({ note + shape.intervals[t], m.getChannel(), m.getVelocity() }, note, noEnd, sample, out);
+        }
+        return;
+    }
+
+    if (m.isNoteOff())
+    {
+        const int note = m.getNoteNumber();
+
+        for (int i = 0; i < numHeld; ++i)
+        {
+            if (held[(size_t) i].note == note)
+            {
+                std::move (held.begin() + i + 1, held.begin() + numHeld, held.begin() + i);
+                --numHeld;
+                poolDirty = true;
+                break;
+            }
+        }
+
+        // Step modes let generated notes finish their gate; chords end with the key
+        for (int i = numSounding; --i >= 0;)
+        {
+            if (sounding[(size_t) i].sourceNote == note && sounding[(size_t) i].offBeat == noEnd)
+            {
+                out.addEvent (juce::MidiMessage::noteOff (sounding[(size_t) i].channel, sounding[(size_t) i].note), sample);
+                removeSounding (i);
+            }
+        }
+        return;
+    }
+
+    if (m.isAllNotesOff() || m.isAllSoundOff())
+    {
+        numHeld = 0;
+        poolDirty = true;
+        stopAllSounding (sample, out);
+    }
+
+    // Everything else (CCs, pitch bend, aftertouch...) is passed on untouched
+    out.addEvent (m, sample);
+}
+
+void MidiFxProcessor::fireStep (int sample, double stepBeat, juce::MidiBuffer& out) noexcept
+{
+    if (poolDirty)
+        rebuildPool();
+
+    if (poolSize == 0)
+        return;
+
+    const double offBeat = stepBeat + current.stepBeats * current.gate;
+
+    if (current.mode == Mode::noteRepeat)
+    {
+        for (int i = 0; i < poolSize; ++i)
+            startNote (pool[(size_t) i], -1, offBeat, sample, out);
+    }
+    else
+    {
+        int index = 0;
+
+        switch (current.pattern)
+        {
+            case Pattern::upDown:
+            {
+                const int period = juce::jmax (1, 2 * poolSize - 2);
+                const int k = stepIndex % period;
+                index = k < poolSize ? k : period - k;
+                break;
+            }
+            case Pattern::random:
+                index = random.nextInt (poolSize);
+                break;
+            case Pattern::up:
+            case Pattern::down:
+            case Pattern::asPlayed:
+            default:
+                index = stepIndex % poolSize;
+                break;
+        }
+
+        startNote (pool[(size_t) index], -1, offBeat, sample, out);
+    }
+
+    ++stepIndex;
+}
+
+void MidiFxProcessor::rebuildPool() noexcept
+{
+    poolSize = 0;
+    poolDirty = false;
+
+    const auto& shape = shapeFor (current.chord);
+    const int octaves = current.mode == Mode::arpeggiator ? current.octaves : 1;
+
+    for (int o = 0; o < octaves; ++o)
+    {
+        for (int h = 0; h < numHeld; ++h)
+        {
+            for (int t = 0; t < shape.numTones; ++t)
+            {
+                const int n = held[(size_t) h].note + shape.intervals[t] + 12 * o;
+                if (n < 0 || n > 127 || poolSize >= maxPoolSize)
+                    continue;
+
+                bool duplicate = false;
+                for (int i = 0; i < poolSize; ++i)
+                    duplicate = duplicate || pool[(size_t) i].note == n;
+
+                if (! duplicate)
+                    pool[(size_t) poolSize++] = { n, held[(size_t) h].channel, held[(size_t) h].velocity };
+            }
+        }
+    }
+
+    const auto byNote = [] (const Note& a, const Note& b) { return a.note < b.note; };
+
+    if (current.pattern == Pattern::up || current.pattern == Pattern::upDown || current.mode == Mode::noteRepeat)
+        std::sort (pool.begin(), pool.begin() + poolSize, byNote);
+    else if (current.pattern == Pattern::down)
+        std::sort (pool.begin(), pool.begin() + poolSize, [&] (const Note& a, const Note& b) { return byNote (b, a); });
+}
+
+//==============================================================================
+// Sounding notes
+
+void MidiFxProcessor::startNote (const Note& n, int sourceNote, double offBeat, int sample, juce::MidiBuffer& out) noexcept
+{
+    if (n.note < 0 || n.note > 127)
+        return;
+
+    // Retrigger: end the previous instance first so note-ons and note-offs stay paired
+    for (int i = numSounding; --i >= 0;)
+    {
+        if (sounding[(size_t) i].note == n.note && sounding[(size_t) i].channel == n.channel)
+        {
+            out.addEvent (juce::MidiMessage::noteOff (n.channel, n.note), sample);
+            removeSounding (i);
+        }
+    }
+
+    if (numSounding >= maxSoundingNotes)
+        return;
+
+    out.addEvent (juce::MidiMessage::noteOn (n.channel, n.note, n.velocity), sample);
+    sounding[(size_t) numSounding++] = { n.note, n.channel, sourceNote, offBeat };
+}
+
+void MidiFxProcessor::stopAllSounding (int sample, juce::MidiBuffer& out) noexcept
+{
+    for (int i = 0; i < numSounding; ++i)
+        out.addEvent (juce::MidiMessage::noteOff (sounding[(size_t) i].channel, sounding[(size_t) i].note), sample);
+
+    numSounding = 0;
+}
+
+void MidiFxProcessor::removeSounding (int index) noexcept
+{
+    sounding[(size_t) index] = sounding[(size_t) (numSounding - 1)];
+    --numSounding;
+}
+
+double MidiFxProcessor::samplePosition (double beat) const noexcept
+{
+    if (blockBeatsPerSample <= 0.0)
+        return beat <= blockStartBeat ? 0.0 : noEnd;
+
+    // First sample at or after the beat
+    return juce::jmax (0.0, std::ceil ((beat - blockStartBeat) / blockBeatsPerSample - 1.0e-9));
+}
+
+double MidiFxProcessor::alignToGrid (double beat) const noexcept
+{
+    return std::ceil (beat / current.stepBeats - 1.0e-9) * current.stepBeats;
+}
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+#include <array>
+
+/**
+ * @brief Arpeggiator, chord generator and note repeat as a block-based MIDI transform.
+ *
+ * This is the real-time core of MidiFxPlugin. It is kept free of Tracktion so it can
+ * be driven directly from tests. Each process() call takes one block of input
+ * MIDI (sample positions) and the block's position on the beat grid. It writes
+ * the generated MIDI at sample-accurate positions.
+ *
+ * Modes:
+ *  - off:         held notes pass through. If a chord is selected, each note
+ *                 plays the whole chord.
+ *  - arpeggiator: held notes (plus chord tones and extra octaves) are played one
+ *                 at a time on the step grid, in the selected pattern.
+ *  - noteRepeat:  held notes (plus chord tones) are retriggered together on every step.
+ *
+ * Steps fall on exact multiples of stepBeats, so output stays locked to the
+ * edit's tempo (including tempo changes) no matter where playback starts.
+ * Generated notes last gate * stepBeats.
+ *
+ * Real-time safety: all state lives in fixed-size arrays, so process() never
+ * allocates. The output buffer must be reserved by the caller (MidiBuffer::ensureSize).
+ *
+ * Thread safety: single-threaded (the audio thread that owns the plugin).
+ */
+class MidiFxProcessor
+{
+public:
+    //==============================================================================
+    // Settings
+
+    enum class Mode { off, arpeggiator, noteRepeat };
+    enum class Pattern { up, down, upDown, asPlayed, random };
+    enum class Chord { off, major, minor, major7, minor7, dominant7, sus2, sus4, power, octave };
+
+    struct Settings
+    {
+        Mode mode = Mode::off;
+        Pattern pattern = Pattern::up;
+        Chord chord = Chord::off;
+        double stepBeats = 0.25;    ///< Step length in beats (0.25 = 1/16 note)
+        int octaves = 1;            ///< Arpeggiator range, 1..maxOctaves
+        float gate = 0.5f;          ///< Generated note length as a fraction of a step
+    };
+
+    /** Display names for the step rates, in parameter order. */
+    static juce::StringArray getRateNames();
+
+    /** Step length in beats for a rate index from getRateNames(). */
+    static double rateIndexToBeats (int index);
+
+    static juce::StringArray getModeNames();
+    static juce::StringArray getPatternNames();
+    static juce::StringArray getChordNames();
+
+    //==============================================================================
+    // Processing
+
+    MidiFxProcessor() = default;
+
+    /** Forgets held and sounding notes (no note-offs are sent). */
+    void reset();
+
+    /**
+     * @brief Transforms one block of MIDI.
+     *
+     * @param settings       Current settings (may change between blocks)
+     * @param input          Incoming MIDI, sample positions 0..numSamples-1
+     * @param output         Cleared, then filled with the transformed MIDI
+     * @param numSamples     Block length in samples
+     * @param startBeat      Beat position of the block's first sample
+     * @param beatsPerSample Beat advance per sample (tempo / 60 / sampleRate)
+     */
+    void process (const Settings& settings, const juce::MidiBuffer& input, juce::MidiBuffer& output,
+                  int numSamples, double startBeat, double beatsPerSample) noexcept;
+
+    /** Number of notes currently held on the input (for tests/diagnostics). */
+    int getNumHeldNotes() const noexcept { return numHeld; }
+
+    /** Number of generated notes still sounding (for tests/diagnostics). */
+    int getNumSoundingNotes() const noexcept { return numSounding; }
+
+    static constexpr int maxHeldNotes = 16;
+    static constexpr int maxChordTones = 4;
+    static constexpr int maxOctaves = 4;
+    static constexpr int maxPoolSize = maxHeldNotes * maxChordTones * maxOctaves;
+    static constexpr int maxSoundingNotes = 128;
+
+private:
+    //==============================================================================
+    // Internal Types
+
+    struct Note
+    {
+        int note = 0;
+        int channel = 1;
+        juce::uint8 velocity = 100;
+    };
+
+    struct Sounding
+    {
+        int note = 0;
+        int channel = 1;
+        int sourceNote = -1;    ///< Held input note that produced it (chord/passthrough mode)
+        double offBeat = 0.0;   ///< When the note ends (infinity: ends with its source note)
+    };
+
+    //==============================================================================
+    // Helpers
+
+    bool isStepMode() const noexcept { return current.mode != Mode::off; }
+
+    void applySettings (const Settings& s, juce::MidiBuffer& out) noexcept;
+    void advanceTo (int limitSample, juce::MidiBuffer& out) noexcept;
+    void handleMessage (const juce::MidiMessage& m, int sample, juce::MidiBuffer& out) noexcept;
+    void fireStep (int sample, double stepBeat, juce::MidiBuffer& out) noexcept;
+    void rebuildPool() noexcept;
+
+    void startNote (const Note& n, int sourceNote, double offBeat, int sample, juce::MidiBuffer& out) noexcept;
+    void stopAllSounding (int sample, juce::MidiBuffer& out) noexcept;
+    void removeSounding (int index) noexcept;
+
+    /** Sample offset in the current block where @p beat falls (may be >= the block length). */
+    double samplePosition (double beat) const noexcept;
+    double alignToGrid (double beat) const noexcept;
+
+    //==============================================================================
+    // State
+
+    Settings current;
+    bool hasSettings = false;
+
+    std::array<Note, maxHeldNotes> held {};            ///< In the order they were played
+    int numHeld = 0;
+
+    std::array<Note, maxPoolSize> pool {};             ///< Notes a step can choose from
+    int poolSize = 0;
+    bool poolDirty = true;
+
+    std::array<Sounding, maxSoundingNotes> sounding {};
+    int numSounding = 0;
+
+    double nextStepBeat = 0.0;
+    double expectedStartBeat = -1.0;                   ///< End of the previous block (jump detection)
+    int stepIndex = 0;
+
+    // Current block (valid during process())
+    double blockStartBeat = 0.0;
+    double blockBeatsPerSample = 0.0;
+    int blockNumSamples = 0;
+
+    juce::Random random;
+};
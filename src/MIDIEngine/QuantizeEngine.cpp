@@ -0,0 +1,446 @@
+#include "QuantizeEngine.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace
+{
+    using FVO = juce::FloatVectorOperations;
+
+    /** Beat tolerance below which a note counts as unchanged. */
+    constexpr double beatEpsilon = 1.0e-9;
+
+    /** Nearest grid line to @p beat, with every odd line delayed by @p swingBeats (<= grid / 2). */
+    inline double nearestSwungGridLine (double beat, double grid, double swingBeats) noexcept
+    {
+        auto linePosition = [grid, swingBeats] (double line)
+        {
+            const bool odd = (static_cast<juce::int64> (line) & 1) != 0;
+            return line * grid + (odd ? swingBeats : 0.0);
+        };
+
+        // With at most half a step of swing, only the lines either side can be nearest
+        const double below = std::floor (beat / grid);
+        const double a = linePosition (below);
+        const double b = linePosition (below + 1.0);
+        return std::abs (beat - a) <= std::abs (b - beat) ? a : b;
+    }
+
+    /** Nearest groove position to @p beat (across period boundaries). @return its index */
+    inline size_t nearestGroovePosition (double beat, const QuantizeEngine::GrooveTemplate& groove,
+                                         double& target) noexcept
+    {
+        const auto& positions = groove.positions;
+        const double length = groove.lengthBeats;
+        const double period = std::floor (beat / length) * length;
+        const double local = beat - period;
+
+        const size_t n = positions.size();
+        const auto i = (size_t) (std::lower_bound (positions.begin(), positions.end(), local) - positions.begin());
+
+        const size_t hiIndex = i < n ? i : 0;
+        const double hiPos   = i < n ? positions[i] : positions[0] + length;
+        const size_t loIndex = i > 0 ? i - 1 : n - 1;
+        const double loPos   = i > 0 ? positions[i - 1] : positions[n - 1] - length;
+
+        if (hiPos - local <= local - loPos)
+        {
+            target = period + hiPos;
+            return hiIndex;
+        }
+
+        target = period + loPos;
+        return loIndex;
+    }
+
+    /** Fills @p targets (and @p accents, for a groove) with the snap position of each beat. */
+    void findTargets (const double* beats, double* targets, float* accents, size_t num,
+                      const QuantizeEngine::GrooveTemplate* groove, double grid, double swingBeats) noexcept
+    {
+        if (groove != nullptr)
+        {
+            for (size_t i = 0; i < num; ++i)
+            {
+                const auto index = nearestGroovePosition (beats[i], *groove, targets[i]);
+                if (accents != nullptr)
+                    accents[i] = groove->accents[index];
+            }
+            return;
+        }
+
+        if (swingBeats <= 0.0)
+        {
+            // Straight grid: a branch-free loop the compiler can vectorise
+            for (size_t i = 0; i < num; ++i)
+                targets[i] = std::round (beats[i] / grid) * grid;
+            return;
+        }
+
+        for (size_t i = 0; i < num; ++i)
+            targets[i] = nearestSwungGridLine (beats[i], grid, swingBeats);
+    }
+
+    /** Edit beat of a clip's sequence beat 0. */
+    double getSequenceOffsetBeats (te::MidiClip& clip)
+    {
+        return clip.getStartBeat().inBeats() - clip.getOffsetInBeats().inBeats();
+    }
+}
+
+//==============================================================================
+// Groove templates
+
+QuantizeEngine::GrooveTemplate QuantizeEngine::GrooveTemplate::fromOnsets (const std::vector<double>& beats,
+                                                                           const std::vector<float>& weights,
+                                                                           double lengthBeats, double gridBeats)
+{
+    GrooveTemplate groove;
+    groove.lengthBeats = lengthBeats;
+
+    if (beats.empty() || lengthBeats <= 0.0 || gridBeats <= 0.0)
+        return groove;
+
+    const int numSlots = juce::jmax (1, juce::roundToInt (lengthBeats / gridBeats));
+    const double slotBeats = lengthBeats / numSlots;
+
+    std::vector<double> offsetSum ((size_t) numSlots, 0.0), weightSum ((size_t) numSlots, 0.0);
+    std::vector<int> count ((size_t) numSlots, 0);
+
+    for (size_t i = 0; i < beats.size(); ++i)
+    {
+        const double weight = juce::jmax (1.0e-3, (double) (i < weights.size() ? weights[i] : 1.0f));
+
+        double local = std::fmod (beats[i], lengthBeats);
+        if (local < 0.0)
+            local += lengthBeats;
+
+        const double slotPosition = local / slotBeats;
+        const int nearest = (int) std::floor (slotPosition + 0.5);
+        const auto slot = (size_t) (nearest % numSlots);
+
+        offsetSum[slot] += (slotPosition - nearest) * slotBeats * weight;
+        weightSum[slot] += weight;
+        ++count[slot];
+    }
+
+    // Mean weight per hit slot, normalised to the loudest; empty slots get the average
+    double maxAccent = 0.0, accentSum = 0.0;
+    int numHit = 0;
+    for (size_t s = 0; s < (size_t) numSlots; ++s)
+    {
+        if (count[s] == 0)
+            continue;
+
+        const double accent = weightSum[s] / count[s];
+        maxAccent = juce::jmax (maxAccent, accent);
+        accentSum += accent;
+        ++numHit;
+    }
+
+    const double meanAccent = accentSum / numHit;
+
+    std::vector<std::pair<double, float>> slots;
+    slots.reserve ((size_t) numSlots);
+
+    for (size_t s = 0; s < (size_t) numSlots; ++s)
+    {
+        double position = (double) s * slotBeats;
+        double accent = meanAccent;
+
+        if (count[s] > 0)
+        {
+            position += offsetSum[s] / weightSum[s];
+            accent = weightSum[s] / count[s];
+        }
+
+        if (position < 0.0)
+            position += lengthBeats;
+        else if (position >= lengthBeats)
+            position -= lengthBeats;
+
+        slots.emplace_back (position, (float) (accent / maxAccent));
+    }
+
+    std::sort (slots.begin(), slots.end());
+
+    for (auto& [position, accent] : slots)
+    {
+        groove.positions.push_back (position);
+        groove.accents.push_back (accent);
+    }
+
+    return groove;
+}
+
+QuantizeEngine::GrooveTemplate QuantizeEngine::GrooveTemplate::fromMidiClip (te::MidiClip& clip,
+                                                                             double lengthBeats, double gridBeats)
+{
+    const double offset = getSequenceOffsetBeats (clip);
+    const auto& notes = clip.getSequence().getNotes();
+
+    std::vector<double> beats;
+    std::vector<float> weights;
+    beats.reserve ((size_t) notes.size());
+    weights.reserve ((size_t) notes.size());
+
+    for (auto* note : notes)
+    {
+        beats.push_back (offset + note->getStartBeat().inBeats());
+        weights.push_back ((float) note->getVelocity() / 127.0f);
+    }
+
+    return fromOnsets (beats, weights, lengthBeats, gridBeats);
+}
+
+bool QuantizeEngine::detectOnsets (const juce::File& file, juce::AudioFormatManager& formats,
+                                   std::vector<double>& seconds, std::vector<float>& weights)
+{
+    seconds.clear();
+    weights.clear();
+
+    std::unique_ptr<juce::AudioFormatReader> reader (formats.createReaderFor (file));
+    if (reader == nullptr || reader->sampleRate <= 0.0 || reader->numChannels == 0)
+        return false;
+
+    const auto numHops = (size_t) (reader->lengthInSamples / onsetHopSize);
+    if (numHops < 3)
+        return true;
+
+    // RMS per hop, read in blocks of hopsPerRead hops
+    constexpr int hopsPerRead = 64;
+    const int numChannels = (int) reader->numChannels;
+    juce::AudioBuffer<float> block (numChannels, onsetHopSize * hopsPerRead);
+    std::vector<float> rms (numHops);
+
+    for (size_t hop = 0; hop < numHops;)
+    {
+        const int hopsThisRead = (int) std::min<size_t> ((size_t) hopsPerRead, numHops - hop);
+        reader->read (&block, 0, hopsThisRead * onsetHopSize, (juce::int64) hop * onsetHopSize, true, true);
+
+        for (int h = 0; h < hopsThisRead; ++h)
+        {
+            float sumOfSquares = 0.0f;
+            for (int ch = 0; ch < numChannels; ++ch)
+                sumOfSquares += juce::square (block.getRMSLevel (ch, h * onsetHopSize, onsetHopSize));
+
+            rms[hop + (size_t) h] = std::sqrt (sumOfSquares / (float) numChannels);
+        }
+
+        hop += (size_t) hopsThisRead;
+    }
+
+    // Positive rise in energy, thresholded against its own statistics
+    std::vector<float> rise (numHops, 0.0f);
+    for (size_t i = 1; i < numHops; ++i)
+        rise[i] = juce::jmax (0.0f, rms[i] - rms[i - 1]);
+
+    const double mean = std::accumulate (rise.begin(), rise.end(), 0.0) / (double) numHops;
+    double variance = 0.0;
+    for (auto r : rise)
+        variance += juce::square (r - mean);
+
+    const double threshold = mean + 1.5 * std::sqrt (variance / (double) numHops);
+
+    const double hopSeconds = onsetHopSize / reader->sampleRate;
+    const auto minGapHops = (size_t) std::ceil (minOnsetGapSeconds / hopSeconds);
+    size_t lastOnset = 0;
+
+    for (size_t i = 1; i + 1 < numHops; ++i)
+    {
+        const bool isPeak = rise[i] > threshold && rise[i] >= rise[i - 1] && rise[i] > rise[i + 1];
+        if (! isPeak || (! seconds.empty() && i - lastOnset < minGapHops))
+            continue;
+
+        seconds.push_back ((double) i * hopSeconds);
+        weights.push_back (juce::jmax (rms[i], rms[i + 1]));
+        lastOnset = i;
+    }
+
+    return true;
+}
+
+//==============================================================================
+// Packed notes
+
+void QuantizeEngine::NoteArrays::addClip (te::MidiClip& clip)
+{
+    addNotes (clip, clip.getSequence().getNotes());
+}
+
+void QuantizeEngine::NoteArrays::addNotes (te::MidiClip& clip, const juce::Array<te::MidiNote*>& selection)
+{
+    ClipRange range;
+    range.clip = &clip;
+    range.begin = size();
+    range.beatOffset = getSequenceOffsetBeats (clip);
+
+    for (auto* note : selection)
+    {
+        if (note == nullptr)
+            continue;
+
+        start.push_back (range.beatOffset + note->getStartBeat().inBeats());
+        end.push_back (range.beatOffset + note->getEndBeat().inBeats());
+        velocity.push_back ((float) note->getVelocity());
+        notes.push_back (note);
+    }
+
+    range.end = size();
+    if (range.end > range.begin)
+        clips.push_back (range);
+}
+
+void QuantizeEngine::NoteArrays::addNote (double startBeat, double endBeat, float vel)
+{
+    start.push_back (startBeat);
+    end.push_back (endBeat);
+    velocity.push_back (vel);
+    notes.push_back (nullptr);
+}
+
+void QuantizeEngine::NoteArrays::reserve (size_t num)
+{
+    start.reserve (num);
+    end.reserve (num);
+    velocity.reserve (num);
+    notes.reserve (num);
+}
+
+void QuantizeEngine::NoteArrays::clear()
+{
+    start.clear();
+    end.clear();
+    velocity.clear();
+    notes.clear();
+    clips.clear();
+}
+
+//==============================================================================
+// Processing
+
+void QuantizeEngine::process (const Settings& settings, NoteArrays& notes)
+{
+    const size_t n = notes.size();
+    if (n == 0)
+        return;
+
+    const int num = (int) n;
+    const auto* groove = settings.groove != nullptr && settings.groove->isValid() ? settings.groove : nullptr;
+    const double grid = juce::jmax (minLengthBeats, settings.gridBeats);
+    const double swingBeats = (double) juce::jlimit (0.0f, 1.0f, settings.swing) * grid * 0.5;
+    const double strength = (double) juce::jlimit (0.0f, 1.0f, settings.strength);
+
+    std::vector<double> delta (n);
+    std::vector<float> scratch (n);
+    double* const shift = delta.data();
+    double* const start = notes.start.data();
+    double* const end = notes.end.data();
+    float* const velocity = notes.velocity.data();
+
+    // 1 + 2. Pull starts towards their targets: shift = strength * (target - start)
+    findTargets (start, shift, groove != nullptr ? scratch.data() : nullptr, n, groove, grid, swingBeats);
+    FVO::subtract (shift, start, num);
+    FVO::multiply (shift, strength, num);
+    FVO::add (start, shift, num);
+
+    if (settings.quantizeEnds)
+    {
+        // Ends go to the plain (swung) grid; groove positions are hit positions, not releases
+        findTargets (end, shift, nullptr, n, nullptr, grid, swingBeats);
+        FVO::subtract (shift, end, num);
+        FVO::multiply (shift, strength, num);
+        FVO::add (end, shift, num);
+    }
+    else
+    {
+        FVO::add (end, shift, num);
+    }
+
+    // 3. Velocity towards the groove accent: velocity += amount * (accent * 127 - velocity)
+    if (groove != nullptr && settings.grooveVelocity > 0.0f)
+    {
+        const float amount = juce::jlimit (0.0f, 1.0f, settings.grooveVelocity) * (float) strength;
+        FVO::multiply (scratch.data(), 127.0f, num);
+        FVO::subtract (scratch.data(), velocity, num);
+        FVO::addWithMultiply (velocity, scratch.data(), amount, num);
+    }
+
+    // 4. Humanize
+    juce::Random random (settings.seed);
+
+    if (settings.humanizeBeats > 0.0)
+    {
+        for (size_t i = 0; i < n; ++i)
+            shift[i] = (random.nextDouble() * 2.0 - 1.0) * settings.humanizeBeats;
+
+        FVO::add (start, shift, num);
+        FVO::add (end, shift, num);
+    }
+
+    if (settings.humanizeVelocity > 0.0f)
+    {
+        for (size_t i = 0; i < n; ++i)
+            scratch[i] = (random.nextFloat() * 2.0f - 1.0f) * settings.humanizeVelocity;
+
+        FVO::add (velocity, scratch.data(), num);
+    }
+
+    // 5. Clamp
+    for (size_t i = 0; i < n; ++i)
+        end[i] = juce::jmax (end[i], start[i] + minLengthBeats);
+
+    FVO::clip (velocity, velocity, 1.0f, 127.0f, num);
+}
+
+int QuantizeEngine::writeBack (const NoteArrays& notes, juce::UndoManager* undoManager)
+{
+    int numChanged = 0;
+
+    for (const auto& range : notes.clips)
+    {
+        for (size_t i = range.begin; i < range.end; ++i)
+        {
+            auto* note = notes.notes[i];
+            if (note == nullptr)
+                continue;
+
+            // Notes can't move before the start of their sequence
+            const double start = juce::jmax (0.0, notes.start[i] - range.beatOffset);
+            const double length = juce::jmax (minLengthBeats, notes.end[i] - range.beatOffset - start);
+            const int velocity = juce::jlimit (1, 127, juce::roundToInt (notes.velocity[i]));
+
+            bool changed = false;
+
+            if (std::abs (start - note->getStartBeat().inBeats()) > beatEpsilon
+                || std::abs (length - note->getLengthBeats().inBeats()) > beatEpsilon)
+            {
+                note->setStartAndLength (t::BeatPosition::fromBeats (start), t::BeatDuration::fromBeats (length), undoManager);
+                changed = true;
+            }
+
+            if (velocity != note->getVelocity())
+            {
+                note->setVelocity (velocity, undoManager);
+                changed = true;
+            }
+
+            if (changed)
+                ++numChanged;
+        }
+    }
+
+    return numChanged;
+}
+
+int QuantizeEngine::quantizeClips (const juce::Array<te::MidiClip*>& clips, const Settings& settings,
+                                   juce::UndoManager* undoManager)
+{
+    NoteArrays notes;
+    for (auto* clip : clips)
+        if (clip != nullptr)
+            notes.addClip (*clip);
+
+    process (settings, notes);
+    return writeBack (notes, undoManager);
+}
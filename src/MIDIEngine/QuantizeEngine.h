@@ -0,0 +1,153 @@
+#pragma once
+
+#include <tracktion_engine/tracktion_engine.h>
+
+#include <vector>
+
+namespace te = tracktion::engine;
+namespace t = tracktion;
+
+/**
+ * @brief Quantize, swing, groove and humanize for MIDI notes, one clip or a whole project.
+ *
+ * Notes are copied into packed arrays (NoteArrays: one array per field, in edit
+ * beats) and every stage runs as a pass over those arrays, using JUCE's
+ * vectorised FloatVectorOperations where the maths is element-wise:
+ *
+ *  1. Targets: the nearest grid line (with swing) or groove position per note.
+ *  2. Strength: start += strength * (target - start). Lengths are kept unless
+ *     quantizeEnds is set, in which case note ends are pulled to the grid as well.
+ *  3. Groove velocity: velocity moves towards the groove accent of its target.
+ *  4. Humanize: seeded random timing and velocity offsets.
+ *  5. Clamping: starts >= 0, lengths >= minLengthBeats, velocity 1..127.
+ *
+ * Only notes that actually changed are written back to their MidiLists, all inside
+ * the caller's undo transaction, so quantizing every clip in a project is one undo step.
+ *
+ * Groove templates come from the timing and accents of existing material: a MIDI
+ * clip, or onsets detected in an audio file. They replace the straight grid.
+ *
+ * Thread safety: message thread only (it edits the Edit's state).
+ */
+class QuantizeEngine
+{
+public:
+    //==============================================================================
+    // Groove templates
+
+    /** One period of hit positions and accents that notes snap to instead of the grid. */
+    struct GrooveTemplate
+    {
+        double lengthBeats = 1.0;           ///< Period of the groove (e.g. 1 beat, 4 beats)
+        std::vector<double> positions;      ///< Sorted hit positions in [0, lengthBeats)
+        std::vector<float> accents;         ///< Accent per position, 0..1 (same size as positions)
+
+        bool isValid() const noexcept       { return lengthBeats > 0.0 && ! positions.empty(); }
+
+        /**
+         * @brief Builds a groove from onsets by averaging them per grid slot.
+         *
+         * Each onset is assigned to its nearest grid slot within the period. The slot's
+         * position is the slot plus the weighted mean offset of its onsets. Its accent
+         * is the mean weight, normalised to the loudest slot. Slots with no onsets stay
+         * on the grid at the average accent.
+         *
+         * @param beats       Onset positions in beats
+         * @param weights     Onset strengths (any positive scale)
+         * @param lengthBeats Groove period in beats
+         * @param gridBeats   Slot spacing in beats
+         */
+        static GrooveTemplate fromOnsets (const std::vector<double>& beats, const std::vector<float>& weights,
+                                          double lengthBeats, double gridBeats);
+
+        /** Groove from a MIDI clip's note starts (edit beats) and velocities. */
+        static GrooveTemplate fromMidiClip (te::MidiClip& clip, double lengthBeats, double gridBeats);
+    };
+
+    /**
+     * @brief Detects note onsets in an audio file (energy rise with peak picking).
+     *
+     * Works on a mono mixdown in hops of onsetHopSize samples. A hop is an onset when
+     * its rise in RMS is a local maximum above mean + 1.5 standard deviations, and at
+     * least minOnsetGapSeconds after the previous onset.
+     *
+     * @param file     Audio file to analyse
+     * @param formats  Format manager used to open it
+     * @param seconds  Receives onset times in seconds from the start of the file
+     * @param weights  Receives the RMS level at each onset
+     * @return false if the file can't be read
+     */
+    static bool detectOnsets (const juce::File& file, juce::AudioFormatManager& formats,
+                              std::vector<double>& seconds, std::vector<float>& weights);
+
+    //==============================================================================
+    // Settings
+
+    struct Settings
+    {
+        double gridBeats = 0.25;                ///< Grid spacing in beats (0.25 = 1/16)
+        float strength = 1.0f;                  ///< 0 = unchanged, 1 = fully on the grid
+        float swing = 0.0f;                     ///< Delay of every other grid line, as a fraction of half a grid step
+        bool quantizeEnds = false;              ///< Also pull note ends to the grid (else lengths are kept)
+
+        const GrooveTemplate* groove = nullptr; ///< Replaces the grid when set and valid (not owned)
+        float grooveVelocity = 0.0f;            ///< How far velocities follow the groove accents, 0..1
+
+        double humanizeBeats = 0.0;             ///< Maximum random timing offset in beats (+/-)
+        float humanizeVelocity = 0.0f;          ///< Maximum random velocity offset (+/-)
+        juce::int64 seed = 1;                   ///< Random seed, so a humanize pass is repeatable
+    };
+
+    //==============================================================================
+    // Packed notes
+
+    /** Structure-of-arrays copy of notes from one or more clips, in edit beats. */
+    struct NoteArrays
+    {
+        std::vector<double> start, end;
+        std::vector<float> velocity;
+        std::vector<te::MidiNote*> notes;       ///< Source note for each entry
+
+        /** A run of entries that came from one clip. */
+        struct ClipRange
+        {
+            te::MidiClip* clip = nullptr;
+            size_t begin = 0, end = 0;
+            double beatOffset = 0.0;            ///< Edit beat of the clip's sequence beat 0
+        };
+        std::vector<ClipRange> clips;
+
+        /** Appends all notes of @p clip. */
+        void addClip (te::MidiClip& clip);
+
+        /** Appends @p selection, which must all belong to @p clip. */
+        void addNotes (te::MidiClip& clip, const juce::Array<te::MidiNote*>& selection);
+
+        /** Appends one note given in edit beats (no source; used by tests and benchmarks). */
+        void addNote (double startBeat, double endBeat, float vel);
+
+        size_t size() const noexcept            { return start.size(); }
+        void reserve (size_t num);
+        void clear();
+    };
+
+    /** Runs all stages of @p settings over @p notes in place. */
+    static void process (const Settings& settings, NoteArrays& notes);
+
+    /**
+     * @brief Writes processed notes back to their MidiLists.
+     *
+     * The caller opens the undo transaction. Unchanged notes are skipped.
+     *
+     * @return Number of notes that changed
+     */
+    static int writeBack (const NoteArrays& notes, juce::UndoManager* undoManager);
+
+    /** Loads every note of @p clips, processes them and writes them back. @return notes changed */
+    static int quantizeClips (const juce::Array<te::MidiClip*>& clips, const Settings& settings,
+                              juce::UndoManager* undoManager);
+
+    static constexpr int onsetHopSize = 512;
+    static constexpr double minOnsetGapSeconds = 0.05;
+    static constexpr double minLengthBeats = 1.0 / 64.0;
+};
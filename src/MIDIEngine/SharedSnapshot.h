@@ -0,0 +1,101 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Immutable data built on the message thread and read from real-time threads.
+ *
+ * publish() swaps a new snapshot in with one atomic store. A reader takes a
+ * ReadScope, which counts it as active for as long as it holds the pointer. A
+ * replaced snapshot is only retired, not deleted: it is freed by the first
+ * publish() or collect() that sees no reader active. Any reader that starts after
+ * the swap already gets the new snapshot, so none can still hold a freed one, no
+ * matter how many publishes happen during one read.
+ *
+ * Reading costs one atomic increment and one decrement, and never blocks or
+ * allocates. Under a constant stream of overlapping reads retired snapshots wait;
+ * owners with a tick call collect() from it.
+ *
+ * Thread safety: read() from any thread; everything else on the message thread.
+ */
+template <typename Snapshot>
+class SharedSnapshot
+{
+public:
+    SharedSnapshot() = default;
+
+    /** Readers must be gone by now. */
+    ~SharedSnapshot()
+    {
+        jassert (readers.load() == 0);
+        published.store (nullptr);
+    }
+
+    //==============================================================================
+    /** Holds the snapshot current when it was made until it goes out of scope. */
+    class ReadScope
+    {
+    public:
+        explicit ReadScope (const SharedSnapshot& s) noexcept
+            : owner (s)
+        {
+            owner.readers.fetch_add (1);
+            snapshot = owner.published.load();
+        }
+
+        ~ReadScope()                                        { owner.readers.fetch_sub (1); }
+
+        /** nullptr until the first publish(). */
+        const Snapshot* get() const noexcept                { return snapshot; }
+        const Snapshot* operator->() const noexcept         { return snapshot; }
+        explicit operator bool() const noexcept             { return snapshot != nullptr; }
+
+    private:
+        const SharedSnapshot& owner;
+        const Snapshot* snapshot = nullptr;
+
+        JUCE_DECLARE_NON_COPYABLE (ReadScope)
+    };
+
+    /** Any thread: the snapshot to read, valid while the scope lives. */
+    ReadScope read() const noexcept                         { return ReadScope (*this); }
+
+    //==============================================================================
+    /** Swaps @p next in and retires the one it replaces. */
+    void publish (std::unique_ptr<Snapshot> next)
+    {
+        published.store (next.get());
+
+        if (current != nullptr)
+            retired.push_back (std::move (current));
+
+        current = std::move (next);
+        collect();
+    }
+
+    /** Frees retired snapshots if no reader is active. */
+    void collect()
+    {
+        if (! retired.empty() && readers.load() == 0)
+            retired.clear();
+    }
+
+    /** The published snapshot, for the message thread (which is the only writer). */
+    Snapshot* getCurrent() const noexcept                   { return current.get(); }
+
+    /** Snapshots held: the current one plus those waiting to be freed. */
+    int getNumHeld() const noexcept                         { return (current != nullptr ? 1 : 0) + (int) retired.size(); }
+
+private:
+    std::atomic<Snapshot*> published { nullptr };
+    mutable std::atomic<int> readers { 0 };
+
+    std::unique_ptr<Snapshot> current;
+    std::vector<std::unique_ptr<Snapshot>> retired;
+
+    JUCE_DECLARE_NON_COPYABLE (SharedSnapshot)
+};
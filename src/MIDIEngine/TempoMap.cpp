@@ -0,0 +1,477 @@
+#include "TempoMap.h"
+#include "../AppEngine/ValidationUtils.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // Tracktion tempo curves: 1 holds the tempo until the next change, 0 ramps linearly to it.
+    constexpr float stepCurve = 1.0f;
+    constexpr float rampCurve = 0.0f;
+
+    constexpr double beatTolerance = 1.0e-6;
+
+    bool isRampCurve (float curve)
+    {
+        return std::abs (curve - stepCurve) > 0.001f;
+    }
+
+    /**
+     * Where clips, the loop range and the playhead sit in beats before a tempo edit.
+     * restore() moves them back onto those beats afterwards. Note data is already
+     * stored in beats inside each clip, so it is never rewritten.
+     *
+     * restore() rewrites the position of every clip in the edit (one undoable
+     * property change each), so it should run once per edit or gesture.
+     */
+    class BeatAnchors
+    {
+    public:
+        explicit BeatAnchors (te::Edit& edit)
+        {
+            auto& ts = edit.tempoSequence;
+            auto& transport = edit.getTransport();
+
+            loop = transport.getLoopRange();
+            loopStart = ts.toBeats (loop.getStart());
+            loopEnd = ts.toBeats (loop.getEnd());
+            playhead = ts.toBeats (transport.getPosition());
+
+            snapshot.savePreChangeState (edit);
+        }
+
+        void restore (te::Edit& edit)
+        {
+            auto& ts = edit.tempoSequence;
+            auto& transport = edit.getTransport();
+
+            snapshot.remapEdit (edit);
+
+            if (loop.getLength() > t::TimeDuration())
+                transport.setLoopRange ({ ts.toTime (loopStart), ts.toTime (loopEnd) });
+
+            if (! transport.isPlaying())
+                transport.setPosition (ts.toTime (playhead));
+        }
+
+    private:
+        te::EditTimecodeRemapperSnapshot snapshot;
+        t::TimeRange loop;
+        t::BeatPosition loopStart, loopEnd, playhead;
+    };
+
+    /** Applies a tempo edit, keeping everything on its bar/beat position. */
+    template <typename Fn>
+    void changePreservingBeats (te::Edit& edit, Fn&& change)
+    {
+        BeatAnchors anchors (edit);
+        change();
+        anchors.restore (edit);
+    }
+}
+
+/** The anchors of a tempo gesture in progress, restored when it ends. */
+struct TempoMap::Gesture
+{
+    explicit Gesture (te::Edit& e) : edit (&e), anchors (e) {}
+
+    te::Edit* edit;
+    BeatAnchors anchors;
+};
+
+//==============================================================================
+TempoMap::TempoMap (te::Edit& e)
+    : edit (&e),
+      tempoState (e.state.getChildWithName (te::IDs::TEMPOSEQUENCE))
+{
+    tempoState.addListener (this);
+}
+
+TempoMap::~TempoMap()
+{
+    tempoState.removeListener (this);
+}
+
+void TempoMap::setEdit (te::Edit& newEdit)
+{
+    // A gesture on the old edit can't be finished on this one
+    gesture.reset();
+
+    tempoState.removeListener (this);
+
+    edit = &newEdit;
+    tempoState = newEdit.state.getChildWithName (te::IDs::TEMPOSEQUENCE);
+    tempoState.addListener (this);
+
+    markDirty();
+}
+
+//==============================================================================
+// Table
+
+void TempoMap::rebuildIfNeeded() const
+{
+    if (! dirty)
+        return;
+
+    dirty = false;
+    knots.clear();
+
+    auto& ts = edit->tempoSequence;
+    const int numTempos = ts.getNumTempos();
+
+    auto addKnot = [this, &ts] (double beat)
+    {
+        if (knots.empty() || beat > knots.back().beat + beatTolerance)
+            knots.push_back ({ beat, ts.toTime (t::BeatPosition::fromBeats (beat)).inSeconds() });
+    };
+
+    for (int i = 0; i < numTempos; ++i)
+    {
+        const double startBeat = ts.getTempo (i)->getStartBeat().inBeats();
+        addKnot (startBeat);
+
+        if (i + 1 >= numTempos)
+            break;
+
+        const double endBeat = ts.getTempo (i + 1)->getStartBeat().inBeats();
+        if (endBeat <= startBeat + beatTolerance)
+            continue;
+
+        // A ramp shows up as a midpoint that isn't halfway in time; only those need extra knots.
+        const double startSec = knots.back().seconds;
+        const double endSec   = ts.toTime (t::BeatPosition::fromBeats (endBeat)).inSeconds();
+        const double midSec   = ts.toTime (t::BeatPosition::fromBeats ((startBeat + endBeat) * 0.5)).inSeconds();
+
+        if (std::abs (midSec - (startSec + endSec) * 0.5) > 1.0e-9)
+        {
+            const int pieces = juce::jlimit (2, 4096, (int) std::ceil ((endBeat - startBeat) * rampKnotsPerBeat));
+
+            for (int p = 1; p < pieces; ++p)
+                addKnot (startBeat + (endBeat - startBeat) * (double) p / (double) pieces);
+        }
+    }
+
+    if (knots.empty())
+        knots.push_back ({ 0.0, 0.0 });
+
+    firstSecondsPerBeat = numTempos > 0 ? 60.0 / ts.getTempo (0)->getBpm() : 0.5;
+    lastSecondsPerBeat  = numTempos > 0 ? 60.0 / ts.getTempo (numTempos - 1)->getBpm() : 0.5;
+}
+
+void TempoMap::markDirty()
+{
+    dirty = true;
+    sendChangeMessage();   // async and coalesced, so bursts of tree changes cost one callback
+}
+
+size_t TempoMap::findKnotForBeat (double beat) const
+{
+    auto it = std::upper_bound (knots.begin(), knots.end(), beat,
+                                [] (double b, const Knot& k) { return b < k.beat; });
+
+    return it == knots.begin() ? 0 : (size_t) std::distance (knots.begin(), it) - 1;
+}
+
+size_t TempoMap::findKnotForSeconds (double seconds) const
+{
+    auto it = std::upper_bound (knots.begin(), knots.end(), seconds,
+                                [] (double s, const Knot& k) { return s < k.seconds; });
+
+    return it == knots.begin() ? 0 : (size_t) std::distance (knots.begin(), it) - 1;
+}
+
+double TempoMap::beatToSecondsFrom (size_t k, double beat) const
+{
+    const auto& a = knots[k];
+
+    if (beat < a.beat)
+        return a.seconds + (beat - a.beat) * firstSecondsPerBeat;
+
+    if (k + 1 < knots.size())
+    {
+        const auto& b = knots[k + 1];
+        return a.seconds + (beat - a.beat) * (b.seconds - a.seconds) / (b.beat - a.beat);
+    }
+
+    return a.seconds + (beat - a.beat) * lastSecondsPerBeat;
+}
+
+double TempoMap::secondsToBeatFrom (size_t k, double seconds) const
+{
+    const auto& a = knots[k];
+
+    if (seconds < a.seconds)
+        return a.beat + (seconds - a.seconds) / firstSecondsPerBeat;
+
+    if (k + 1 < knots.size())
+    {
+        const auto& b = knots[k + 1];
+        return a.beat + (seconds - a.seconds) * (b.beat - a.beat) / (b.seconds - a.seconds);
+    }
+
+    return a.beat + (seconds - a.seconds) / lastSecondsPerBeat;
+}
+
+//==============================================================================
+// Conversion
+
+t::TimePosition TempoMap::toTime (t::BeatPosition beat) const
+{
+    rebuildIfNeeded();
+    const double b = beat.inBeats();
+    return t::TimePosition::fromSeconds (beatToSecondsFrom (findKnotForBeat (b), b));
+}
+
+t::BeatPosition TempoMap::toBeats (t::TimePosition time) const
+{
+    rebuildIfNeeded();
+    const double s = time.inSeconds();
+    return t::BeatPosition::fromBeats (secondsToBeatFrom (findKnotForSeconds (s), s));
+}
+
+void TempoMap::beatsToSeconds (const double* beats, double* secondsOut, size_t num) const
+{
+    rebuildIfNeeded();
+
+    size_t k = 0;
+    for (size_t i = 0; i < num; ++i)
+    {
+        const double b = beats[i];
+
+        if (b < knots[k].beat)
+            k = findKnotForBeat (b);
+        else
+            while (k + 1 < knots.size() && b >= knots[k + 1].beat)
+                ++k;
+
+        secondsOut[i] = beatToSecondsFrom (k, b);
+    }
+}
+
+void TempoMap::secondsToBeats (const double* seconds, double* beatsOut, size_t num) const
+{
+    rebuildIfNeeded();
+
+    size_t k = 0;
+    for (size_t i = 0; i < num; ++i)
+    {
+        const double s = seconds[i];
+
+        if (s < knots[k].seconds)
+            k = findKnotForSeconds (s);
+        else
+            while (k + 1 < knots.size() && s >= knots[k + 1].seconds)
+                ++k;
+
+        beatsOut[i] = secondsToBeatFrom (k, s);
+    }
+}
+
+double TempoMap::getBpmAt (t::BeatPosition beat) const
+{
+    rebuildIfNeeded();
+
+    const double b = beat.inBeats();
+    const size_t k = findKnotForBeat (b);
+
+    if (b < knots[k].beat || k + 1 >= knots.size())
+        return 60.0 / (b < knots[k].beat ? firstSecondsPerBeat : lastSecondsPerBeat);
+
+    const auto& a = knots[k];
+    const auto& n = knots[k + 1];
+    return 60.0 * (n.beat - a.beat) / (n.seconds - a.seconds);
+}
+
+size_t TempoMap::getNumKnots() const
+{
+    rebuildIfNeeded();
+    return knots.size();
+}
+
+//==============================================================================
+// Editing
+
+std::vector<TempoMap::TempoChange> TempoMap::getTempoChanges() const
+{
+    auto& ts = edit->tempoSequence;
+    const int numTempos = ts.getNumTempos();
+
+    std::vector<TempoChange> changes;
+    changes.reserve ((size_t) numTempos);
+
+    for (int i = 0; i < numTempos; ++i)
+    {
+        auto* tempo = ts.getTempo (i);
+        changes.push_back ({ tempo->getStartBeat().inBeats(),
+                             tempo->getBpm(),
+                             i + 1 < numTempos && isRampCurve (tempo->getCurve()) });
+    }
+
+    return changes;
+}
+
+int TempoMap::setTempoAt (double beat, double bpm, bool ramp)
+{
+    beat = juce::jmax (0.0, beat);
+    bpm  = ValidationUtils::constrainAndRoundBpm (bpm);
+
+    auto& ts = edit->tempoSequence;
+
+    changePreservingBeats (*edit, [&]
+    {
+        for (int i = 0; i < ts.getNumTempos(); ++i)
+        {
+            if (auto* tempo = ts.getTempo (i); std::abs (tempo->getStartBeat().inBeats() - beat) < beatTolerance)
+            {
+                tempo->setBpm (bpm);
+                tempo->setCurve (ramp ? rampCurve : stepCurve);
+                return;
+            }
+        }
+
+        ts.insertTempo (t::BeatPosition::fromBeats (beat), bpm, ramp ? rampCurve : stepCurve);
+    });
+
+    markDirty();
+
+    const auto changes = getTempoChanges();
+    for (size_t i = 0; i < changes.size(); ++i)
+        if (std::abs (changes[i].beat - beat) < beatTolerance)
+            return (int) i;
+
+    return -1;
+}
+
+void TempoMap::setTempoChangeBpm (int index, double bpm)
+{
+    if (auto* tempo = edit->tempoSequence.getTempo (index))
+    {
+        const auto change = [&] { tempo->setBpm (ValidationUtils::constrainAndRoundBpm (bpm)); };
+
+        // Inside a gesture only the tempo moves; clips follow once, in endGesture()
+        if (gesture != nullptr)
+            change();
+        else
+            changePreservingBeats (*edit, change);
+
+        markDirty();
+    }
+}
+
+void TempoMap::beginGesture()
+{
+    if (gesture == nullptr)
+        gesture = std::make_unique<Gesture> (*edit);
+}
+
+void TempoMap::endGesture()
+{
+    if (auto g = std::move (gesture))
+    {
+        g->anchors.restore (*g->edit);
+        markDirty();
+    }
+}
+
+void TempoMap::setTempoChangeRamp (int index, bool ramp)
+{
+    if (auto* tempo = edit->tempoSequence.getTempo (index))
+    {
+        changePreservingBeats (*edit, [&] { tempo->setCurve (ramp ? rampCurve : stepCurve); });
+        markDirty();
+    }
+}
+
+void TempoMap::removeTempoChange (int index)
+{
+    if (index <= 0 || index >= edit->tempoSequence.getNumTempos())
+        return;
+
+    edit->tempoSequence.removeTempo (index, true);
+    markDirty();
+}
+
+void TempoMap::clearTempoChanges()
+{
+    auto& ts = edit->tempoSequence;
+
+    changePreservingBeats (*edit, [&]
+    {
+        for (int i = ts.getNumTempos(); --i > 0;)
+            ts.removeTempo (i, false);
+    });
+
+    markDirty();
+}
+
+int TempoMap::countTempoEvents (const juce::MidiFile& file)
+{
+    juce::MidiMessageSequence tempoEvents;
+    file.findAllTempoEvents (tempoEvents);
+    return tempoEvents.getNumEvents();
+}
+
+int TempoMap::importFromMidiFile (const juce::MidiFile& file, double beatOffset, double fileStartBeat)
+{
+    const int ppq = file.getTimeFormat();
+    if (ppq <= 0)
+        return 0;   // SMPTE timing has no beats to map
+
+    juce::MidiMessageSequence tempoEvents;
+    file.findAllTempoEvents (tempoEvents);
+
+    if (tempoEvents.getNumEvents() == 0)
+        return 0;
+
+    auto& ts = edit->tempoSequence;
+    int written = 0;
+
+    changePreservingBeats (*edit, [&]
+    {
+        for (int i = ts.getNumTempos(); --i > 0;)
+            if (ts.getTempo (i)->getStartBeat().inBeats() > beatOffset + beatTolerance)
+                ts.removeTempo (i, false);
+
+        for (int i = 0; i < tempoEvents.getNumEvents(); ++i)
+        {
+            const auto& msg = tempoEvents.getEventPointer (i)->message;
+            const double secondsPerQuarter = msg.getTempoSecondsPerQuarterNote();
+
+            if (secondsPerQuarter <= 0.0)
+                continue;
+
+            const double fileBeat = msg.getTimeStamp() / (double) ppq;
+            const double beat     = beatOffset + juce::jmax (0.0, fileBeat - fileStartBeat);
+            const double bpm      = ValidationUtils::constrainAndRoundBpm (60.0 / secondsPerQuarter);
+
+            bool updated = false;
+            for (int j = 0; j < ts.getNumTempos() && ! updated; ++j)
+            {
+                if (auto* tempo = ts.getTempo (j); std::abs (tempo->getStartBeat().inBeats() - beat) < beatTolerance)
+                {
+                    tempo->setBpm (bpm);
+                    tempo->setCurve (stepCurve);
+                    updated = true;
+                }
+            }
+
+            if (! updated)
+                ts.insertTempo (t::BeatPosition::fromBeats (beat), bpm, stepCurve);
+
+            ++written;
+        }
+    });
+
+    markDirty();
+    return written;
+}
+
+//==============================================================================
+// juce::ValueTree::Listener
+
+void TempoMap::valueTreePropertyChanged (juce::ValueTree&, const juce::Identifier&) { markDirty(); }
+void TempoMap::valueTreeChildAdded (juce::ValueTree&, juce::ValueTree&)            { markDirty(); }
+void TempoMap::valueTreeChildRemoved (juce::ValueTree&, juce::ValueTree&, int)     { markDirty(); }
+void TempoMap::valueTreeChildOrderChanged (juce::ValueTree&, int, int)             { markDirty(); }
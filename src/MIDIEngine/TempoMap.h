@@ -0,0 +1,168 @@
+#pragma once
+
+#include "tracktion_graph/tracktion_graph.h"
+#include <tracktion_engine/tracktion_engine.h>
+
+#include <memory>
+#include <vector>
+
+namespace te = tracktion::engine;
+namespace t = tracktion;
+
+/**
+ * @brief GrooveKit's view of an Edit's tempo sequence: editing plus fast beat/time conversion.
+ *
+ * The Edit's te::TempoSequence stays the source of truth (it drives playback and is
+ * saved with the Edit). TempoMap adds two things on top of it:
+ *
+ *  - Editing: tempo changes at a beat, optionally ramping to the next change, and
+ *    import of a Standard MIDI File's tempo map. Clips keep their bar/beat
+ *    positions across every edit.
+ *  - Conversion: a precomputed, piecewise-linear table of (beat, seconds) knots.
+ *    Constant-tempo sections need one knot; ramps are subdivided so the table
+ *    matches Tracktion's own conversion at every knot. Lookups are a binary search
+ *    (O(log n)); the batched overloads walk the table with a cursor when the input
+ *    is sorted, which is the common case for clip and note layout.
+ *
+ * The table is rebuilt lazily on the first lookup after the tempo sequence changes
+ * (including undo/redo), and ChangeListeners are told asynchronously.
+ *
+ * Thread safety: message thread only.
+ *
+ * Usage:
+ *  - Owned by AppEngine for the whole session and moved to each new Edit with
+ *    setEdit(), so views may keep a reference (and stay registered as listeners)
+ *    across edit loads.
+ *  - UI and engine code should convert through AppEngine::getTempoMap() rather
+ *    than calling edit.tempoSequence directly.
+ */
+class TempoMap : public juce::ChangeBroadcaster,
+                 private juce::ValueTree::Listener
+{
+public:
+    /** One tempo change, as shown in the tempo track. */
+    struct TempoChange
+    {
+        double beat = 0.0;      ///< Position of the change in beats.
+        double bpm  = 120.0;    ///< Tempo at this change.
+        bool ramp   = false;    ///< True if the tempo ramps towards the next change.
+    };
+
+    explicit TempoMap (te::Edit& edit);
+    ~TempoMap() override;
+
+    /** Follows @p newEdit's tempo sequence from now on; listeners are told the map changed. */
+    void setEdit (te::Edit& newEdit);
+
+    //==============================================================================
+    // Conversion
+
+    t::TimePosition toTime  (t::BeatPosition beat) const;
+    t::BeatPosition toBeats (t::TimePosition time) const;
+
+    /**
+     * @brief Converts many beat positions to seconds in one pass.
+     *
+     * Sorted input is converted in O(n + segments); unsorted input still works
+     * (each out-of-order value falls back to a binary search).
+     */
+    void beatsToSeconds (const double* beats, double* secondsOut, size_t num) const;
+
+    /** Batched inverse of beatsToSeconds(). */
+    void secondsToBeats (const double* seconds, double* beatsOut, size_t num) const;
+
+    /** Tempo in effect at @p beat (interpolated inside ramps). */
+    double getBpmAt (t::BeatPosition beat) const;
+
+    /** Number of knots in the conversion table (diagnostics/tests). */
+    size_t getNumKnots() const;
+
+    //==============================================================================
+    // Editing
+
+    /** All tempo changes, in beat order. The first one is always at beat 0. */
+    std::vector<TempoChange> getTempoChanges() const;
+
+    /**
+     * @brief Adds a tempo change, or updates the one already at @p beat.
+     *
+     * @param beat Position in beats (clamped to >= 0).
+     * @param bpm  Tempo (clamped to the Edit's valid range).
+     * @param ramp True to ramp linearly to the following change.
+     * @return Index of the change in getTempoChanges().
+     */
+    int setTempoAt (double beat, double bpm, bool ramp = false);
+
+    /** Changes a tempo; inside a gesture, clips only catch up when it ends. */
+    void setTempoChangeBpm  (int index, double bpm);
+    void setTempoChangeRamp (int index, bool ramp);
+
+    /**
+     * @brief Starts a continuous tempo edit, such as dragging a tempo change.
+     *
+     * Keeping clips on their beats rewrites every clip's position. Between
+     * beginGesture() and endGesture(), setTempoChangeBpm() only changes the tempo,
+     * and the clips, loop range and playhead are moved back onto their beats once,
+     * when the gesture ends. Until then they keep their times.
+     */
+    void beginGesture();
+    void endGesture();
+    bool isInGesture() const noexcept   { return gesture != nullptr; }
+
+    /** Removes a tempo change. The first change (beat 0) can't be removed. */
+    void removeTempoChange (int index);
+
+    /** Removes every change except the first, leaving a single tempo. */
+    void clearTempoChanges();
+
+    /**
+     * @brief Replaces the tempo map from a Standard MIDI File's tempo meta events.
+     *
+     * The file's beat @p fileStartBeat lands on the Edit's beat @p beatOffset (the
+     * MIDI importer trims leading silence). Tempo events before that point set the
+     * tempo at @p beatOffset; existing changes after it are replaced.
+     *
+     * @return Number of tempo changes written (0 if the file has no tempo events).
+     */
+    int importFromMidiFile (const juce::MidiFile& file, double beatOffset, double fileStartBeat = 0.0);
+
+    /** Number of tempo meta events in @p file. */
+    static int countTempoEvents (const juce::MidiFile& file);
+
+private:
+    struct Knot
+    {
+        double beat;
+        double seconds;
+    };
+
+    void rebuildIfNeeded() const;
+    void markDirty();
+
+    size_t findKnotForBeat    (double beat) const;
+    size_t findKnotForSeconds (double seconds) const;
+    double beatToSecondsFrom  (size_t knot, double beat) const;
+    double secondsToBeatFrom  (size_t knot, double seconds) const;
+
+    // juce::ValueTree::Listener
+    void valueTreePropertyChanged (juce::ValueTree&, const juce::Identifier&) override;
+    void valueTreeChildAdded (juce::ValueTree&, juce::ValueTree&) override;
+    void valueTreeChildRemoved (juce::ValueTree&, juce::ValueTree&, int) override;
+    void valueTreeChildOrderChanged (juce::ValueTree&, int, int) override;
+
+    /** Knots per beat used when subdividing a ramp. */
+    static constexpr double rampKnotsPerBeat = 16.0;
+
+    struct Gesture;
+    std::unique_ptr<Gesture> gesture;   ///< Set between beginGesture() and endGesture()
+
+    te::Edit* edit;             ///< Current Tracktion Edit (not owned)
+    juce::ValueTree tempoState; ///< The Edit's TEMPOSEQUENCE tree (kept alive for the listener)
+
+    mutable std::vector<Knot> knots;
+    mutable double firstSecondsPerBeat = 0.5;  ///< Used before the first knot
+    mutable double lastSecondsPerBeat  = 0.5;  ///< Used after the last knot
+    mutable bool dirty = true;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TempoMap)
+};
@@ -1,4 +1,5 @@
 #include "PluginManager.h"
+#include "SandboxedPlugin.h"
 
 //==============================================================================
 // Local helpers
@@ -17,7 +18,9 @@ namespace
 // Construction
 
 PluginManager::PluginManager (te::Edit& e, const Settings& s)
-    : edit (e), settings (s)
+    : edit (e), settings (s),
+      formatManager (e.engine.getPluginManager().pluginFormatManager),
+      knownPlugins  (e.engine.getPluginManager().knownPluginList)
 {
     auto base = ensureDir (settings.appDataDir);
     knownListFile = base.getChildFile ("KnownPlugins.xml");
@@ -28,20 +31,36 @@ PluginManager::PluginManager (te::Edit& e, const Settings& s)
     loadKnownListFromDisk();
 }
 
+PluginManager::~PluginManager()
+{
+    if (scanJob != nullptr)
+        scanJob->stopThread (10000);
+}
+
 //==============================================================================
 // Format initialisation
 
 void PluginManager::initFormats()
 {
+    auto hasFormat = [this] (const juce::String& name)
+    {
+        for (auto* format : formatManager.getFormats())
+            if (format->getName() == name)
+                return true;
+        return false;
+    };
+
    #if JUCE_PLUGINHOST_AU
-    if (settings.scanAudioUnits)
+    if (settings.scanAudioUnits && ! hasFormat (juce::AudioUnitPluginFormat::getFormatName()))
         formatManager.addFormat (std::make_unique<juce::AudioUnitPluginFormat>());
    #endif
 
    #if JUCE_PLUGINHOST_VST3
-    if (settings.scanVST3)
+    if (settings.scanVST3 && ! hasFormat (juce::VST3PluginFormat::getFormatName()))
         formatManager.addFormat (std::make_unique<juce::VST3PluginFormat>());
    #endif
+
+    juce::ignoreUnused (hasFormat);
 }
 
 //==============================================================================
@@ -111,115 +130,106 @@ juce::FileSearchPath PluginManager::buildSearchPaths() const
 }
 
 //==============================================================================
-// Scanning control
-
-void PluginManager::startNextFormatScan (bool reset)
+// Background scanning
+
+/**
+ * Scans every format into a private list on its own thread, then hands the
+ * result back to the message thread. The shared catalogue is never touched
+ * from this thread.
+ */
+class PluginManager::ScanJob : public juce::Thread
 {
-    juce::ignoreUnused (reset);
-
-    if (currentFormatIndex >= formatManager.getNumFormats())
+public:
+    ScanJob (PluginManager& o, const juce::KnownPluginList& seed)
+        : juce::Thread ("GrooveKit Plugin Scan"),
+          owner (o),
+          searchPaths (o.buildSearchPaths()),
+          deadMansFile (o.deadMansFile)
     {
-        scanner.reset();
-        saveKnownListToDisk();
-        stopTimer();
-        return;
+        if (auto xml = seed.createXml())
+            scratch.recreateFromXml (*xml);
     }
 
-    auto* format = formatManager.getFormat (currentFormatIndex++);
-
-    scanner = std::make_unique<juce::PluginDirectoryScanner> (
-        knownPlugins,
-        *format,
-        buildSearchPaths(),
-        /* searchRecursively */ true,
-        deadMansFile,
-        /* allowAsyncInstantiation */ true);
-
-    startTimerHz (30); // Pump scanner in timerCallback.
-}
-
-void PluginManager::startScanner (bool reset)
-{
-    currentFormatIndex = 0;
-    startNextFormatScan (reset);
-
-    if (scanner != nullptr)
-        return;
-
-    // Fallback path: only executes if startNextFormatScan did not create a scanner.
-    auto searchPaths = buildSearchPaths();
+    void run() override
+    {
+        for (auto* format : owner.formatManager.getFormats())
+        {
+            juce::PluginDirectoryScanner scanner (scratch,
+                                                  *format,
+                                                  searchPaths,
+                                                  /* searchRecursively */ true,
+                                                  deadMansFile,
+                                                  /* allowAsyncInstantiation */ true);
+
+            juce::String discovered;
+            while (! threadShouldExit() && scanner.scanNextFile (true, discovered))
+            {
+            }
+        }
 
-    if (! scannerThread)
-        scannerThread = std::make_unique<juce::TimeSliceThread> ("PluginScanThread");
+        if (threadShouldExit())
+            return;
 
-    if (! scannerThread->isThreadRunning())
-        scannerThread->startThread();
+        // Drop plugins that were uninstalled since the cache was written.
+        for (const auto& type : scratch.getTypes())
+            if (! owner.formatManager.doesPluginStillExist (type))
+                scratch.removeType (type);
 
-    if (formatManager.getNumFormats() > 0)
-    {
-        auto* format = formatManager.getFormat (0);
+        std::shared_ptr<juce::XmlElement> result (scratch.createXml().release());
+        juce::WeakReference<PluginManager> weakOwner (&owner);
 
-        scanner = std::make_unique<juce::PluginDirectoryScanner> (
-            knownPlugins,
-            *format,
-            searchPaths,
-            /* searchRecursively */ true,
-            /* deadMansPedalFile */ deadMansFile,
-            /* allowAsyncInstantiation */ true);
-
-        startTimerHz (30);
+        juce::MessageManager::callAsync ([weakOwner, result]
+        {
+            if (auto* pm = weakOwner.get(); pm != nullptr && result != nullptr)
+                pm->applyScanResult (*result);
+        });
     }
-}
 
-void PluginManager::timerCallback()
+private:
+    PluginManager& owner;
+    juce::KnownPluginList scratch;
+    const juce::FileSearchPath searchPaths;
+    const juce::File deadMansFile;
+};
+
+void PluginManager::startBackgroundScan (bool fullRescan)
 {
-    if (! scanner)
-    {
-        stopTimer();
+    if (scanJob != nullptr)
         return;
-    }
-
-    juce::String discovered;
-    int pumped = 0;
-    constexpr int maxPerTick = 8;
 
-    // Pump a limited number of files per timer tick to keep the UI responsive.
-    while (pumped++ < maxPerTick && scanner->scanNextFile (true, discovered))
+    // A full rescan keeps only the blacklist; otherwise up-to-date entries are skipped.
+    juce::KnownPluginList seed;
+    if (fullRescan)
     {
-        // `discovered` is intentionally unused here; we only care about
-        // progressing the scanner.
+        for (const auto& path : knownPlugins.getBlacklistedFiles())
+            seed.addToBlacklist (path);
     }
-
-    // Check if scanning is finished (using a non-advancing call).
-    if (! scanner->scanNextFile (false, discovered))
+    else if (auto xml = knownPlugins.createXml())
     {
-        stopTimer();
-        scanner.reset();
-
-        startNextFormatScan (/* reset */ false);
-        saveKnownListToDisk();
+        seed.recreateFromXml (*xml);
     }
+
+    scanJob = std::make_unique<ScanJob> (*this, seed);
+    scanJob->startThread (juce::Thread::Priority::background);
 }
 
-void PluginManager::pumpScannerUntilDone (juce::String progressPrefix)
+void PluginManager::applyScanResult (const juce::XmlElement& scannedList)
 {
-    juce::ignoreUnused (progressPrefix);
-    jassert (scanner != nullptr);
-
-    juce::String pluginName;
+    JUCE_ASSERT_MESSAGE_THREAD
 
-    // Simple loop for blocking mode; async callers should not use this.
-    while (scanner && scanner->scanNextFile (true, pluginName))
+    if (scanJob != nullptr)
     {
-        // `pluginName` and `progressPrefix` could be used for logging or
-        // progress reporting if needed.
+        scanJob->stopThread (2000);
+        scanJob.reset();
     }
 
-    if (scanner)
-    {
-        scanner.reset();
-        saveKnownListToDisk();
-    }
+    knownPlugins.recreateFromXml (scannedList);
+    saveKnownListToDisk();
+
+    DBG ("[PluginManager] Catalogue updated: " + juce::String (knownPlugins.getNumTypes()) + " plugins");
+
+    if (onCatalogueChanged)
+        onCatalogueChanged();
 }
 
 //==============================================================================
@@ -227,7 +237,7 @@ void PluginManager::pumpScannerUntilDone (juce::String progressPrefix)
 
 void PluginManager::scanForPluginsAsync()
 {
-    startScanner (/* reset */ false);
+    startBackgroundScan (/* fullRescan */ false);
 }
 
 void PluginManager::scanForPluginsBlocking()
@@ -264,7 +274,7 @@ void PluginManager::rescanAsync (bool clearBlacklistFirst)
         blacklistFile.deleteFile();
     }
 
-    startScanner (/* reset */ true);
+    startBackgroundScan (/* fullRescan */ true);
 }
 
 //==============================================================================
@@ -316,6 +326,40 @@ te::Plugin::Ptr PluginManager::addExternalInstrumentToTrack (te::AudioTrack& tra
                                                              const juce::PluginDescription& desc,
                                                              int insertIndex)
 {
+    if (settings.sandboxExternalPlugins)
+    {
+        auto plugin = track.edit.getPluginCache().createNewPlugin (SandboxedPlugin::createState (desc));
+
+        if (! plugin)
+            return {};
+
+        track.pluginList.insertPlugin (plugin, insertIndex, nullptr);
+        auto* inserted = track.pluginList[insertIndex];
+
+        // The worker reports the load later; a plugin it can't load is removed like an in-process one
+        if (auto* sandboxed = dynamic_cast<SandboxedPlugin*> (inserted))
+        {
+            sandboxed->onLoadFailed = [this, sandboxed, name = desc.name] (const juce::String& error)
+            {
+                // Not from inside the plugin's own message handler
+                juce::MessageManager::callAsync ([this, p = te::Plugin::Ptr (sandboxed), name, error]
+                {
+                    auto* owner = dynamic_cast<te::AudioTrack*> (p->getOwnerTrack());
+
+                    if (owner == nullptr)
+                        return;
+
+                    p->deleteFromParent();
+
+                    if (onPluginLoadFailed)
+                        onPluginLoadFailed (*owner, name, error);
+                });
+            };
+        }
+
+        return inserted;
+    }
+
     auto* descPtr = const_cast<juce::PluginDescription*> (&desc);
 
     auto plugin = track.edit.getPluginCache()
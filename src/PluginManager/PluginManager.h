@@ -5,16 +5,24 @@
 namespace te = tracktion::engine;
 
 /**
- * @brief Manages discovery and instantiation of external audio plugins.
+ * @brief Owns GrooveKit's single plugin catalogue and inserts external plugins.
  *
- * PluginManager wraps Tracktion Engine's plugin scanning and known-list
- * functionality for a given Edit. It:
- *  - Scans AU/VST3 (depending on settings and platform).
- *  - Persists the known-plugin list, blacklist, and dead-man's file.
+ * There is exactly one known-plugin list: Tracktion Engine's
+ * te::PluginManager::knownPluginList, which ExternalPlugin resolves against.
+ * This class operates on that list (and the engine's format manager) directly,
+ * so the browser menus and the engine can never disagree or scan twice.
+ *
+ * It:
+ *  - Loads the catalogue from an on-disk cache at construction (milliseconds,
+ *    no plugin is probed).
+ *  - Rescans on a background thread into a scratch list seeded from the current
+ *    catalogue (unchanged files are skipped), then swaps the result into the
+ *    shared list in one step on the message thread.
+ *  - Persists the catalogue, blacklist and dead-man's file.
  *  - Provides helpers for inserting external instrument/effect plugins
  *    onto AudioTracks.
  */
-class PluginManager : private juce::Timer
+class PluginManager
 {
 public:
     //==============================================================================
@@ -29,6 +37,7 @@ public:
         juce::File appDataDir; ///< Directory where known plugins, blacklist, etc. are stored.
         bool scanAudioUnits = true; ///< Whether to scan AudioUnit plugins (macOS only).
         bool scanVST3       = true; ///< Whether to scan VST3 plugins.
+        bool sandboxExternalPlugins = false; ///< Host newly inserted external plugins in worker processes (SandboxedPlugin).
     };
 
     //==============================================================================
@@ -37,23 +46,27 @@ public:
     /**
      * @brief Constructs a PluginManager for the given Edit using the provided settings.
      *
-     * This will initialise plugin formats and attempt to load a previously
-     * saved known-plugin list and blacklist from disk.
+     * Registers the configured formats with the engine's format manager and
+     * loads the cached catalogue and blacklist from disk. Does not scan.
      *
      * @param edit      Tracktion Edit this PluginManager is associated with.
      * @param settings  Scanning and persistence settings.
      */
     explicit PluginManager (te::Edit& edit, const Settings& settings);
 
+    /** Stops any background scan (waiting for the current file to finish). */
+    ~PluginManager();
+
     //==============================================================================
     // Scanning API
 
     /**
-     * @brief Starts an asynchronous plugin scan using the current settings.
+     * @brief Starts a background scan using the current settings.
      *
-     * Use isScanRunning() to check progress. When scanning completes, the
-     * known-plugin list and blacklist will be written to disk automatically
-     * (or you can call saveKnownListToDisk() explicitly).
+     * Returns immediately. Files already in the catalogue and unchanged on disk
+     * are skipped. When the scan finishes, the shared catalogue is replaced in
+     * one step on the message thread, written to disk, and onCatalogueChanged
+     * is called. Does nothing if a scan is already running.
      */
     void scanForPluginsAsync();
 
@@ -61,29 +74,37 @@ public:
      * @brief Performs a blocking scan over all supported plugin formats.
      *
      * This call does not return until the scan has completed. On completion,
-     * the known-plugin list and blacklist are written to disk.
+     * the catalogue and blacklist are written to disk.
      */
     void scanForPluginsBlocking();
 
     /**
-     * @brief Starts an asynchronous rescan of plugins.
+     * @brief Starts a full background rescan of plugins.
+     *
+     * Unlike scanForPluginsAsync(), every file is probed again.
      *
      * @param clearBlacklistFirst  If true, clears the blacklist in memory and
      *                             deletes the on-disk blacklist file before scanning.
      */
     void rescanAsync (bool clearBlacklistFirst = false);
 
+    /** Called on the message thread after a background scan has updated the catalogue. */
+    std::function<void()> onCatalogueChanged;
+
+    /** Called on the message thread after a sandboxed plugin failed to load in its worker and was removed from @p track. */
+    std::function<void (te::AudioTrack& track, const juce::String& pluginName, const juce::String& error)> onPluginLoadFailed;
+
     //==============================================================================
     // State inspection / persistence
 
-    /** @brief Returns true while an asynchronous scan is in progress. */
-    bool isScanRunning() const noexcept                 { return scanner != nullptr; }
+    /** @brief Returns true while a background scan is in progress. */
+    bool isScanRunning() const noexcept                 { return scanJob != nullptr; }
 
-    /** @brief Returns the current known plugin list. */
+    /** @brief Returns the shared catalogue (the engine's known plugin list). */
     const juce::KnownPluginList& getKnownList() const noexcept { return knownPlugins; }
 
     /**
-     * @brief Loads the known-plugin list and blacklist from disk if present.
+     * @brief Loads the catalogue and blacklist from disk if present.
      *
      * Normally called during construction. Safe to call again to re-sync
      * from disk.
@@ -91,7 +112,7 @@ public:
     void loadKnownListFromDisk();
 
     /**
-     * @brief Writes the known-plugin list and blacklist to disk.
+     * @brief Writes the catalogue and blacklist to disk.
      */
     void saveKnownListToDisk() const;
 
@@ -113,6 +134,17 @@ public:
      */
     juce::OwnedArray<juce::PluginDescription> getInstrumentDescriptions() const;
 
+    //==============================================================================
+    // Sandboxing
+
+    /**
+     * @brief Hosts external plugins inserted from now on in their own processes.
+     *
+     * Plugins already on tracks keep the host they were created with.
+     */
+    void setSandboxingEnabled (bool shouldSandbox) noexcept { settings.sandboxExternalPlugins = shouldSandbox; }
+    bool isSandboxingEnabled() const noexcept               { return settings.sandboxExternalPlugins; }
+
     //==============================================================================
     // Track helpers
 
@@ -124,6 +156,8 @@ public:
      * @param insertIndex  Index at which the plugin should be added.
      *
      * @return A pointer to the inserted plugin on success, or an empty Ptr on failure.
+     *         A sandboxed plugin loads asynchronously: if its worker can't load it, it
+     *         is removed from the track later and onPluginLoadFailed is called.
      */
     te::Plugin::Ptr addExternalInstrumentToTrack (te::AudioTrack& track,
                                                   const juce::PluginDescription& desc,
@@ -149,10 +183,13 @@ private:
     //==============================================================================
     // Internal helpers
 
+    class ScanJob;
+
     /**
-     * @brief Registers plugin formats with the AudioPluginFormatManager.
+     * @brief Registers plugin formats with the engine's AudioPluginFormatManager.
      *
-     * Respects the current settings (e.g. scanAudioUnits, scanVST3).
+     * Respects the current settings (e.g. scanAudioUnits, scanVST3) and skips
+     * formats the engine has already registered.
      */
     void initFormats();
 
@@ -164,34 +201,19 @@ private:
     juce::FileSearchPath buildSearchPaths() const;
 
     /**
-     * @brief Starts the scanner over all formats.
-     *
-     * @param reset Whether to reset scanning state (e.g. when rescanning).
-     */
-    void startScanner (bool reset);
-
-    /**
-     * @brief Starts scanning the next plugin format in the manager.
+     * @brief Starts the background scan job.
      *
-     * Called internally when a format scan completes.
-     *
-     * @param reset Whether this is part of a reset/rescan operation.
+     * @param fullRescan If true, the scratch list starts empty so every file is probed.
      */
-    void startNextFormatScan (bool reset);
+    void startBackgroundScan (bool fullRescan);
 
     /**
-     * @brief Timer callback used to pump the PluginDirectoryScanner asynchronously.
-     */
-    void timerCallback() override;
-
-    /**
-     * @brief Pumps the scanner in a blocking loop until completion.
-     *
-     * Intended for blocking scan paths; async callers should not use this.
+     * @brief Replaces the shared catalogue with a finished scan's result.
      *
-     * @param progressPrefix Optional string to prefix any logging/progress output.
+     * Message thread only; the list is rebuilt in a single call so no reader
+     * ever sees a half-updated catalogue.
      */
-    void pumpScannerUntilDone (juce::String progressPrefix);
+    void applyScanResult (const juce::XmlElement& scannedList);
 
     //==============================================================================
     // Member variables
@@ -199,15 +221,14 @@ private:
     te::Edit& edit;   ///< Edit this PluginManager belongs to.
     Settings  settings; ///< Scanning and persistence configuration.
 
-    juce::AudioPluginFormatManager        formatManager; ///< Registered plugin formats.
-    juce::KnownPluginList                 knownPlugins;  ///< In-memory known plugin list.
+    juce::AudioPluginFormatManager& formatManager; ///< Engine's registered plugin formats (not owned).
+    juce::KnownPluginList&          knownPlugins;  ///< Engine's known plugin list: the catalogue (not owned).
 
-    std::unique_ptr<juce::TimeSliceThread>        scannerThread;  ///< Thread used for async scanning.
-    std::unique_ptr<juce::PluginDirectoryScanner> scanner;        ///< Active directory scanner.
+    std::unique_ptr<ScanJob> scanJob; ///< Background scan in progress, if any.
 
-    juce::File knownListFile;   ///< XML file storing the known-plugin list.
+    juce::File knownListFile;   ///< XML file storing the catalogue cache.
     juce::File blacklistFile;   ///< Text file storing blacklisted plugin paths.
     juce::File deadMansFile;    ///< Dead-man's file used by JUCE during scanning.
 
-    int currentFormatIndex = -1; ///< Index of the format currently being scanned.
+    JUCE_DECLARE_WEAK_REFERENCEABLE (PluginManager)
 };
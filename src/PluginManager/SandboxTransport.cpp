@@ -0,0 +1,311 @@
+#include "SandboxTransport.h"
+
+//==============================================================================
+// Construction
+
+namespace
+{
+    double ticksToMs (juce::int64 ticks, juce::int64 count)
+    {
+        return count > 0 ? juce::Time::highResolutionTicksToSeconds (ticks) * 1000.0 / (double) count : 0.0;
+    }
+}
+
+std::unique_ptr<SandboxTransport> SandboxTransport::createHost (int numChannels)
+{
+    auto f = juce::File::getSpecialLocation (juce::File::tempDirectory)
+                 .getChildFile ("GrooveKitSandbox-" + juce::Uuid().toString() + ".shm");
+
+    juce::MemoryBlock zeros (sizeof (Shared), true);
+    if (! f.replaceWithData (zeros.getData(), zeros.getSize()))
+        return {};
+
+    auto mapped = std::make_unique<juce::MemoryMappedFile> (f, juce::MemoryMappedFile::readWrite, false);
+    if (mapped->getData() == nullptr || mapped->getSize() < sizeof (Shared))
+    {
+        f.deleteFile();
+        return {};
+    }
+
+    auto* s = new (mapped->getData()) Shared();
+    s->magic = magicNumber;
+    s->numChannels = juce::jlimit (1, maxChannels, numChannels);
+
+    return std::unique_ptr<SandboxTransport> (new SandboxTransport (f, std::move (mapped), true));
+}
+
+std::unique_ptr<SandboxTransport> SandboxTransport::openWorker (const juce::File& f)
+{
+    auto mapped = std::make_unique<juce::MemoryMappedFile> (f, juce::MemoryMappedFile::readWrite, false);
+    if (mapped->getData() == nullptr || mapped->getSize() < sizeof (Shared))
+        return {};
+
+    if (static_cast<const Shared*> (mapped->getData())->magic != magicNumber)
+        return {};
+
+    return std::unique_ptr<SandboxTransport> (new SandboxTransport (f, std::move (mapped), false));
+}
+
+SandboxTransport::SandboxTransport (const juce::File& f, std::unique_ptr<juce::MemoryMappedFile> m, bool host)
+    : file (f), mapping (std::move (m)), shared (static_cast<Shared*> (mapping->getData())), isHost (host)
+{
+    lastProcessed = shared->completed.load();
+}
+
+SandboxTransport::~SandboxTransport()
+{
+    mapping.reset();
+
+    if (isHost)
+        file.deleteFile();
+}
+
+int SandboxTransport::getNumChannels() const noexcept
+{
+    return shared->numChannels;
+}
+
+//==============================================================================
+// Host side
+
+void SandboxTransport::prepareHost (int blockSize)
+{
+    latencySamples = juce::jlimit (1, maxBlockSize, blockSize);
+
+    // Room for the primed block, one collected block and the current one
+    const int capacity = latencySamples + 2 * maxBlockSize + 1;
+    fifo.setSize (getNumChannels(), capacity);
+    fifo.clear();
+    fifoIndex.setTotalSize (capacity);
+    fifoIndex.reset();
+
+    pushSilence (latencySamples);
+
+    // Whatever is in flight belongs to the old stream
+    pendingLate = pending != 0;
+    skippedSamples = 0;
+}
+
+bool SandboxTransport::isWorkerBusy() const noexcept
+{
+    return shared->completed.load (std::memory_order_acquire) != shared->published.load (std::memory_order_relaxed);
+}
+
+void SandboxTransport::pushSilence (int numSamples) noexcept
+{
+    const auto scope = fifoIndex.write (juce::jmin (numSamples, fifoIndex.getFreeSpace()));
+
+    for (int ch = 0; ch < fifo.getNumChannels(); ++ch)
+    {
+        if (scope.blockSize1 > 0) fifo.clear (ch, scope.startIndex1, scope.blockSize1);
+        if (scope.blockSize2 > 0) fifo.clear (ch, scope.startIndex2, scope.blockSize2);
+    }
+}
+
+void SandboxTransport::collect (juce::uint32 sequence, bool late) noexcept
+{
+    auto& slot = slotFor (sequence);
+
+    answeredBlocks.fetch_add (1, std::memory_order_relaxed);
+    processTicks.fetch_add (slot.endTicks - slot.startTicks, std::memory_order_relaxed);
+    wakeTicks.fetch_add (slot.startTicks - slot.publishTicks, std::memory_order_relaxed);
+
+    // Its time has passed: silence was already played in its place
+    if (late)
+        return;
+
+    const auto scope = fifoIndex.write (juce::jmin ((int) slot.numSamples, fifoIndex.getFreeSpace()));
+
+    for (int ch = 0; ch < fifo.getNumChannels(); ++ch)
+    {
+        if (scope.blockSize1 > 0) fifo.copyFrom (ch, scope.startIndex1, slot.audio[ch], scope.blockSize1);
+        if (scope.blockSize2 > 0) fifo.copyFrom (ch, scope.startIndex2, slot.audio[ch] + scope.blockSize1, scope.blockSize2);
+    }
+}
+
+void SandboxTransport::hostProcess (juce::AudioBuffer<float>& audio, int startSample, int numSamples,
+                                    const te::MidiMessageArray* midi, double sampleRate, bool waitForWorker) noexcept
+{
+    const auto startTicks = juce::Time::getHighResolutionTicks();
+    const int numChannels = juce::jmin (audio.getNumChannels(), getNumChannels());
+
+    // 1) The previous block's output. A block still in flight here is late: it is
+    //    played as silence now, and its output is dropped whenever it arrives
+    if (pending != 0)
+    {
+        if (waitForWorker)
+        {
+            // Offline: the worker keeps up by definition, but give up on a hung one
+            const auto deadline = juce::Time::getMillisecondCounter() + 2000;
+            while (shared->completed.load (std::memory_order_acquire) != pending
+                   && juce::Time::getMillisecondCounter() < deadline)
+                juce::Thread::yield();
+        }
+
+        if (shared->completed.load (std::memory_order_acquire) == pending)
+        {
+            collect (pending, pendingLate);
+            pending = 0;
+            pendingLate = false;
+        }
+        else if (! pendingLate)
+        {
+            pushSilence (pendingSamples);
+            pendingLate = true;
+            lateBlocks.fetch_add (1, std::memory_order_relaxed);
+        }
+    }
+
+    // The previous block wasn't sent at all
+    if (skippedSamples > 0)
+    {
+        pushSilence (skippedSamples);
+        skippedSamples = 0;
+    }
+
+    // 2) Publish this block, unless the worker is still on the last one
+    if (pending == 0 && numSamples <= maxBlockSize)
+    {
+        const auto sequence = lastPublished + 1;
+        auto& slot = slotFor (sequence);
+
+        slot.numSamples = numSamples;
+
+        for (int ch = 0; ch < getNumChannels(); ++ch)
+        {
+            if (ch < numChannels)
+                juce::FloatVectorOperations::copy (slot.audio[ch], audio.getReadPointer (ch, startSample), numSamples);
+            else
+                juce::FloatVectorOperations::clear (slot.audio[ch], numSamples);
+        }
+
+        int numEvents = 0;
+        if (midi != nullptr)
+        {
+            for (auto& m : *midi)
+            {
+                if (numEvents >= maxMidiEvents || m.getRawDataSize() > 3)
+                    continue;
+
+                auto& e = slot.midi[numEvents++];
+                e.sampleOffset = juce::jlimit (0, numSamples - 1, juce::roundToInt (m.getTimeStamp() * sampleRate));
+                e.size = (juce::uint8) m.getRawDataSize();
+                std::memcpy (e.data, m.getRawData(), (size_t) e.size);
+            }
+        }
+        slot.numMidiEvents = numEvents;
+
+        slot.publishTicks = juce::Time::getHighResolutionTicks();
+        shared->published.store (sequence, std::memory_order_release);
+
+        lastPublished = sequence;
+        pending = sequence;
+        pendingSamples = numSamples;
+        blocks.fetch_add (1, std::memory_order_relaxed);
+    }
+    else
+    {
+        skippedSamples = numSamples;
+        lateBlocks.fetch_add (1, std::memory_order_relaxed);
+    }
+
+    // 3) Play from the FIFO, one block behind
+    const auto scope = fifoIndex.read (juce::jmin (numSamples, fifoIndex.getNumReady()));
+
+    for (int ch = 0; ch < audio.getNumChannels(); ++ch)
+    {
+        if (ch >= fifo.getNumChannels())
+        {
+            audio.clear (ch, startSample, numSamples);
+            continue;
+        }
+
+        if (scope.blockSize1 > 0) audio.copyFrom (ch, startSample, fifo, ch, scope.startIndex1, scope.blockSize1);
+        if (scope.blockSize2 > 0) audio.copyFrom (ch, startSample + scope.blockSize1, fifo, ch, scope.startIndex2, scope.blockSize2);
+
+        const int done = scope.blockSize1 + scope.blockSize2;
+        if (done < numSamples)
+            audio.clear (ch, startSample + done, numSamples - done);
+    }
+
+    hostTicks.fetch_add (juce::Time::getHighResolutionTicks() - startTicks, std::memory_order_relaxed);
+}
+
+SandboxTransport::Stats SandboxTransport::getStats() const noexcept
+{
+    Stats s;
+    s.blocks     = blocks.load();
+    s.lateBlocks = lateBlocks.load();
+
+    const auto answered = answeredBlocks.load();
+    s.processMs = ticksToMs (processTicks.load(), answered);
+    s.wakeMs    = ticksToMs (wakeTicks.load(), answered);
+    s.hostMs    = ticksToMs (hostTicks.load(), s.blocks + s.lateBlocks);
+    return s;
+}
+
+//==============================================================================
+// Worker side
+
+void SandboxTransport::prepareWorker (int numProcessChannels)
+{
+    workerAudio.setSize (juce::jlimit (getNumChannels(), maxChannels, numProcessChannels), maxBlockSize);
+    workerMidi.ensureSize ((size_t) maxMidiEvents * 16);
+}
+
+bool SandboxTransport::workerProcessNext (const ProcessCallback& process)
+{
+    const auto sequence = shared->published.load (std::memory_order_acquire);
+    if (sequence == lastProcessed)
+        return false;
+
+    auto& slot = slotFor (sequence);
+    slot.startTicks = juce::Time::getHighResolutionTicks();
+
+    const int numSamples = juce::jlimit (0, maxBlockSize, (int) slot.numSamples);
+    const int numChannels = getNumChannels();
+
+    // The plugin may want more channels than the host sends: those start silent
+    workerAudio.setSize (workerAudio.getNumChannels(), numSamples, false, false, true);
+    for (int ch = 0; ch < workerAudio.getNumChannels(); ++ch)
+    {
+        if (ch < numChannels)
+            workerAudio.copyFrom (ch, 0, slot.audio[ch], numSamples);
+        else
+            workerAudio.clear (ch, 0, numSamples);
+    }
+
+    workerMidi.clear();
+    for (int i = 0; i < juce::jlimit (0, maxMidiEvents, (int) slot.numMidiEvents); ++i)
+        workerMidi.addEvent (slot.midi[i].data, slot.midi[i].size, slot.midi[i].sampleOffset);
+
+    process (workerAudio, workerMidi);
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        if (ch < workerAudio.getNumChannels())
+            juce::FloatVectorOperations::copy (slot.audio[ch], workerAudio.getReadPointer (ch), numSamples);
+        else
+            juce::FloatVectorOperations::clear (slot.audio[ch], numSamples);
+    }
+
+    slot.endTicks = juce::Time::getHighResolutionTicks();
+    lastProcessed = sequence;
+    shared->completed.store (sequence, std::memory_order_release);
+    return true;
+}
+
+//==============================================================================
+// Control messages
+
+juce::MemoryBlock SandboxTransport::encodeMessage (const juce::ValueTree& message)
+{
+    juce::MemoryOutputStream out;
+    message.writeToStream (out);
+    return out.getMemoryBlock();
+}
+
+juce::ValueTree SandboxTransport::decodeMessage (const juce::MemoryBlock& data)
+{
+    return juce::ValueTree::readFromData (data.getData(), data.getSize());
+}
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <tracktion_engine/tracktion_engine.h>
+
+#include <atomic>
+#include <functional>
+
+namespace te = tracktion::engine;
+
+/**
+ * @brief Shared-memory audio/MIDI channel between GrooveKit and a sandboxed plugin process.
+ *
+ * Both processes map the same file. It holds two block slots and two sequence
+ * counters: the host writes a block's input audio and MIDI into a slot and
+ * publishes its sequence number; the worker processes the slot in place and
+ * marks it completed. Nothing blocks and nothing is locked. Each side only ever
+ * waits by polling an atomic.
+ *
+ * The handoff is double-buffered with one block in flight. In each block the host
+ * collects the previous block's output, publishes the current block to the other
+ * slot, and plays from a local FIFO that was primed with one block of silence. The
+ * worker therefore has a whole block period to answer, and the host's latency is
+ * a constant getLatencySamples() whatever the block sizes. A block the worker
+ * misses is played as silence, and its late output is dropped. A stalled plugin
+ * goes quiet instead of stalling the session.
+ *
+ * Control traffic (load, parameters, state) doesn't go through here. It uses the
+ * child-process pipe, encoded with encodeMessage()/decodeMessage().
+ *
+ * Thread safety: hostProcess() on the host audio thread, workerProcessNext() on the
+ * worker's processing thread, prepareHost() while the host isn't processing.
+ */
+class SandboxTransport
+{
+public:
+    static constexpr int maxChannels   = 8;
+    static constexpr int maxBlockSize  = 4096;
+    static constexpr int maxMidiEvents = 1024;     ///< Per block; sysex is not carried
+
+    /** Command-line id that turns a GrooveKit process into a plugin worker. */
+    static inline const juce::String workerCommandLineID { "groovekit-plugin-sandbox" };
+
+    /** A worker that hears no ping from its host for this long quits. */
+    static constexpr int pipeTimeoutMs = 5000;
+
+    //==============================================================================
+    /** Creates and maps a new shared file (host side). Returns nullptr if mapping fails. */
+    static std::unique_ptr<SandboxTransport> createHost (int numChannels);
+
+    /** Maps a file created by createHost() (worker side). Returns nullptr if it isn't one. */
+    static std::unique_ptr<SandboxTransport> openWorker (const juce::File& file);
+
+    /** The host deletes the shared file. */
+    ~SandboxTransport();
+
+    const juce::File& getFile() const noexcept      { return file; }
+    int getNumChannels() const noexcept;
+
+    //==============================================================================
+    // Host side
+
+    /** Sizes the output FIFO for @p blockSize and primes it with one block of silence. */
+    void prepareHost (int blockSize);
+
+    /** Delay added by the handoff, in samples. */
+    int getLatencySamples() const noexcept          { return latencySamples; }
+
+    /**
+     * @brief Runs one block through the worker, replacing @p audio with the output of one
+     *        block ago.
+     *
+     * @param midi           Block MIDI (timestamps in seconds from the block start), or nullptr
+     * @param waitForWorker  Offline rendering: wait for the previous block instead of dropping it
+     */
+    void hostProcess (juce::AudioBuffer<float>& audio, int startSample, int numSamples,
+                      const te::MidiMessageArray* midi, double sampleRate, bool waitForWorker) noexcept;
+
+    /** True while a published block is still waiting for the worker. */
+    bool isWorkerBusy() const noexcept;
+
+    /** Last block the worker finished; a busy worker whose count stops moving has stalled. */
+    juce::uint32 getCompletedSequence() const noexcept      { return shared->completed.load(); }
+
+    /** Host-side counters, for diagnostics. */
+    struct Stats
+    {
+        juce::int64 blocks = 0;          ///< Blocks published to the worker
+        juce::int64 lateBlocks = 0;      ///< Blocks the worker missed (played as silence)
+        double processMs = 0.0;          ///< Average worker processing time per block
+        double wakeMs = 0.0;             ///< Average delay from publish to the worker starting
+        double hostMs = 0.0;             ///< Average host-side cost (copies, FIFO) per block
+    };
+
+    Stats getStats() const noexcept;
+
+    //==============================================================================
+    // Worker side
+
+    /** Processes a block in place: @p audio spans every channel, @p midi is sample-stamped. */
+    using ProcessCallback = std::function<void (juce::AudioBuffer<float>& audio, juce::MidiBuffer& midi)>;
+
+    /** Prepares the worker's scratch buffers (message thread, before processing). */
+    void prepareWorker (int numProcessChannels);
+
+    /** Processes the published block, if there is one. @return false if there was nothing to do */
+    bool workerProcessNext (const ProcessCallback& process);
+
+    //==============================================================================
+    // Control messages
+
+    static juce::MemoryBlock encodeMessage (const juce::ValueTree& message);
+    static juce::ValueTree decodeMessage (const juce::MemoryBlock& data);
+
+    /** Message types (ValueTree types) and their properties. */
+    struct Msg
+    {
+        // Host -> worker
+        static inline const juce::Identifier load       { "load" };         ///< description, shm, sampleRate, blockSize, stateData
+        static inline const juce::Identifier prepare    { "prepare" };      ///< sampleRate, blockSize
+        static inline const juce::Identifier getState   { "getState" };
+        static inline const juce::Identifier showEditor { "showEditor" };
+
+        // Worker -> host
+        static inline const juce::Identifier loaded     { "loaded" };       ///< ok, error, latency; one PARAM child per parameter (name, value)
+
+        // Both ways
+        static inline const juce::Identifier param      { "param" };        ///< index, value (normalised)
+        static inline const juce::Identifier state      { "state" };        ///< stateData (base64)
+
+        static inline const juce::Identifier description { "description" }; ///< juce::PluginDescription XML
+        static inline const juce::Identifier stateData   { "stateData" };
+    };
+
+private:
+    struct MidiEvent
+    {
+        juce::int32 sampleOffset;
+        juce::uint8 size;
+        juce::uint8 data[3];
+    };
+
+    struct Slot
+    {
+        juce::int32 numSamples;
+        juce::int32 numMidiEvents;
+        juce::int64 publishTicks, startTicks, endTicks;   ///< juce::Time::getHighResolutionTicks(), system-wide
+        MidiEvent midi[maxMidiEvents];
+        float audio[maxChannels][maxBlockSize];
+    };
+
+    struct Shared
+    {
+        juce::uint32 magic;
+        juce::int32 numChannels;
+        std::atomic<juce::uint32> published;   ///< Last sequence the host wrote (0 = none)
+        std::atomic<juce::uint32> completed;   ///< Last sequence the worker finished
+        Slot slots[2];
+    };
+
+    static_assert (std::atomic<juce::uint32>::is_always_lock_free, "Sequence counters must be lock-free to be shared");
+
+    static constexpr juce::uint32 magicNumber = 0x474b5342;   // "GKSB"
+
+    SandboxTransport (const juce::File&, std::unique_ptr<juce::MemoryMappedFile>, bool isHost);
+
+    Slot& slotFor (juce::uint32 sequence) noexcept  { return shared->slots[sequence & 1]; }
+
+    void collect (juce::uint32 sequence, bool late) noexcept;
+    void pushSilence (int numSamples) noexcept;
+
+    juce::File file;
+    std::unique_ptr<juce::MemoryMappedFile> mapping;
+    Shared* shared = nullptr;
+    const bool isHost;
+
+    // Host audio thread
+    juce::AudioBuffer<float> fifo;
+    juce::AbstractFifo fifoIndex { 1 };
+    int latencySamples = 0;
+    juce::uint32 lastPublished = 0;
+    juce::uint32 pending = 0;          ///< Sequence in flight (0 = none)
+    int pendingSamples = 0;
+    bool pendingLate = false;          ///< Already played as silence; its output is dropped
+    int skippedSamples = 0;            ///< Previous block, not sent because the worker was busy
+
+    std::atomic<juce::int64> blocks { 0 }, lateBlocks { 0 }, answeredBlocks { 0 };
+    std::atomic<juce::int64> processTicks { 0 }, wakeTicks { 0 }, hostTicks { 0 };
+
+    // Worker processing thread
+    juce::uint32 lastProcessed = 0;
+    juce::AudioBuffer<float> workerAudio;
+    juce::MidiBuffer workerMidi;
+
+    JUCE_DECLARE_NON_COPYABLE (SandboxTransport)
+};
@@ -0,0 +1,254 @@
+#include "SandboxWorker.h"
+
+namespace
+{
+    using Msg = SandboxTransport::Msg;
+}
+
+//==============================================================================
+// Construction
+
+std::unique_ptr<SandboxWorker> SandboxWorker::createFromCommandLine (const juce::String& commandLine)
+{
+    if (! commandLine.contains (SandboxTransport::workerCommandLineID))
+        return {};
+
+    std::unique_ptr<SandboxWorker> worker (new SandboxWorker());
+
+    if (! worker->initialiseFromCommandLine (commandLine, SandboxTransport::workerCommandLineID,
+                                             SandboxTransport::pipeTimeoutMs))
+        return {};
+
+    return worker;
+}
+
+SandboxWorker::SandboxWorker()
+    : juce::Thread ("Sandbox processing")
+{
+    formatManager.addDefaultFormats();
+}
+
+SandboxWorker::~SandboxWorker()
+{
+    stopTimer();
+    cancelPendingUpdate();
+    stopThread (2000);
+
+    editorWindow.reset();
+    instance.reset();
+}
+
+//==============================================================================
+// Pipe
+
+void SandboxWorker::handleMessageFromCoordinator (const juce::MemoryBlock& data)
+{
+    {
+        const juce::ScopedLock sl (lock);
+        inbox.add (data);
+    }
+    triggerAsyncUpdate();
+}
+
+void SandboxWorker::handleConnectionLost()
+{
+    lost = true;
+    triggerAsyncUpdate();
+}
+
+void SandboxWorker::handleAsyncUpdate()
+{
+    juce::Array<juce::MemoryBlock> messages;
+    {
+        const juce::ScopedLock sl (lock);
+        messages.swapWith (inbox);
+    }
+
+    for (auto& m : messages)
+        handleMessage (SandboxTransport::decodeMessage (m));
+
+    if (lost)
+        juce::JUCEApplicationBase::quit();
+}
+
+void SandboxWorker::send (const juce::ValueTree& message)
+{
+    sendMessageToCoordinator (SandboxTransport::encodeMessage (message));
+}
+
+void SandboxWorker::handleMessage (const juce::ValueTree& message)
+{
+    if (message.hasType (Msg::load))
+    {
+        load (message);
+    }
+    else if (message.hasType (Msg::prepare))
+    {
+        prepare (message["sampleRate"], message["blockSize"]);
+    }
+    else if (message.hasType (Msg::param) && instance != nullptr)
+    {
+        const int index = message["index"];
+        const auto& params = instance->getParameters();
+
+        if (juce::isPositiveAndBelow (index, params.size()))
+        {
+            const float value = message["value"];
+            params[index]->setValueNotifyingHost (value);
+            sentValues.set (index, value);     // the host already knows
+            stateDirty = true;
+            lastChangeMs = juce::Time::getMillisecondCounter();
+        }
+    }
+    else if (message.hasType (Msg::getState))
+    {
+        sendState();
+    }
+    else if (message.hasType (Msg::showEditor) && instance != nullptr)
+    {
+        if (editorWindow == nullptr)
+            editorWindow = PluginEditorWindow::createFor (*instance, [this] { juce::MessageManager::callAsync ([this] { editorWindow.reset(); }); });
+
+        if (editorWindow != nullptr)
+            editorWindow->toFront (true);
+    }
+}
+
+//==============================================================================
+// Plugin
+
+void SandboxWorker::load (const juce::ValueTree& message)
+{
+    juce::ValueTree reply (Msg::loaded);
+
+    auto fail = [&] (const juce::String& error)
+    {
+        reply.setProperty ("ok", false, nullptr);
+        reply.setProperty ("error", error, nullptr);
+        send (reply);
+    };
+
+    juce::PluginDescription description;
+    auto xml = juce::parseXML (message[Msg::description].toString());
+    if (xml == nullptr || ! description.loadFromXml (*xml))
+        return fail ("Bad plugin description");
+
+    transport = SandboxTransport::openWorker (juce::File (message["shm"].toString()));
+    if (transport == nullptr)
+        return fail ("Couldn't map shared memory");
+
+    const double sampleRate = message["sampleRate"];
+    const int blockSize = message["blockSize"];
+
+    juce::String error;
+    instance = formatManager.createPluginInstance (description, sampleRate, blockSize, error);
+    if (instance == nullptr)
+        return fail (error.isNotEmpty() ? error : juce::String ("Couldn't create the plugin"));
+
+    juce::MemoryBlock stateData;
+    if (stateData.fromBase64Encoding (message[Msg::stateData].toString()) && stateData.getSize() > 0)
+        instance->setStateInformation (stateData.getData(), (int) stateData.getSize());
+
+    prepare (sampleRate, blockSize);
+
+    sentValues.clearQuick();
+    for (auto* p : instance->getParameters())
+    {
+        juce::ValueTree param ("PARAM");
+        param.setProperty ("name", p->getName (64), nullptr);
+        param.setProperty ("value", p->getValue(), nullptr);
+        reply.appendChild (param, nullptr);
+        sentValues.add (p->getValue());
+    }
+
+    reply.setProperty ("ok", true, nullptr);
+    reply.setProperty ("latency", instance->getLatencySamples(), nullptr);
+    send (reply);
+
+    startTimerHz (10);
+}
+
+void SandboxWorker::prepare (double sampleRate, int blockSize)
+{
+    if (instance == nullptr || transport == nullptr)
+        return;
+
+    stopThread (2000);
+
+    instance->releaseResources();
+    instance->prepareToPlay (sampleRate, blockSize);
+    transport->prepareWorker (juce::jmax (instance->getTotalNumInputChannels(), instance->getTotalNumOutputChannels()));
+
+    startThread (juce::Thread::Priority::highest);
+}
+
+void SandboxWorker::sendState()
+{
+    if (instance == nullptr)
+        return;
+
+    juce::MemoryBlock data;
+    instance->getStateInformation (data);
+
+    juce::ValueTree m (Msg::state);
+    m.setProperty (Msg::stateData, data.toBase64Encoding(), nullptr);
+    send (m);
+
+    stateDirty = false;
+}
+
+void SandboxWorker::timerCallback()
+{
+    if (instance == nullptr)
+        return;
+
+    // Changes made in the plugin's own editor (or by the plugin itself)
+    const auto& params = instance->getParameters();
+    for (int i = 0; i < params.size() && i < sentValues.size(); ++i)
+    {
+        const float value = params[i]->getValue();
+        if (value == sentValues[i])
+            continue;
+
+        juce::ValueTree m (Msg::param);
+        m.setProperty ("index", i, nullptr);
+        m.setProperty ("value", value, nullptr);
+        send (m);
+
+        sentValues.set (i, value);
+        stateDirty = true;
+        lastChangeMs = juce::Time::getMillisecondCounter();
+    }
+
+    if (stateDirty && juce::Time::getMillisecondCounter() - lastChangeMs > (juce::uint32) stateDelayMs)
+        sendState();
+}
+
+//==============================================================================
+// Processing thread
+
+void SandboxWorker::run()
+{
+    const SandboxTransport::ProcessCallback process = [this] (juce::AudioBuffer<float>& audio, juce::MidiBuffer& midi)
+    {
+        const juce::ScopedLock sl (instance->getCallbackLock());
+        instance->processBlock (audio, midi);
+    };
+
+    int idle = 0;
+
+    while (! threadShouldExit())
+    {
+        if (transport->workerProcessNext (process))
+        {
+            idle = 0;
+            continue;
+        }
+
+        // The next block is usually due within a block period: poll hard briefly, then back off
+        if (++idle < spinIterations)
+            juce::Thread::yield();
+        else
+            wait (1);
+    }
+}
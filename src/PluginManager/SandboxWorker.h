@@ -0,0 +1,71 @@
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include "SandboxTransport.h"
+#include "PluginEditorWindow.h"
+
+/**
+ * @brief The worker-process side of SandboxedPlugin.
+ *
+ * A GrooveKit process launched with SandboxTransport::workerCommandLineID shows no
+ * window. It creates one of these instead, which:
+ *  - Loads the plugin named in the host's "load" message on the message thread
+ *    and restores its state.
+ *  - Runs a processing thread that takes blocks from the shared-memory transport
+ *    as soon as they are published (a short spin, then 1 ms sleeps while idle).
+ *  - Polls the plugin's parameters ten times a second and sends changes to the
+ *    host, followed by the full state once they settle.
+ *  - Opens the plugin's editor on request.
+ *
+ * The process quits when the host's pipe closes.
+ *
+ * Thread safety: pipe callbacks are moved onto the message thread; the processing
+ * thread only touches the plugin inside its callback lock.
+ */
+class SandboxWorker : public juce::ChildProcessWorker,
+                      private juce::AsyncUpdater,
+                      private juce::Timer,
+                      private juce::Thread
+{
+public:
+    /** Returns a connected worker if @p commandLine launches one, otherwise nullptr. */
+    static std::unique_ptr<SandboxWorker> createFromCommandLine (const juce::String& commandLine);
+
+    ~SandboxWorker() override;
+
+    void handleMessageFromCoordinator (const juce::MemoryBlock& data) override;
+    void handleConnectionLost() override;
+
+    /** Idle polls (yields) before the processing thread starts sleeping between checks. */
+    static constexpr int spinIterations = 2000;
+    /** Quiet time after a parameter change before the full state is sent. */
+    static constexpr int stateDelayMs = 500;
+
+private:
+    SandboxWorker();
+
+    void handleAsyncUpdate() override;
+    void timerCallback() override;
+    void run() override;
+
+    void handleMessage (const juce::ValueTree& message);
+    void load (const juce::ValueTree& message);
+    void prepare (double sampleRate, int blockSize);
+    void sendState();
+    void send (const juce::ValueTree& message);
+
+    juce::AudioPluginFormatManager formatManager;
+    std::unique_ptr<juce::AudioPluginInstance> instance;
+    std::unique_ptr<SandboxTransport> transport;
+    std::unique_ptr<PluginEditorWindow> editorWindow;
+
+    juce::Array<float> sentValues;      ///< Last parameter values the host knows about
+    juce::uint32 lastChangeMs = 0;
+    bool stateDirty = false;
+
+    juce::CriticalSection lock;
+    juce::Array<juce::MemoryBlock> inbox;
+    std::atomic<bool> lost { false };
+
+    JUCE_DECLARE_NON_COPYABLE (SandboxWorker)
+};
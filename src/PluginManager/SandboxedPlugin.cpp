@@ -0,0 +1,337 @@
+#include "SandboxedPlugin.h"
+
+#include <utility>
+
+namespace
+{
+    using Msg = SandboxTransport::Msg;
+}
+
+//==============================================================================
+/**
+ * Owns the worker process and moves its messages onto the message thread (JUCE
+ * delivers them on the pipe's thread).
+ */
+class SandboxedPlugin::Coordinator : public juce::ChildProcessCoordinator,
+                                     private juce::AsyncUpdater
+{
+public:
+    explicit Coordinator (SandboxedPlugin& p) : owner (p) {}
+
+    ~Coordinator() override
+    {
+        cancelPendingUpdate();
+        killWorkerProcess();
+    }
+
+    void handleMessageFromWorker (const juce::MemoryBlock& data) override
+    {
+        {
+            const juce::ScopedLock sl (lock);
+            inbox.add (data);
+        }
+        triggerAsyncUpdate();
+    }
+
+    void handleConnectionLost() override
+    {
+        lost = true;
+        triggerAsyncUpdate();
+    }
+
+private:
+    void handleAsyncUpdate() override
+    {
+        juce::Array<juce::MemoryBlock> messages;
+        {
+            const juce::ScopedLock sl (lock);
+            messages.swapWith (inbox);
+        }
+
+        for (auto& m : messages)
+            owner.handleWorkerMessage (SandboxTransport::decodeMessage (m));
+
+        // After any messages that arrived before the pipe closed
+        if (lost.exchange (false))
+            owner.handleWorkerLost();
+    }
+
+    SandboxedPlugin& owner;
+    juce::CriticalSection lock;
+    juce::Array<juce::MemoryBlock> inbox;
+    std::atomic<bool> lost { false };
+};
+
+//==============================================================================
+// Construction
+
+juce::ValueTree SandboxedPlugin::createState (const juce::PluginDescription& desc)
+{
+    juce::ValueTree v (te::IDs::PLUGIN);
+    v.setProperty (te::IDs::type, pluginType, nullptr);
+
+    if (auto xml = desc.createXml())
+        v.setProperty (Msg::description, xml->toString (juce::XmlElement::TextFormat().singleLine()), nullptr);
+
+    return v;
+}
+
+SandboxedPlugin::SandboxedPlugin (const te::PluginCreationInfo& info)
+    : te::Plugin (info)
+{
+    if (auto xml = juce::parseXML (state[Msg::description].toString()))
+        description.loadFromXml (*xml);
+
+    transport = SandboxTransport::createHost (2);
+
+    if (transport == nullptr)
+        lastError = "Couldn't create shared memory";
+    else
+        launchWorker();
+
+    startTimer (500);
+}
+
+SandboxedPlugin::~SandboxedPlugin()
+{
+    notifyListenersOfDeletion();
+    stopTimer();
+
+    workerReady = false;
+    coordinator.reset();
+}
+
+//==============================================================================
+// Worker lifetime
+
+void SandboxedPlugin::launchWorker()
+{
+    workerReady = false;
+    coordinator.reset();
+
+    coordinator = std::make_unique<Coordinator> (*this);
+
+    if (! coordinator->launchWorkerProcess (juce::File::getSpecialLocation (juce::File::currentExecutableFile),
+                                            SandboxTransport::workerCommandLineID, SandboxTransport::pipeTimeoutMs))
+    {
+        lastError = "Couldn't start the plugin worker";
+        coordinator.reset();
+        return;
+    }
+
+    juce::ValueTree load (Msg::load);
+    load.setProperty (Msg::description, state[Msg::description], nullptr);
+    load.setProperty ("shm", transport->getFile().getFullPathName(), nullptr);
+    load.setProperty ("sampleRate", sampleRate, nullptr);
+    load.setProperty ("blockSize", blockSize, nullptr);
+    load.setProperty (Msg::stateData, state[Msg::stateData], nullptr);
+    send (load);
+}
+
+void SandboxedPlugin::handleWorkerLost()
+{
+    // Called from inside the coordinator: replace it from the timer instead
+    workerReady = false;
+    restartPending = true;
+}
+
+void SandboxedPlugin::restartWorker()
+{
+    restartPending = false;
+    workerReady = false;
+    coordinator.reset();
+
+    if (restarts >= maxRestarts)
+    {
+        lastError = "Crashed; not restarting";
+        DBG ("[Sandbox] " << getName() << " crashed too often, leaving it silent");
+        return;
+    }
+
+    ++restarts;
+    DBG ("[Sandbox] " << getName() << " worker lost, restarting (" << restarts << "/" << maxRestarts << ")");
+    launchWorker();
+}
+
+void SandboxedPlugin::timerCallback()
+{
+    if (restartPending)
+        restartWorker();
+
+    if (! workerReady || transport == nullptr)
+        return;
+
+    // A worker with a block in hand whose completed count doesn't move is hung
+    const auto completed = transport->getCompletedSequence();
+    const auto now = juce::Time::getMillisecondCounter();
+
+    if (! transport->isWorkerBusy() || completed != lastCompleted)
+    {
+        lastCompleted = completed;
+        stalledSinceMs = 0;
+        return;
+    }
+
+    if (stalledSinceMs == 0)
+        stalledSinceMs = now;
+    else if (now - stalledSinceMs > (juce::uint32) stallTimeoutMs)
+    {
+        stalledSinceMs = 0;
+        DBG ("[Sandbox] " << getName() << " stalled, killing its worker");
+        restartWorker();
+    }
+}
+
+//==============================================================================
+// Messages
+
+void SandboxedPlugin::send (const juce::ValueTree& message)
+{
+    if (coordinator != nullptr)
+        coordinator->sendMessageToWorker (SandboxTransport::encodeMessage (message));
+}
+
+void SandboxedPlugin::handleWorkerMessage (const juce::ValueTree& message)
+{
+    if (message.hasType (Msg::loaded))
+    {
+        const auto failed = std::exchange (onLoadFailed, nullptr);
+
+        if (! (bool) message["ok"])
+        {
+            lastError = message["error"].toString();
+            DBG ("[Sandbox] " << getName() << " failed to load: " << lastError);
+
+            if (failed)
+                failed (lastError);
+
+            return;
+        }
+
+        parameterNames.clearQuick();
+        parameterValues.clearQuick();
+        for (auto p : message)
+        {
+            parameterNames.add (p["name"].toString());
+            parameterValues.add ((float) p["value"]);
+        }
+
+        const int latency = message["latency"];
+        const bool latencyChanged = latency != remoteLatencySamples;
+        remoteLatencySamples = latency;
+
+        lastError.clear();
+        lastCompleted = transport->getCompletedSequence();
+        workerReady = true;
+
+        // Delay compensation has to pick up the plugin's own latency
+        if (latencyChanged)
+            edit.restartPlayback();
+    }
+    else if (message.hasType (Msg::param))
+    {
+        const int index = message["index"];
+        if (juce::isPositiveAndBelow (index, parameterValues.size()))
+            parameterValues.set (index, (float) message["value"]);
+    }
+    else if (message.hasType (Msg::state))
+    {
+        state.setProperty (Msg::stateData, message[Msg::stateData], nullptr);
+    }
+}
+
+void SandboxedPlugin::setRemoteParameterValue (int index, float value)
+{
+    if (! juce::isPositiveAndBelow (index, parameterValues.size()))
+        return;
+
+    parameterValues.set (index, value);
+
+    juce::ValueTree m (Msg::param);
+    m.setProperty ("index", index, nullptr);
+    m.setProperty ("value", value, nullptr);
+    send (m);
+}
+
+void SandboxedPlugin::showEditor()
+{
+    send (juce::ValueTree (Msg::showEditor));
+}
+
+void SandboxedPlugin::flushPluginStateToValueTree()
+{
+    te::Plugin::flushPluginStateToValueTree();
+    send (juce::ValueTree (Msg::getState));
+}
+
+//==============================================================================
+// Rendering
+
+void SandboxedPlugin::initialise (const te::PluginInitialisationInfo& info)
+{
+    const bool changed = info.sampleRate != sampleRate || info.blockSizeSamples != blockSize;
+
+    sampleRate = info.sampleRate;
+    blockSize  = info.blockSizeSamples;
+
+    if (transport != nullptr)
+        transport->prepareHost (blockSize);
+
+    if (changed && coordinator != nullptr)
+    {
+        juce::ValueTree m (Msg::prepare);
+        m.setProperty ("sampleRate", sampleRate, nullptr);
+        m.setProperty ("blockSize", blockSize, nullptr);
+        send (m);
+    }
+}
+
+void SandboxedPlugin::deinitialise()
+{
+}
+
+double SandboxedPlugin::getLatencySeconds()
+{
+    if (transport == nullptr || sampleRate <= 0.0)
+        return 0.0;
+
+    return (transport->getLatencySamples() + remoteLatencySamples) / sampleRate;
+}
+
+void SandboxedPlugin::applyToBuffer (const te::PluginRenderContext& rc)
+{
+    auto* audio = rc.destBuffer;
+    if (audio == nullptr)
+        return;
+
+    // Not loaded yet, or restarting: instruments are silent, effects pass through
+    if (! workerReady.load (std::memory_order_acquire))
+    {
+        if (isSynth())
+            audio->clear (rc.bufferStartSample, rc.bufferNumSamples);
+        return;
+    }
+
+    transport->hostProcess (*audio, rc.bufferStartSample, rc.bufferNumSamples,
+                            rc.bufferForMidiMessages, sampleRate, rc.isRendering);
+}
+
+//==============================================================================
+// Diagnostics
+
+SandboxedPlugin::Stats SandboxedPlugin::getStats() const
+{
+    Stats s;
+    s.name     = description.name;
+    s.running  = workerReady.load();
+    s.restarts = restarts;
+    s.error    = lastError;
+
+    if (transport != nullptr)
+    {
+        s.latencyMs = sampleRate > 0.0 ? 1000.0 * transport->getLatencySamples() / sampleRate : 0.0;
+        s.transport = transport->getStats();
+    }
+
+    return s;
+}
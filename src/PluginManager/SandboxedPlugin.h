@@ -0,0 +1,156 @@
+#pragma once
+
+#include <tracktion_engine/tracktion_engine.h>
+#include "SandboxTransport.h"
+
+namespace te = tracktion::engine;
+
+/**
+ * @brief Hosts an external plugin in a separate GrooveKit worker process.
+ *
+ * Takes the place of a te::ExternalPlugin when PluginManager's sandboxing is on.
+ * The worker (SandboxWorker, the GrooveKit executable relaunched with
+ * SandboxTransport::workerCommandLineID) loads and runs the real plugin. If the
+ * plugin crashes or hangs, only that process goes down: this side plays silence,
+ * relaunches the worker with the last known state (up to maxRestarts times) and
+ * the session carries on.
+ *
+ * Audio and MIDI go through SandboxTransport's shared memory, one block behind,
+ * and that delay is reported through getLatencySeconds() so the graph compensates.
+ * Loading, parameters, state and the editor go over the child-process pipe and
+ * are fully asynchronous:
+ *  - The worker pushes parameter changes and, shortly after them, the plugin state.
+ *    The state is stored in this plugin's ValueTree, so saving an edit never
+ *    waits on the worker.
+ *  - setRemoteParameterValue() is sent to the worker and applied there.
+ *  - The editor opens in the worker process (showEditor()).
+ *
+ * Thread safety: applyToBuffer() on the audio thread; everything else on the
+ * message thread.
+ */
+class SandboxedPlugin final : public te::Plugin,
+                              private juce::Timer
+{
+public:
+    static inline const juce::String pluginType { "sandboxedplugin" };
+
+    /** Plugin state for createNewPlugin() that loads @p description sandboxed. */
+    static juce::ValueTree createState (const juce::PluginDescription& description);
+
+    explicit SandboxedPlugin (const te::PluginCreationInfo& info);
+    ~SandboxedPlugin() override;
+
+    //==============================================================================
+    // te::Plugin overrides
+
+    juce::String getName() const override                   { return description.name; }
+    juce::String getPluginType() override                   { return pluginType; }
+    juce::String getSelectableDescription() override        { return description.name + " (sandboxed)"; }
+
+    bool takesMidiInput() override                          { return isSynth(); }
+    bool producesAudioWhenNoAudioInput() override           { return isSynth(); }
+    double getLatencySeconds() override;
+
+    void initialise   (const te::PluginInitialisationInfo&) override;
+    void deinitialise () override;
+    void applyToBuffer (const te::PluginRenderContext&) override;
+
+    /** Asks the worker for fresh state; the stored state is at most a moment old. */
+    void flushPluginStateToValueTree() override;
+
+    //==============================================================================
+    const juce::PluginDescription& getDescription() const noexcept  { return description; }
+    bool isSynth() const noexcept                                   { return description.isInstrument; }
+
+    /** True once the worker has loaded the plugin and is processing. */
+    bool isRunning() const noexcept                                 { return workerReady.load(); }
+
+    /**
+     * Called on the message thread if the worker's first attempt to load the plugin
+     * fails, with the worker's error. Not called for later restarts.
+     */
+    std::function<void (const juce::String& error)> onLoadFailed;
+
+    /** Opens the plugin's editor in the worker process. */
+    void showEditor();
+
+    int getNumRemoteParameters() const noexcept                     { return parameterNames.size(); }
+    juce::String getRemoteParameterName (int index) const           { return parameterNames[index]; }
+    float getRemoteParameterValue (int index) const                 { return parameterValues[index]; }
+
+    /** Sets a normalised parameter value in the worker. */
+    void setRemoteParameterValue (int index, float value);
+
+    /** Overhead and health, for diagnostics. */
+    struct Stats
+    {
+        juce::String name;
+        bool running = false;
+        int restarts = 0;
+        double latencyMs = 0.0;                 ///< Added by the handoff (the plugin's own latency excluded)
+        SandboxTransport::Stats transport;
+        juce::String error;
+    };
+
+    Stats getStats() const;
+
+    static constexpr int maxRestarts = 3;
+    static constexpr int stallTimeoutMs = 2000;     ///< A busy worker making no progress this long is killed
+
+private:
+    class Coordinator;
+
+    void timerCallback() override;
+
+    /** Starts a worker and asks it to load the plugin with the stored state. */
+    void launchWorker();
+
+    /** The worker's pipe closed: schedules restartWorker(). */
+    void handleWorkerLost();
+
+    /** Kills the worker and relaunches it, if restarts remain. */
+    void restartWorker();
+
+    void handleWorkerMessage (const juce::ValueTree& message);
+    void send (const juce::ValueTree& message);
+
+    juce::PluginDescription description;
+
+    std::unique_ptr<SandboxTransport> transport;
+    std::unique_ptr<Coordinator> coordinator;
+    std::atomic<bool> workerReady { false };
+
+    double sampleRate = 44100.0;
+    int blockSize = 512;
+    int remoteLatencySamples = 0;
+
+    juce::StringArray parameterNames;
+    juce::Array<float> parameterValues;
+
+    int restarts = 0;
+    bool restartPending = false;
+    juce::String lastError;
+
+    juce::uint32 lastCompleted = 0;
+    juce::uint32 stalledSinceMs = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SandboxedPlugin)
+};
+
+//==============================================================================
+/** Tracktion built-in type creating SandboxedPlugin (so sandboxed plugins reload with an edit). */
+struct SandboxedPluginBuiltIn : public te::PluginManager::BuiltInType
+{
+    SandboxedPluginBuiltIn() : te::PluginManager::BuiltInType (SandboxedPlugin::pluginType) {}
+
+    te::Plugin::Ptr create (te::PluginCreationInfo info) override
+    {
+        return new SandboxedPlugin (info);
+    }
+};
+
+/** Registers SandboxedPlugin with @p engine. Call once, next to registerMorphSynthCompat(). */
+inline void registerSandboxedPlugin (te::Engine& engine)
+{
+    engine.getPluginManager().registerBuiltInType (std::make_unique<SandboxedPluginBuiltIn>());
+}
@@ -0,0 +1,227 @@
+#include "MemoryDiagnosticsComponent.h"
+#include "../../AppEngine/AppEngine.h"
+
+MemoryDiagnosticsComponent::MemoryDiagnosticsComponent (AppEngine& engine)
+    : appEngine (engine)
+{
+    totalLabel.setFont (juce::Font (juce::FontOptions (15.0f, juce::Font::bold)));
+    addAndMakeVisible (totalLabel);
+
+    dumpButton.onClick = [this] { dumpJson(); };
+    addAndMakeVisible (dumpButton);
+
+    list.setRowHeight (22);
+    list.setColour (juce::ListBox::backgroundColourId, juce::Colour (0xff1e1e1e));
+    addAndMakeVisible (list);
+
+    silenceLabel.setText ("Silent tracks (CPU saved)", juce::dontSendNotification);
+    silenceLabel.setFont (juce::Font (juce::FontOptions (15.0f, juce::Font::bold)));
+    addAndMakeVisible (silenceLabel);
+
+    suspendToggle.setToggleState (appEngine.isSilenceSuspensionEnabled(), juce::dontSendNotification);
+    suspendToggle.onClick = [this] { appEngine.setSilenceSuspensionEnabled (suspendToggle.getToggleState()); };
+    addAndMakeVisible (suspendToggle);
+
+    resetSilenceButton.onClick = [this] { appEngine.resetSilenceStats(); refresh(); };
+    addAndMakeVisible (resetSilenceButton);
+
+    sandboxLabel.setText ("Sandboxed plugins", juce::dontSendNotification);
+    sandboxLabel.setFont (juce::Font (juce::FontOptions (15.0f, juce::Font::bold)));
+    addAndMakeVisible (sandboxLabel);
+
+    refresh();
+    startTimer (1000);
+}
+
+MemoryDiagnosticsComponent::~MemoryDiagnosticsComponent()
+{
+    stopTimer();
+}
+
+void MemoryDiagnosticsComponent::paint (juce::Graphics& g)
+{
+    g.fillAll (juce::Colour (0xff2a2a2a));
+    paintSilenceStats (g);
+    paintSandboxStats (g);
+}
+
+void MemoryDiagnosticsComponent::paintSandboxStats (juce::Graphics& g)
+{
+    g.setFont (juce::Font (juce::FontOptions (13.0f)));
+
+    if (sandboxStats.empty())
+    {
+        g.setColour (juce::Colours::grey);
+        g.drawText ("None (Track > Run New External Plugins Sandboxed)", sandboxArea, juce::Justification::topLeft);
+        return;
+    }
+
+    auto area = sandboxArea;
+    const int numRows = juce::jmin ((int) sandboxStats.size(), maxSandboxRows);
+
+    for (int i = 0; i < numRows; ++i)
+    {
+        const auto& s = sandboxStats[(size_t) i].stats;
+        const auto& t = s.transport;
+        auto row = area.removeFromTop (silenceRowHeight);
+
+        const auto ms = [] (double v) { return juce::String (v, 2); };
+
+        juce::String status = s.running ? juce::String() : (s.error.isNotEmpty() ? s.error : juce::String ("starting"));
+        if (s.restarts > 0)
+            status << (status.isEmpty() ? "" : ", ") << s.restarts << " restarts";
+
+        g.setColour (s.running ? juce::Colours::white : juce::Colours::orange);
+        g.drawText ("T" + juce::String (sandboxStats[(size_t) i].trackIndex + 1) + " " + s.name
+                        + (status.isNotEmpty() ? "  (" + status + ")" : ""),
+                    row.withTrimmedLeft (6).withTrimmedRight (310), juce::Justification::centredLeft, true);
+
+        const double lateFraction = t.blocks + t.lateBlocks > 0 ? (double) t.lateBlocks / (double) (t.blocks + t.lateBlocks) : 0.0;
+        // Milliseconds: added latency, then per-block averages of plugin, wake-up and host-side cost
+        g.drawText ("+" + ms (s.latencyMs) + " | plug " + ms (t.processMs) + " wake " + ms (t.wakeMs)
+                        + " host " + ms (t.hostMs) + " ms | late " + juce::String (lateFraction * 100.0, 1) + "%",
+                    row.withTrimmedRight (6), juce::Justification::centredRight);
+    }
+}
+
+void MemoryDiagnosticsComponent::paintSilenceStats (juce::Graphics& g)
+{
+    g.setFont (juce::Font (juce::FontOptions (13.0f)));
+
+    if (silenceStats.empty())
+    {
+        g.setColour (juce::Colours::grey);
+        g.drawText ("No MorphSynth tracks", silenceArea, juce::Justification::topLeft);
+        return;
+    }
+
+    auto area = silenceArea;
+    const int numRows = juce::jmin ((int) silenceStats.size(), maxSilenceRows);
+
+    for (int i = 0; i < numRows; ++i)
+    {
+        const auto& s = silenceStats[(size_t) i];
+        auto row = area.removeFromTop (silenceRowHeight);
+
+        // Idle (render skipped) behind suspended (inserts off too)
+        const auto bar = row.reduced (0, 2).toFloat();
+        g.setColour (juce::Colour (0xff34506e));
+        g.fillRect (bar.withWidth (bar.getWidth() * (float) s.idleFraction));
+        g.setColour (juce::Colour (0xff3d6ea8));
+        g.fillRect (bar.withWidth (bar.getWidth() * (float) s.suspendedFraction));
+
+        g.setColour (juce::Colours::white);
+        g.drawText (s.name + (s.suspended ? "  (suspended)" : ""),
+                    row.withTrimmedLeft (6).withTrimmedRight (260), juce::Justification::centredLeft, true);
+
+        const auto percent = [] (double f) { return juce::String (juce::roundToInt (f * 100.0)) + "%"; };
+        g.drawText ("synth idle " + percent (s.idleFraction)
+                        + "  |  " + juce::String (s.numInserts) + " inserts off " + percent (s.suspendedFraction),
+                    row.withTrimmedRight (6), juce::Justification::centredRight);
+    }
+}
+
+void MemoryDiagnosticsComponent::resized()
+{
+    auto area = getLocalBounds().reduced (10);
+
+    auto header = area.removeFromTop (28);
+    dumpButton.setBounds (header.removeFromRight (120));
+    totalLabel.setBounds (header);
+
+    area.removeFromTop (8);
+
+    sandboxArea = area.removeFromBottom (maxSandboxRows * silenceRowHeight);
+    area.removeFromBottom (4);
+    sandboxLabel.setBounds (area.removeFromBottom (24));
+    area.removeFromBottom (8);
+
+    silenceArea = area.removeFromBottom (maxSilenceRows * silenceRowHeight);
+    area.removeFromBottom (4);
+    auto silenceHeader = area.removeFromBottom (24);
+    resetSilenceButton.setBounds (silenceHeader.removeFromRight (70));
+    silenceHeader.removeFromRight (8);
+    suspendToggle.setBounds (silenceHeader.removeFromRight (170));
+    silenceLabel.setBounds (silenceHeader);
+    area.removeFromBottom (8);
+
+    list.setBounds (area);
+}
+
+void MemoryDiagnosticsComponent::refresh()
+{
+    report = appEngine.collectMemoryReport();
+    totalBytes = report.getTotalBytes();
+
+    rows.clear();
+    const auto items = report.getEntriesBySize();
+
+    for (const auto& subsystem : report.getSubsystemTotals())
+    {
+        rows.push_back ({ subsystem, true });
+
+        int shown = 0;
+        for (const auto& e : items)
+            if (e.subsystem == subsystem.subsystem && shown++ < maxItemsPerSubsystem)
+                rows.push_back ({ e, false });
+    }
+
+    totalLabel.setText ("Estimated total: " + MemoryAccounting::formatBytes (totalBytes), juce::dontSendNotification);
+    list.updateContent();
+    list.repaint();
+
+    silenceStats = appEngine.getSilenceStats();
+    sandboxStats = appEngine.getSandboxStats();
+    repaint (silenceArea);
+    repaint (sandboxArea);
+}
+
+int MemoryDiagnosticsComponent::getNumRows()
+{
+    return (int) rows.size();
+}
+
+void MemoryDiagnosticsComponent::paintListBoxItem (int rowNumber, juce::Graphics& g, int width, int height, bool)
+{
+    if (rowNumber < 0 || rowNumber >= (int) rows.size())
+        return;
+
+    const auto& row = rows[(size_t) rowNumber];
+    const auto& e   = row.entry;
+
+    // Size bar, relative to the whole session
+    const float fraction = totalBytes > 0 ? (float) e.bytes / (float) totalBytes : 0.0f;
+    g.setColour (row.isSubsystem ? juce::Colour (0xff3d6ea8) : juce::Colour (0xff34506e));
+    g.fillRect (0.0f, 2.0f, (float) width * fraction, (float) height - 4.0f);
+
+    g.setColour (juce::Colours::white);
+    g.setFont (juce::Font (juce::FontOptions (13.0f, row.isSubsystem ? juce::Font::bold : juce::Font::plain)));
+
+    const int indent = row.isSubsystem ? 6 : 24;
+    const auto name  = row.isSubsystem ? e.subsystem : e.item;
+    g.drawText (name, indent, 0, width - 200 - indent, height, juce::Justification::centredLeft, true);
+
+    g.drawText ("x" + juce::String (e.count), width - 200, 0, 70, height, juce::Justification::centredRight);
+    g.drawText (MemoryAccounting::formatBytes (e.bytes), width - 125, 0, 120, height, juce::Justification::centredRight);
+}
+
+void MemoryDiagnosticsComponent::timerCallback()
+{
+    if (isShowing())
+        refresh();
+}
+
+void MemoryDiagnosticsComponent::dumpJson()
+{
+    const auto defaultFile = juce::File::getSpecialLocation (juce::File::userDesktopDirectory)
+                                 .getChildFile ("GrooveKit-memory.json");
+
+    chooser = std::make_unique<juce::FileChooser> ("Save memory report", defaultFile, "*.json");
+    chooser->launchAsync (juce::FileBrowserComponent::saveMode | juce::FileBrowserComponent::warnAboutOverwriting,
+                          [this] (const juce::FileChooser& fc)
+                          {
+                              const auto file = fc.getResult();
+                              if (file != juce::File())
+                                  appEngine.writeMemoryReport (file);
+                          });
+}
@@ -0,0 +1,85 @@
+#pragma once
+#include <juce_gui_basics/juce_gui_basics.h>
+#include "../../AppEngine/MemoryAccounting.h"
+#include "../../AppEngine/AppEngine.h"
+
+/**
+ * @brief Live view of where session memory goes, from AppEngine::collectMemoryReport().
+ *
+ * Shows each subsystem's total (largest first) followed by its biggest items,
+ * with a bar scaled to the overall total. Refreshes once a second while visible
+ * and can dump the full report as JSON.
+ *
+ * Below the memory list, one row per MorphSynth track shows how much of the time
+ * the synth skipped rendering and its FX inserts were suspended (the CPU the
+ * silence gate saved), with a toggle for suspension itself. Sandboxed plugins
+ * follow, with the latency and per-block overhead of running out of process.
+ *
+ * Usage:
+ *  - Launched from GrooveKitMenuBar via "Help → Memory Diagnostics..."
+ */
+class MemoryDiagnosticsComponent : public juce::Component,
+                                   private juce::ListBoxModel,
+                                   private juce::Timer
+{
+public:
+    explicit MemoryDiagnosticsComponent (AppEngine& engine);
+    ~MemoryDiagnosticsComponent() override;
+
+    void paint (juce::Graphics& g) override;
+    void resized() override;
+
+    /** Re-collects the report and repaints. */
+    void refresh();
+
+private:
+    /** One display row: a subsystem header or one of its items. */
+    struct Row
+    {
+        MemoryReport::Entry entry;
+        bool isSubsystem = false;
+    };
+
+    // juce::ListBoxModel
+    int getNumRows() override;
+    void paintListBoxItem (int rowNumber, juce::Graphics& g, int width, int height, bool rowIsSelected) override;
+
+    // juce::Timer
+    void timerCallback() override;
+
+    void dumpJson();
+
+    /** Draws the per-track silence rows into silenceArea. */
+    void paintSilenceStats (juce::Graphics& g);
+
+    /** Draws one row per sandboxed plugin into sandboxArea. */
+    void paintSandboxStats (juce::Graphics& g);
+
+    static constexpr int maxItemsPerSubsystem = 8;
+
+    AppEngine& appEngine; ///< Reference to global engine (not owned)
+
+    MemoryReport report;
+    std::vector<Row> rows;
+    juce::int64 totalBytes = 0;
+
+    juce::Label totalLabel;
+    juce::TextButton dumpButton { "Dump JSON..." };
+    juce::ListBox list { "Memory", this };
+
+    std::vector<SilenceMonitor::TrackStats> silenceStats;
+    juce::Label silenceLabel;
+    juce::ToggleButton suspendToggle { "Suspend idle inserts" };
+    juce::TextButton resetSilenceButton { "Reset" };
+    juce::Rectangle<int> silenceArea;
+    static constexpr int silenceRowHeight = 20;
+    static constexpr int maxSilenceRows = 8;
+
+    std::vector<AppEngine::SandboxTrackStats> sandboxStats;
+    juce::Label sandboxLabel;
+    juce::Rectangle<int> sandboxArea;
+    static constexpr int maxSandboxRows = 4;
+    std::unique_ptr<juce::FileChooser> chooser;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MemoryDiagnosticsComponent)
+};
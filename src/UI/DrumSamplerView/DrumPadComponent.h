@@ -2,6 +2,7 @@
 
 #include <functional>
 #include <juce_gui_basics/juce_gui_basics.h>
+#include "DrumSamplerEngine/DefaultSampleLibrary.h"
 
 /**
  * @brief A single drum pad UI element with click + drag-and-drop behavior.
@@ -87,7 +88,8 @@ public:
 
     void itemDropped (const SourceDetails& d) override
     {
-        const juce::File f (d.description.toString());
+        // Built-in samples may not be on disk yet: write them out first
+        const auto f = DefaultSampleLibrary::materialise (juce::File (d.description.toString()));
         if (f.existsAsFile() && onDropFile)
             onDropFile (f);
     }
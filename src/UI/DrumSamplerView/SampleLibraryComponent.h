@@ -136,7 +136,7 @@ class SampleLibraryComponent : public juce::Component
 public:
     SampleLibraryComponent()
     {
-        // Make sure built-in samples are on disk before listing them.
+        // Index built-in samples (served from the binary) and tidy the library folder.
         DefaultSampleLibrary::ensureInstalled();
 
         refreshList();
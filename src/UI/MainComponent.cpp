@@ -19,9 +19,11 @@ MainComponent::MainComponent()
 
     setSize(1200, 800);
 
-    appEngine.initialise();
-
     showTrackView();
+
+    // The empty edit and main view exist; devices, plugins and samples follow in stages
+    appEngine.getStartup().markInteractive();
+    appEngine.initialise();
 }
 
 MainComponent::~MainComponent() = default;
@@ -3,6 +3,7 @@
 
 #include "GrooveKitMenuBar.h"
 #include "../Settings/SettingsDialog.h"
+#include "../Diagnostics/MemoryDiagnosticsComponent.h"
 
 #include <TrackView/ExportOverlayComponent.h>
 
@@ -56,7 +57,15 @@ juce::PopupMenu GrooveKitMenuBar::getMenuForIndex(const int topLevelMenuIndex, c
         SaveEditAs = 2004,
         ExportAudio = 2005,
         NewInstrumentTrack = 3001,
-        NewDrumTrack = 3002
+        NewDrumTrack = 3002,
+        NewAudioTrack = 3003,
+        QuantizeAllMidiClips = 3004,
+        QuantizeAllMidiClipsToGroove = 3005,
+        SandboxExternalPlugins = 3006,
+        MidiLearnMode = 3007,
+        SendControllerFeedback = 3008,
+        ClearMidiMappings = 3009,
+        ShowMemoryDiagnostics = 4001
     };
 
     if (topLevelMenuIndex == 0) // File
@@ -80,8 +89,22 @@ juce::PopupMenu GrooveKitMenuBar::getMenuForIndex(const int topLevelMenuIndex, c
     {
         menu.addItem(NewInstrumentTrack, "New Instrument Track");
         menu.addItem(NewDrumTrack, "New Drum Track");
+        menu.addItem(NewAudioTrack, "New Audio Track");
+        menu.addSeparator();
+        menu.addItem(QuantizeAllMidiClips, "Quantize All MIDI Clips (1/16)");
+        menu.addItem(QuantizeAllMidiClipsToGroove, "Quantize All MIDI Clips to Groove", appEngine->getGroove() != nullptr);
+        menu.addSeparator();
+        menu.addItem(SandboxExternalPlugins, "Run New External Plugins Sandboxed", true, appEngine->isPluginSandboxingEnabled());
+        menu.addSeparator();
+        auto& midiLearn = appEngine->getMidiLearn();
+        menu.addItem(MidiLearnMode, "MIDI Learn", true, midiLearn.isLearning());
+        menu.addItem(SendControllerFeedback, "Send Controller Feedback", true, midiLearn.isFeedbackEnabled());
+        menu.addItem(ClearMidiMappings, "Clear MIDI Mappings", ! midiLearn.getMappings().empty());
+    }
+    else if (topLevelMenuIndex == 3) // Help
+    {
+        menu.addItem(ShowMemoryDiagnostics, "Memory Diagnostics...");
     }
-    // topLevelMenuIndex == 3 or 2 (depending on view mode) is Help - empty for now
 
     return menu;
 }
@@ -99,7 +122,15 @@ void GrooveKitMenuBar::menuItemSelected(const int menuItemID, int)
         SaveEditAs = 2004,
         ExportAudio = 2005,
         NewInstrumentTrack = 3001,
-        NewDrumTrack = 3002
+        NewDrumTrack = 3002,
+        NewAudioTrack = 3003,
+        QuantizeAllMidiClips = 3004,
+        QuantizeAllMidiClipsToGroove = 3005,
+        SandboxExternalPlugins = 3006,
+        MidiLearnMode = 3007,
+        SendControllerFeedback = 3008,
+        ClearMidiMappings = 3009,
+        ShowMemoryDiagnostics = 4001
     };
 
     switch (menuItemID)
@@ -112,6 +143,31 @@ void GrooveKitMenuBar::menuItemSelected(const int menuItemID, int)
             if (onNewDrumTrack)
                 onNewDrumTrack();
             break;
+        case NewAudioTrack:
+            if (onNewAudioTrack)
+                onNewAudioTrack();
+            break;
+        case QuantizeAllMidiClips:
+        case QuantizeAllMidiClipsToGroove:
+        {
+            QuantizeEngine::Settings settings;
+            if (menuItemID == QuantizeAllMidiClipsToGroove)
+                settings.groove = appEngine->getGroove();
+            appEngine->quantizeAllMidiClips(settings);
+            break;
+        }
+        case SandboxExternalPlugins:
+            appEngine->setPluginSandboxingEnabled(! appEngine->isPluginSandboxingEnabled());
+            break;
+        case MidiLearnMode:
+            appEngine->getMidiLearn().setLearning(! appEngine->getMidiLearn().isLearning());
+            break;
+        case SendControllerFeedback:
+            appEngine->getMidiLearn().setFeedbackEnabled(! appEngine->getMidiLearn().isFeedbackEnabled());
+            break;
+        case ClearMidiMappings:
+            appEngine->getMidiLearn().clearMappings();
+            break;
         case SwitchToTrackEdit: // (Written by Claude Code)
             if (onSwitchToTrackEdit)
                 onSwitchToTrackEdit();
@@ -123,6 +179,9 @@ void GrooveKitMenuBar::menuItemSelected(const int menuItemID, int)
         case ShowPreferences: // (Written by Claude Code)
             showPreferences();
             break;
+        case ShowMemoryDiagnostics:
+            showMemoryDiagnostics();
+            break;
         case NewEdit:
             showNewEditMenu();
             break;
@@ -163,6 +222,19 @@ void GrooveKitMenuBar::showPreferences() const
     opts.launchAsync();
 }
 
+void GrooveKitMenuBar::showMemoryDiagnostics() const
+{
+    auto* diagnostics = new MemoryDiagnosticsComponent(*appEngine);
+    diagnostics->setSize(560, 760);
+
+    juce::DialogWindow::LaunchOptions opts;
+    opts.content.setOwned(diagnostics);
+    opts.dialogTitle = "Memory Diagnostics";
+    opts.resizable = true;
+    opts.useNativeTitleBar = true;
+    opts.launchAsync();
+}
+
 void GrooveKitMenuBar::showNewEditMenu() const
 {
     if (appEngine->isDirty())
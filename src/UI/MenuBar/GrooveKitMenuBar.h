@@ -47,9 +47,11 @@ public:
     std::function<void()> onSwitchToTrackEdit; // (Written by Claude Code)
     std::function<void()> onNewInstrumentTrack;
     std::function<void()> onNewDrumTrack;
+    std::function<void()> onNewAudioTrack;
 
 private:
     void showPreferences() const; // (Written by Claude Code)
+    void showMemoryDiagnostics() const;
     void showNewEditMenu() const;
     void showOpenEditMenu() const;
     void exportAudio();
@@ -27,6 +27,10 @@ MixView::MixView(AppEngine& engine, TransportBar& transport, GrooveKitMenuBar& m
         appEngine.addDrumTrack();
         refreshMixer();
     };
+    menuBar->onNewAudioTrack = [this] {
+        appEngine.addAudioTrack();
+        refreshMixer();
+    };
 
     // Enable keyboard focus for MIDI playback
     setWantsKeyboardFocus(true);
@@ -0,0 +1,234 @@
+// ==============================================================================
+// MidiFxPlugin.cpp
+// ------------------------------------------------------------------------------
+// Parameter creation, tempo tracking and MIDI rendering for MidiFxPlugin.
+// ==============================================================================
+
+#include "MidiFxPlugin.h"
+
+//------------------------------------------------------------------------------
+// Parameter helpers (local to this TU)
+//------------------------------------------------------------------------------
+namespace
+{
+    namespace IDs
+    {
+        static const juce::Identifier mode    ("mode");
+        static const juce::Identifier rate    ("rate");
+        static const juce::Identifier pattern ("pattern");
+        static const juce::Identifier chord   ("chord");
+        static const juce::Identifier octaves ("octaves");
+        static const juce::Identifier gate    ("gate");
+    }
+
+    /** Create a discrete (choice) parameter backed by @p value. */
+    static te::AutomatableParameter* addChoice (te::Plugin& plug, juce::CachedValue<float>& value,
+                                                const juce::String& id, const juce::String& name,
+                                                const juce::StringArray& choices)
+    {
+        auto range = juce::NormalisableRange<float> (0.f, (float) (choices.size() - 1), 1.f);
+
+        auto valueToString = [choices] (float v)
+        {
+            return choices[juce::jlimit (0, choices.size() - 1, (int) std::round (v))];
+        };
+        auto stringToValue = [choices] (const juce::String& s)
+        {
+            return (float) juce::jmax (0, choices.indexOf (s));
+        };
+
+        auto* p = plug.addParam (id, name, range, valueToString, stringToValue);
+        p->attachToCurrentValue (value);
+        return p;
+    }
+
+    static int indexOf (const te::AutomatableParameter::Ptr& p)
+    {
+        return p != nullptr ? juce::roundToInt (p->getCurrentValue()) : 0;
+    }
+}
+
+//==============================================================================
+// Construction / destruction
+//==============================================================================
+
+MidiFxPlugin::MidiFxPlugin (const te::PluginCreationInfo& info)
+    : te::Plugin (info),
+      midiSourceID (te::createUniqueMPESourceID())
+{
+    auto* um = getUndoManager();
+
+    modeValue   .referTo (state, IDs::mode,    um, 1.0f);   // Arpeggiator
+    rateValue   .referTo (state, IDs::rate,    um, 3.0f);   // 1/16
+    patternValue.referTo (state, IDs::pattern, um, 0.0f);   // Up
+    chordValue  .referTo (state, IDs::chord,   um, 0.0f);   // Off
+    octavesValue.referTo (state, IDs::octaves, um, 1.0f);
+    gateValue   .referTo (state, IDs::gate,    um, 0.5f);
+
+    modeParam    = addChoice (*this, modeValue,    "mode",    "Mode",    MidiFxProcessor::getModeNames());
+    rateParam    = addChoice (*this, rateValue,    "rate",    "Rate",    MidiFxProcessor::getRateNames());
+    patternParam = addChoice (*this, patternValue, "pattern", "Pattern", MidiFxProcessor::getPatternNames());
+    chordParam   = addChoice (*this, chordValue,   "chord",   "Chord",   MidiFxProcessor::getChordNames());
+
+    octavesParam = addParam ("octaves", "Octaves", { 1.0f, (float) MidiFxProcessor::maxOctaves, 1.0f });
+    octavesParam->attachToCurrentValue (octavesValue);
+
+    gateParam = addParam ("gate", "Gate", { 0.05f, 1.0f });
+    gateParam->attachToCurrentValue (gateValue);
+}
+
+MidiFxPlugin::~MidiFxPlugin()
+{
+    notifyListenersOfDeletion();
+
+    for (auto* p : { modeParam.get(), rateParam.get(), patternParam.get(),
+                     chordParam.get(), octavesParam.get(), gateParam.get() })
+        if (p != nullptr)
+            p->detachFromCurrentValue();
+}
+
+//==============================================================================
+// te::Plugin lifecycle
+//==============================================================================
+
+void MidiFxPlugin::initialise (const te::PluginInitialisationInfo& info)
+{
+    sampleRate = info.sampleRate;
+    const int maxBlock = (info.blockSizeSamples > 0 ? (int) info.blockSizeSamples : 512);
+
+    // Enough for a dense block on both sides, so rendering never grows them. A chord
+    // turns every incoming note into several, so the output side gets room for that
+    const int inputEvents = juce::jmax (maxBlock, minMidiEventsPerBlock);
+    outputEventCapacity = inputEvents * MidiFxProcessor::maxChordTones;
+
+    inScratch.clear();
+    inScratch.ensureSize ((size_t) (inputEvents * bytesPerMidiEvent));
+    outScratch.clear();
+    outScratch.ensureSize ((size_t) (outputEventCapacity * bytesPerMidiEvent));
+
+    // The graph's output array is only seen while rendering: have storage ready to swap in
+    outputSpare.clear();
+    outputSpare.reserve (outputEventCapacity);
+    spareReserved = true;
+
+    processor.reset();
+    auditionQueue.reset();
+}
+
+void MidiFxPlugin::deinitialise()
+{
+    processor.reset();
+}
+
+void MidiFxPlugin::reset()
+{
+    processor.reset();
+    auditionQueue.reset();
+}
+
+void MidiFxPlugin::restorePluginStateFromValueTree (const juce::ValueTree& v)
+{
+    te::copyPropertiesToCachedValues (v, modeValue, rateValue, patternValue, chordValue, octavesValue, gateValue);
+}
+
+//==============================================================================
+// Settings
+//==============================================================================
+
+MidiFxProcessor::Settings MidiFxPlugin::getSettings() const
+{
+    MidiFxProcessor::Settings s;
+    s.mode      = (MidiFxProcessor::Mode)    indexOf (modeParam);
+    s.pattern   = (MidiFxProcessor::Pattern) indexOf (patternParam);
+    s.chord     = (MidiFxProcessor::Chord)   indexOf (chordParam);
+    s.stepBeats = MidiFxProcessor::rateIndexToBeats (indexOf (rateParam));
+    s.octaves   = indexOf (octavesParam);
+    s.gate      = gateParam != nullptr ? gateParam->getCurrentValue() : 0.5f;
+    return s;
+}
+
+bool MidiFxPlugin::isPassThrough() const
+{
+    const auto s = getSettings();
+    return s.mode == MidiFxProcessor::Mode::off && s.chord == MidiFxProcessor::Chord::off;
+}
+
+juce::String MidiFxPlugin::getSummary() const
+{
+    const auto s = getSettings();
+    const auto rate = MidiFxProcessor::getRateNames()[indexOf (rateParam)];
+    const auto chord = MidiFxProcessor::getChordNames()[indexOf (chordParam)];
+
+    switch (s.mode)
+    {
+        case MidiFxProcessor::Mode::arpeggiator: return "Arp " + rate;
+        case MidiFxProcessor::Mode::noteRepeat:  return "Repeat " + rate;
+        case MidiFxProcessor::Mode::off:
+        default:                                 return s.chord != MidiFxProcessor::Chord::off ? "Chord " + chord : "MIDI FX";
+    }
+}
+
+//==============================================================================
+// Rendering
+//==============================================================================
+
+void MidiFxPlugin::applyToBuffer (const te::PluginRenderContext& rc)
+{
+    auto* midi = rc.bufferForMidiMessages;
+    const int numSamples = rc.bufferNumSamples;
+
+    if (midi == nullptr || numSamples <= 0)
+        return;
+
+    // Incoming timestamps are seconds relative to the block start
+    inScratch.clear();
+    for (auto& m : *midi)
+        inScratch.addEvent (m, juce::jlimit (0, numSamples - 1, juce::roundToInt (m.getTimeStamp() * sampleRate)));
+
+    // Where this block sits on the beat grid. One conversion per block edge; within
+    // the block the tempo is treated as constant (exact unless a ramp is mid-block).
+    double startBeat = freeRunningBeat;
+    double beatsPerSample = 0.0;
+    auto& tempo = edit.tempoSequence;
+
+    if (rc.isPlaying)
+    {
+        startBeat = tempo.toBeats (rc.editTime.getStart()).inBeats();
+        const double endBeat = tempo.toBeats (rc.editTime.getEnd()).inBeats();
+        beatsPerSample = (endBeat - startBeat) / numSamples;
+    }
+    else
+    {
+        beatsPerSample = tempo.getBeatsPerSecondAt (rc.editTime.getStart()) / sampleRate;
+    }
+
+    freeRunningBeat = startBeat + beatsPerSample * numSamples;
+
+    processor.process (getSettings(), inScratch, outScratch, numSamples, startBeat, beatsPerSample);
+
+    // Audition notes skip the effect: the instrument plays what was drawn
+    auditionQueue.render (outScratch, 0, numSamples, sampleRate);
+
+    // The graph's array keeps its storage across clear(). The first block after
+    // initialise() hands it the spare's storage (the input is in inScratch by now);
+    // after that, reserve() only checks the capacity, and allocates only if the graph
+    // swaps in another array before the next initialise(). Anything past the budget
+    // is dropped
+    if (spareReserved)
+    {
+        midi->swapWith (outputSpare);
+        spareReserved = false;
+    }
+
+    midi->reserve (outputEventCapacity);
+    midi->clear();
+    int numOut = 0;
+
+    for (const auto meta : outScratch)
+    {
+        if (numOut++ == outputEventCapacity)
+            break;
+
+        midi->addMidiMessage (meta.getMessage(), meta.samplePosition / sampleRate, midiSourceID);
+    }
+}
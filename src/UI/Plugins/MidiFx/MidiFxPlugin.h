@@ -0,0 +1,133 @@
+// ==============================================================================
+// MidiFxPlugin.h
+// ------------------------------------------------------------------------------
+// Tracktion Engine MIDI-effect plugin: arpeggiator / chord / note repeat
+//
+// Responsibilities:
+//  - Owns the MIDI FX parameters (mode, rate, pattern, chord, octaves, gate).
+//  - Runs MidiFxProcessor on the track's MIDI ahead of the instrument.
+//  - Follows the Edit's tempo sequence so steps land on the beat grid.
+//  - Carries piano-roll audition notes to instruments other than MorphSynth.
+//
+// Notes:
+//  - Lives in the track's MIDI FX slot (pluginList[0], before the instrument);
+//    see TrackManager::getInstrumentSlotIndex().
+//  - Audio passes through untouched.
+// ==============================================================================
+
+#pragma once
+
+#include <tracktion_engine/tracktion_engine.h>
+#include "../../../MIDIEngine/MidiFxProcessor.h"
+#include "../../../MIDIEngine/AuditionQueue.h"
+
+namespace te = tracktion::engine;
+
+/**
+ * @brief Tracktion Engine MIDI effect: arpeggiator, chord generator and note repeat.
+ *
+ * Sits before the instrument on a track and rewrites the block's MIDI in place, so
+ * a held chord can replace a clip full of drawn-in arpeggio notes. All generation
+ * happens in applyToBuffer() on the audio thread, at sample-accurate positions.
+ *
+ * Tempo sync: while playing, each block's beat range comes from the Edit's tempo
+ * sequence, so steps follow tempo changes and restart on the grid after a locate.
+ * While stopped (live playing) the grid free-runs at the tempo at the playhead.
+ *
+ * Parameters are te::AutomatableParameters backed by CachedValues on the plugin
+ * state, so they're saved with the Edit and can be automated.
+ *
+ * Audition: instruments other than MorphSynth have no queue of their own, so the
+ * slot drains an AuditionQueue into its output, after the effect (the note plays
+ * as drawn). With mode and chord both off (isPassThrough()) the plugin only does
+ * that, and the track counts as having no MIDI FX.
+ */
+class MidiFxPlugin final : public te::Plugin
+{
+public:
+    //==============================================================================
+    // Construction & identity
+    //------------------------------------------------------------------------------
+
+    /** Stable XML/plugin type id (must match registration). */
+    static inline const juce::String pluginType { "gkmidifx" };
+
+    /** Construct with Tracktion's PluginCreationInfo. */
+    explicit MidiFxPlugin (const te::PluginCreationInfo& info);
+
+    /** Destructor. */
+    ~MidiFxPlugin() override;
+
+    //==============================================================================
+    // te::Plugin overrides
+    //------------------------------------------------------------------------------
+
+    juce::String getName() const override                   { return "MIDI FX"; }
+    juce::String getPluginType() override                   { return pluginType; }
+    juce::String getSelectableDescription() override        { return getName(); }
+
+    bool takesMidiInput() override                          { return true; }
+
+    void initialise   (const te::PluginInitialisationInfo&) override;
+    void deinitialise () override;
+    void reset        () override;
+
+    /** Main render entry point: rewrites rc.bufferForMidiMessages. */
+    void applyToBuffer (const te::PluginRenderContext&) override;
+
+    void restorePluginStateFromValueTree (const juce::ValueTree&) override;
+
+    //==============================================================================
+    // Settings
+    //------------------------------------------------------------------------------
+
+    /** Current parameter values as processor settings. */
+    MidiFxProcessor::Settings getSettings() const;
+
+    /** Short label for track headers/menus, e.g. "Arp 1/16" or "Chord Min7". */
+    juce::String getSummary() const;
+
+    /** True with mode and chord both off: MIDI passes through unchanged. */
+    bool isPassThrough() const;
+
+    /** Piano-roll notes for the instrument after this slot. */
+    AuditionQueue& getAuditionQueue() noexcept              { return auditionQueue; }
+
+    //==============================================================================
+    // Parameters (menus bind to these directly)
+    //------------------------------------------------------------------------------
+    te::AutomatableParameter::Ptr modeParam, rateParam, patternParam, chordParam, octavesParam, gateParam;
+
+private:
+    //==============================================================================
+    // State
+    //------------------------------------------------------------------------------
+    juce::CachedValue<float> modeValue, rateValue, patternValue, chordValue, octavesValue, gateValue;
+
+    MidiFxProcessor processor;
+    AuditionQueue auditionQueue;
+
+    /** Block MIDI in sample positions. Reserved in initialise(), only cleared while rendering. */
+    juce::MidiBuffer inScratch, outScratch;
+
+    int outputEventCapacity = minMidiEventsPerBlock;        ///< Most events written back per block
+
+    /**
+     * Render arrays belong to the graph, which only hands them over once playing.
+     * This one is reserved in initialise() and swapped into the first array rendered
+     * after it, so that array already has room for outputEventCapacity events.
+     */
+    te::MidiMessageArray outputSpare;
+    bool spareReserved = false;
+
+    double sampleRate = 44100.0;
+    double freeRunningBeat = 0.0;               ///< Grid position while the transport is stopped
+    te::MPESourceID midiSourceID;
+
+    /** Bytes reserved per MIDI event in the scratch buffers (timestamp + size + short message). */
+    static constexpr int bytesPerMidiEvent = 16;
+    /** Lower bound on reserved events per block, for tiny block sizes. */
+    static constexpr int minMidiEventsPerBlock = 512;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MidiFxPlugin)
+};
@@ -0,0 +1,40 @@
+#pragma once
+
+// ==============================================================================
+// MidiFxRegistration.h
+// ------------------------------------------------------------------------------
+// Registers the MIDI FX plugin as a Tracktion Engine built-in plugin type.
+// Mirrors MorphSynthRegistration.h.
+// ==============================================================================
+
+#include <tracktion_engine/tracktion_engine.h>
+#include "MidiFxPlugin.h"
+
+namespace te = tracktion::engine;
+
+/**
+ * @brief Tracktion built-in type for the MIDI FX plugin.
+ *
+ * Lets the PluginCache create MidiFxPlugin instances from code and restore them
+ * from saved edits.
+ */
+struct MidiFxBuiltIn : public te::PluginManager::BuiltInType
+{
+    MidiFxBuiltIn()
+        : te::PluginManager::BuiltInType (MidiFxPlugin::pluginType) {}
+
+    te::Plugin::Ptr create (te::PluginCreationInfo info) override
+    {
+        return new MidiFxPlugin (info);
+    }
+};
+
+/**
+ * @brief Register the MIDI FX built-in plugin with a Tracktion Engine.
+ *
+ * Call once during app initialisation, next to registerMorphSynthCompat().
+ */
+inline void registerMidiFx (te::Engine& engine)
+{
+    engine.getPluginManager().registerBuiltInType (std::make_unique<MidiFxBuiltIn>());
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include <juce_audio_basics/juce_audio_basics.h>
+
+// ==============================================================================
+// MorphExpression.h
+// ------------------------------------------------------------------------------
+// Per-note expression (MPE pitch bend, pressure, slide) for all Morph Synth voices.
+//
+// Responsibilities:
+//  - Hold every voice's expression targets and smoothed values in flat arrays.
+//  - Smooth all voices in one vectorised pass per control tick.
+//  - Remember the last pressure/slide per MIDI channel, so a note picks up values
+//    sent just before its note-on (as MPE controllers do).
+//
+// Notes:
+//  - Owned by MorphSynthPlugin; voices write targets and read smoothed values
+//    through their slot index.
+// ==============================================================================
+
+/**
+ * @brief Structure-of-arrays expression state for up to maxVoices voices.
+ *
+ * Each dimension is one contiguous run of maxVoices floats, and the targets and
+ * smoothed values are two contiguous blocks of numDimensions * maxVoices floats.
+ * A control tick is then three FloatVectorOperations calls over the whole block,
+ * whatever the number of sounding voices. A 15-channel MPE performance costs the
+ * same as a single note.
+ *
+ * Units: pitch is in semitones, pressure is 0..1, slide is -1..1 (CC74 centred on 64).
+ *
+ * Thread safety: audio thread only (written from voice callbacks and the plugin's
+ * render loop).
+ */
+struct MorphExpression
+{
+    static constexpr int maxVoices = 16;        ///< 15 MPE member channels plus one for the master channel
+    static constexpr int controlInterval = 32;  ///< Samples per control tick
+
+    enum Dimension : int { pitch, pressure, slide, numDimensions };
+
+    /** Sets the smoothing time constant (call from prepare, not while rendering). */
+    void prepare (double sampleRate, double smoothingSeconds = 0.005)
+    {
+        coefficient = (float) (1.0 - std::exp (-(double) controlInterval / juce::jmax (1.0, smoothingSeconds * sampleRate)));
+        reset();
+    }
+
+    /** Zeroes all voices, the master bend and the channel memory. */
+    void reset() noexcept
+    {
+        juce::FloatVectorOperations::clear (target, numValues);
+        juce::FloatVectorOperations::clear (current, numValues);
+        juce::FloatVectorOperations::clear (channelPressure, 16);
+        juce::FloatVectorOperations::clear (channelSlide, 16);
+        masterBendTarget = masterBend = 0.0f;
+    }
+
+    /** Starts a voice at the given values with no smoothing (note-on). */
+    void startVoice (int voice, float pitchSemis, float pressureValue, float slideValue) noexcept
+    {
+        target[index (pitch, voice)]    = current[index (pitch, voice)]    = pitchSemis;
+        target[index (pressure, voice)] = current[index (pressure, voice)] = pressureValue;
+        target[index (slide, voice)]    = current[index (slide, voice)]    = slideValue;
+    }
+
+    void setTarget (Dimension d, int voice, float value) noexcept   { target[index (d, voice)] = value; }
+    float get (Dimension d, int voice) const noexcept               { return current[index (d, voice)]; }
+
+    /** Moves every smoothed value one control tick towards its target. */
+    void advance() noexcept
+    {
+        juce::FloatVectorOperations::copy (delta, target, numValues);
+        juce::FloatVectorOperations::subtract (delta, current, numValues);
+        juce::FloatVectorOperations::addWithMultiply (current, delta, coefficient, numValues);
+
+        masterBend += coefficient * (masterBendTarget - masterBend);
+    }
+
+    //==============================================================================
+    float masterBendTarget = 0.0f, masterBend = 0.0f;  ///< Zone-wide bend from the MPE master channel (semitones)
+    float channelPressure[16] {};                      ///< Last pressure per MIDI channel, 0..1
+    float channelSlide[16] {};                         ///< Last slide per MIDI channel, -1..1
+
+private:
+    static constexpr int numValues = numDimensions * maxVoices;
+
+    static constexpr int index (Dimension d, int voice) noexcept   { return (int) d * maxVoices + voice; }
+
+    alignas (16) float target [numValues] {};
+    alignas (16) float current[numValues] {};
+    alignas (16) float delta  [numValues] {};
+    float coefficient = 1.0f;
+};
@@ -5,6 +5,7 @@
 // ==============================================================================
 
 #include "MorphSynthPlugin.h"
+#include "../../../AppEngine/MemoryAccounting.h"
 
 //------------------------------------------------------------------------------
 // Local sound type for JUCE Synthesiser
@@ -124,6 +125,33 @@ MorphSynthPlugin::MorphSynthPlugin (const te::PluginCreationInfo& info)
     // --- Output
     gain = addFloat (*this, "gain", "Output", -24.f, 6.f, 0.f);
 
+    // --- Expression (MPE)
+    mpe            = addChoice (*this, "mpe", "MPE", juce::StringArray{ "Off", "Lower Zone", "Upper Zone" }, 0);
+    bendRange      = addFloat  (*this, "bendRange",      "Bend Range",       0.f, 48.f, 2.f);   // semitones
+    pressureCutoff = addFloat  (*this, "pressureCutoff", "Pressure > Cutoff", 0.f, 4.f,  1.f);  // octaves
+    slideMorph     = addFloat  (*this, "slideMorph",     "Slide > Morph",     0.f, 1.f,  0.5f);
+
+    // --- Voice lookup table (ParamID -> parameter)
+    using PID = MorphVoice::ParamID;
+    const std::pair<PID, te::AutomatableParameter*> lookup[] = {
+        { PID::morph, morph },         { PID::pulseWidth, pulseWidth },
+        { PID::cutoff, cutoff },       { PID::resonance, resonance },
+        { PID::aA, aA }, { PID::dA, dA }, { PID::sA, sA }, { PID::rA, rA },
+        { PID::aF, aF }, { PID::dF, dF }, { PID::sF, sF }, { PID::rF, rF },
+        { PID::fEnvAmt, fEnvAmt },
+        { PID::semi, semi },           { PID::fine, fine },
+        { PID::glide, glide },         { PID::keyTrack, keyTrack },
+        { PID::lfoRate, lfoRate },     { PID::lfoDepth, lfoDepth },
+        { PID::gain, gain },
+        { PID::oscAType, oscAType },   { PID::oscBType, oscBType },
+        { PID::filterType, filterType }, { PID::lfoTarget, lfoTarget },
+        { PID::mpe, mpe },             { PID::bendRange, bendRange },
+        { PID::pressureCutoff, pressureCutoff }, { PID::slideMorph, slideMorph }
+    };
+
+    for (auto& [id, param] : lookup)
+        paramTable[(size_t) id] = param;
+
     // --- Synth voices/sounds
     for (int i = 0; i < numVoices; ++i)
         synth.addVoice (new MorphVoice());
@@ -147,13 +175,22 @@ void MorphSynthPlugin::initialise (const te::PluginInitialisationInfo& info)
     const double sr       = info.sampleRate;
     const int    maxBlock = (info.blockSizeSamples > 0 ? (int) info.blockSizeSamples : 512);
 
+    currentSampleRate = sr;
+    expression.prepare (sr);
+
     synth.setCurrentPlaybackSampleRate (sr);
     synth.setNoteStealingEnabled (true);
 
+    // Reserve room for (at least) one event per sample so applyToBuffer never
+    // has to grow the buffer on the audio thread.
+    midiScratch.clear();
+    midiScratchReservedBytes = (size_t) (juce::jmax (maxBlock, minMidiEventsPerBlock) * bytesPerMidiEvent);
+    midiScratch.ensureSize (midiScratchReservedBytes);
+
     // Prepare voices with engine parameters/ptrs
     for (int i = 0; i < synth.getNumVoices(); ++i)
         if (auto* v = dynamic_cast<MorphVoice*> (synth.getVoice (i)))
-            v->prepare (sr, maxBlock, this);
+            v->prepare (sr, maxBlock, this, &expression, i);
 }
 
 void MorphSynthPlugin::deinitialise()
@@ -166,6 +203,8 @@ void MorphSynthPlugin::deinitialise()
 void MorphSynthPlugin::reset()
 {
     stopAllNotes();
+    expression.reset();
+    auditionQueue.reset();
 }
 
 //==============================================================================
@@ -181,18 +220,102 @@ void MorphSynthPlugin::applyToBuffer (const te::PluginRenderContext& rc)
     const int start   = rc.bufferStartSample;
     const int numSamp = rc.bufferNumSamples;
 
-    // Collect MIDI
-    juce::MidiBuffer midi;
+    // The zone bend came from the old mode's master channel: drop it on a mode change
+    if (const int mode = choice (MorphVoice::ParamID::mpe); mode != mpeMode)
+    {
+        mpeMode = mode;
+        expression.masterBendTarget = 0.0f;
+    }
+
+    // Collect MIDI into the preallocated scratch buffer (clear keeps capacity).
+    // Message timestamps are seconds relative to the block start.
+    midiScratch.clear();
     if (auto* mma = rc.bufferForMidiMessages)
+    {
+        const int lastSample = juce::jmax (0, numSamp - 1);
+
         for (auto& m : *mma)
-            midi.addEvent (m, 0);
+        {
+            if (! handleExpressionMessage (m))
+                continue;
+
+            const int offset = juce::jlimit (0, lastSample, juce::roundToInt (m.getTimeStamp() * currentSampleRate));
+            midiScratch.addEvent (m, start + offset);
+        }
+    }
+
+    // Audition notes go in ahead of the silence check so they wake the synth this block
+    auditionQueue.render (midiScratch, start, numSamp, currentSampleRate);
+
+    // Nothing to play and nothing sounding: skip the synth and gain entirely and let
+    // the gate suspend the inserts once their tail has run out
+    if (midiScratch.isEmpty() && ! anyVoiceActive())
+    {
+        silenceGate.instrumentBlock (false, numSamp);
+        return;
+    }
+
+    silenceGate.instrumentBlock (true, numSamp);
+
+    // Render in control-rate slices: one smoothing pass over every voice's
+    // expression and one lookup per macro target per slice, then the synth
+    // (which still splits at MIDI events)
+    macroDriven.fill (false);
+
+    for (int pos = 0; pos < numSamp; pos += MorphExpression::controlInterval)
+    {
+        expression.advance();
+        macroBank.evaluate ([this] (int slot, float value)
+        {
+            if (slot >= 0 && slot < (int) macroValues.size())
+            {
+                macroValues[(size_t) slot] = value;
+                macroDriven[(size_t) slot] = true;
+            }
+        });
+
+        synth.renderNextBlock (*audio, midiScratch, start + pos, juce::jmin (MorphExpression::controlInterval, numSamp - pos));
+    }
 
-    // Render synth then apply output gain
-    const float g = juce::Decibels::decibelsToGain (gain ? gain->getCurrentValue() : 0.0f);
-    synth.renderNextBlock (*audio, midi, start, numSamp);
+    // Apply output gain
+    const float g = juce::Decibels::decibelsToGain (get (MorphVoice::ParamID::gain));
     audio->applyGain (start, numSamp, g);
 }
 
+bool MorphSynthPlugin::anyVoiceActive() const noexcept
+{
+    for (int i = 0; i < synth.getNumVoices(); ++i)
+        if (synth.getVoice (i)->isVoiceActive())
+            return true;
+
+    return false;
+}
+
+bool MorphSynthPlugin::handleExpressionMessage (const juce::MidiMessage& m) noexcept
+{
+    const int ch = m.getChannel();
+    if (ch < 1 || ch > 16)
+        return true;
+
+    // Remembered per channel for notes that start later (MPE sends these before the
+    // note-on). Block granularity: a value sent later in this block is seen early.
+    if (m.isChannelPressure())
+        expression.channelPressure[ch - 1] = (float) m.getChannelPressureValue() / 127.0f;
+    else if (m.isController() && m.getControllerNumber() == 74)
+        expression.channelSlide[ch - 1] = MorphVoice::slideFromController (m.getControllerValue());
+
+    // MPE master channel bend moves the whole zone; it never reaches the synth
+    const int masterChannel = mpeMode == MorphVoice::mpeUpperZone ? 16 : 1;
+
+    if (m.isPitchWheel() && mpeMode != MorphVoice::mpeOff && ch == masterChannel)
+    {
+        expression.masterBendTarget = (float) (m.getPitchWheelValue() - 8192) / 8192.0f * get (MorphVoice::ParamID::bendRange);
+        return false;
+    }
+
+    return true;
+}
+
 //==============================================================================
 // Parameter enumeration & lookup
 //==============================================================================
@@ -254,7 +377,8 @@ juce::ValueTree MorphSynthPlugin::saveToValueTree()
         semi, fine, glide,
         lfoTarget, lfoRate, lfoDepth,
         keyTrack,
-        gain
+        gain,
+        mpe, bendRange, pressureCutoff, slideMorph
     };
 
     for (auto* p : params)
@@ -279,7 +403,8 @@ void MorphSynthPlugin::restoreFromValueTree (const juce::ValueTree& /*unused*/)
         semi, fine, glide,
         lfoTarget, lfoRate, lfoDepth,
         keyTrack,
-        gain
+        gain,
+        mpe, bendRange, pressureCutoff, slideMorph
     };
 
     for (auto* p : params)
@@ -290,57 +415,34 @@ void MorphSynthPlugin::restoreFromValueTree (const juce::ValueTree& /*unused*/)
 }
 
 //==============================================================================
-// MorphVoice::ParamsView (voices read parameter values by string key)
+// MorphVoice::ParamsView (voices read parameter values by ParamID)
 //==============================================================================
 
-float MorphSynthPlugin::get (const juce::String& id) const
+float MorphSynthPlugin::get (MorphVoice::ParamID id) const
 {
-    // Tone
-    if      (id == "morph")       return morph       ? morph->getCurrentValue()       : 0.f;
-    else if (id == "pulseWidth")  return pulseWidth  ? pulseWidth->getCurrentValue()  : 0.f;
-
-    // Filter
-    else if (id == "cutoff")      return cutoff      ? cutoff->getCurrentValue()      : 0.f;
-    else if (id == "resonance")   return resonance   ? resonance->getCurrentValue()   : 0.f;
-
-    // Amp ADSR
-    else if (id == "aA") return aA ? aA->getCurrentValue() : 0.f;
-    else if (id == "dA") return dA ? dA->getCurrentValue() : 0.f;
-    else if (id == "sA") return sA ? sA->getCurrentValue() : 0.f;
-    else if (id == "rA") return rA ? rA->getCurrentValue() : 0.f;
-
-    // Filter ADSR + amount
-    else if (id == "aF")      return aF      ? aF->getCurrentValue()      : 0.f;
-    else if (id == "dF")      return dF      ? dF->getCurrentValue()      : 0.f;
-    else if (id == "sF")      return sF      ? sF->getCurrentValue()      : 0.f;
-    else if (id == "rF")      return rF      ? rF->getCurrentValue()      : 0.f;
-    else if (id == "fEnvAmt") return fEnvAmt ? fEnvAmt->getCurrentValue() : 0.f;
-
-    // Pitch / glide / key tracking
-    else if (id == "semi")     return semi     ? semi->getCurrentValue()     : 0.f;
-    else if (id == "fine")     return fine     ? fine->getCurrentValue()     : 0.f;
-    else if (id == "glide")    return glide    ? glide->getCurrentValue()    : 0.f;
-    else if (id == "keyTrack") return keyTrack ? keyTrack->getCurrentValue() : 0.f;
-
-    // LFO  **ADD THESE**
-    else if (id == "lfoRate")  return lfoRate  ? lfoRate->getCurrentValue()  : 0.f;
-    else if (id == "lfoDepth") return lfoDepth ? lfoDepth->getCurrentValue() : 0.f;
-
-    // Output
-    else if (id == "gain") return gain ? gain->getCurrentValue() : 0.f;
-
-    return 0.f;
-}
+    const auto index = (size_t) id;
+    if (index >= paramTable.size())
+        return 0.f;
+
+    if (macroDriven[index])
+        return macroValues[index];
 
+    auto* p = paramTable[index];
+    return p != nullptr ? p->getCurrentValue() : 0.f;
+}
 
-int MorphSynthPlugin::choice (const juce::String& id) const
+int MorphSynthPlugin::getParamIndex (const te::AutomatableParameter& param) const noexcept
 {
-    if      (id == "oscAType")   return oscAType   ? (int) std::round (oscAType->getCurrentValue())   : 0;
-    else if (id == "oscBType")   return oscBType   ? (int) std::round (oscBType->getCurrentValue())   : 0;
-    else if (id == "filterType") return filterType ? (int) std::round (filterType->getCurrentValue()) : 0;
-    else if (id == "lfoTarget")  return lfoTarget  ? (int) std::round (lfoTarget->getCurrentValue())  : 0;
+    for (size_t i = 0; i < paramTable.size(); ++i)
+        if (paramTable[i] == &param)
+            return (int) i;
 
-    return 0;
+    return -1;
+}
+
+int MorphSynthPlugin::choice (MorphVoice::ParamID id) const
+{
+    return (int) std::round (get (id));
 }
 
 //==============================================================================
@@ -353,4 +455,13 @@ void MorphSynthPlugin::stopAllNotes()
         synth.allNotesOff (ch, false); // false = kill immediately (no tail)
 }
 
+juce::int64 MorphSynthPlugin::getMemoryUsageBytes() const
+{
+    return (juce::int64) sizeof (*this)
+         + (juce::int64) synth.getNumVoices() * (juce::int64) sizeof (MorphVoice)
+         + (juce::int64) midiScratchReservedBytes
+         + macroBank.getMemoryUsageBytes()
+         + MemoryAccounting::estimateValueTreeBytes (state);
+}
+
 void MorphSynthPlugin::timerCallback() {}
\ No newline at end of file
@@ -7,6 +7,7 @@
 //  - Owns parameters (osc types, morph, pulse, filter, envelopes, LFO, pitch).
 //  - Hosts a JUCE Synthesiser with MorphVoice voices.
 //  - Renders audio/MIDI and exposes parameters to Tracktion automation.
+//  - Tracks per-note expression (MPE or plain channel messages) for the voices.
 //
 // Notes:
 //  - See MorphSynthPlugin.cpp for parameter creation & rendering.
@@ -18,6 +19,10 @@
 #include <tracktion_engine/tracktion_engine.h>
 #include <juce_audio_processors/juce_audio_processors.h>
 #include "MorphVoice.h"
+#include "../../../AppEngine/SilenceGate.h"
+#include "../../../MIDIEngine/AuditionQueue.h"
+#include "../../../MIDIEngine/MacroBank.h"
+#include <array>
 
 namespace te = tracktion::engine;
 
@@ -28,6 +33,12 @@ namespace te = tracktion::engine;
  * Rendering pulls current parameter values, pushes MIDI to the synth, and
  * applies output gain. All parameters are exposed as te::AutomatableParameter
  * instances for host automation and UI attachments.
+ *
+ * Expression: pitch bend, pressure (channel or polyphonic) and slide (CC74) on a
+ * voice's channel drive its pitch, cutoff and morph. With MPE on, each note has
+ * its own member channel (±48 semitone bend), and the zone's master channel
+ * (1 for the lower zone, 16 for the upper) bends every voice by Bend Range. Expression is smoothed
+ * per voice at control rate (see MorphExpression).
  */
 class MorphSynthPlugin final : public te::Plugin,
                                private juce::Timer,
@@ -83,6 +94,27 @@ public:
     /** kill all active notes immediately. */
     void stopAllNotes();
 
+    /** Estimated bytes held by this instance: plugin object, voices and reserved MIDI scratch. */
+    juce::int64 getMemoryUsageBytes() const;
+
+    /** Gate suspending this track's FX inserts while the synth is silent (see SilenceMonitor). */
+    SilenceGate& getSilenceGate() noexcept                  { return silenceGate; }
+
+    /** Piano-roll audition notes, mixed into the next block's MIDI (see AppEngine::auditionNote). */
+    AuditionQueue& getAuditionQueue() noexcept              { return auditionQueue; }
+
+    /** The track's macros; target slots are MorphVoice::ParamID (see MacroControls). */
+    MacroBank& getMacroBank() noexcept                      { return macroBank; }
+
+    /** Smoothed expression of voice slot @p slot, without the zone bend (tests/diagnostics). */
+    float getVoiceExpression (MorphExpression::Dimension d, int slot) const noexcept { return expression.get (d, slot); }
+
+    /** Smoothed zone-wide bend from the MPE master channel, in semitones (tests/diagnostics). */
+    float getMasterBend() const noexcept                    { return expression.masterBend; }
+
+    /** The MorphVoice::ParamID of @p param, or -1 if it isn't one of this synth's. */
+    int getParamIndex (const te::AutomatableParameter& param) const noexcept;
+
     //==============================================================================
     // Parameters (UI binds to these directly)
     //------------------------------------------------------------------------------
@@ -104,12 +136,15 @@ public:
     // Output
     te::AutomatableParameter *gain = nullptr;
 
+    // Expression (MPE)
+    te::AutomatableParameter *mpe = nullptr, *bendRange = nullptr, *pressureCutoff = nullptr, *slideMorph = nullptr;
+
 private:
     //==============================================================================
     // MorphVoice::ParamsView implementation
     //------------------------------------------------------------------------------
-    float get   (const juce::String& id) const override;
-    int   choice(const juce::String& id) const override;
+    float get   (MorphVoice::ParamID id) const override;
+    int   choice(MorphVoice::ParamID id) const override;
 
     //==============================================================================
     // Helpers
@@ -122,7 +157,47 @@ private:
     // State
     //------------------------------------------------------------------------------
     juce::Synthesiser synth;
-    static constexpr int numVoices = 8;
+    static constexpr int numVoices = MorphExpression::maxVoices;
+
+    /** Per-voice expression state shared with the voices (one slot per voice). */
+    MorphExpression expression;
+    int mpeMode = MorphVoice::mpeOff;               ///< MPE setting of the last block (audio thread)
+
+    /** Reports silence to the FX inserts; skipped blocks cost nothing. */
+    SilenceGate silenceGate;
+
+    /** Notes posted by the piano roll; drained at the top of applyToBuffer(). */
+    AuditionQueue auditionQueue;
+
+    /** Macro targets, evaluated once per control slice in applyToBuffer(). */
+    MacroBank macroBank;
+
+    /** True while any voice is playing or releasing. */
+    bool anyVoiceActive() const noexcept;
+
+    /** Updates channel memory / master bend from a block's MIDI. @return false if @p m is consumed here */
+    bool handleExpressionMessage (const juce::MidiMessage& m) noexcept;
+
+    /** ParamID -> parameter lookup used by the voices (filled once in the constructor). */
+    std::array<te::AutomatableParameter*, (size_t) MorphVoice::ParamID::numParams> paramTable {};
+
+    /** Audio thread: values of macro-driven parameters, which the voices read instead of the knobs. */
+    std::array<float, (size_t) MorphVoice::ParamID::numParams> macroValues {};
+    std::array<bool, (size_t) MorphVoice::ParamID::numParams> macroDriven {};
+
+    /**
+     * Scratch MIDI buffer handed to the synth each block. Storage is reserved in
+     * initialise() and only cleared (never freed) in applyToBuffer(), so the
+     * render path does not touch the heap.
+     */
+    juce::MidiBuffer midiScratch;
+    size_t midiScratchReservedBytes = 0;
+    double currentSampleRate = 44100.0;
+
+    /** Bytes reserved per MIDI event in midiScratch (timestamp + size + short message). */
+    static constexpr int bytesPerMidiEvent = 16;
+    /** Lower bound on reserved events per block, for tiny block sizes. */
+    static constexpr int minMidiEventsPerBlock = 256;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MorphSynthPlugin)
 };
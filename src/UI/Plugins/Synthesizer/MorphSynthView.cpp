@@ -78,6 +78,10 @@ MorphSynthView::MorphSynthView (MorphSynthPlugin& p)
         // LFO
         lnf->styleKnob (lfoRate); lnf->styleKnob (lfoDepth);
         lnf->styleCombo (lfoTarget);
+
+        // Expression
+        lnf->styleKnob (bendRange); lnf->styleKnob (pressureCutoff); lnf->styleKnob (slideMorph);
+        lnf->styleCombo (mpeSelect);
     }
 
     // Selectors ----------------------------------------------------------------
@@ -188,6 +192,23 @@ MorphSynthView::MorphSynthView (MorphSynthPlugin& p)
     lfoTargetA = std::make_unique<ChoiceAttachment> (*plugin.lfoTarget, lfoTarget);
     lfoRateA   = std::make_unique<SliderAttachment>  (*plugin.lfoRate,   lfoRate);
     lfoDepthA  = std::make_unique<SliderAttachment>  (*plugin.lfoDepth,  lfoDepth);
+
+    // Expression (MPE) ---------------------------------------------------------
+    addAndMakeVisible (mpeSelect); addChoices (mpeSelect, { "Off", "Lower Zone", "Upper Zone" });
+    addAndMakeVisible (mpeLabel);  setupLabel (mpeLabel, "MPE");
+    for (auto* s : { &bendRange, &pressureCutoff, &slideMorph }) { setupKnob (*s); addAndMakeVisible (*s); }
+    addAndMakeVisible (bendRangeLabel);      setupLabel (bendRangeLabel,      "Bend Range");
+    addAndMakeVisible (pressureCutoffLabel); setupLabel (pressureCutoffLabel, "Pressure > Cutoff");
+    addAndMakeVisible (slideMorphLabel);     setupLabel (slideMorphLabel,     "Slide > Morph");
+
+    bendRange.setRange (0.0, 48.0, 1.0);
+    pressureCutoff.setRange (0.0, 4.0, 0.01);
+    slideMorph.setRange (0.0, 1.0, 0.01);
+
+    mpeA            = std::make_unique<ChoiceAttachment> (*plugin.mpe,            mpeSelect);
+    bendRangeA      = std::make_unique<SliderAttachment> (*plugin.bendRange,      bendRange);
+    pressureCutoffA = std::make_unique<SliderAttachment> (*plugin.pressureCutoff, pressureCutoff);
+    slideMorphA     = std::make_unique<SliderAttachment> (*plugin.slideMorph,     slideMorph);
 }
 
 MorphSynthView::~MorphSynthView()
@@ -209,7 +230,7 @@ void MorphSynthView::resized()
     const int labelH       = 18;  // label height under each knob
     const int knobPad      = 6;   // padding inside each knob cell
 
-    // We have 6 "knob rows" (Tone, Amp ADSR, Pitch, Filter ADSR, LFO, Output)
+    // We have 6 "knob rows" (Tone, Amp ADSR, Pitch, Filter ADSR, LFO, Expression/Output)
     const int knobRowCount = 6;
 
     // Compute a row height that includes knob + label and keeps things readable
@@ -344,9 +365,27 @@ void MorphSynthView::resized()
 
     r.removeFromTop (rowGap);
 
-    // Row 6: Output (Gain) -----------------------------------------------------
+    // Row 6: Expression (MPE / Bend / Pressure / Slide) + Output -------------
     {
         auto row = r.removeFromTop (knobRowH);
-        placeKnob (gain, gainLabel, row);
+        const int w = row.getWidth();
+
+        auto left = row.removeFromLeft (w / 5);
+        {
+            auto l = left.reduced (4);
+            auto title = l.removeFromTop (labelH);
+            mpeLabel.setBounds (title);
+            mpeSelect.setBounds (l.removeFromTop (selectorRowH));
+        }
+
+        auto e1 = row.removeFromLeft (w / 5);
+        auto e2 = row.removeFromLeft (w / 5);
+        auto e3 = row.removeFromLeft (w / 5);
+        auto out = row;
+
+        placeKnob (bendRange,      bendRangeLabel,      e1);
+        placeKnob (pressureCutoff, pressureCutoffLabel, e2);
+        placeKnob (slideMorph,     slideMorphLabel,     e3);
+        placeKnob (gain,           gainLabel,           out);
     }
 }
\ No newline at end of file
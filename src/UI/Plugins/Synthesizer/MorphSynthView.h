@@ -177,6 +177,11 @@ private:
     juce::ComboBox lfoTarget;            juce::Label lfoTargetLabel;
     juce::Slider   lfoRate, lfoDepth;    juce::Label lfoRateLabel, lfoDepthLabel;
 
+    // --- expression (MPE)
+    juce::ComboBox mpeSelect;            juce::Label mpeLabel;
+    juce::Slider   bendRange, pressureCutoff, slideMorph;
+    juce::Label    bendRangeLabel, pressureCutoffLabel, slideMorphLabel;
+
     //==============================================================================
     // Attachments (UI <-> parameters)
     //------------------------------------------------------------------------------
@@ -188,6 +193,8 @@ private:
     std::unique_ptr<SliderAttachment>  aFA, dFA, sFA, rFA, fAmtA;
     std::unique_ptr<ChoiceAttachment>  lfoTargetA;
     std::unique_ptr<SliderAttachment>  lfoRateA, lfoDepthA;
+    std::unique_ptr<ChoiceAttachment>  mpeA;
+    std::unique_ptr<SliderAttachment>  bendRangeA, pressureCutoffA, slideMorphA;
 
     //==============================================================================
     // UI helpers
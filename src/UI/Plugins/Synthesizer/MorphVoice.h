@@ -2,6 +2,7 @@
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
 #include "MorphOsc.h"
+#include "MorphExpression.h"
 
 // ==============================================================================
 // MorphVoice.h
@@ -12,9 +13,12 @@
 //  - Convert note/midi events into audio using a MorphOsc, envelopes, and SVF.
 //  - Read parameter values from a lightweight ParamsView supplied by the plugin.
 //  - Handle per-voice state such as envelopes, LFO phase, glide, and filter type.
+//  - Apply per-note expression (pitch bend -> pitch, pressure -> cutoff,
+//    slide -> morph) read from the plugin's MorphExpression.
 //
 // Notes:
-//  - No logic changed in this pass; comments and structure only.
+//  - Expression is read once per renderNextBlock() call; the plugin renders in
+//    MorphExpression::controlInterval sub-blocks, so that is the control rate.
 // ==============================================================================
 
 /**
@@ -29,30 +33,57 @@ struct MorphVoice : public juce::SynthesiserVoice
     //==============================================================================
     // Parameter access interface
     //------------------------------------------------------------------------------
+    /** Parameter slots a voice can read (indexes into the plugin's lookup table). */
+    enum class ParamID : int
+    {
+        morph, pulseWidth,
+        cutoff, resonance,
+        aA, dA, sA, rA,
+        aF, dF, sF, rF, fEnvAmt,
+        semi, fine, glide, keyTrack,
+        lfoRate, lfoDepth,
+        gain,
+        oscAType, oscBType, filterType, lfoTarget,
+        mpe, bendRange, pressureCutoff, slideMorph,
+        numParams
+    };
+
     /**
      * @brief Read-only view of the plugin's parameters.
      *
-     * Voices use string IDs to fetch current values (continuous or choice index).
+     * Voices fetch current values (continuous or choice index) by ParamID. The
+     * lookup is a plain table index so it is safe to call from the audio thread
+     * (no string construction or comparison).
      */
     struct ParamsView
     {
-        virtual float get   (const juce::String& id) const = 0;
-        virtual int   choice(const juce::String& id) const = 0;
+        virtual float get   (ParamID id) const = 0;
+        virtual int   choice(ParamID id) const = 0;
     };
 
     //==============================================================================
     // Setup
     //------------------------------------------------------------------------------
+    /** Pitch bend range of MPE member channels, in semitones (the MPE default). */
+    static constexpr float mpeMemberBendRange = 48.0f;
+
+    /** Values of ParamID::mpe. The zone's master channel is 1 (lower) or 16 (upper). */
+    enum MpeMode : int { mpeOff, mpeLowerZone, mpeUpperZone };
+
     /**
      * @brief Prepare the voice with sample rate and block size.
-     * @param sr       Sample rate in Hz.
-     * @param maxBlock Maximum block size (for DSP setup).
-     * @param pv       Parameter view provided by the plugin (non-owning).
+     * @param sr         Sample rate in Hz.
+     * @param maxBlock   Maximum block size (for DSP setup).
+     * @param pv         Parameter view provided by the plugin (non-owning).
+     * @param expr       Shared per-note expression state (non-owning, may be nullptr).
+     * @param exprSlot   This voice's slot in @p expr (0..MorphExpression::maxVoices-1).
      */
-    void prepare (double sr, int maxBlock, ParamsView* pv)
+    void prepare (double sr, int maxBlock, ParamsView* pv, MorphExpression* expr = nullptr, int exprSlot = 0)
     {
         sampleRate = sr;
         params = pv;
+        expression = expr;
+        slot = juce::jlimit (0, MorphExpression::maxVoices - 1, exprSlot);
 
         osc.prepare (sr);
         ampEnv.setSampleRate (sr);
@@ -70,10 +101,10 @@ struct MorphVoice : public juce::SynthesiserVoice
     bool canPlaySound (juce::SynthesiserSound* s) override { return dynamic_cast<juce::SynthesiserSound*>(s) != nullptr; }
 
     /** Start a note: compute base pitch (with semi/fine), reset/envelope triggers. */
-    void startNote (int midiNote, float vel, juce::SynthesiserSound*, int) override
+    void startNote (int midiNote, float vel, juce::SynthesiserSound*, int pitchWheel) override
     {
-        const int semiParam  = (int) params->get ("semi");
-        const float fineCents = params->get ("fine"); // -100..100
+        const int semiParam  = (int) params->get (ParamID::semi);
+        const float fineCents = params->get (ParamID::fine); // -100..100
 
         // semitone + cents -> Hz
         const double semis = (double) semiParam + fineCents / 100.0;
@@ -89,6 +120,14 @@ struct MorphVoice : public juce::SynthesiserVoice
         ampEnv.noteOn();
         filtEnv.noteOn();
 
+        // Expression starts from the channel's current bend/pressure/slide, unsmoothed
+        if (expression != nullptr)
+        {
+            const int ch = getPlayingChannel();
+            expression->startVoice (slot, bendToSemitones (pitchWheel),
+                                    expression->channelPressure[ch - 1], expression->channelSlide[ch - 1]);
+        }
+
         // LFO phase will continue free-run (musical); leave as-is
     }
 
@@ -101,11 +140,38 @@ struct MorphVoice : public juce::SynthesiserVoice
             clearCurrentNote();
     }
 
-    /** Unused pitch wheel handler (kept for completeness). */
-    void pitchWheelMoved (int) override {}
+    /** Pitch bend on this voice's channel (per-note in MPE mode). */
+    void pitchWheelMoved (int value) override
+    {
+        if (expression != nullptr)
+            expression->setTarget (MorphExpression::pitch, slot, bendToSemitones (value));
+    }
+
+    /** CC74 on this voice's channel is MPE slide (the third dimension). */
+    void controllerMoved (int controller, int value) override
+    {
+        if (expression != nullptr && controller == 74)
+            expression->setTarget (MorphExpression::slide, slot, slideFromController (value));
+    }
+
+    /** Channel pressure on this voice's channel (per-note in MPE mode). */
+    void channelPressureChanged (int value) override
+    {
+        if (expression != nullptr)
+            expression->setTarget (MorphExpression::pressure, slot, (float) value / 127.0f);
+    }
+
+    /** Polyphonic aftertouch for this voice's note. */
+    void aftertouchChanged (int value) override
+    {
+        channelPressureChanged (value);
+    }
 
-    /** Unused controller handler (kept for completeness). */
-    void controllerMoved (int, int) override {}
+    /** CC74 value (0..127) to slide (-1..1, centred on 64). */
+    static float slideFromController (int value) noexcept
+    {
+        return juce::jlimit (-1.0f, 1.0f, (float) (value - 64) / 63.0f);
+    }
 
     /**
      * @brief Render the next block of audio for this voice.
@@ -119,26 +185,40 @@ struct MorphVoice : public juce::SynthesiserVoice
         if (params == nullptr) return;
 
         // Read parameters once
-        const auto typeA   = params->choice ("oscAType");
-        const auto typeB   = params->choice ("oscBType");
-        const auto morph   = params->get ("morph");
-        const auto pw      = params->get ("pulseWidth");
-        const auto cutoff  = params->get ("cutoff");
-        const auto reso    = params->get ("resonance");
-
-        const auto aA = params->get ("aA"), dA = params->get ("dA"), sA = params->get ("sA"), rA = params->get ("rA");
-        const auto aF = params->get ("aF"), dF = params->get ("dF"), sF = params->get ("sF"), rF = params->get ("rF");
-        const auto glideMs  = params->get ("glide");
-        const auto lfoR     = params->get ("lfoRate");
-        const auto lfoD     = params->get ("lfoDepth");
-        const int  lfoT     = params->choice ("lfoTarget");
-        const auto keyT     = params->get ("keyTrack");
-        const auto fAmt     = params->get ("fEnvAmt");
+        const auto typeA   = params->choice (ParamID::oscAType);
+        const auto typeB   = params->choice (ParamID::oscBType);
+        const auto morph   = params->get (ParamID::morph);
+        const auto pw      = params->get (ParamID::pulseWidth);
+        const auto cutoff  = params->get (ParamID::cutoff);
+        const auto reso    = params->get (ParamID::resonance);
+
+        const auto aA = params->get (ParamID::aA), dA = params->get (ParamID::dA), sA = params->get (ParamID::sA), rA = params->get (ParamID::rA);
+        const auto aF = params->get (ParamID::aF), dF = params->get (ParamID::dF), sF = params->get (ParamID::sF), rF = params->get (ParamID::rF);
+        const auto glideMs  = params->get (ParamID::glide);
+        const auto lfoR     = params->get (ParamID::lfoRate);
+        const auto lfoD     = params->get (ParamID::lfoDepth);
+        const int  lfoT     = params->choice (ParamID::lfoTarget);
+        const auto keyT     = params->get (ParamID::keyTrack);
+        const auto fAmt     = params->get (ParamID::fEnvAmt);
+
+        // Per-note expression, smoothed at control rate by the plugin (constant over this call)
+        double bendSemis = 0.0;
+        float pressureNow = 0.0f, slideNow = 0.0f;
+        if (expression != nullptr)
+        {
+            bendSemis   = (double) (expression->get (MorphExpression::pitch, slot) + expression->masterBend);
+            pressureNow = expression->get (MorphExpression::pressure, slot);
+            slideNow    = expression->get (MorphExpression::slide, slot);
+        }
+
+        const double bendMul        = bendSemis != 0.0 ? std::pow (2.0, bendSemis / 12.0) : 1.0;
+        const double pressureCutMul = std::pow (2.0, (double) (params->get (ParamID::pressureCutoff) * pressureNow));
+        const float  slideMorphMod  = params->get (ParamID::slideMorph) * slideNow;
 
         ampEnv.setParameters ({ aA, dA, sA, rA });
         filtEnv.setParameters ({ aF, dF, sF, rF });
 
-        setFilterType (params->choice ("filterType"));
+        setFilterType (params->choice (ParamID::filterType));
         svf.setResonance (reso);
 
         osc.setTypes (typeA, typeB);
@@ -156,7 +236,7 @@ struct MorphVoice : public juce::SynthesiserVoice
         for (int i = 0; i < num; ++i)
         {
             // Update target pitch each sample (if you want pitch LFO to act too)
-            double hzNow = baseHz;
+            double hzNow = baseHz * bendMul;
 
             // LFO value in [-1, 1]
             lfoPhase += lfoInc; if (lfoPhase >= 1.0) lfoPhase -= 1.0;
@@ -189,7 +269,7 @@ struct MorphVoice : public juce::SynthesiserVoice
             osc.setFrequency (currentHz);
 
             // Morph + Pulse LFO
-            osc.setMorph (juce::jlimit (0.0f, 1.0f, morph + morphMod));
+            osc.setMorph (juce::jlimit (0.0f, 1.0f, morph + morphMod + slideMorphMod));
             osc.setPulseWidth (juce::jlimit (0.05f, 0.95f, pw + pulseMod));
 
             // Filter cutoff: env, keyTrack, and LFO multiplicative
@@ -199,7 +279,7 @@ struct MorphVoice : public juce::SynthesiserVoice
             // base cutoff with env amount
             const double cBase = juce::jlimit (20.0, 20000.0, (double) cutoff * std::pow (2.0, (double) fAmt * envF));
             // apply LFO and tracking
-            const double cNow  = juce::jlimit (20.0, 20000.0, cBase * cutoffModMul * keyMul);
+            const double cNow  = juce::jlimit (20.0, 20000.0, cBase * cutoffModMul * keyMul * pressureCutMul);
             svf.setCutoffFrequency ((float) cNow);
 
             const float sig = osc.next();
@@ -223,6 +303,23 @@ struct MorphVoice : public juce::SynthesiserVoice
 
 private:
     //==============================================================================
+    /** MIDI channel of the current note (1..16). */
+    int getPlayingChannel() const
+    {
+        for (int ch = 1; ch <= 16; ++ch)
+            if (isPlayingChannel (ch))
+                return ch;
+        return 1;
+    }
+
+    /** 14-bit pitch wheel value to semitones: MPE member range, or the Bend Range parameter. */
+    float bendToSemitones (int wheelValue) const
+    {
+        const float range = params->choice (ParamID::mpe) != 0 ? mpeMemberBendRange
+                                                               : params->get (ParamID::bendRange);
+        return (float) (wheelValue - 8192) / 8192.0f * range;
+    }
+
     /** Map integer filter type to the JUCE TPT filter mode. */
     void setFilterType (int t)
     {
@@ -239,6 +336,8 @@ private:
     // Per-voice state
     //------------------------------------------------------------------------------
     ParamsView* params = nullptr;                    ///< Parameter accessor (non-owning)
+    MorphExpression* expression = nullptr;           ///< Shared per-note expression (non-owning)
+    int slot = 0;                                    ///< This voice's slot in expression
     MorphOsc osc;                                    ///< Primary oscillator
     juce::ADSR ampEnv, filtEnv;                      ///< Amplitude & filter envelopes
     juce::dsp::StateVariableTPTFilter<float> svf;    ///< State-variable filter
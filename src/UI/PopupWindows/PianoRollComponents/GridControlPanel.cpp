@@ -49,6 +49,40 @@ GridControlPanel::GridControlPanel(NoteGridComponent &component, GridStyleSheet
     quantisationValue.onChange = [this]() {
         noteGrid.setQuantisation(fractionsOfBeat.at(quantisationValue.getSelectedId()));
     };
+
+    addAndMakeVisible(quantiseNotes);
+    quantiseNotes.setButtonText("Quantise");
+    quantiseNotes.onClick = [this]() {
+        noteGrid.quantiseNotes(makeQuantiseSettings());
+    };
+
+    addAndMakeVisible(humaniseNotes);
+    humaniseNotes.setButtonText("Humanise");
+    humaniseNotes.onClick = [this]() {
+        // Timing only moves by up to a tenth of a grid step; strength 0 leaves the grid alone
+        auto settings = makeQuantiseSettings();
+        settings.strength = 0.0f;
+        settings.humanizeBeats = settings.gridBeats * 0.1;
+        settings.humanizeVelocity = 12.0f;
+        settings.seed = juce::Random::getSystemRandom().nextInt64();
+        noteGrid.quantiseNotes(settings);
+    };
+
+    for (auto* slider : { &quantiseStrength, &swingAmount }) {
+        addAndMakeVisible(slider);
+        slider->setSliderStyle(juce::Slider::LinearHorizontal);
+        slider->setTextBoxStyle(juce::Slider::TextBoxRight, false, 45, 20);
+        slider->setRange(0.0, 100.0, 1.0);
+        slider->setTextValueSuffix("%");
+    }
+    quantiseStrength.setValue(100.0, juce::dontSendNotification);
+    quantiseStrength.setTooltip("Quantise strength");
+    swingAmount.setValue(0.0, juce::dontSendNotification);
+    swingAmount.setTooltip("Swing");
+
+    addAndMakeVisible(useGroove);
+    useGroove.setButtonText("Groove");
+    useGroove.setTooltip("Quantise to the groove extracted from a clip (the grid is used until one is extracted)");
 }
 
 GridControlPanel::~GridControlPanel() {
@@ -66,7 +100,31 @@ void GridControlPanel::resized() {
 
     quantisationValue.setBounds(getWidth() - 250, 5, 200, 40);
     deleteNotes.setBounds(quantisationValue.getX() - 150, 5, 120, quantisationValue.getHeight());
+
+    humaniseNotes.setBounds(deleteNotes.getX() - 100, 5, 90, quantisationValue.getHeight());
+    quantiseNotes.setBounds(humaniseNotes.getX() - 100, 5, 90, quantisationValue.getHeight());
+    useGroove.setBounds(quantiseNotes.getX() - 90, 5, 80, quantisationValue.getHeight());
+    swingAmount.setBounds(useGroove.getX() - 160, 5, 150, quantisationValue.getHeight());
+    quantiseStrength.setBounds(swingAmount.getX() - 160, 5, 150, quantisationValue.getHeight());
 }
 
 void GridControlPanel::paint(juce::Graphics &g) {
+}
+
+//==============================================================================
+// Quantise
+//==============================================================================
+
+QuantizeEngine::Settings GridControlPanel::makeQuantiseSettings() const {
+    QuantizeEngine::Settings settings;
+    settings.gridBeats = fractionsOfBeat.at(quantisationValue.getSelectedId());
+    settings.strength = (float) quantiseStrength.getValue() / 100.0f;
+    settings.swing = (float) swingAmount.getValue() / 100.0f;
+
+    if (useGroove.getToggleState()) {
+        settings.groove = noteGrid.getGroove();
+        settings.grooveVelocity = 0.5f;
+    }
+
+    return settings;
 }
\ No newline at end of file
@@ -20,6 +20,8 @@
  *
  * **Features:**
  * - Quantization selector (1/64 to whole note)
+ * - Quantise / Humanise buttons with strength and swing, optionally to the
+ *   project's groove template (see QuantizeEngine)
  * - Delete selected notes button
  * - Grid zoom configuration callback
  * - Future: Toggle buttons for MIDI note display options
@@ -142,6 +144,19 @@ private:
 
     juce::TextButton deleteNotes;  ///< Button to delete selected notes
 
+    juce::TextButton quantiseNotes;   ///< Quantise selected (or all) notes to the grid/groove
+    juce::TextButton humaniseNotes;   ///< Randomise timing and velocity of selected (or all) notes
+    juce::Slider quantiseStrength;    ///< Quantise strength, 0-100 %
+    juce::Slider swingAmount;         ///< Swing, 0-100 % of half a grid step
+    juce::ToggleButton useGroove;     ///< Quantise to the extracted groove instead of the grid
+
+    /**
+     * @brief Builds quantise settings from the current controls.
+     *
+     * @return Settings for NoteGridComponent::quantiseNotes().
+     */
+    QuantizeEngine::Settings makeQuantiseSettings() const;
+
     // Future display toggles (currently unused):
     // juce::ToggleButton drawMIDINotes, drawMIDIText, drawVelocity;
 
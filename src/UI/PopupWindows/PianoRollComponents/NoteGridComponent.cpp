@@ -28,6 +28,13 @@ NoteGridComponent::NoteGridComponent (GridStyleSheet& sheet, AppEngine& engine,
     // Set ticks according to time signature's beatValue
     ticksPerTimeSignature = PRE::defaultResolution * timeSignature.beatsPerBar;
 
+    // One component per note is the piano roll's main memory cost, so report it
+    memoryProviderId = appEngine.getMemoryAccounting().addProvider ([this] (MemoryReport& report)
+    {
+        report.add ("UI", "Piano roll note components",
+                    (juce::int64) (noteComps.size() * sizeof (NoteComponent)), (int) noteComps.size());
+    });
+
     // TODO: refactor to not use NoteComponent?
     // Components for each note will likely impact performance. We will probably want to draw directly
     // on the grid instead, and also figure out a way to select notes and drag them
@@ -49,6 +56,7 @@ NoteGridComponent::NoteGridComponent (GridStyleSheet& sheet, AppEngine& engine,
             {
                 if (tracks[i] == clipTrack)
                 {
+                    trackIndex = i;
                     isDrumTrack = appEngine.isDrumTrack (i);
                     break;
                 }
@@ -63,6 +71,8 @@ NoteGridComponent::NoteGridComponent (GridStyleSheet& sheet, AppEngine& engine,
 
 NoteGridComponent::~NoteGridComponent()
 {
+    appEngine.getMemoryAccounting().removeProvider (memoryProviderId);
+
     // Detach all note components; unique_ptr will clean up
     for (auto& nc : noteComps)
         if (auto* raw = nc.get())
@@ -214,6 +224,10 @@ void NoteGridComponent::noteCompSelected (NoteComponent* noteComponent, const ju
 
     noteComponent->setState (NoteComponent::eSelected);
     noteComponent->toFront (true);
+
+    if (auto* model = noteComponent->getModel())
+        auditionNote (model->getNoteNumber(), model->getVelocity());
+
     sendEdit();
 }
 
@@ -259,6 +273,11 @@ void NoteGridComponent::noteCompDragging (NoteComponent* original, const juce::M
     // move original
     original->setTopLeftPosition(origLeftSnappedPx, origTopSnappedPx);
 
+    // sound each new pitch as the note crosses it
+    const int pitchNow             = juce::jlimit(0, 127, yToPitch((float) origTopSnappedPx));
+    if (pitchNow != lastTrigger)
+        auditionNote (pitchNow, original->getModel() != nullptr ? original->getModel()->getVelocity() : 100);
+
     // delta to apply to any other selected notes (in beats, not pixels)
     const float deltaBeats         = newStartBeats - startBeatsOrig;
 
@@ -540,6 +559,7 @@ void NoteGridComponent::mouseDoubleClick (const juce::MouseEvent& e)
 
     newNote->setState (NoteComponent::eSelected);
     newNote->toFront (true);
+    auditionNote (pitch, 100);
 
     resized();
     repaint();
@@ -660,6 +680,33 @@ void NoteGridComponent::deleteAllSelected()
     }
 }
 
+void NoteGridComponent::quantiseNotes (const QuantizeEngine::Settings& settings)
+{
+    if (clip == nullptr)
+    {
+        DBG ("Error: NoteGridComponent has no clip set.");
+        return;
+    }
+
+    QuantizeEngine::NoteArrays notes;
+    const auto selected = getSelectedModels();
+    if (selected.isEmpty())
+        notes.addClip (*clip);
+    else
+        notes.addNotes (*clip, selected);
+
+    auto* um = clip->getUndoManager();
+    if (um != nullptr)
+        um->beginNewTransaction ("Quantise");
+
+    QuantizeEngine::process (settings, notes);
+    if (QuantizeEngine::writeBack (notes, um) > 0)
+    {
+        resized();
+        sendEdit();
+    }
+}
+
 //==============================================================================
 // Data Access
 //==============================================================================
@@ -688,6 +735,7 @@ void NoteGridComponent::setClip (te::MidiClip* newClip)
 
     // Update drum track detection when clip changes (Written by Claude Code)
     isDrumTrack = false;  // Reset to false
+    trackIndex = -1;
     if (clip != nullptr)
     {
         if (auto* clipTrack = dynamic_cast<te::AudioTrack*> (clip->getTrack()))
@@ -698,6 +746,7 @@ void NoteGridComponent::setClip (te::MidiClip* newClip)
             {
                 if (tracks[i] == clipTrack)
                 {
+                    trackIndex = i;
                     isDrumTrack = appEngine.isDrumTrack (i);
                     break;
                 }
@@ -730,6 +779,17 @@ juce::Array<te::MidiNote*> NoteGridComponent::getSelectedModels()
 // Internal Methods
 //==============================================================================
 
+void NoteGridComponent::auditionNote (int note, int velocity)
+{
+    lastTrigger = note;
+
+    // Monophonic: a new pitch cuts off the last one, so a drag plays as a single voice
+    appEngine.auditionNote (trackIndex, note, velocity, auditionSeconds, true);
+
+    if (sendChange != nullptr)
+        sendChange (note, velocity);
+}
+
 void NoteGridComponent::sendEdit()
 {
     if (this->onEdit != nullptr)
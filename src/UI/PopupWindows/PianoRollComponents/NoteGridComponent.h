@@ -237,6 +237,23 @@ public:
      */
     void deleteAllSelected();
 
+    /**
+     * @brief Quantizes the selected notes, or every note if none are selected.
+     *
+     * Runs QuantizeEngine over the notes as one undo step, then refreshes the
+     * note components and calls `onEdit`.
+     *
+     * @param settings Grid, strength, swing, groove and humanize settings.
+     */
+    void quantiseNotes (const QuantizeEngine::Settings& settings);
+
+    /**
+     * @brief Returns the project's current groove template, if one was extracted.
+     *
+     * @return Groove template, or nullptr.
+     */
+    const QuantizeEngine::GrooveTemplate* getGroove() const { return appEngine.getGroove(); }
+
     /**
      * @brief Updates the visual positions of all note components.
      *
@@ -376,6 +393,14 @@ private:
      */
     void sendEdit();
 
+    /**
+     * @brief Plays a note on the clip's track for feedback (see AppEngine::auditionNote).
+     *
+     * @param note     MIDI note number.
+     * @param velocity Note velocity (1-127).
+     */
+    void auditionNote (int note, int velocity);
+
     /**
      * @brief Creates a new NoteComponent visual for a MidiNote model.
      *
@@ -436,9 +461,12 @@ private:
     GridStyleSheet& styleSheet;       ///< Visual style for grid rendering (not owned).
     SelectionBox selectorBox;         ///< Selection box component for drag selection.
     std::vector<std::unique_ptr<NoteComponent>> noteComps; ///< Visual components for each MIDI note.
+    int memoryProviderId = 0;         ///< MemoryAccounting hook id (removed in destructor).
 
     std::set<int> blackPitches = { 1, 3, 6, 8, 10 }; ///< MIDI note offsets for black piano keys (within octave).
     bool isDrumTrack = false;         ///< True if editing a drum track (for note highlighting). (Written by Claude Code)
+    int trackIndex = -1;              ///< Index of the clip's track, or -1 if unknown.
+    static constexpr double auditionSeconds = 0.3; ///< Length of an auditioned note.
 
     float noteCompHeight;             ///< Vertical zoom level (pixels per MIDI note).
     float pixelsPerBar;               ///< Horizontal zoom level (pixels per bar).
@@ -0,0 +1,367 @@
+#include "ArrangementTileCache.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iterator>
+
+//==============================================================================
+// TileJob
+
+/** Rasterises one column of a lane, then posts the image back to the message thread. */
+class ArrangementTileCache::TileJob final : public juce::ThreadPoolJob
+{
+public:
+    TileJob (ArrangementTileCache& cache, const Key& k, std::shared_ptr<const Lane> l)
+        : juce::ThreadPoolJob ("Arrangement tile"), owner (&cache), key (k), lane (std::move (l))
+    {
+    }
+
+    JobStatus runJob() override
+    {
+        const float scale = (float) key.scale / 100.0f;
+
+        // Software-backed, so the worker can draw into it without touching the native context
+        juce::Image image (juce::Image::ARGB,
+                           juce::jmax (1, (int) std::ceil ((float) tileWidth * scale)),
+                           juce::jmax (1, (int) std::ceil ((float) lane->height * scale)),
+                           true, juce::SoftwareImageType());
+        {
+            juce::Graphics g (image);
+            g.addTransform (juce::AffineTransform::translation ((float) (-key.column * tileWidth), 0.0f).scaled (scale));
+            paintLane (g, *lane, lane->background);
+        }
+
+        if (shouldExit())
+            return jobHasFinished;
+
+        juce::MessageManager::callAsync ([weakOwner = owner, k = key, image]
+        {
+            if (auto* cache = weakOwner.get())
+                cache->tileRendered (k, image);
+        });
+
+        return jobHasFinished;
+    }
+
+    int getTrack() const noexcept                   { return key.track; }
+    juce::uint32 getVersion() const noexcept        { return key.version; }
+
+private:
+    juce::WeakReference<ArrangementTileCache> owner;
+    const Key key;
+    const std::shared_ptr<const Lane> lane;
+};
+
+namespace
+{
+    /** Queued renders of a track's older lane versions. */
+    template <typename Job>
+    struct StaleJobs final : juce::ThreadPool::JobSelector
+    {
+        StaleJobs (int t, juce::uint32 v) : track (t), version (v) {}
+
+        bool isJobSuitable (juce::ThreadPoolJob* job) override
+        {
+            auto* tileJob = dynamic_cast<Job*> (job);
+            return tileJob != nullptr && tileJob->getTrack() == track && tileJob->getVersion() != version;
+        }
+
+        int track;
+        juce::uint32 version;
+    };
+}
+
+//==============================================================================
+// Painting
+
+juce::uint32 ArrangementTileCache::nextVersion() noexcept
+{
+    static std::atomic<juce::uint32> counter { 0 };
+    return ++counter;
+}
+
+void ArrangementTileCache::paintBackground (juce::Graphics& g, const Lane& lane, const juce::Colour background)
+{
+    g.setColour (background);
+    g.fillRoundedRectangle (juce::Rectangle<int> (lane.width, lane.height).toFloat().reduced (1.0f), 10.0f);
+}
+
+void ArrangementTileCache::paintLane (juce::Graphics& g, const Lane& lane, const juce::Colour background)
+{
+    const auto r = juce::Rectangle<int> (lane.width, lane.height).toFloat().reduced (1.0f);
+    constexpr float radius = 10.0f;
+
+    paintBackground (g, lane, background);
+
+    // Clips too narrow for their own component, already merged per pixel run
+    if (! lane.strips.empty())
+    {
+        const auto body = juce::Rectangle<int> (lane.width, lane.height).reduced (5);
+
+        juce::RectangleList<int> strips;
+        for (const auto& strip : lane.strips)
+            strips.addWithoutMerging ({ strip.getStart(), body.getY(), strip.getLength(), body.getHeight() });
+
+        g.setColour (lane.clipColour);
+        g.fillRectList (strips);
+    }
+
+    const auto visible = g.getClipBounds();
+
+    for (const auto& clip : lane.clips)
+    {
+        const auto area = juce::Rectangle<int> (clip.x.getStart(), 5, clip.x.getLength(), lane.height - 10);
+        if (area.intersects (visible))
+            paintClip (g, clip, area, lane.clipColour);
+    }
+
+    // Rounded border
+    g.setColour (juce::Colours::white.withAlpha (0.35f));
+    g.drawRoundedRectangle (r, radius, 1.0f);
+}
+
+void ArrangementTileCache::paintClip (juce::Graphics& g, const Clip& clip, const juce::Rectangle<int> area, const juce::Colour colour)
+{
+    const auto r = area.toFloat();
+    constexpr float radius = 8.0f;
+
+    g.setColour (colour);
+    g.fillRoundedRectangle (r, radius);
+
+    auto content = area.reduced (4, 2);
+    auto header = content.removeFromTop (14);
+
+    // Only the part of the preview this tile shows
+    const auto visible = g.getClipBounds().getIntersection (content);
+    g.setColour (juce::Colours::black.withAlpha (0.55f));
+
+    if (clip.isAudio)
+    {
+        if (clip.peaks.empty())
+        {
+            g.drawText ("Loading...", content, juce::Justification::centred, false);
+        }
+        else
+        {
+            const float centre = (float) content.getCentreY();
+            const float halfHeight = (float) content.getHeight() * 0.5f;
+
+            juce::RectangleList<float> bars;
+            for (int x = visible.getX(); x < visible.getRight(); ++x)
+            {
+                const auto index = (size_t) (x - content.getX());
+                if (index >= clip.peaks.size())
+                    break;
+
+                const auto& p = clip.peaks[index];
+                const float top = centre - p.getEnd() * halfHeight;
+                bars.addWithoutMerging ({ (float) x, top, 1.0f, juce::jmax (1.0f, (p.getEnd() - p.getStart()) * halfHeight) });
+            }
+
+            g.fillRectList (bars);
+        }
+    }
+    else if (! clip.notes.empty())
+    {
+        juce::RectangleList<float> bars;
+        for (const auto& n : clip.notes)
+        {
+            const juce::Rectangle<float> bar (n.getX(),
+                                              (float) content.getY() + n.getY() * (float) content.getHeight(),
+                                              juce::jmax (1.0f, n.getWidth()),
+                                              juce::jmax (1.0f, n.getHeight() * (float) content.getHeight()));
+
+            if (bar.getRight() >= (float) visible.getX() && bar.getX() <= (float) visible.getRight())
+                bars.addWithoutMerging (bar);
+        }
+
+        g.fillRectList (bars);
+    }
+
+    // Name + warp badge
+    g.setColour (juce::Colours::white.withAlpha (0.9f));
+    g.setFont (juce::Font (juce::FontOptions (11.0f)));
+
+    if (clip.warped)
+    {
+        auto badge = header.removeFromRight (36).toFloat();
+        g.drawRoundedRectangle (badge.reduced (1.0f), 3.0f, 1.0f);
+        g.drawText ("WARP", badge, juce::Justification::centred, false);
+    }
+
+    g.drawText (clip.name, header, juce::Justification::centredLeft, true);
+
+    g.setColour (juce::Colours::white.withAlpha (0.35f));
+    g.drawRoundedRectangle (r.reduced (0.5f), radius, 1.0f);
+}
+
+//==============================================================================
+// Construction
+
+ArrangementTileCache::ArrangementTileCache()
+{
+    // Create the weak-reference master now; workers copy it while posting tiles back
+    juce::WeakReference<ArrangementTileCache> master (this);
+    juce::ignoreUnused (master);
+}
+
+ArrangementTileCache::~ArrangementTileCache()
+{
+    pool.removeAllJobs (true, 5000);
+}
+
+void ArrangementTileCache::clear()
+{
+    pool.removeAllJobs (true, 5000);
+
+    tiles.clear();
+    pending.clear();
+    laneVersions.clear();
+    cachedBytes = 0;
+}
+
+//==============================================================================
+// Drawing
+
+void ArrangementTileCache::draw (juce::Graphics& g, const int trackIndex, const std::shared_ptr<const Lane>& lane,
+                                 const juce::Rectangle<int> visibleArea)
+{
+    jassert (lane != nullptr);
+    forgetOlderVersions (trackIndex, lane->version);
+
+    const auto area = g.getClipBounds().getIntersection ({ lane->width, lane->height });
+    if (area.isEmpty())
+        return;
+
+    const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    const int scaleKey = juce::roundToInt (scale * 100.0f);
+    ++useCounter;
+
+    for (int column = area.getX() / tileWidth; column * tileWidth < area.getRight(); ++column)
+    {
+        const Key key { trackIndex, lane->version, column, scaleKey };
+        const juce::Rectangle<int> tileArea (column * tileWidth, 0, tileWidth, lane->height);
+
+        if (auto it = tiles.find (key); it != tiles.end())
+        {
+            it->second.lastUsed = useCounter;
+            g.drawImageTransformed (it->second.image,
+                                    juce::AffineTransform::scale (1.0f / scale).translated ((float) tileArea.getX(), 0.0f));
+            continue;
+        }
+
+        // Not rendered yet: the background stands in until the worker's tile arrives
+        {
+            juce::Graphics::ScopedSaveState save (g);
+            g.reduceClipRegion (tileArea);
+            paintBackground (g, *lane, lane->background);
+        }
+
+        requestTile (key, lane);
+    }
+
+    prefetch (trackIndex, scaleKey, lane, visibleArea);
+}
+
+void ArrangementTileCache::prefetch (const int trackIndex, const int scaleKey, const std::shared_ptr<const Lane>& lane,
+                                     const juce::Rectangle<int> visibleArea)
+{
+    const auto visible = visibleArea.getIntersection ({ lane->width, lane->height });
+    if (visible.isEmpty())
+        return;
+
+    const int numColumns = (lane->width + tileWidth - 1) / tileWidth;
+    const int firstVisible = visible.getX() / tileWidth;
+    const int lastVisible = (visible.getRight() - 1) / tileWidth;
+    const int margin = (visible.getWidth() + tileWidth - 1) / tileWidth;
+
+    auto request = [&] (int column)
+    {
+        if (! juce::isPositiveAndBelow (column, numColumns))
+            return;
+
+        const Key key { trackIndex, lane->version, column, scaleKey };
+        if (tiles.find (key) == tiles.end())
+            requestTile (key, lane);
+    };
+
+    // Visible columns first (painting may only have covered part of the view), then outwards
+    for (int column = firstVisible; column <= lastVisible; ++column)
+        request (column);
+
+    for (int step = 1; step <= margin; ++step)
+    {
+        request (firstVisible - step);
+        request (lastVisible + step);
+    }
+}
+
+void ArrangementTileCache::requestTile (const Key& key, const std::shared_ptr<const Lane>& lane)
+{
+    if (pending.insert (key).second)
+        pool.addJob (new TileJob (*this, key, lane), true);
+}
+
+void ArrangementTileCache::tileRendered (const Key& key, const juce::Image& image)
+{
+    pending.erase (key);
+
+    // The lane changed while this was rendering
+    if (laneVersions[key.track] != key.version)
+        return;
+
+    auto& tile = tiles[key];
+    cachedBytes += getNumBytes (image) - getNumBytes (tile.image);
+    tile.image = image;
+    tile.lastUsed = useCounter;
+
+    evictToFit();
+
+    if (onTileReady)
+        onTileReady (key.track, { key.column * tileWidth, 0, tileWidth,
+                                  juce::roundToInt ((float) image.getHeight() * 100.0f / (float) key.scale) });
+}
+
+void ArrangementTileCache::forgetOlderVersions (const int trackIndex, const juce::uint32 version)
+{
+    auto& latest = laneVersions[trackIndex];
+    if (latest == version)
+        return;
+
+    latest = version;
+
+    // Renders still queued for the old content would be thrown away on arrival; running ones finish
+    StaleJobs<TileJob> stale (trackIndex, version);
+    pool.removeAllJobs (false, 0, &stale);
+
+    for (auto it = pending.begin(); it != pending.end();)
+        it = (it->track == trackIndex && it->version != version) ? pending.erase (it) : std::next (it);
+
+    for (auto it = tiles.begin(); it != tiles.end();)
+    {
+        if (it->first.track == trackIndex && it->first.version != version)
+        {
+            cachedBytes -= getNumBytes (it->second.image);
+            it = tiles.erase (it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+void ArrangementTileCache::evictToFit()
+{
+    while (cachedBytes > maxCacheBytes && ! tiles.empty())
+    {
+        auto oldest = std::min_element (tiles.begin(), tiles.end(), [] (const auto& a, const auto& b)
+        {
+            return a.second.lastUsed < b.second.lastUsed;
+        });
+
+        cachedBytes -= getNumBytes (oldest->second.image);
+        tiles.erase (oldest);
+    }
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <tuple>
+#include <vector>
+
+/**
+ * @brief Renders the static part of each track lane into image tiles on worker threads.
+ *
+ * Each TrackComponent describes its lane as a Lane, a plain-data snapshot safe to
+ * hand to another thread: the rounded background and border, the merged coverage
+ * of clips too narrow for components, and every other clip's body with its preview
+ * (note bars for MIDI, the waveform's per-pixel peaks for audio) and name. The
+ * cache splits the lane into tileWidth-wide columns, and each column is rasterised
+ * by the software renderer on a worker. Painting the lane is then a few image
+ * blits. Clip components only draw what changes with interaction (drag, resize,
+ * piano roll highlight) on top; the recording preview, the playhead and the loop
+ * overlay paint themselves as before.
+ *
+ * Tiles are keyed by track, lane version and column (plus the display scale). The
+ * lane is in component coordinates, and scrolling moves the viewport, not the lane,
+ * so scrolling reuses tiles. Anything that changes the lane's content (zoom, clip
+ * edits, resizing) gives it a new version. A track's tiles and queued renders for
+ * older versions are dropped the first time the new version is drawn.
+ *
+ * Painting a lane never rasterises it on the message thread. A column with no tile
+ * yet gets the lane background only and is queued; when the tile arrives,
+ * onTileReady asks for that area to be repainted. Every draw also queues the
+ * columns within one view width either side of the visible area, so scrolling
+ * mostly finds its tiles ready.
+ *
+ * Thread safety: everything except the workers runs on the message thread. Workers
+ * only read their Lane (immutable once shared) and post the finished image back.
+ */
+class ArrangementTileCache
+{
+public:
+    static constexpr int tileWidth = 256;                       ///< Column width in component pixels
+    static constexpr juce::int64 maxCacheBytes = 64 << 20;      ///< Least recently drawn tiles go first past this
+
+    /** A clip wide enough for its own component, painted with its content. */
+    struct Clip
+    {
+        juce::Range<int> x;                                     ///< Component x
+        juce::String name;
+        bool isAudio = false, warped = false;
+        std::vector<juce::Rectangle<float>> notes;              ///< MIDI: x and width in component pixels, y and height 0..1
+        std::vector<juce::Range<float>> peaks;                  ///< Audio: min/max (-1..1) per pixel of the waveform area; empty while loading
+
+        bool operator== (const Clip& other) const
+        {
+            return x == other.x && name == other.name && isAudio == other.isAudio && warped == other.warped
+                && notes == other.notes && peaks == other.peaks;
+        }
+    };
+
+    /** Everything a worker needs to paint one track lane. */
+    struct Lane
+    {
+        juce::uint32 version = 0;                               ///< From nextVersion(); part of every tile key
+        int width = 0, height = 0;
+        juce::Colour background, clipColour;
+        std::vector<juce::Range<int>> strips;                   ///< Merged clip coverage, in component x
+        std::vector<Clip> clips;
+
+        /** True if both would paint the same pixels. */
+        bool hasSameContent (const Lane& other) const
+        {
+            return width == other.width && height == other.height
+                && background == other.background && clipColour == other.clipColour
+                && strips == other.strips && clips == other.clips;
+        }
+    };
+
+    /** A version no lane has used yet. */
+    static juce::uint32 nextVersion() noexcept;
+
+    /** Paints @p lane in its own coordinates with @p background (the lane's, or a tinted one). */
+    static void paintLane (juce::Graphics& g, const Lane& lane, juce::Colour background);
+
+    /** Paints one clip's body, preview and name into @p area (its x range, the lane's clip height). */
+    static void paintClip (juce::Graphics& g, const Clip& clip, juce::Rectangle<int> area, juce::Colour colour);
+
+    ArrangementTileCache();
+    ~ArrangementTileCache();
+
+    /**
+     * @brief Draws the part of @p lane inside g's clip region from its tiles.
+     *
+     * Columns without a tile show the background until theirs arrives. Renders are
+     * queued for those, then for the columns around @p visibleArea (the lane's part
+     * of the viewport, in lane coordinates).
+     */
+    void draw (juce::Graphics& g, int trackIndex, const std::shared_ptr<const Lane>& lane,
+               juce::Rectangle<int> visibleArea);
+
+    /** Drops every tile and queued render. */
+    void clear();
+
+    /** Called on the message thread when a tile for @p trackIndex covering @p area arrives. */
+    std::function<void (int trackIndex, juce::Rectangle<int> area)> onTileReady;
+
+private:
+    struct Key
+    {
+        int track = 0;
+        juce::uint32 version = 0;
+        int column = 0;
+        int scale = 100;                                        ///< Display scale, in percent
+
+        bool operator< (const Key& other) const noexcept
+        {
+            return std::tie (track, version, column, scale) < std::tie (other.track, other.version, other.column, other.scale);
+        }
+    };
+
+    struct Tile
+    {
+        juce::Image image;
+        juce::uint64 lastUsed = 0;
+    };
+
+    class TileJob;
+
+    /** Paints the lane's rounded background, for a column whose tile hasn't arrived. */
+    static void paintBackground (juce::Graphics& g, const Lane& lane, juce::Colour background);
+
+    void requestTile (const Key& key, const std::shared_ptr<const Lane>& lane);
+
+    /** Queues the uncached columns within one view width either side of @p visibleArea, nearest first. */
+    void prefetch (int trackIndex, int scaleKey, const std::shared_ptr<const Lane>& lane, juce::Rectangle<int> visibleArea);
+    void tileRendered (const Key& key, const juce::Image& image);
+    void forgetOlderVersions (int trackIndex, juce::uint32 version);
+    void evictToFit();
+
+    static juce::int64 getNumBytes (const juce::Image& image) noexcept
+    {
+        return (juce::int64) image.getWidth() * image.getHeight() * 4;
+    }
+
+    std::map<Key, Tile> tiles;
+    std::set<Key> pending;                                      ///< Queued or rendering
+    std::map<int, juce::uint32> laneVersions;                   ///< Latest version drawn, by track
+    juce::int64 cachedBytes = 0;
+    juce::uint64 useCounter = 0;
+
+    juce::ThreadPool pool { juce::jlimit (1, 4, juce::SystemStats::getNumCpus() - 1) };
+
+    JUCE_DECLARE_WEAK_REFERENCEABLE (ArrangementTileCache)
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ArrangementTileCache)
+};
@@ -0,0 +1,164 @@
+#include "AudioClipComponent.h"
+#include "TrackListComponent.h"
+#include "../../AudioEngine/AudioClipEngine.h"
+
+AudioClipComponent::AudioClipComponent (te::WaveAudioClip& c, AudioThumbnailService& thumbnails)
+    : clip (&c),
+      thumbnail (thumbnails.createThumbnail (c.getOriginalFile()))
+{
+    thumbnail->addChangeListener (this);
+}
+
+AudioClipComponent::~AudioClipComponent()
+{
+    thumbnail->removeChangeListener (this);
+}
+
+void AudioClipComponent::setColor (juce::Colour newColor)
+{
+    clipColor = newColor;
+    repaint();
+}
+
+void AudioClipComponent::changeListenerCallback (juce::ChangeBroadcaster*)
+{
+    if (onContentChanged)
+        onContentChanged();
+}
+
+juce::Range<double> AudioClipComponent::getSourceRange() const
+{
+    if (clip->getAutoTempo())
+    {
+        // Warped: the clip plays its beats at the source's own tempo
+        const double bpm = AudioClipEngine::getSourceBpm (*clip);
+        if (bpm > 0.0)
+        {
+            const double secondsPerBeat = 60.0 / bpm;
+            const double start = clip->getOffsetInBeats().inBeats() * secondsPerBeat;
+            return { start, start + clip->getLengthInBeats().inBeats() * secondsPerBeat };
+        }
+    }
+
+    const double speed = clip->getSpeedRatio();
+    const double start = clip->getPosition().getOffset().inSeconds() * speed;
+    return { start, start + clip->getPosition().getLength().inSeconds() * speed };
+}
+
+std::vector<juce::Range<float>> AudioClipComponent::getPeaks (const int numPixels) const
+{
+    std::vector<juce::Range<float>> peaks;
+
+    if (numPixels <= 0 || thumbnail->getTotalLength() <= 0.0)
+        return peaks;
+
+    const auto source = getSourceRange();
+    const double secondsPerPixel = source.getLength() / numPixels;
+    peaks.reserve ((size_t) numPixels);
+
+    for (int i = 0; i < numPixels; ++i)
+    {
+        const double start = source.getStart() + i * secondsPerPixel;
+        float low = 0.0f, high = 0.0f;
+
+        for (int ch = 0; ch < thumbnail->getNumChannels(); ++ch)
+        {
+            float chLow = 0.0f, chHigh = 0.0f;
+            thumbnail->getApproximateMinMax (start, start + secondsPerPixel, ch, chLow, chHigh);
+            low = juce::jmin (low, chLow);
+            high = juce::jmax (high, chHigh);
+        }
+
+        peaks.push_back ({ juce::jlimit (-1.0f, 1.0f, low), juce::jlimit (-1.0f, 1.0f, high) });
+    }
+
+    return peaks;
+}
+
+//==============================================================================
+// Painting
+
+void AudioClipComponent::paint (juce::Graphics& g)
+{
+    // At rest the track's tiles show this clip
+    if (! isDragging)
+        return;
+
+    const auto r = getLocalBounds().toFloat();
+    constexpr float radius = 8.0f;
+
+    g.setColour (clipColor.withAlpha (isDragging ? 0.6f : 1.0f));
+    g.fillRoundedRectangle (r, radius);
+
+    auto content = getLocalBounds().reduced (4, 2);
+    auto header = content.removeFromTop (14);
+
+    // Waveform
+    const auto source = getSourceRange();
+    g.setColour (juce::Colours::black.withAlpha (0.55f));
+
+    if (thumbnail->getTotalLength() > 0.0)
+        thumbnail->drawChannels (g, content, source.getStart(), source.getEnd(), 1.0f);
+    else
+        g.drawText ("Loading...", content, juce::Justification::centred, false);
+
+    // Name + warp badge
+    g.setColour (juce::Colours::white.withAlpha (0.9f));
+    g.setFont (juce::Font (juce::FontOptions (11.0f)));
+
+    if (clip->getAutoTempo())
+    {
+        auto badge = header.removeFromRight (36).toFloat();
+        g.drawRoundedRectangle (badge.reduced (1.0f), 3.0f, 1.0f);
+        g.drawText ("WARP", badge, juce::Justification::centred, false);
+    }
+
+    g.drawText (clip->getName(), header, juce::Justification::centredLeft, true);
+
+    g.setColour (juce::Colours::white.withAlpha (0.35f));
+    g.drawRoundedRectangle (r.reduced (0.5f), radius, 1.0f);
+}
+
+//==============================================================================
+// Mouse
+
+void AudioClipComponent::mouseDown (const juce::MouseEvent& e)
+{
+    if (e.mods.isPopupMenu())
+    {
+        if (onContextMenuRequested)
+            onContextMenuRequested (clip.get());
+        return;
+    }
+
+    dragStartX = getX();
+    isDragging = false;
+}
+
+void AudioClipComponent::mouseDrag (const juce::MouseEvent& e)
+{
+    if (e.mods.isPopupMenu())
+        return;
+
+    isDragging = true;
+    setTopLeftPosition (juce::jmax (0, dragStartX + e.getDistanceFromDragStartX()), getY());
+    repaint();
+}
+
+void AudioClipComponent::mouseUp (const juce::MouseEvent&)
+{
+    if (! isDragging)
+        return;
+
+    isDragging = false;
+    repaint();
+
+    auto* tl = findParentComponentOfClass<TrackListComponent>();
+    if (tl == nullptr || ! onMoveRequested)
+        return;
+
+    // Same 1/4-beat grid as MIDI clips
+    constexpr double gridSize = 0.25;
+    const double beat = tl->getViewStartBeat().inBeats() + getX() / juce::jmax (1.0, tl->getPixelsPerBeat());
+    onMoveRequested (clip.get(), juce::jmax (0.0, std::round (beat / gridSize) * gridSize));
+}
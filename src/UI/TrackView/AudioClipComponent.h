@@ -0,0 +1,63 @@
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+#include <tracktion_engine/tracktion_engine.h>
+#include "../../AudioEngine/AudioThumbnailService.h"
+#include <functional>
+#include <vector>
+
+namespace te = tracktion::engine;
+namespace t = tracktion;
+
+/**
+ * @brief Track-lane view of one audio clip: waveform, name and warp state.
+ *
+ * The waveform comes from the app-wide AudioThumbnailService, so clips sharing a
+ * file share the scan. At rest the clip is painted by its track's tiles, from
+ * getPeaks(); the component paints itself only while dragged, and reports the
+ * thumbnail filling in through onContentChanged.
+ *
+ * **Mouse Interaction**:
+ * - **Drag** horizontally: move the clip (snapped to 1/4 beat on release)
+ * - **Right-click**: context menu, owned by TrackComponent
+ *
+ * Layout (bounds) is set by TrackComponent, in beats, like TrackClip.
+ */
+class AudioClipComponent final : public juce::Component,
+                                 private juce::ChangeListener
+{
+public:
+    AudioClipComponent (te::WaveAudioClip& clip, AudioThumbnailService& thumbnails);
+    ~AudioClipComponent() override;
+
+    void setColor (juce::Colour newColor);
+
+    te::WaveAudioClip* getAudioClip() const noexcept { return clip.get(); }
+
+    /** Min/max of the part of the source the clip plays, for @p numPixels columns; empty until the thumbnail has data. */
+    std::vector<juce::Range<float>> getPeaks (int numPixels) const;
+
+    void paint (juce::Graphics& g) override;
+    void mouseDown (const juce::MouseEvent& e) override;
+    void mouseDrag (const juce::MouseEvent& e) override;
+    void mouseUp (const juce::MouseEvent& e) override;
+
+    std::function<void (te::WaveAudioClip*, double newStartBeat)> onMoveRequested;
+    std::function<void (te::WaveAudioClip*)> onContextMenuRequested;
+    std::function<void()> onContentChanged;                 ///< The waveform changed (the thumbnail filled in)
+
+private:
+    void changeListenerCallback (juce::ChangeBroadcaster*) override;
+
+    /** Part of the source file (in seconds) that the clip currently plays. */
+    juce::Range<double> getSourceRange() const;
+
+    te::WaveAudioClip::Ptr clip;
+    std::unique_ptr<juce::AudioThumbnail> thumbnail;
+    juce::Colour clipColor { juce::Colours::grey };
+
+    int dragStartX = 0;
+    bool isDragging = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioClipComponent)
+};
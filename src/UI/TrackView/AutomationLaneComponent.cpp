@@ -0,0 +1,266 @@
+#include "AutomationLaneComponent.h"
+
+#include <algorithm>
+#include <cmath>
+
+AutomationLaneComponent::AutomationLaneComponent (te::Edit& e, TempoMap& map, te::AutomatableParameter& p)
+    : edit (e), tempoMap (map), param (&p)
+{
+    param->addListener (this);
+    tempoMap.addChangeListener (this);
+}
+
+AutomationLaneComponent::~AutomationLaneComponent()
+{
+    tempoMap.removeChangeListener (this);
+    param->removeListener (this);
+}
+
+//==============================================================================
+// Zoom / scroll
+
+void AutomationLaneComponent::setPixelsPerBeat (double ppb)
+{
+    pixelsPerBeat = juce::jmax (1.0, ppb);
+    repaint();
+}
+
+void AutomationLaneComponent::setViewStartBeat (t::BeatPosition b)
+{
+    viewStartBeat = b;
+    repaint();
+}
+
+//==============================================================================
+// Curve changes
+
+void AutomationLaneComponent::curveHasChanged (te::AutomatableParameter&)
+{
+    invalidate();
+}
+
+void AutomationLaneComponent::currentValueChanged (te::AutomatableParameter&)
+{
+    // Only drawn while there is no curve
+    if (pointsValid && points.empty())
+        repaint();
+}
+
+void AutomationLaneComponent::changeListenerCallback (juce::ChangeBroadcaster*)
+{
+    invalidate();
+}
+
+void AutomationLaneComponent::invalidate()
+{
+    pointsValid = false;
+    columnsByZoom.clear();
+    repaint();
+}
+
+const std::vector<AutomationLaneComponent::Point>& AutomationLaneComponent::getPoints()
+{
+    if (pointsValid)
+        return points;
+
+    pointsValid = true;
+    points.clear();
+
+    auto& curve = param->getCurve();
+    const int numPoints = curve.getNumPoints();
+    points.reserve ((size_t) numPoints);
+
+    for (int i = 0; i < numPoints; ++i)
+    {
+        const auto time = te::toTime (curve.getPointPosition (i), edit.tempoSequence);
+        points.push_back ({ tempoMap.toBeats (time).inBeats(), normalise (curve.getPointValue (i)) });
+    }
+
+    return points;
+}
+
+//==============================================================================
+// Decimation
+
+std::vector<AutomationLaneComponent::Column> AutomationLaneComponent::decimate (const std::vector<Point>& points,
+                                                                               double pixelsPerBeat,
+                                                                               int firstColumn, int numColumns)
+{
+    std::vector<Column> columns;
+    if (points.empty() || numColumns <= 0 || pixelsPerBeat <= 0.0)
+        return columns;
+
+    columns.resize ((size_t) numColumns);
+    const size_t n = points.size();
+
+    // Value at @p beat, given the index of the first point after it
+    const auto valueAt = [&] (double beat, size_t next)
+    {
+        if (next == 0)
+            return points.front().value;
+
+        if (next >= n)
+            return points.back().value;
+
+        const auto& a = points[next - 1];
+        const auto& b = points[next];
+        const double span = b.beat - a.beat;
+        const double proportion = span > 0.0 ? (beat - a.beat) / span : 1.0;
+        return (float) (a.value + (b.value - a.value) * proportion);
+    };
+
+    // First point after the first column's start; points before the range are skipped, not walked
+    const double rangeStart = firstColumn / pixelsPerBeat;
+    size_t next = (size_t) (std::upper_bound (points.begin(), points.end(), rangeStart,
+                                              [] (double beat, const Point& p) { return beat < p.beat; })
+                            - points.begin());
+
+    for (int c = 0; c < numColumns; ++c)
+    {
+        const double start = (firstColumn + c) / pixelsPerBeat;
+        const double end   = (firstColumn + c + 1) / pixelsPerBeat;
+
+        while (next < n && points[next].beat <= start)
+            ++next;
+
+        float lo = valueAt (start, next);
+        float hi = lo;
+
+        // Every point inside the column, then the value where the next one begins
+        size_t i = next;
+        for (; i < n && points[i].beat <= end; ++i)
+        {
+            lo = std::min (lo, points[i].value);
+            hi = std::max (hi, points[i].value);
+        }
+
+        const float atEnd = valueAt (end, i);
+        columns[(size_t) c] = { std::min (lo, atEnd), std::max (hi, atEnd) };
+    }
+
+    return columns;
+}
+
+const AutomationLaneComponent::ColumnWindow& AutomationLaneComponent::getColumns (int firstColumn, int numColumns)
+{
+    const auto key = (juce::int64) std::llround (pixelsPerBeat * 1000.0);
+    ++useCounter;
+
+    if (auto it = columnsByZoom.find (key); it != columnsByZoom.end())
+    {
+        auto& window = it->second;
+
+        if (firstColumn >= window.firstColumn
+             && firstColumn + numColumns <= window.firstColumn + (int) window.columns.size())
+        {
+            window.lastUsed = useCounter;
+            return window;
+        }
+    }
+    else if (columnsByZoom.size() >= maxCachedZoomLevels)
+    {
+        // Zooming back and forth reuses the last few levels; the least recently drawn goes
+        auto oldest = std::min_element (columnsByZoom.begin(), columnsByZoom.end(),
+                                        [] (const auto& a, const auto& b) { return a.second.lastUsed < b.second.lastUsed; });
+        columnsByZoom.erase (oldest);
+    }
+
+    // The range plus a lane width either side, so scrolls and small repaints stay inside the window
+    const int margin = juce::jmax (numColumns, getWidth());
+    const int start = juce::jmax (0, firstColumn - margin);
+    const int end = firstColumn + numColumns + margin;
+
+    auto& window = columnsByZoom[key];
+    window.firstColumn = start;
+    window.columns = decimate (getPoints(), pixelsPerBeat, start, end - start);
+    window.lastUsed = useCounter;
+    return window;
+}
+
+//==============================================================================
+// Painting
+
+float AutomationLaneComponent::normalise (float value) const
+{
+    const auto range = param->getValueRange();
+    return range.getLength() > 0.0f ? (value - range.getStart()) / range.getLength() : 0.0f;
+}
+
+float AutomationLaneComponent::valueToY (float normalisedValue) const
+{
+    const auto area = getLocalBounds().toFloat().reduced (0.0f, 3.0f);
+    return area.getBottom() - juce::jlimit (0.0f, 1.0f, normalisedValue) * area.getHeight();
+}
+
+void AutomationLaneComponent::paint (juce::Graphics& g)
+{
+    const auto bounds = getLocalBounds();
+
+    g.fillAll (juce::Colour (0xFF262A2E));
+    g.setColour (juce::Colours::black.withAlpha (0.4f));
+    g.drawHorizontalLine (bounds.getBottom() - 1, 0.0f, (float) bounds.getRight());
+
+    const auto curveColour = juce::Colour (0xFFFFB74D);
+    const auto& pts = getPoints();
+
+    if (pts.empty())
+    {
+        // No automation: the value the parameter is sitting at
+        g.setColour (curveColour.withAlpha (0.4f));
+        g.drawHorizontalLine (juce::roundToInt (valueToY (normalise (param->getCurrentValue()))),
+                              0.0f, (float) bounds.getRight());
+    }
+    else
+    {
+        const auto clip = g.getClipBounds();
+        const int firstColumn = juce::roundToInt (viewStartBeat.inBeats() * pixelsPerBeat);
+        const int left = juce::jmax (0, clip.getX());
+        const auto& window = getColumns (firstColumn + left, juce::jmax (1, clip.getRight() - left));
+        const auto& columns = window.columns;
+
+        g.setColour (curveColour);
+
+        for (int x = left; x < clip.getRight(); ++x)
+        {
+            const int c = firstColumn + x - window.firstColumn;
+            if (c < 0 || c >= (int) columns.size())
+                continue;
+
+            const float top    = valueToY (columns[(size_t) c].max);
+            const float bottom = valueToY (columns[(size_t) c].min);
+            g.fillRect ((float) x, top - 0.5f, 1.0f, juce::jmax (1.5f, bottom - top + 1.0f));
+        }
+    }
+
+    g.setColour (juce::Colours::white.withAlpha (0.7f));
+    g.setFont (juce::Font (juce::FontOptions (11.0f)));
+    g.drawText (param->getParameterName(), bounds.reduced (6, 2), juce::Justification::topLeft, true);
+}
+
+//==============================================================================
+// Mouse
+
+void AutomationLaneComponent::mouseUp (const juce::MouseEvent& e)
+{
+    if (! e.mods.isPopupMenu())
+        return;
+
+    juce::PopupMenu m;
+    m.addItem (1, "Clear Automation", ! getPoints().empty());
+    m.addSeparator();
+    m.addItem (2, "Hide Lane");
+
+    juce::Component::SafePointer<AutomationLaneComponent> safeThis (this);
+
+    m.showMenuAsync (juce::PopupMenu::Options().withTargetComponent (this).withMousePosition(),
+                     [safeThis] (int result)
+                     {
+                         if (safeThis == nullptr)
+                             return;
+
+                         if (result == 1)
+                             safeThis->param->getCurve().clear (&safeThis->edit.getUndoManager());
+                         else if (result == 2 && safeThis->onHideRequested)
+                             safeThis->onHideRequested();
+                     });
+}
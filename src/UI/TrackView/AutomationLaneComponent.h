@@ -0,0 +1,127 @@
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+#include <tracktion_engine/tracktion_engine.h>
+#include "../../MIDIEngine/TempoMap.h"
+
+#include <functional>
+#include <map>
+#include <vector>
+
+namespace te = tracktion::engine;
+namespace t = tracktion;
+
+/**
+ * @brief Automation lane for one parameter, shown under its track.
+ *
+ * Draws the parameter's curve in the same beat coordinates as the tempo lane.
+ * A recorded curve can hold far more points than the lane has pixels, so the
+ * lane never strokes it point by point. The visible stretch (plus a screen either
+ * side) is decimated into one min/max pair per pixel column, and paint() fills a
+ * one-pixel bar per visible column. Repaints then cost O(visible width), however
+ * dense the curve, and a long song at a deep zoom never decimates more than a few
+ * screens. Adjacent columns share the value at their common edge, so the bars
+ * join into a continuous line.
+ *
+ * Each zoom level keeps one window of columns; the least recently drawn level
+ * goes first when there are too many. Scrolling past a window decimates a new one
+ * around the view. Everything is dropped when the curve or the tempo map changes.
+ *
+ * **Mouse Interaction**:
+ * - **Right-click**: clear the automation / hide the lane
+ *
+ * **Integration**:
+ * - Owned by TrackListComponent, laid out under the parameter's track
+ * - Curves are written by AutomationRecorder while recording
+ */
+class AutomationLaneComponent final : public juce::Component,
+                                      private te::AutomatableParameter::Listener,
+                                      private juce::ChangeListener
+{
+public:
+    /** A curve point on the beat grid, value normalised to the parameter's range. */
+    struct Point
+    {
+        double beat = 0.0;
+        float value = 0.0f;
+    };
+
+    /** Lowest and highest normalised value the curve reaches within one pixel column. */
+    struct Column
+    {
+        float min = 0.0f, max = 0.0f;
+    };
+
+    AutomationLaneComponent (te::Edit& edit, TempoMap& tempoMap, te::AutomatableParameter& param);
+    ~AutomationLaneComponent() override;
+
+    te::AutomatableParameter& getParameter() const noexcept   { return *param; }
+
+    void setPixelsPerBeat (double ppb);
+    void setViewStartBeat (t::BeatPosition b);
+
+    void paint (juce::Graphics& g) override;
+    void mouseUp (const juce::MouseEvent& e) override;
+
+    /** Called from the context menu to hide this lane. */
+    std::function<void()> onHideRequested;
+
+    /**
+     * @brief Reduces a curve to min/max per pixel column.
+     *
+     * Column c covers beats [c, c + 1) / pixelsPerBeat. Values hold before the
+     * first point and after the last, as in playback. O(log points + points in
+     * range + columns).
+     *
+     * @param points        Curve points in beat order
+     * @param pixelsPerBeat Zoom level
+     * @param firstColumn   Column the result starts at
+     * @param numColumns    Columns to produce
+     */
+    static std::vector<Column> decimate (const std::vector<Point>& points, double pixelsPerBeat,
+                                         int firstColumn, int numColumns);
+
+private:
+    // te::AutomatableParameter::Listener
+    void curveHasChanged (te::AutomatableParameter&) override;
+    void currentValueChanged (te::AutomatableParameter&) override;
+
+    /** Tempo map changed: the points move on the beat grid. */
+    void changeListenerCallback (juce::ChangeBroadcaster*) override;
+
+    /** Drops the points and every cached zoom level. */
+    void invalidate();
+
+    /** The points, read from the curve if they were dropped. */
+    const std::vector<Point>& getPoints();
+
+    /** Decimated columns of one zoom level, starting at firstColumn. */
+    struct ColumnWindow
+    {
+        int firstColumn = 0;
+        std::vector<Column> columns;
+        juce::uint64 lastUsed = 0;
+    };
+
+    /** Columns for the current zoom covering [firstColumn, firstColumn + numColumns), from the cache if possible. */
+    const ColumnWindow& getColumns (int firstColumn, int numColumns);
+
+    float valueToY (float normalisedValue) const;
+    float normalise (float value) const;
+
+    static constexpr size_t maxCachedZoomLevels = 4;
+
+    te::Edit& edit;
+    TempoMap& tempoMap;         ///< Reference to the Edit's tempo map (not owned)
+    te::AutomatableParameter::Ptr param;
+
+    std::vector<Point> points;
+    bool pointsValid = false;
+    std::map<juce::int64, ColumnWindow> columnsByZoom;          ///< Keyed by pixels per beat, in thousandths
+    juce::uint64 useCounter = 0;
+
+    double pixelsPerBeat = 100.0;
+    t::BeatPosition viewStartBeat { t::BeatPosition::fromBeats (0.0) };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AutomationLaneComponent)
+};
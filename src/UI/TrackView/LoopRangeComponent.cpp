@@ -6,8 +6,8 @@
  * The component does not accept mouse input; it simply renders loop markers
  * on top of the track view without interfering with user interaction.
  */
-LoopRangeComponent::LoopRangeComponent (te::Edit& e)
-    : edit (e)
+LoopRangeComponent::LoopRangeComponent (const TempoMap& map)
+    : tempoMap (map)
 {
     // Allow mouse events to pass through to underlying components.
     setInterceptsMouseClicks (false, false);
@@ -28,8 +28,8 @@ void LoopRangeComponent::paint (juce::Graphics& g)
         return;
 
     // Convert loop boundaries to beat positions
-    const auto startBeatPos = edit.tempoSequence.toBeats (loopRange.getStart());
-    const auto endBeatPos   = edit.tempoSequence.toBeats (loopRange.getEnd());
+    const auto startBeatPos = tempoMap.toBeats (loopRange.getStart());
+    const auto endBeatPos   = tempoMap.toBeats (loopRange.getEnd());
 
     // Convert beat → x pixel based on zoom & scroll
     const double startX = (startBeatPos.inBeats() - viewStartBeat.inBeats()) * pixelsPerBeat;
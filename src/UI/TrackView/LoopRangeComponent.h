@@ -2,6 +2,7 @@
 
 #include <juce_gui_basics/juce_gui_basics.h>
 #include <tracktion_engine/tracktion_engine.h>
+#include "../../MIDIEngine/TempoMap.h"
 
 namespace t  = tracktion;
 namespace te = tracktion::engine;
@@ -28,14 +29,13 @@ class LoopRangeComponent final : public juce::Component
 {
 public:
     /**
-     * @brief Construct a LoopRangeComponent tied to a Tracktion Edit.
+     * @brief Construct a LoopRangeComponent tied to an Edit's tempo map.
      *
-     * The Edit is required so we can convert from TimePosition → BeatPosition
-     * using the tempoSequence.
+     * The tempo map is required so we can convert from TimePosition → BeatPosition.
      *
-     * @param edit Reference to the Tracktion Edit.
+     * @param tempoMap The Edit's tempo map (not owned).
      */
-    explicit LoopRangeComponent (te::Edit& edit);
+    explicit LoopRangeComponent (const TempoMap& tempoMap);
 
     //==============================================================================
     /** @internal Draws the loop start/end lines if looping is enabled. */
@@ -56,7 +56,7 @@ public:
 
 private:
     //==============================================================================
-    te::Edit& edit;                      ///< Reference to Edit for time ↔ beat conversion.
+    const TempoMap& tempoMap;            ///< Time ↔ beat conversion for the Edit.
 
     double pixelsPerBeat = 100.0;        ///< Horizontal zoom factor.
     t::BeatPosition viewStartBeat { t::BeatPosition::fromBeats (0.0) };
@@ -0,0 +1,149 @@
+#include "MacroKnobsComponent.h"
+
+MacroKnobsComponent::MacroKnobsComponent (AppEngine& engine, int index)
+    : appEngine (engine), trackIndex (index)
+{
+    auto& macros = appEngine.getMacroControls();
+
+    for (int m = 0; m < MacroControls::numMacros; ++m)
+    {
+        auto* knob = knobs.add (new juce::Slider (juce::Slider::RotaryHorizontalVerticalDrag, juce::Slider::NoTextBox));
+        knob->setRange (0.0, 1.0);
+        knob->setValue (macros.getMacroValue (trackIndex, m), juce::dontSendNotification);
+
+        // Looked up on every move: the controls are recreated with the edit
+        knob->onValueChange = [this, m, knob]
+        {
+            appEngine.getMacroControls().setMacroValue (trackIndex, m, (float) knob->getValue());
+        };
+
+        // The track's state takes the value once, when the sweep ends
+        knob->onDragEnd = [this] { appEngine.getMacroControls().saveValues(); };
+
+        auto* label = labels.add (new juce::Label ({}, "M" + juce::String (m + 1)));
+        label->setJustificationType (juce::Justification::centred);
+        label->setFont (juce::Font (juce::FontOptions (11.0f)));
+
+        addAndMakeVisible (knob);
+        addAndMakeVisible (label);
+    }
+
+    updateAssignments();
+}
+
+void MacroKnobsComponent::updateAssignments()
+{
+    const auto assignments = appEngine.getMacroControls().getAssignments (trackIndex);
+
+    for (int m = 0; m < knobs.size(); ++m)
+    {
+        juce::StringArray targets;
+        for (const auto& a : assignments)
+            if (a.macro == m)
+                targets.add (a.param->getParameterName());
+
+        knobs[m]->setTooltip (targets.isEmpty() ? juce::String ("Nothing assigned") : targets.joinIntoString (", "));
+    }
+
+    rows.clear();
+
+    for (const auto& a : assignments)
+        addAndMakeVisible (rows.add (new AssignmentRow (*this, a)));
+
+    setSize (knobSize * MacroControls::numMacros + 8, knobSize + 24 + rows.size() * rowHeight);
+    resized();
+}
+
+void MacroKnobsComponent::resized()
+{
+    auto area = getLocalBounds().reduced (4);
+    auto knobRow = area.removeFromTop (knobSize + 16);
+
+    for (int m = 0; m < knobs.size(); ++m)
+    {
+        auto column = knobRow.removeFromLeft (knobSize);
+        labels[m]->setBounds (column.removeFromBottom (16));
+        knobs[m]->setBounds (column);
+    }
+
+    for (auto* row : rows)
+        row->setBounds (area.removeFromTop (rowHeight));
+}
+
+//==============================================================================
+// Assignment rows
+
+MacroKnobsComponent::AssignmentRow::AssignmentRow (MacroKnobsComponent& o, const MacroControls::Assignment& a)
+    : owner (o), macro (a.macro), param (a.param)
+{
+    name.setText ("M" + juce::String (macro + 1) + "  " + param->getParameterName(), juce::dontSendNotification);
+    name.setFont (juce::Font (juce::FontOptions (11.0f)));
+    name.setTooltip ("Range this macro sweeps the parameter over, and how it gets there");
+
+    for (auto* s : { &start, &end })
+    {
+        s->setSliderStyle (juce::Slider::LinearHorizontal);
+        s->setTextBoxStyle (juce::Slider::TextBoxRight, false, 36, rowHeight - 4);
+        s->setRange (0.0, 1.0, 0.01);
+        s->onDragEnd = [this] { commit(); };
+        s->onValueChange = [this, s]
+        {
+            // Drags commit once at the end; typed values and clicks commit now
+            if (! s->isMouseButtonDown())
+                commit();
+        };
+    }
+
+    start.setValue (a.start, juce::dontSendNotification);
+    end.setValue (a.end, juce::dontSendNotification);
+    start.setTooltip ("Parameter value at macro 0");
+    end.setTooltip ("Parameter value at macro 1");
+
+    // Ids are the curve's value plus one: 0 means no selection
+    curve.addItem ("Linear", (int) MacroControls::Curve::linear + 1);
+    curve.addItem ("Exponential", (int) MacroControls::Curve::exponential + 1);
+    curve.addItem ("Logarithmic", (int) MacroControls::Curve::logarithmic + 1);
+    curve.addItem ("S-Curve", (int) MacroControls::Curve::sCurve + 1);
+    curve.setSelectedId ((int) a.curve + 1, juce::dontSendNotification);
+    curve.onChange = [this] { commit(); };
+
+    remove.setTooltip ("Remove this assignment");
+    remove.onClick = [this]
+    {
+        owner.appEngine.getMacroControls().unassign (owner.trackIndex, macro, *param);
+
+        // This row goes with the rebuild: leave its click handler first
+        juce::MessageManager::callAsync ([safe = juce::Component::SafePointer<MacroKnobsComponent> (&owner)]
+        {
+            if (safe != nullptr)
+                safe->updateAssignments();
+        });
+    };
+
+    addAndMakeVisible (name);
+    addAndMakeVisible (start);
+    addAndMakeVisible (end);
+    addAndMakeVisible (curve);
+    addAndMakeVisible (remove);
+}
+
+void MacroKnobsComponent::AssignmentRow::commit()
+{
+    owner.appEngine.getMacroControls().assign (owner.trackIndex, macro, *param,
+                                               (float) start.getValue(), (float) end.getValue(),
+                                               (MacroControls::Curve) (curve.getSelectedId() - 1));
+}
+
+void MacroKnobsComponent::AssignmentRow::resized()
+{
+    auto area = getLocalBounds().reduced (0, 2);
+
+    remove.setBounds (area.removeFromRight (area.getHeight()));
+    area.removeFromRight (4);
+    curve.setBounds (area.removeFromRight (96));
+    area.removeFromRight (4);
+
+    name.setBounds (area.removeFromLeft (area.getWidth() / 3));
+    start.setBounds (area.removeFromLeft (area.getWidth() / 2));
+    end.setBounds (area);
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "../../AppEngine/AppEngine.h"
+#include <juce_gui_basics/juce_gui_basics.h>
+
+/**
+ * @brief A row of macro knobs for one track, shown in a call-out from the track menu.
+ *
+ * Each knob sets its macro through MacroControls; the assigned parameters are
+ * listed in the knob's tooltip. Below the knobs, every assignment gets a row to
+ * edit the range it sweeps and its curve, or to remove it.
+ */
+class MacroKnobsComponent final : public juce::Component
+{
+public:
+    MacroKnobsComponent (AppEngine& appEngine, int trackIndex);
+
+    void resized() override;
+
+private:
+    static constexpr int knobSize = 56;
+    static constexpr int rowHeight = 24;
+
+    /** One assignment: its name, the start and end of its range, its curve and a remove button. */
+    class AssignmentRow final : public juce::Component
+    {
+    public:
+        AssignmentRow (MacroKnobsComponent& owner, const MacroControls::Assignment& assignment);
+
+        void resized() override;
+
+    private:
+        /** Writes the edited range and curve back through MacroControls. */
+        void commit();
+
+        MacroKnobsComponent& owner;
+        const int macro;
+        te::AutomatableParameter::Ptr param;
+
+        juce::Label name;
+        juce::Slider start, end;
+        juce::ComboBox curve;
+        juce::TextButton remove { "x" };
+
+        JUCE_DECLARE_NON_COPYABLE (AssignmentRow)
+    };
+
+    /** Recreates the assignment rows and the knobs' tooltips, and resizes to fit. */
+    void updateAssignments();
+
+    AppEngine& appEngine;
+    const int trackIndex;
+
+    juce::OwnedArray<juce::Slider> knobs;
+    juce::OwnedArray<juce::Label> labels;
+    juce::OwnedArray<AssignmentRow> rows;
+    juce::TooltipWindow tooltips { this };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MacroKnobsComponent)
+};
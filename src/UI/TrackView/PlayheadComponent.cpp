@@ -54,7 +54,7 @@ void PlayheadComponent::mouseDrag (const juce::MouseEvent& e)
     // Convert mouse x to beat position, then to time using tempo sequence
     const double beats = e.x / pixelsPerBeat + viewStartBeat.inBeats();
     const auto beatPos = t::BeatPosition::fromBeats(juce::jmax(0.0, beats));
-    const auto timePos = edit.tempoSequence.toTime(beatPos);
+    const auto timePos = appEngine.getTempoMap().toTime(beatPos);
     edit.getTransport().setPosition(timePos);
     timerCallback();
 }
@@ -67,7 +67,7 @@ void PlayheadComponent::timerCallback ()
 {
     // Convert transport position (time) to beat position, then to x coordinate
     const auto timePos = edit.getTransport().getPosition();
-    const auto beatPos = edit.tempoSequence.toBeats(timePos);
+    const auto beatPos = appEngine.getTempoMap().toBeats(timePos);
     const double beats = beatPos.inBeats();
 
     if (const int newX = (beats - viewStartBeat.inBeats()) * pixelsPerBeat; newX != xPosition)
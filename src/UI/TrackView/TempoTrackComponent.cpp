@@ -0,0 +1,270 @@
+#include "TempoTrackComponent.h"
+
+TempoTrackComponent::TempoTrackComponent (TempoMap& map)
+    : tempoMap (map)
+{
+    tempoMap.addChangeListener (this);
+    changeListenerCallback (nullptr);
+}
+
+TempoTrackComponent::~TempoTrackComponent()
+{
+    tempoMap.removeChangeListener (this);
+}
+
+//==============================================================================
+// Zoom / scroll
+
+void TempoTrackComponent::setPixelsPerBeat (double ppb)
+{
+    pixelsPerBeat = juce::jmax (10.0, ppb);
+    repaint();
+}
+
+void TempoTrackComponent::setViewStartBeat (t::BeatPosition b)
+{
+    viewStartBeat = b;
+    repaint();
+}
+
+void TempoTrackComponent::changeListenerCallback (juce::ChangeBroadcaster*)
+{
+    changes = tempoMap.getTempoChanges();
+
+    // Keep the scale fixed while dragging so the marker stays under the mouse
+    if (draggingIndex < 0)
+        updateDisplayRange();
+
+    repaint();
+}
+
+void TempoTrackComponent::updateDisplayRange()
+{
+    double lo = 1.0e9, hi = 0.0;
+    for (const auto& c : changes)
+    {
+        lo = juce::jmin (lo, c.bpm);
+        hi = juce::jmax (hi, c.bpm);
+    }
+
+    if (changes.empty())
+        lo = hi = 120.0;
+
+    // Pad so a single tempo sits mid-lane and markers never touch the edges
+    const double pad = juce::jmax (10.0, (hi - lo) * 0.15);
+    minShownBpm = lo - pad;
+    maxShownBpm = hi + pad;
+}
+
+//==============================================================================
+// Coordinates
+
+float TempoTrackComponent::bpmToY (double bpm) const
+{
+    const auto area = getLocalBounds().toFloat().reduced (0.0f, markerRadius + 1.0f);
+    const double norm = (bpm - minShownBpm) / (maxShownBpm - minShownBpm);
+    return area.getBottom() - (float) norm * area.getHeight();
+}
+
+double TempoTrackComponent::yToBpm (float y) const
+{
+    const auto area = getLocalBounds().toFloat().reduced (0.0f, markerRadius + 1.0f);
+    const double norm = (area.getBottom() - y) / juce::jmax (1.0f, area.getHeight());
+    return minShownBpm + norm * (maxShownBpm - minShownBpm);
+}
+
+float TempoTrackComponent::beatToX (double beat) const
+{
+    return (float) ((beat - viewStartBeat.inBeats()) * pixelsPerBeat);
+}
+
+double TempoTrackComponent::xToBeat (float x) const
+{
+    return viewStartBeat.inBeats() + (double) x / pixelsPerBeat;
+}
+
+int TempoTrackComponent::findChangeAt (juce::Point<float> pos) const
+{
+    for (int i = (int) changes.size(); --i >= 0;)
+    {
+        const auto& c = changes[(size_t) i];
+        if (pos.getDistanceFrom ({ beatToX (c.beat), bpmToY (c.bpm) }) <= markerRadius + 3.0f)
+            return i;
+    }
+
+    return -1;
+}
+
+//==============================================================================
+// Painting
+
+void TempoTrackComponent::paint (juce::Graphics& g)
+{
+    const auto bounds = getLocalBounds().toFloat();
+
+    g.fillAll (juce::Colour (0xFF262A2E));
+    g.setColour (juce::Colours::black.withAlpha (0.4f));
+    g.drawLine (0.0f, bounds.getBottom() - 0.5f, bounds.getRight(), bounds.getBottom() - 0.5f);
+
+    if (changes.empty())
+        return;
+
+    const auto curveColour = juce::Colour (0xFF4FC3F7);
+
+    // Tempo curve: hold each BPM until the next change (step) or slide to it (ramp)
+    juce::Path curve;
+    curve.startNewSubPath (juce::jmin (0.0f, beatToX (changes.front().beat)), bpmToY (changes.front().bpm));
+
+    for (size_t i = 0; i < changes.size(); ++i)
+    {
+        const auto& c = changes[i];
+        const float x = beatToX (c.beat);
+        const float y = bpmToY (c.bpm);
+
+        curve.lineTo (x, y);
+
+        if (i + 1 < changes.size())
+        {
+            const auto& next = changes[i + 1];
+            const float nextX = beatToX (next.beat);
+            curve.lineTo (nextX, c.ramp ? bpmToY (next.bpm) : y);
+        }
+        else
+        {
+            curve.lineTo (juce::jmax (bounds.getRight(), x), y);
+        }
+    }
+
+    g.setColour (curveColour);
+    g.strokePath (curve, juce::PathStrokeType (1.5f));
+
+    // Markers + labels
+    g.setFont (juce::Font (juce::FontOptions (10.0f)));
+
+    for (size_t i = 0; i < changes.size(); ++i)
+    {
+        const auto& c = changes[i];
+        const float x = beatToX (c.beat);
+        const float y = bpmToY (c.bpm);
+
+        if (x < -40.0f || x > bounds.getRight() + markerRadius)
+            continue;
+
+        g.setColour ((int) i == draggingIndex ? juce::Colours::white : curveColour);
+        g.fillEllipse (x - markerRadius, y - markerRadius, markerRadius * 2.0f, markerRadius * 2.0f);
+
+        g.setColour (juce::Colours::white.withAlpha (0.75f));
+        const float labelY = y > bounds.getCentreY() ? y - 14.0f : y + 2.0f;
+        g.drawText (juce::String (c.bpm, 1), juce::Rectangle<float> (x + 5.0f, labelY, 40.0f, 12.0f),
+                    juce::Justification::centredLeft, false);
+    }
+}
+
+//==============================================================================
+// Mouse
+
+void TempoTrackComponent::mouseDown (const juce::MouseEvent& e)
+{
+    const int index = findChangeAt (e.position);
+
+    if (index >= 0 && e.mods.isPopupMenu())
+    {
+        showChangeMenu (index);
+        return;
+    }
+
+    draggingIndex = index;
+
+    // Clips follow the tempo once, on release, not on every drag step
+    if (draggingIndex >= 0)
+        tempoMap.beginGesture();
+
+    repaint();
+}
+
+void TempoTrackComponent::mouseDrag (const juce::MouseEvent& e)
+{
+    if (draggingIndex < 0 || draggingIndex >= (int) changes.size())
+        return;
+
+    const double bpm = juce::jlimit (minShownBpm, maxShownBpm, yToBpm (e.position.y));
+    tempoMap.setTempoChangeBpm (draggingIndex, std::round (bpm * 10.0) / 10.0);
+}
+
+void TempoTrackComponent::mouseUp (const juce::MouseEvent&)
+{
+    if (draggingIndex >= 0)
+    {
+        draggingIndex = -1;
+        tempoMap.endGesture();
+        changeListenerCallback (nullptr);
+    }
+}
+
+void TempoTrackComponent::mouseDoubleClick (const juce::MouseEvent& e)
+{
+    if (findChangeAt (e.position) >= 0)
+        return;
+
+    const double beat = std::round (juce::jmax (0.0, xToBeat (e.position.x)));
+    const double bpm  = std::round (yToBpm (e.position.y));
+
+    tempoMap.setTempoAt (beat, bpm);
+}
+
+//==============================================================================
+// Context menu
+
+void TempoTrackComponent::showChangeMenu (int index)
+{
+    if (index < 0 || index >= (int) changes.size())
+        return;
+
+    const auto change = changes[(size_t) index];
+    const bool isLast = index + 1 >= (int) changes.size();
+
+    juce::PopupMenu m;
+    m.addItem (1, "Ramp to Next Change", ! isLast, change.ramp);
+    m.addItem (2, "Set Tempo...");
+    m.addSeparator();
+    m.addItem (3, "Delete Tempo Change", index > 0);
+
+    juce::Component::SafePointer<TempoTrackComponent> safeThis (this);
+
+    m.showMenuAsync (juce::PopupMenu::Options().withTargetComponent (this).withMousePosition(),
+                     [safeThis, index, change] (int result)
+                     {
+                         if (safeThis == nullptr)
+                             return;
+
+                         if (result == 1)
+                             safeThis->tempoMap.setTempoChangeRamp (index, ! change.ramp);
+                         else if (result == 2)
+                             safeThis->promptForBpm (index);
+                         else if (result == 3)
+                             safeThis->tempoMap.removeTempoChange (index);
+                     });
+}
+
+void TempoTrackComponent::promptForBpm (int index)
+{
+    if (index < 0 || index >= (int) changes.size())
+        return;
+
+    auto* window = new juce::AlertWindow ("Set Tempo", "BPM at this tempo change:", juce::MessageBoxIconType::NoIcon);
+    window->addTextEditor ("bpm", juce::String (changes[(size_t) index].bpm, 2));
+    window->addButton ("OK", 1, juce::KeyPress (juce::KeyPress::returnKey));
+    window->addButton ("Cancel", 0, juce::KeyPress (juce::KeyPress::escapeKey));
+
+    juce::Component::SafePointer<TempoTrackComponent> safeThis (this);
+
+    window->enterModalState (true, juce::ModalCallbackFunction::create ([safeThis, window, index] (int result)
+    {
+        if (safeThis != nullptr && result == 1)
+        {
+            const double bpm = window->getTextEditorContents ("bpm").getDoubleValue();
+            if (bpm > 0.0)
+                safeThis->tempoMap.setTempoChangeBpm (index, bpm);
+        }
+    }), true);
+}
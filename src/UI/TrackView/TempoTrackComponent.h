@@ -0,0 +1,74 @@
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+#include <tracktion_engine/tracktion_engine.h>
+#include "../../MIDIEngine/TempoMap.h"
+
+namespace te = tracktion::engine;
+namespace t = tracktion;
+
+/**
+ * @brief Tempo lane shown under the timeline ruler.
+ *
+ * Draws the Edit's tempo map as a step/ramp curve in the same beat coordinates
+ * as the tracks, and edits it through TempoMap.
+ *
+ * **Mouse Interaction**:
+ * - **Double-click** empty space: add a tempo change at the nearest beat, with
+ *   the BPM taken from the click height
+ * - **Drag** a marker up/down: change its BPM
+ * - **Right-click** a marker: ramp to next / set BPM / delete
+ *
+ * **Integration**:
+ * - Owned by TrackListComponent, laid out between the timeline and the tracks
+ * - Repaints whenever the tempo map changes (including undo/redo)
+ */
+class TempoTrackComponent final : public juce::Component,
+                                  private juce::ChangeListener
+{
+public:
+    /** @param tempoMap The Edit's tempo map (not owned). */
+    explicit TempoTrackComponent (TempoMap& tempoMap);
+    ~TempoTrackComponent() override;
+
+    void setPixelsPerBeat (double ppb);
+    void setViewStartBeat (t::BeatPosition b);
+
+    void paint (juce::Graphics& g) override;
+    void mouseDown (const juce::MouseEvent& e) override;
+    void mouseDrag (const juce::MouseEvent& e) override;
+    void mouseUp (const juce::MouseEvent& e) override;
+    void mouseDoubleClick (const juce::MouseEvent& e) override;
+
+private:
+    void changeListenerCallback (juce::ChangeBroadcaster*) override;
+
+    /** Recomputes the BPM range shown in the lane from the current changes. */
+    void updateDisplayRange();
+
+    float bpmToY (double bpm) const;
+    double yToBpm (float y) const;
+    float beatToX (double beat) const;
+    double xToBeat (float x) const;
+
+    /** Index of the change whose marker is under @p pos, or -1. */
+    int findChangeAt (juce::Point<float> pos) const;
+
+    void showChangeMenu (int index);
+    void promptForBpm (int index);
+
+    static constexpr float markerRadius = 4.0f;
+
+    TempoMap& tempoMap; ///< Reference to the Edit's tempo map (not owned)
+    std::vector<TempoMap::TempoChange> changes;
+
+    double pixelsPerBeat = 100.0;
+    t::BeatPosition viewStartBeat { t::BeatPosition::fromBeats (0.0) };
+
+    double minShownBpm = 60.0;
+    double maxShownBpm = 180.0;
+
+    int draggingIndex = -1;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TempoTrackComponent)
+};
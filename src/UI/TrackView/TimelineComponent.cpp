@@ -98,8 +98,8 @@ void ui::TimelineComponent::paint (Graphics& g)
     if (hasLoop)
     {
         // Convert loop range time positions to beat positions
-        const auto startBeatPos = edit.tempoSequence.toBeats (loopRange.getStart());
-        const auto endBeatPos   = edit.tempoSequence.toBeats (loopRange.getEnd());
+        const auto startBeatPos = tempoMap.toBeats (loopRange.getStart());
+        const auto endBeatPos   = tempoMap.toBeats (loopRange.getEnd());
 
         const int x1 = beatsToX (startBeatPos.inBeats());
         const int x2 = beatsToX (endBeatPos.inBeats());
@@ -198,8 +198,8 @@ void ui::TimelineComponent::mouseDown (const juce::MouseEvent& e)
         const double defLenBeats  = 4.0; // seed length: 1 bar (4 beats in 4/4)
 
         // Convert beat positions to time positions for loopRange
-        const auto startTime = edit.tempoSequence.toTime (t::BeatPosition::fromBeats (startBeats));
-        const auto endTime   = edit.tempoSequence.toTime (t::BeatPosition::fromBeats (startBeats + defLenBeats));
+        const auto startTime = tempoMap.toTime (t::BeatPosition::fromBeats (startBeats));
+        const auto endTime   = tempoMap.toTime (t::BeatPosition::fromBeats (startBeats + defLenBeats));
 
         loopRange        = t::TimeRange (startTime, endTime);
         hasLoop          = true;
@@ -215,8 +215,8 @@ void ui::TimelineComponent::mouseDown (const juce::MouseEvent& e)
     }
 
     // Convert existing loop range to beat positions for hit testing
-    const auto startBeatPos = edit.tempoSequence.toBeats (loopRange.getStart());
-    const auto endBeatPos   = edit.tempoSequence.toBeats (loopRange.getEnd());
+    const auto startBeatPos = tempoMap.toBeats (loopRange.getStart());
+    const auto endBeatPos   = tempoMap.toBeats (loopRange.getEnd());
 
     const int x1 = beatsToX (startBeatPos.inBeats());
     const int x2 = beatsToX (endBeatPos.inBeats());
@@ -249,8 +249,8 @@ void ui::TimelineComponent::mouseDown (const juce::MouseEvent& e)
         const double startBeats   = xToBeats (mx);
         const double defLenBeats  = 4.0;
 
-        const auto startTime = edit.tempoSequence.toTime (t::BeatPosition::fromBeats (startBeats));
-        const auto endTime   = edit.tempoSequence.toTime (t::BeatPosition::fromBeats (startBeats + defLenBeats));
+        const auto startTime = tempoMap.toTime (t::BeatPosition::fromBeats (startBeats));
+        const auto endTime   = tempoMap.toTime (t::BeatPosition::fromBeats (startBeats + defLenBeats));
 
         loopRange        = t::TimeRange (startTime, endTime);
         hasLoop          = true;
@@ -283,8 +283,8 @@ void ui::TimelineComponent::mouseDrag (const juce::MouseEvent& e)
 
     // Work in beat space for dragging
     const double mouseBeats = xToBeats (e.x);
-    double startBeats       = edit.tempoSequence.toBeats (loopRange.getStart()).inBeats();
-    double endBeats         = edit.tempoSequence.toBeats (loopRange.getEnd()).inBeats();
+    double startBeats       = tempoMap.toBeats (loopRange.getStart()).inBeats();
+    double endBeats         = tempoMap.toBeats (loopRange.getEnd()).inBeats();
 
     switch (dragMode)
     {
@@ -298,19 +298,13 @@ void ui::TimelineComponent::mouseDrag (const juce::MouseEvent& e)
 
         case DragMode::dragBody:
         {
-            const double anchorBeats = edit.tempoSequence
-                                           .toBeats (t::TimePosition::fromSeconds (dragAnchorSec))
-                                           .inBeats();
+            const double anchorBeats = tempoMap.toBeats (t::TimePosition::fromSeconds (dragAnchorSec)).inBeats();
 
             const double delta = mouseBeats - anchorBeats;
 
-            const double originalStartBeats = edit.tempoSequence
-                                                  .toBeats (t::TimePosition::fromSeconds (originalStartSec))
-                                                  .inBeats();
+            const double originalStartBeats = tempoMap.toBeats (t::TimePosition::fromSeconds (originalStartSec)).inBeats();
 
-            const double originalEndBeats = edit.tempoSequence
-                                                .toBeats (t::TimePosition::fromSeconds (originalEndSec))
-                                                .inBeats();
+            const double originalEndBeats = tempoMap.toBeats (t::TimePosition::fromSeconds (originalEndSec)).inBeats();
 
             startBeats = juce::jmax (0.0, originalStartBeats + delta);
             endBeats   = originalEndBeats + delta;
@@ -329,8 +323,8 @@ void ui::TimelineComponent::mouseDrag (const juce::MouseEvent& e)
     }
 
     // Convert back to time positions
-    const auto startTime = edit.tempoSequence.toTime (t::BeatPosition::fromBeats (startBeats));
-    const auto endTime   = edit.tempoSequence.toTime (t::BeatPosition::fromBeats (endBeats));
+    const auto startTime = tempoMap.toTime (t::BeatPosition::fromBeats (startBeats));
+    const auto endTime   = tempoMap.toTime (t::BeatPosition::fromBeats (endBeats));
 
     loopRange = t::TimeRange (startTime, endTime);
 
@@ -390,9 +384,8 @@ void ui::TimelineComponent::snapSecondsToBeats (double& seconds) const
     if (! snapToBeats || editForSnap == nullptr)
         return;
 
-    auto& ts = editForSnap->tempoSequence;
-    const auto beat        = ts.toBeats (t::TimePosition::fromSeconds (seconds)).inBeats();
+    const auto beat        = tempoMap.toBeats (t::TimePosition::fromSeconds (seconds)).inBeats();
     const auto snappedBeat = std::round (beat);
 
-    seconds = ts.toTime (t::BeatPosition::fromBeats (snappedBeat)).inSeconds();
+    seconds = tempoMap.toTime (t::BeatPosition::fromBeats (snappedBeat)).inSeconds();
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 #include <juce_gui_basics/juce_gui_basics.h>
 #include <tracktion_engine/tracktion_engine.h>
+#include "../../MIDIEngine/TempoMap.h"
 
 namespace te = tracktion::engine;
 namespace t  = tracktion;
@@ -24,7 +25,7 @@ namespace ui
      *  - Optionally notify listeners while scrubbing (`onScrub`)
      *
      * The component works in **beats** for positioning and converts to
-     * Tracktion `TimePosition` using the `Edit`'s `tempoSequence`.
+     * Tracktion `TimePosition` through the Edit's TempoMap.
      */
     class TimelineComponent : public juce::Component
     {
@@ -32,12 +33,14 @@ namespace ui
         /**
          * @brief Constructs a TimelineComponent bound to a Tracktion Edit.
          *
-         * The Edit is used for time/beat conversions and for transport control.
+         * The Edit is used for transport control, the TempoMap for time/beat
+         * conversions.
          *
-         * @param e Reference to the owning Tracktion Edit.
+         * @param e   Reference to the owning Tracktion Edit.
+         * @param map The Edit's tempo map (not owned).
          */
-        explicit TimelineComponent (te::Edit& e)
-            : edit (e) {}
+        TimelineComponent (te::Edit& e, const TempoMap& map)
+            : edit (e), tempoMap (map) {}
 
         //==========================================================================
         // Zoom/scroll API (beat-based)
@@ -122,21 +125,22 @@ namespace ui
         //==========================================================================
         // Core state
 
-        te::Edit& edit;  ///< Owning Edit used for tempo mapping and transport.
+        te::Edit& edit;            ///< Owning Edit used for transport.
+        const TempoMap& tempoMap;  ///< Beat/time conversion for edit.
 
         double pixelsPerBeat = 100.0; ///< Horizontal zoom (px per beat).
         t::BeatPosition viewStartBeat { t::BeatPosition::fromBeats (0.0) };
 
         /**
          * @brief Convert an x-coordinate in this component to a TimePosition
-         *        using the Edit's tempoSequence.
+         *        using the Edit's tempo map.
          */
         t::TimePosition xToTime (int x) const
         {
             // Convert x to beat position, then to time
             const auto beats   = viewStartBeat.inBeats() + (double) x / pixelsPerBeat;
             const auto beatPos = t::BeatPosition::fromBeats (juce::jmax (0.0, beats));
-            return edit.tempoSequence.toTime (beatPos);
+            return tempoMap.toTime (beatPos);
         }
 
         /** Update the Edit's transport based on a mouse x coordinate. */
@@ -2,10 +2,10 @@
 #include "TrackEditView.h"
 #include "TrackComponent.h"
 #include "TrackListComponent.h"
-#include <limits> // For std::numeric_limits
 
-TrackClip::TrackClip (te::MidiClip* c, float pixelsPerBeat)
+TrackClip::TrackClip (te::MidiClip* c, float pixelsPerBeat, const TempoMap& map)
     : clip (c),
+      tempoMap (map),
       pixelsPerBeat (pixelsPerBeat),
       resizeConstrainer (*this),
       edgeResizer (this, &resizeConstrainer, juce::ResizableEdgeComponent::Edge::rightEdge)
@@ -43,12 +43,11 @@ void TrackClip::updateSizeFromClip()
     if (tl)
     {
         const double ppb = tl->getPixelsPerBeat();
-        auto& tempoSeq = clip->edit.tempoSequence;
 
         // Convert time positions to beat positions for width calculation
         const auto posRange = clip->getPosition().time;
-        const double clipStartBeats = tempoSeq.toBeats (posRange.getStart()).inBeats();
-        const double clipEndBeats = tempoSeq.toBeats (posRange.getEnd()).inBeats();
+        const double clipStartBeats = tempoMap.toBeats (posRange.getStart()).inBeats();
+        const double clipEndBeats = tempoMap.toBeats (posRange.getEnd()).inBeats();
         const double clipLenBeats = clipEndBeats - clipStartBeats;
 
         const int w = static_cast<int> (juce::roundToIntAccurate (clipLenBeats * ppb));
@@ -77,13 +76,24 @@ void TrackClip::setPixelsPerBeat (float ppb)
 
 void TrackClip::paint (juce::Graphics& g)
 {
-    // Written by Claude Code
+    // The body, note preview and name are in the track's tiles; this adds interaction state
     const auto r = getLocalBounds().toFloat();
     constexpr float radius = 8.0f;
 
-    // Fill - Apply drag alpha for transparency during drag
-    g.setColour (clipColor.withAlpha (dragAlpha));
-    g.fillRoundedRectangle (r, radius);
+    if (isResizing)
+    {
+        // The tiles show the old length until the resize lands
+        g.setColour (clipColor);
+        g.fillRoundedRectangle (r, radius);
+        g.setColour (juce::Colours::white.withAlpha (0.35f));
+        g.drawRoundedRectangle (r.reduced (0.5f), radius, 1.0f);
+    }
+    else if (isDragging)
+    {
+        // Dimmed in place while the ghost shows where it lands
+        g.setColour (juce::Colours::black.withAlpha (1.0f - dragAlpha));
+        g.fillRoundedRectangle (r, radius);
+    }
 
     // Border - highlight if being edited in piano roll
     if (isBeingEdited)
@@ -96,12 +106,6 @@ void TrackClip::paint (juce::Graphics& g)
         g.setColour (juce::Colours::cyan.withAlpha (0.35f));
         g.drawRoundedRectangle (r.expanded (1.0f), radius + 1.0f, 1.5f);
     }
-    else
-    {
-        // Normal white border
-        g.setColour (juce::Colours::white.withAlpha (0.35f * dragAlpha));
-        g.drawRoundedRectangle (r.reduced (0.5f), radius, 1.0f);
-    }
 }
 
 void TrackClip::resized()
@@ -112,6 +116,9 @@ void TrackClip::resized()
 
 void TrackClip::onResizeEnd()
 {
+    isResizing = false;
+    repaint();
+
     // Written by Claude Code (fixed seconds/beats conversion)
     if (!clip)
         return;
@@ -124,8 +131,6 @@ void TrackClip::onResizeEnd()
     if (ppb <= 0.0)
         return;
 
-    auto& tempoSeq = clip->edit.tempoSequence;
-
     // Calculate the new length based on the current width (pixels → beats)
     const double newLengthBeats = static_cast<double> (getWidth()) / ppb;
 
@@ -139,36 +144,12 @@ void TrackClip::onResizeEnd()
     if (trackComp)
     {
         const auto clipStart = clip->getPosition().getStart();
-        const double clipStartBeats = tempoSeq.toBeats (clipStart).inBeats();
-
-        // Find the nearest clip that starts after this one
-        double nearestClipStartBeats = std::numeric_limits<double>::max();
-
-        // Get AppEngine through TrackListComponent to access clips
-        for (int i = 0; i < trackComp->getNumChildComponents(); ++i)
-        {
-            if (auto* otherClipUI = dynamic_cast<TrackClip*> (trackComp->getChildComponent (i)))
-            {
-                if (otherClipUI == this)
-                    continue; // Skip self
-
-                auto* otherClip = otherClipUI->getMidiClip();
-                if (!otherClip)
-                    continue;
-
-                const auto otherStart = otherClip->getPosition().getStart();
-                const double otherStartBeats = tempoSeq.toBeats (otherStart).inBeats();
-
-                // Check if this clip starts after our clip
-                if (otherStartBeats > clipStartBeats)
-                    nearestClipStartBeats = std::min (nearestClipStartBeats, otherStartBeats);
-            }
-        }
+        const double clipStartBeats = tempoMap.toBeats (clipStart).inBeats();
 
         // If we found a clip that would be overlapped, constrain the resize
-        if (nearestClipStartBeats < std::numeric_limits<double>::max())
+        if (const auto nextClipStart = trackComp->getNextClipStart (*clip))
         {
-            const double maxAllowedLengthBeats = nearestClipStartBeats - clipStartBeats;
+            const double maxAllowedLengthBeats = tempoMap.toBeats (*nextClipStart).inBeats() - clipStartBeats;
             if (finalLengthBeats > maxAllowedLengthBeats)
             {
                 // Constrain to just before the next clip, quantized
@@ -178,13 +159,13 @@ void TrackClip::onResizeEnd()
         }
     }
 
-    // Convert beats to TimeDuration using tempo sequence
+    // Convert beats to TimeDuration using the tempo map
     const auto clipStart = clip->getPosition().getStart();
-    const double clipStartBeats = tempoSeq.toBeats (clipStart).inBeats();
+    const double clipStartBeats = tempoMap.toBeats (clipStart).inBeats();
     const double clipEndBeats = clipStartBeats + finalLengthBeats;
 
-    const auto startTime = tempoSeq.toTime (t::BeatPosition::fromBeats (clipStartBeats));
-    const auto endTime = tempoSeq.toTime (t::BeatPosition::fromBeats (clipEndBeats));
+    const auto startTime = tempoMap.toTime (t::BeatPosition::fromBeats (clipStartBeats));
+    const auto endTime = tempoMap.toTime (t::BeatPosition::fromBeats (clipEndBeats));
     const auto finalDuration = endTime - startTime;
 
     // Update the model - preserveSync=true prevents offset adjustment (Written by Claude Code)
@@ -194,8 +175,8 @@ void TrackClip::onResizeEnd()
     // Update only the width from the model, using the same calculation as TrackComponent::resized()
     // This preserves the X position and avoids visual "jump"
     const auto posRange = clip->getPosition().time;
-    const double actualStartBeats = tempoSeq.toBeats (posRange.getStart()).inBeats();
-    const double actualEndBeats = tempoSeq.toBeats (posRange.getEnd()).inBeats();
+    const double actualStartBeats = tempoMap.toBeats (posRange.getStart()).inBeats();
+    const double actualEndBeats = tempoMap.toBeats (posRange.getEnd()).inBeats();
     const double actualLengthBeats = actualEndBeats - actualStartBeats;
     const int correctWidth = static_cast<int> (juce::roundToIntAccurate (actualLengthBeats * ppb));
 
@@ -231,36 +212,13 @@ void TrackClip::quantizeWidth (juce::Rectangle<int>& bounds)
     auto* trackComp = findParentComponentOfClass<TrackComponent>();
     if (trackComp && clip)
     {
-        auto& tempoSeq = clip->edit.tempoSequence;
         const auto clipStart = clip->getPosition().getStart();
-        const double clipStartBeats = tempoSeq.toBeats (clipStart).inBeats();
+        const double clipStartBeats = tempoMap.toBeats (clipStart).inBeats();
 
-        // Find the nearest clip that starts after this one
-        double nearestClipStartBeats = std::numeric_limits<double>::max();
-
-        for (int i = 0; i < trackComp->getNumChildComponents(); ++i)
+        // Constrain to not overlap adjacent clip (called for every mouse move: an index lookup)
+        if (const auto nextClipStart = trackComp->getNextClipStart (*clip))
         {
-            if (auto* otherClipUI = dynamic_cast<TrackClip*> (trackComp->getChildComponent (i)))
-            {
-                if (otherClipUI == this)
-                    continue;
-
-                auto* otherClip = otherClipUI->getMidiClip();
-                if (!otherClip)
-                    continue;
-
-                const auto otherStart = otherClip->getPosition().getStart();
-                const double otherStartBeats = tempoSeq.toBeats (otherStart).inBeats();
-
-                if (otherStartBeats > clipStartBeats)
-                    nearestClipStartBeats = std::min (nearestClipStartBeats, otherStartBeats);
-            }
-        }
-
-        // Constrain to not overlap adjacent clip
-        if (nearestClipStartBeats < std::numeric_limits<double>::max())
-        {
-            const double maxAllowedLengthBeats = nearestClipStartBeats - clipStartBeats;
+            const double maxAllowedLengthBeats = tempoMap.toBeats (*nextClipStart).inBeats() - clipStartBeats;
             if (finalLengthBeats > maxAllowedLengthBeats)
             {
                 const double constrainedLengthBeats = std::floor (maxAllowedLengthBeats / gridSize) * gridSize;
@@ -295,11 +253,10 @@ t::TimePosition TrackClip::mouseToTime (const juce::MouseEvent& e)
     // Calculate click position in beats
     const double clickBeats = viewStartBeats + (static_cast<double> (timelineX) / ppb);
 
-    // Convert beats to TimePosition using tempo sequence
+    // Convert beats to TimePosition using the tempo map
     if (clip)
     {
-        auto& tempoSeq = clip->edit.tempoSequence;
-        return tempoSeq.toTime (t::BeatPosition::fromBeats (clickBeats));
+        return tempoMap.toTime (t::BeatPosition::fromBeats (clickBeats));
     }
 
     return t::TimePosition::fromSeconds (0.0);
@@ -314,15 +271,8 @@ int TrackClip::mouseToTrackIndex (const juce::MouseEvent& e)
     // Convert event to TrackListComponent coordinates
     auto eventInTrackList = e.getEventRelativeTo (tl);
 
-    // Account for timeline height at top
-    constexpr int timelineHeight = 24;
-    constexpr int trackHeight = 125;
-
-    const int y = eventInTrackList.y - timelineHeight;
-    if (y < 0)
-        return -1;
-
-    return y / trackHeight;
+    // Rows vary in height with their automation lanes
+    return tl->getTrackIndexAtY (eventInTrackList.y);
 }
 
 t::TimePosition TrackClip::quantizeToGrid (t::TimePosition time, double gridSize)
@@ -330,10 +280,9 @@ t::TimePosition TrackClip::quantizeToGrid (t::TimePosition time, double gridSize
     // Quantize in beats for musical grid alignment (Written by Claude Code)
     if (clip)
     {
-        auto& tempoSeq = clip->edit.tempoSequence;
-        const double beats = tempoSeq.toBeats (time).inBeats();
+        const double beats = tempoMap.toBeats (time).inBeats();
         const double quantizedBeats = std::round (beats / gridSize) * gridSize;
-        return tempoSeq.toTime (t::BeatPosition::fromBeats (juce::jmax (0.0, quantizedBeats)));
+        return tempoMap.toTime (t::BeatPosition::fromBeats (juce::jmax (0.0, quantizedBeats)));
     }
 
     // Fallback if no clip available
@@ -368,13 +317,12 @@ void TrackClip::mouseDown (const juce::MouseEvent& e)
         const int clickXInClip = e.getPosition().x; // X position relative to clip
         const double clickOffsetBeats = static_cast<double> (clickXInClip) / ppb;
 
-        // Convert beats to TimeDuration using tempo sequence
-        auto& tempoSeq = clip->edit.tempoSequence;
+        // Convert beats to TimeDuration using the tempo map
         const auto clipStartTime = clip->getPosition().getStart();
-        const double clipStartBeats = tempoSeq.toBeats (clipStartTime).inBeats();
+        const double clipStartBeats = tempoMap.toBeats (clipStartTime).inBeats();
         const double clickBeats = clipStartBeats + clickOffsetBeats;
 
-        const auto clickTime = tempoSeq.toTime (t::BeatPosition::fromBeats (clickBeats));
+        const auto clickTime = tempoMap.toTime (t::BeatPosition::fromBeats (clickBeats));
         clickOffsetFromStart = clickTime - clipStartTime;
     }
 
@@ -519,4 +467,28 @@ void TrackClip::valueTreePropertyChanged (juce::ValueTree& tree, const juce::Ide
                 safeThis->updateSizeFromClip();
         });
     }
+
+    contentChanged();
+}
+
+void TrackClip::valueTreeChildAdded (juce::ValueTree&, juce::ValueTree&)          { contentChanged(); }
+void TrackClip::valueTreeChildRemoved (juce::ValueTree&, juce::ValueTree&, int)   { contentChanged(); }
+
+void TrackClip::contentChanged()
+{
+    // A piano roll edit changes many notes at once: report them together
+    if (contentChangePending)
+        return;
+
+    contentChangePending = true;
+
+    juce::Component::SafePointer<TrackClip> safeThis (this);
+    juce::MessageManager::callAsync ([safeThis] {
+        if (safeThis == nullptr)
+            return;
+
+        safeThis->contentChangePending = false;
+        if (safeThis->onContentChanged)
+            safeThis->onContentChanged();
+    });
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <juce_gui_basics/juce_gui_basics.h>
 #include <tracktion_engine/tracktion_engine.h>
 #include "tracktion_graph/tracktion_graph.h"
+#include "../../MIDIEngine/TempoMap.h"
 #include <functional>
 
 namespace te = tracktion::engine;
@@ -11,7 +12,7 @@ namespace t = tracktion;
 class TrackClip final : public juce::Component, private juce::ValueTree::Listener
 {
 public:
-    explicit TrackClip(te::MidiClip* clip, float pixelsPerBeat);
+    TrackClip(te::MidiClip* clip, float pixelsPerBeat, const TempoMap& tempoMap);
     ~TrackClip() override;
 
     void paint (juce::Graphics& g) override;
@@ -19,6 +20,8 @@ public:
 
     void setColor (juce::Colour newColor);
     void valueTreePropertyChanged (juce::ValueTree& tree, const juce::Identifier& property) override;
+    void valueTreeChildAdded (juce::ValueTree& parent, juce::ValueTree& child) override;
+    void valueTreeChildRemoved (juce::ValueTree& parent, juce::ValueTree& child, int index) override;
     void setPixelsPerBeat (float ppb);
     void setBeingEdited (bool edited); // Highlight clip when being edited in piano roll (Written by Claude Code)
 
@@ -32,6 +35,8 @@ public:
     std::function<void(te::MidiClip*)> onDeleteRequested;
     // Request the parent TrackComponent to show a context menu for this clip at the given beat position
     std::function<void(te::MidiClip*)> onContextMenuRequested;
+    // The clip's notes, name or length changed: the track's tiles repaint it
+    std::function<void()> onContentChanged;
 
     // Drag callbacks - Written by Claude Code
     std::function<void(int targetTrack, t::TimePosition time, t::TimeDuration length, bool isValid)> onDragUpdate;
@@ -44,6 +49,7 @@ public:
 
 private:
     void updateSizeFromClip();
+    void contentChanged();
     void onResizeEnd();
     void quantizeWidth (juce::Rectangle<int>& bounds); // Live quantization during resize (Written by Claude Code)
 
@@ -75,6 +81,7 @@ private:
             // Apply live quantization when resizing right edge (Written by Claude Code)
             if (isStretchingRight)
             {
+                trackClip.isResizing = true;
                 trackClip.quantizeWidth (bounds);
             }
         }
@@ -89,6 +96,7 @@ private:
     };
 
     te::MidiClip* clip = nullptr; // not owned
+    const TempoMap& tempoMap; // beat/time conversion for the clip's edit (not owned)
     float pixelsPerBeat = 100.0f;
     juce::Colour clipColor { juce::Colours::blueviolet };
 
@@ -107,5 +115,8 @@ private:
     // Piano roll editing state - Written by Claude Code
     bool isBeingEdited = false; // True when this clip is open in piano roll
 
+    bool isResizing = false; // Right edge being dragged: paints its own body until the tiles catch up
+    bool contentChangePending = false;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TrackClip)
 };
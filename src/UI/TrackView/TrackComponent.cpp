@@ -1,6 +1,8 @@
 #include "TrackComponent.h"
 #include "TrackEditView.h"
 #include "TrackListComponent.h"
+#include "MacroKnobsComponent.h"
+#include <algorithm>
 #include <limits> // For std::numeric_limits (Written by Claude Code)
 
 namespace t = tracktion;
@@ -41,25 +43,35 @@ TrackComponent::~TrackComponent()
 
 void TrackComponent::paint (juce::Graphics& g)
 {
-    const auto r = getLocalBounds().toFloat().reduced (1.0f);
-    constexpr float radius = 10.0f;
+    if (lane == nullptr)
+        return;
 
-    // Background - add red tint if this track is armed and recording
-    auto bgColor = trackColor.darker (0.4f);
+    const bool isRecordingHere = appEngine && appEngine->isRecording() &&
+                                 appEngine->getArmedTrackIndex() == trackIndex;
 
-    if (appEngine && appEngine->isRecording() &&
-        appEngine->getArmedTrackIndex() == trackIndex)
+    // Background, border and clip coverage come from tiles rendered off the message thread
+    if (auto* tl = findParentComponentOfClass<TrackListComponent>(); tl != nullptr && ! isRecordingHere)
     {
-        // Blend with red to indicate active recording on this track
-        bgColor = bgColor.interpolatedWith(juce::Colours::darkred, 0.3f);
+        // The viewport's area decides which columns get rendered ahead of a scroll
+        auto visible = getLocalBounds();
+        if (auto* viewport = tl->findParentComponentOfClass<juce::Viewport>(); viewport != nullptr && viewport->getViewedComponent() != nullptr)
+            visible = getLocalArea (viewport->getViewedComponent(), viewport->getViewArea()).getIntersection (visible);
+
+        tl->getTileCache().draw (g, trackIndex, lane, visible);
+        return;
     }
 
-    g.setColour (bgColor);
-    g.fillRoundedRectangle (r, radius);
+    // Background - add red tint if this track is armed and recording. The preview
+    // changes every frame while recording, so this lane is painted directly.
+    auto bgColor = lane->background;
+
+    if (isRecordingHere)
+        bgColor = bgColor.interpolatedWith(juce::Colours::darkred, 0.3f);
+
+    ArrangementTileCache::paintLane (g, *lane, bgColor);
 
     // Draw recording preview clip if this track is being recorded to
-    if (appEngine && appEngine->isRecording() &&
-        appEngine->getArmedTrackIndex() == trackIndex)
+    if (isRecordingHere)
     {
         auto previewBounds = appEngine->getRecordingPreviewBounds();
         if (!previewBounds.isEmpty())
@@ -70,11 +82,11 @@ void TrackComponent::paint (juce::Graphics& g)
             {
                 const double pixelsPerBeat = tl->getPixelsPerBeat();
                 const double viewStartBeats = tl->getViewStartBeat().inBeats();
-                auto& tempoSeq = appEngine->getEdit().tempoSequence;
+                const auto& tempoMap = appEngine->getTempoMap();
 
                 // Convert preview time range to beat positions
-                const double clipStartBeats = tempoSeq.toBeats(previewBounds.getStart()).inBeats();
-                const double clipEndBeats = tempoSeq.toBeats(previewBounds.getEnd()).inBeats();
+                const double clipStartBeats = tempoMap.toBeats(previewBounds.getStart()).inBeats();
+                const double clipEndBeats = tempoMap.toBeats(previewBounds.getEnd()).inBeats();
                 const double clipLenBeats = clipEndBeats - clipStartBeats;
 
                 // Calculate preview clip position and size
@@ -96,10 +108,6 @@ void TrackComponent::paint (juce::Graphics& g)
             }
         }
     }
-
-    // Rounded border
-    g.setColour (juce::Colours::white.withAlpha (0.35f));
-    g.drawRoundedRectangle (r, radius, 1.0f);
 }
 
 void TrackComponent::resized()
@@ -107,40 +115,218 @@ void TrackComponent::resized()
     const auto bounds = getLocalBounds().reduced (5);
 
     if (!appEngine)
+    {
+        updateLane();
         return;
+    }
 
     // Access the beat-based scaling info through the parent TrackListComponent
     auto* tl = findParentComponentOfClass<TrackListComponent>();
     const double pixelsPerBeat = tl ? tl->getPixelsPerBeat() : 100.0;
     const double viewStartBeats = tl ? tl->getViewStartBeat().inBeats() : 0.0;
 
-    auto& tempoSeq = appEngine->getEdit().tempoSequence;
+    // Coverage strips are painted from the same spans, so refresh all of them
+    updateClipSpanBeats();
+    updateLane();
 
-    for (auto* ui : clipUIs)
+    for (const auto& span : clipSpans)
     {
-        auto* midiClip = ui->getMidiClip();
-        if (!midiClip)
+        if (span.component == nullptr)
             continue;
 
-        const auto posRange = midiClip->getPosition().time;
-        t::TimeRange drawRange = posRange;
+        const double clipLenBeats = span.endBeat - span.startBeat;
+
+        const int x = (int) juce::roundToIntAccurate ((span.startBeat - viewStartBeats) * pixelsPerBeat);
+        const int w = (int) juce::roundToIntAccurate (clipLenBeats * pixelsPerBeat);
+
+        span.component->setBounds (x, bounds.getY(), juce::jmax (w, minClipComponentWidth), bounds.getHeight());
+    }
+}
+
+void TrackComponent::parentHierarchyChanged()
+{
+    // The constructor built the clips before this track knew the list's zoom
+    if (appEngine && findParentComponentOfClass<TrackListComponent>() != nullptr && needsClipComponentsRebuild())
+        rebuildClipsFromEngine();
+}
+
+void TrackComponent::setPixelsPerBeat (const double ppb)
+{
+    pixelsPerBeat = ppb;
+
+    if (needsClipComponentsRebuild())
+    {
+        rebuildClipsFromEngine();
+
+        // Rebuilt components start without the piano roll highlight
+        if (auto* parent = findParentComponentOfClass<TrackEditView>())
+            parent->refreshClipEditState();
+    }
+    else
+    {
+        resized();
+    }
+
+    repaint();
+}
+
+//==============================================================================
+// Level of detail
+
+void TrackComponent::collectClipSpans()
+{
+    clipSpans.clear();
+
+    if (appEngine->isAudioTrack (trackIndex))
+        for (auto* ac : appEngine->getAudioClipsFromTrack (trackIndex))
+            clipSpans.push_back ({ ac });
+
+    for (auto* mc : appEngine->getMidiClipsFromTrack (trackIndex))
+        clipSpans.push_back ({ mc });
+
+    updateClipSpanBeats();
+
+    std::sort (clipSpans.begin(), clipSpans.end(),
+               [] (const ClipSpan& a, const ClipSpan& b) { return a.startBeat < b.startBeat; });
+}
+
+void TrackComponent::updateClipSpanBeats()
+{
+    std::vector<double> edgeSeconds;
+    edgeSeconds.reserve (clipSpans.size() * 2);
+
+    for (const auto& span : clipSpans)
+    {
+        auto drawRange = span.clip->getPosition().time;
+
+        // A looping MIDI clip is drawn one loop long
+        if (auto* midiClip = dynamic_cast<te::MidiClip*> (span.clip); midiClip && midiClip->isLooping())
+            drawRange = t::TimeRange (drawRange.getStart(), drawRange.getStart() + midiClip->getLoopRange().getLength());
+
+        edgeSeconds.push_back (drawRange.getStart().inSeconds());
+        edgeSeconds.push_back (drawRange.getEnd().inSeconds());
+    }
+
+    std::vector<double> edgeBeats (edgeSeconds.size());
+    appEngine->getTempoMap().secondsToBeats (edgeSeconds.data(), edgeBeats.data(), edgeSeconds.size());
+
+    for (size_t i = 0; i < clipSpans.size(); ++i)
+    {
+        clipSpans[i].startBeat = edgeBeats[i * 2];
+        clipSpans[i].endBeat = edgeBeats[i * 2 + 1];
+    }
+}
+
+bool TrackComponent::needsClipComponentsRebuild() const
+{
+    auto* tl = findParentComponentOfClass<TrackListComponent>();
+    const double ppb = tl ? tl->getPixelsPerBeat() : 100.0;
+
+    return std::any_of (clipSpans.begin(), clipSpans.end(), [ppb] (const ClipSpan& span)
+    {
+        return isWideEnough (span, ppb) != (span.component != nullptr);
+    });
+}
+
+void TrackComponent::updateLane()
+{
+    auto* tl = findParentComponentOfClass<TrackListComponent>();
+    const double pixelsPerBeat = tl ? tl->getPixelsPerBeat() : 100.0;
+    const double viewStartBeats = tl ? tl->getViewStartBeat().inBeats() : 0.0;
+
+    auto next = std::make_shared<ArrangementTileCache::Lane>();
+    next->width = getWidth();
+    next->height = getHeight();
+    next->background = trackColor.darker (0.4f);
+    next->clipColour = trackColor;
 
-        if (midiClip->isLooping())
+    // Spans are sorted by start, so clips landing on the same pixels merge into one strip
+    for (const auto& span : clipSpans)
+    {
+        if (span.component != nullptr)
         {
-            const auto loopRange = midiClip->getLoopRange();
-            drawRange = t::TimeRange(posRange.getStart(), posRange.getStart() + loopRange.getLength());
+            next->clips.push_back (describeClip (span, pixelsPerBeat, viewStartBeats));
+            continue;
         }
 
-        // Convert time positions to beat positions for layout
-        const double clipStartBeats = tempoSeq.toBeats(drawRange.getStart()).inBeats();
-        const double clipEndBeats = tempoSeq.toBeats(drawRange.getEnd()).inBeats();
-        const double clipLenBeats = clipEndBeats - clipStartBeats;
+        const int x0 = (int) std::floor ((span.startBeat - viewStartBeats) * pixelsPerBeat);
+        const int x1 = juce::jmax (x0 + 1, (int) std::ceil ((span.endBeat - viewStartBeats) * pixelsPerBeat));
 
-        const int x = (int) juce::roundToIntAccurate ((clipStartBeats - viewStartBeats) * pixelsPerBeat);
-        const int w = (int) juce::roundToIntAccurate (clipLenBeats * pixelsPerBeat);
+        if (! next->strips.empty() && x0 <= next->strips.back().getEnd())
+            next->strips.back().setEnd (juce::jmax (next->strips.back().getEnd(), x1));
+        else
+            next->strips.push_back ({ x0, x1 });
+    }
+
+    // Same pixels: keep the version, and with it the tiles already rendered
+    if (lane != nullptr && lane->hasSameContent (*next))
+        return;
+
+    next->version = ArrangementTileCache::nextVersion();
+    lane = std::move (next);
+    repaint();
+}
+
+void TrackComponent::clipContentChanged()
+{
+    updateClipSpanBeats();
+    updateLane();
+}
+
+ArrangementTileCache::Clip TrackComponent::describeClip (const ClipSpan& span, const double pixelsPerBeat,
+                                                        const double viewStartBeats) const
+{
+    ArrangementTileCache::Clip c;
+
+    // Same placement as the clip's component (resized())
+    const int x = (int) juce::roundToIntAccurate ((span.startBeat - viewStartBeats) * pixelsPerBeat);
+    const int w = juce::jmax ((int) juce::roundToIntAccurate ((span.endBeat - span.startBeat) * pixelsPerBeat),
+                              minClipComponentWidth);
+    c.x = { x, x + w };
+    c.name = span.clip->getName();
+
+    if (auto* audio = dynamic_cast<AudioClipComponent*> (span.component))
+    {
+        c.isAudio = true;
+        c.warped = audio->getAudioClip()->getAutoTempo();
+        c.peaks = audio->getPeaks (juce::jmax (0, w - 8));
+        return c;
+    }
+
+    auto* midiClip = dynamic_cast<te::MidiClip*> (span.clip);
+    if (midiClip == nullptr)
+        return c;
+
+    const auto& notes = midiClip->getSequence().getNotes();
+    if (notes.isEmpty())
+        return c;
+
+    int lowest = 127, highest = 0;
+    for (auto* n : notes)
+    {
+        lowest = juce::jmin (lowest, n->getNoteNumber());
+        highest = juce::jmax (highest, n->getNoteNumber());
+    }
+
+    // Pitch span padded so a single note sits mid-clip
+    const float rows = (float) (highest - lowest + 1) + 2.0f;
+    const double contentStart = midiClip->isLooping() ? midiClip->getLoopStartBeats().inBeats()
+                                                      : midiClip->getOffsetInBeats().inBeats();
+    const double clipLength = span.endBeat - span.startBeat;
+
+    for (auto* n : notes)
+    {
+        const double start = n->getStartBeat().inBeats() - contentStart;
+        const double end = juce::jmin (start + n->getLengthBeats().inBeats(), clipLength);
+        if (end <= 0.0 || start >= clipLength)
+            continue;
 
-        ui->setBounds (x, bounds.getY(), juce::jmax (w, 20), bounds.getHeight());
+        const float left = (float) (x + juce::jmax (0.0, start) * pixelsPerBeat);
+        const float right = (float) (x + end * pixelsPerBeat);
+        c.notes.push_back ({ left, (float) (highest - n->getNoteNumber() + 1) / rows, right - left, 1.0f / rows });
     }
+
+    return c;
 }
 
 void TrackComponent::onInstrumentClicked()
@@ -155,17 +341,51 @@ void TrackComponent::onInstrumentClicked()
         return;
     }
 
+    // Audio tracks have no instrument
+    if (appEngine->isAudioTrack (trackIndex))
+        return;
+
     appEngine->openInstrumentEditor (trackIndex);
 }
 
 void TrackComponent::onInstrumentMenuRequested()
 {
-    if (appEngine)
+    if (appEngine && !appEngine->isAudioTrack (trackIndex))
         appEngine->showInstrumentChooser (trackIndex);
 }
 
 void TrackComponent::onSettingsClicked()
 {
+    if (appEngine && appEngine->isAudioTrack (trackIndex))
+    {
+        juce::PopupMenu m;
+        m.addItem (1, "Import Audio...");
+        m.addSeparator();
+        m.addItem (100, "Delete Track");
+
+        m.showMenuAsync ({}, [safeThis = juce::Component::SafePointer<TrackComponent> (this)] (int result)
+        {
+            if (safeThis == nullptr || safeThis->appEngine == nullptr)
+                return;
+
+            if (result == 1)
+            {
+                // Place after the last clip on the track
+                auto destStart = t::TimePosition::fromSeconds (0.0);
+                for (auto* ac : safeThis->appEngine->getAudioClipsFromTrack (safeThis->trackIndex))
+                    destStart = std::max (destStart, ac->getPosition().getEnd());
+
+                safeThis->appEngine->importAudioClipViaChooser (safeThis->trackIndex, destStart,
+                    [safeThis] { if (safeThis != nullptr) safeThis->rebuildAndRefreshHighlight(); });
+            }
+            else if (result == 100 && safeThis->onRequestDeleteTrack)
+            {
+                safeThis->onRequestDeleteTrack (safeThis->trackIndex);
+            }
+        });
+        return;
+    }
+
     juce::PopupMenu m;
     m.addItem (1, "Add MIDI Clip");
 
@@ -176,11 +396,86 @@ void TrackComponent::onSettingsClicked()
     m.addSeparator();
     m.addItem (3, "Import MIDI Clip");
     m.addSeparator();
+    m.addItem (4, "MIDI Effect...");
+
+    // Automation lanes for the instrument's parameters
+    juce::ReferenceCountedArray<te::AutomatableParameter> automatable;
+    {
+        auto* tl = findParentComponentOfClass<TrackListComponent>();
+        const auto* shown = tl ? tl->getAutomationLaneParameter (trackIndex) : nullptr;
+
+        juce::PopupMenu automationMenu;
+        if (auto* instrument = appEngine ? appEngine->getTrackManager().getInstrumentPluginOnTrack (trackIndex) : nullptr)
+        {
+            for (auto* param : instrument->getAutomatableParameters())
+            {
+                automationMenu.addItem (automationMenuBase + automatable.size(), param->getParameterName(),
+                                        true, param == shown);
+                automatable.add (param);
+            }
+        }
+
+        automationMenu.addSeparator();
+        automationMenu.addItem (automationMenuBase - 1, "Hide Automation", shown != nullptr);
+        m.addSubMenu ("Automation", automationMenu, ! automatable.isEmpty());
+
+        // Macros: one submenu of the same parameters per knob, ticked where assigned.
+        // Their ids follow the automation ids, sized by the parameter count so none overlap.
+        const int macroMenuBase = automationMenuBase + automatable.size();
+        juce::PopupMenu macroMenu;
+        macroMenu.addItem (5, "Macro Knobs...");
+        macroMenu.addSeparator();
+
+        if (appEngine)
+        {
+            auto& macros = appEngine->getMacroControls();
+
+            for (int macro = 0; macro < MacroControls::numMacros; ++macro)
+            {
+                juce::PopupMenu targets;
+                for (int i = 0; i < automatable.size(); ++i)
+                    targets.addItem (macroMenuBase + macro * automatable.size() + i, automatable[i]->getParameterName(),
+                                     true, macros.isAssigned (trackIndex, macro, *automatable[i]));
+
+                macroMenu.addSubMenu ("Macro " + juce::String (macro + 1), targets, ! automatable.isEmpty());
+            }
+        }
+
+        m.addSubMenu ("Macros", macroMenu);
+    }
 
     m.addSeparator();
     m.addItem (100, "Delete Track");
 
-    m.showMenuAsync ({}, [this] (const int result) {
+    m.showMenuAsync ({}, [this, automatable] (const int result) {
+        if (result >= automationMenuBase - 1 && result < automationMenuBase + automatable.size())
+        {
+            // The item before the parameters hides the lane
+            if (onRequestShowAutomation)
+                onRequestShowAutomation (trackIndex, result >= automationMenuBase ? automatable[result - automationMenuBase].get()
+                                                                                  : nullptr);
+            return;
+        }
+
+        const int numParams = automatable.size();
+        const int macroMenuBase = automationMenuBase + numParams;
+
+        if (numParams > 0 && result >= macroMenuBase && result < macroMenuBase + MacroControls::numMacros * numParams
+            && appEngine)
+        {
+            // Toggles the parameter's assignment to that macro
+            const int macro = (result - macroMenuBase) / numParams;
+            if (auto* param = automatable[(result - macroMenuBase) % numParams].get())
+            {
+                auto& macros = appEngine->getMacroControls();
+                if (macros.isAssigned (trackIndex, macro, *param))
+                    macros.unassign (trackIndex, macro, *param);
+                else
+                    macros.assign (trackIndex, macro, *param);
+            }
+            return;
+        }
+
         switch (result)
         {
             case 1: // Add Clip
@@ -228,6 +523,15 @@ void TrackComponent::onSettingsClicked()
                 }
                 break;
             }
+            case 4: // Arpeggiator / chord / note repeat
+                if (appEngine)
+                    appEngine->showMidiFxMenu (trackIndex);
+                break;
+            case 5: // Macro Knobs
+                if (appEngine)
+                    juce::CallOutBox::launchAsynchronously (std::make_unique<MacroKnobsComponent> (*appEngine, trackIndex),
+                                                            getScreenBounds(), nullptr);
+                break;
             case 10: // Open Drum Sampler
                 if (onRequestOpenDrumSampler)
                     onRequestOpenDrumSampler (trackIndex);
@@ -257,6 +561,12 @@ int TrackComponent::getTrackIndex() const
     return trackIndex;
 }
 
+std::optional<t::TimePosition> TrackComponent::getNextClipStart (const te::Clip& clip) const
+{
+    return appEngine ? appEngine->getNextClipStart (trackIndex, clip.getPosition().getStart(), &clip)
+                     : std::nullopt;
+}
+
 void TrackComponent::onMuteToggled (const bool isMuted)
 {
     if (appEngine)
@@ -281,15 +591,30 @@ void TrackComponent::rebuildClipsFromEngine()
 {
     // Remove existing UI clips
     clipUIs.clear();
+    audioClipUIs.clear();
+    clipSpans.clear();
 
     if (!appEngine)
         return;
 
-    auto clips = appEngine->getMidiClipsFromTrack (trackIndex);
-    for (auto* mc : clips)
+    collectClipSpans();
+
+    // Only clips wide enough to grab at this zoom get components; paint() covers the rest
+    auto* tl = findParentComponentOfClass<TrackListComponent>();
+    const double ppb = tl ? tl->getPixelsPerBeat() : 100.0;
+
+    if (appEngine->isAudioTrack (trackIndex))
+        rebuildAudioClips (ppb);
+
+    for (auto& span : clipSpans)
     {
-        auto ui = std::make_unique<TrackClip> (mc, pixelsPerBeat);
+        auto* mc = dynamic_cast<te::MidiClip*> (span.clip);
+        if (mc == nullptr || ! isWideEnough (span, ppb))
+            continue;
+
+        auto ui = std::make_unique<TrackClip> (mc, pixelsPerBeat, appEngine->getTempoMap());
         ui->setColor (trackColor);
+        ui->onContentChanged = [this] { clipContentChanged(); };
 
         // Existing open piano roll callback
         ui->onClicked = [this] (te::MidiClip* c) {
@@ -346,6 +671,9 @@ void TrackComponent::rebuildClipsFromEngine()
             m.addItem (1, "Copy");
             m.addItem (2, "Duplicate");
             m.addSeparator();
+            m.addItem (4, "Quantize (1/16)");
+            m.addItem (5, "Extract Groove");
+            m.addSeparator();
             m.addItem (3, "Delete");
 
             m.showMenuAsync ({}, [safeThis = juce::Component::SafePointer<TrackComponent> (this), clip = c] (int result) {
@@ -361,6 +689,13 @@ void TrackComponent::rebuildClipsFromEngine()
                         safeThis->appEngine->duplicateMidiClip (clip);
                         safeThis->rebuildAndRefreshHighlight();
                         break;
+                    case 4: // Quantize whole clip to the 1/16 grid
+                        safeThis->appEngine->quantizeMidiClips ({ clip }, {});
+                        safeThis->rebuildAndRefreshHighlight();
+                        break;
+                    case 5: // Use this clip's timing as the groove template
+                        safeThis->appEngine->extractGrooveFromClip (*clip);
+                        break;
                     case 3: // Delete
                     {
                         if (auto* parent = safeThis->findParentComponentOfClass<TrackEditView>())
@@ -457,20 +792,22 @@ void TrackComponent::rebuildClipsFromEngine()
             }
         };
 
+        span.component = ui.get();
         addAndMakeVisible (ui.get());
         clipUIs.add (std::move (ui));
     }
 
-    // Extend TrackComponent length to fit all MIDI clips
+    // Extend TrackComponent length to fit all clips
     if (auto* list = findParentComponentOfClass<TrackListComponent>())
     {
         int rightmost = 0;
         // TrackComponent X is the left offset inside TrackList
         const int trackLeftInList = getX();
+        const double viewStartBeats = list->getViewStartBeat().inBeats();
 
-        for (auto* ui : clipUIs)
-            if (ui)
-                rightmost = std::max (rightmost, trackLeftInList + ui->getRight());
+        // Measured from the spans so clips painted as coverage count too
+        for (const auto& span : clipSpans)
+            rightmost = std::max (rightmost, trackLeftInList + (int) std::ceil ((span.endBeat - viewStartBeats) * ppb));
 
         // Account for the header column (same value used in TrackListComponent)
         constexpr int headerWidth = 140;
@@ -483,6 +820,124 @@ void TrackComponent::rebuildClipsFromEngine()
     resized(); // redraw
 }
 
+void TrackComponent::rebuildAudioClips (const double ppb)
+{
+    for (auto& span : clipSpans)
+    {
+        auto* ac = dynamic_cast<te::WaveAudioClip*> (span.clip);
+        if (ac == nullptr || ! isWideEnough (span, ppb))
+            continue;
+
+        auto ui = std::make_unique<AudioClipComponent> (*ac, appEngine->getThumbnailService());
+        ui->setColor (trackColor);
+        ui->onContentChanged = [this] { clipContentChanged(); };
+
+        ui->onMoveRequested = [this] (te::WaveAudioClip* clip, double newStartBeat) {
+            if (!appEngine || !clip)
+                return;
+
+            const auto& tempoMap = appEngine->getTempoMap();
+            const auto newStart = tempoMap.toTime (t::BeatPosition::fromBeats (newStartBeat));
+            const auto newRange = t::TimeRange (newStart, newStart + clip->getPosition().getLength());
+
+            if (!wouldAudioClipOverlap (newRange, clip))
+                clip->setStart (newStart, false, true); // preserveSync=false, keepLength=true
+
+            rebuildAndRefreshHighlight();
+        };
+
+        ui->onContextMenuRequested = [this] (te::WaveAudioClip* c) {
+            if (c == nullptr)
+                return;
+
+            const bool hasTempo = AudioClipEngine::getSourceBpm (*c) > 0.0;
+
+            juce::PopupMenu m;
+            m.addItem (1, hasTempo ? "Warp to Tempo" : "Warp to Tempo (file has no tempo)", hasTempo, c->getAutoTempo());
+            m.addItem (3, "Extract Groove");
+            m.addSeparator();
+            m.addItem (2, "Delete");
+
+            m.showMenuAsync ({}, [safeThis = juce::Component::SafePointer<TrackComponent> (this), clip = te::WaveAudioClip::Ptr (c)] (int result) {
+                if (safeThis == nullptr || safeThis->appEngine == nullptr)
+                    return;
+
+                switch (result)
+                {
+                    case 1:
+                        safeThis->appEngine->getAudioClipEngine().setWarpToTempo (*clip, ! clip->getAutoTempo());
+                        safeThis->rebuildAndRefreshHighlight();
+                        break;
+                    case 2:
+                        safeThis->appEngine->deleteAudioClip (clip.get());
+                        safeThis->rebuildAndRefreshHighlight();
+                        break;
+                    case 3:
+                        safeThis->appEngine->extractGrooveFromClip (*clip);
+                        break;
+                    default:
+                        break;
+                }
+            });
+        };
+
+        span.component = ui.get();
+        addAndMakeVisible (ui.get());
+        audioClipUIs.add (std::move (ui));
+    }
+}
+
+double TrackComponent::xToSnappedBeat (int x) const
+{
+    const auto inner = getLocalBounds().reduced (5);
+    const int localX = juce::jmax (0, x - inner.getX());
+
+    auto* tl = findParentComponentOfClass<TrackListComponent>();
+    const double pixelsPerBeat = tl ? tl->getPixelsPerBeat() : 100.0;
+    const double viewStartBeats = tl ? tl->getViewStartBeat().inBeats() : 0.0;
+
+    constexpr double gridSize = 0.25;
+    const double beats = viewStartBeats + (localX / juce::jmax (1.0, pixelsPerBeat));
+    return std::round (beats / gridSize) * gridSize;
+}
+
+bool TrackComponent::wouldAudioClipOverlap (t::TimeRange range, const te::WaveAudioClip* ignore) const
+{
+    return appEngine->wouldClipOverlap (trackIndex, range, ignore);
+}
+
+bool TrackComponent::isInterestedInFileDrag (const juce::StringArray& files)
+{
+    if (!appEngine || !appEngine->isAudioTrack (trackIndex))
+        return false;
+
+    for (const auto& f : files)
+        if (appEngine->getAudioClipEngine().canImport (juce::File (f)))
+            return true;
+
+    return false;
+}
+
+void TrackComponent::filesDropped (const juce::StringArray& files, int x, int)
+{
+    if (!appEngine || !appEngine->isAudioTrack (trackIndex))
+        return;
+
+    auto start = appEngine->getTempoMap().toTime (t::BeatPosition::fromBeats (xToSnappedBeat (x)));
+
+    for (const auto& path : files)
+    {
+        const juce::File file (path);
+        if (!appEngine->getAudioClipEngine().canImport (file))
+            continue;
+
+        if (auto* clip = appEngine->insertAudioClip (trackIndex, file, start))
+            start = clip->getPosition().getEnd();
+    }
+
+    rebuildAndRefreshHighlight();
+}
+
 void TrackComponent::updateClipEditedState (te::MidiClip* editedClip)
 {
     // Update visual state for all clips to show which one is being edited (Written by Claude Code)
@@ -515,6 +970,24 @@ void TrackComponent::mouseUp (const juce::MouseEvent& e)
     if (!e.mods.isPopupMenu() || e.originalComponent != this)
         return;
 
+    if (appEngine && appEngine->isAudioTrack (trackIndex))
+    {
+        const auto start = appEngine->getTempoMap().toTime (t::BeatPosition::fromBeats (xToSnappedBeat (e.getPosition().x)));
+
+        juce::PopupMenu m;
+        m.addItem (1, "Import Audio Here...");
+
+        m.showMenuAsync ({}, [safeThis = juce::Component::SafePointer<TrackComponent> (this), start] (int result)
+        {
+            if (safeThis == nullptr || safeThis->appEngine == nullptr || result != 1)
+                return;
+
+            safeThis->appEngine->importAudioClipViaChooser (safeThis->trackIndex, start,
+                [safeThis] { if (safeThis != nullptr) safeThis->rebuildAndRefreshHighlight(); });
+        });
+        return;
+    }
+
     // Compute start position from X using beat-based coordinates
     const auto inner = getLocalBounds().reduced (5);
     const int localX = juce::jmax (0, e.getPosition().x - inner.getX());
@@ -530,7 +1003,7 @@ void TrackComponent::mouseUp (const juce::MouseEvent& e)
     const double quantizedBeats = std::round (clickBeats / gridSize) * gridSize;
 
     // Convert quantized beats to TimePosition using tempo sequence (Written by Claude Code)
-    const t::TimePosition startPos = appEngine->getEdit().tempoSequence.toTime(t::BeatPosition::fromBeats(quantizedBeats));
+    const t::TimePosition startPos = appEngine->getTempoMap().toTime(t::BeatPosition::fromBeats(quantizedBeats));
 
     juce::PopupMenu m;
 
@@ -551,26 +1024,15 @@ void TrackComponent::mouseUp (const juce::MouseEvent& e)
             {
                 // Get clipboard clip length and check for overlap (Written by Claude Code)
                 const double clipLengthBeats = safeThis->appEngine->getClipboardClipLengthBeats();
-                const double pasteBeats = safeThis->appEngine->getEdit().tempoSequence.toBeats (startPos).inBeats();
+                const double pasteBeats = safeThis->appEngine->getTempoMap().toBeats (startPos).inBeats();
                 const double endBeats = pasteBeats + clipLengthBeats;
 
                 // Check if paste would overlap with existing clips
-                const auto pasteStartTime = safeThis->appEngine->getEdit().tempoSequence.toTime (t::BeatPosition::fromBeats (pasteBeats));
-                const auto pasteEndTime = safeThis->appEngine->getEdit().tempoSequence.toTime (t::BeatPosition::fromBeats (endBeats));
+                const auto pasteStartTime = safeThis->appEngine->getTempoMap().toTime (t::BeatPosition::fromBeats (pasteBeats));
+                const auto pasteEndTime = safeThis->appEngine->getTempoMap().toTime (t::BeatPosition::fromBeats (endBeats));
                 const t::TimeRange pasteRange (pasteStartTime, pasteEndTime);
 
-                // Check all clips on track for overlap
-                bool wouldOverlap = false;
-                auto clipsOnTrack = safeThis->appEngine->getMidiClipsFromTrack (safeThis->trackIndex);
-                for (auto* existingClip : clipsOnTrack)
-                {
-                    auto existingRange = existingClip->getPosition().time;
-                    if (pasteRange.overlaps (existingRange))
-                    {
-                        wouldOverlap = true;
-                        break;
-                    }
-                }
+                const bool wouldOverlap = safeThis->appEngine->wouldClipOverlap (safeThis->trackIndex, pasteRange);
 
                 // Only paste if no overlap
                 if (!wouldOverlap)
@@ -584,25 +1046,14 @@ void TrackComponent::mouseUp (const juce::MouseEvent& e)
             {
                 // Check for overlap before creating clip (Written by Claude Code)
                 const double clipLengthBeats = 4.0;
-                const auto startBeats = safeThis->appEngine->getEdit().tempoSequence.toBeats (startPos).inBeats();
+                const auto startBeats = safeThis->appEngine->getTempoMap().toBeats (startPos).inBeats();
                 const auto endBeats = startBeats + clipLengthBeats;
 
-                const auto clipStartTime = safeThis->appEngine->getEdit().tempoSequence.toTime (t::BeatPosition::fromBeats (startBeats));
-                const auto clipEndTime = safeThis->appEngine->getEdit().tempoSequence.toTime (t::BeatPosition::fromBeats (endBeats));
+                const auto clipStartTime = safeThis->appEngine->getTempoMap().toTime (t::BeatPosition::fromBeats (startBeats));
+                const auto clipEndTime = safeThis->appEngine->getTempoMap().toTime (t::BeatPosition::fromBeats (endBeats));
                 const t::TimeRange clipRange (clipStartTime, clipEndTime);
 
-                // Check all clips on track for overlap
-                bool wouldOverlap = false;
-                auto clipsOnTrack = safeThis->appEngine->getMidiClipsFromTrack (safeThis->trackIndex);
-                for (auto* existingClip : clipsOnTrack)
-                {
-                    auto existingRange = existingClip->getPosition().time;
-                    if (clipRange.overlaps (existingRange))
-                    {
-                        wouldOverlap = true;
-                        break;
-                    }
-                }
+                const bool wouldOverlap = safeThis->appEngine->wouldClipOverlap (safeThis->trackIndex, clipRange);
 
                 // Only create if no overlap
                 if (!wouldOverlap)
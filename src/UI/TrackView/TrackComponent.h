@@ -2,15 +2,18 @@
 
 #include "../../AppEngine/AppEngine.h"
 #include "TrackClip.h"
+#include "AudioClipComponent.h"
 #include "TrackHeaderComponent.h"
+#include "ArrangementTileCache.h"
 #include <juce_gui_basics/juce_gui_basics.h>
 namespace t = tracktion;
 
 /**
- * @brief Individual track lane displaying MIDI clips in horizontal timeline layout.
+ * @brief Individual track lane displaying MIDI or audio clips in horizontal timeline layout.
  *
  * TrackComponent represents a single track's visual lane in the track editor, containing
- * TrackClip UI components for each MIDI clip on that track. It acts as a listener for
+ * TrackClip UI components for each MIDI clip on that track, or AudioClipComponents on
+ * audio tracks (audio files can be dropped straight onto the lane). It acts as a listener for
  * TrackHeaderComponent button events (mute/solo/arm/delete) and propagates them to AppEngine.
  *
  * Architecture:
@@ -26,6 +29,14 @@ namespace t = tracktion;
  *  - Each TrackClip handles its own drag/resize interactions
  *  - Double-click on clip triggers piano roll editor via onRequestOpenPianoRoll callback
  *
+ * Level of Detail:
+ *  - Only clips at least minClipComponentWidth pixels wide get a TrackClip/AudioClipComponent
+ *  - Narrower clips are merged into coverage strips painted by the track in one pass, so a
+ *    zoomed-out song costs a handful of rectangles per track instead of hundreds of components
+ *  - The lane (background, border, coverage, and every clip's body, preview and name) is
+ *    described by a Lane snapshot and painted from tiles the list's ArrangementTileCache
+ *    renders on worker threads; clip components only paint interaction state on top
+ *
  * Coordinate System:
  *  - pixelsPerBeat: Horizontal zoom level (pixels per beat)
  *  - viewStartBeat: Horizontal scroll position (beat at left edge)
@@ -39,10 +50,13 @@ namespace t = tracktion;
  * Usage:
  *  - Created by TrackListComponent during rebuildFromEngine()
  *  - Call rebuildClipsFromEngine() when clips are added/removed/modified
- *  - Set callbacks (onRequestDeleteTrack, onRequestOpenPianoRoll, onRequestOpenDrumSampler)
+ *  - Set callbacks (onRequestDeleteTrack, onRequestOpenPianoRoll, onRequestOpenDrumSampler,
+ *    onRequestShowAutomation)
  *  - Update zoom via setPixelsPerBeat(), scroll via setViewStartBeat()
  */
-class TrackComponent final : public juce::Component, public TrackHeaderComponent::Listener
+class TrackComponent final : public juce::Component,
+                             public TrackHeaderComponent::Listener,
+                             public juce::FileDragAndDropTarget
 {
 public:
     //==============================================================================
@@ -122,6 +136,9 @@ public:
      */
     int getTrackIndex() const;
 
+    /** Start of the next clip on this track after @p clip, if any: how far @p clip can be resized. */
+    std::optional<t::TimePosition> getNextClipStart (const te::Clip& clip) const;
+
     //==============================================================================
     // Clip Management
 
@@ -129,7 +146,8 @@ public:
      * @brief Rebuilds all clip UI components from current engine state.
      *
      * Queries AppEngine for MIDI clips on this track, clears existing clip UI,
-     * and creates new TrackClip components. Uses immediate mode rendering pattern.
+     * and creates new TrackClip components for the clips wide enough to interact
+     * with at the current zoom. Uses immediate mode rendering pattern.
      * Call this whenever clips are added, removed, or modified.
      */
     void rebuildClipsFromEngine();
@@ -149,6 +167,7 @@ public:
 
     void paint (juce::Graphics& g) override;
     void resized() override;
+    void parentHierarchyChanged() override;
 
     /**
      * @brief Handles right-click to show track context menu.
@@ -157,19 +176,26 @@ public:
      */
     void mouseUp (const juce::MouseEvent& e) override;
 
+    //==============================================================================
+    // File Drag and Drop (audio tracks)
+
+    bool isInterestedInFileDrag (const juce::StringArray& files) override;
+
+    /** Places the dropped audio files one after another, starting at the drop beat. */
+    void filesDropped (const juce::StringArray& files, int x, int y) override;
+
     //==============================================================================
     // Zoom and Scroll
 
     /**
      * @brief Sets the horizontal zoom level.
      *
+     * Rebuilds the clip components when the zoom moves a clip across
+     * minClipComponentWidth (see clipSpans).
+     *
      * @param ppb Pixels per beat
      */
-    void setPixelsPerBeat (const double ppb)
-    {
-        pixelsPerBeat = ppb;
-        resized();
-    }
+    void setPixelsPerBeat (double ppb);
 
     /**
      * @brief Sets the horizontal scroll position.
@@ -188,6 +214,7 @@ public:
     std::function<void (int)> onRequestDeleteTrack; ///< Callback when user requests track deletion
     std::function<void (te::MidiClip* clip)> onRequestOpenPianoRoll; ///< Callback to open piano roll for clip
     std::function<void (int)> onRequestOpenDrumSampler; ///< Callback to open drum sampler editor
+    std::function<void (int, te::AutomatableParameter*)> onRequestShowAutomation; ///< Callback to show (or, with nullptr, hide) an automation lane
 
 private:
     //==============================================================================
@@ -200,6 +227,24 @@ private:
     int numClips = 0; ///< Cached clip count (updated during rebuild)
 
     juce::OwnedArray<TrackClip> clipUIs; ///< Owned array of clip UI components
+    juce::OwnedArray<AudioClipComponent> audioClipUIs; ///< Owned audio clip views (audio tracks only)
+
+    /** Narrowest clip, in pixels, that gets its own component; anything smaller is painted as coverage. */
+    static constexpr int minClipComponentWidth = 20;
+    /** Settings menu ids of the Automation submenu; the Macros submenus follow, one block per macro. */
+    static constexpr int automationMenuBase = 1000;
+
+    /** Where one clip sits on the lane, in beats. */
+    struct ClipSpan
+    {
+        te::Clip* clip = nullptr;
+        double startBeat = 0.0, endBeat = 0.0;
+        juce::Component* component = nullptr;   ///< Its TrackClip/AudioClipComponent, or nullptr if painted as coverage
+    };
+
+    std::vector<ClipSpan> clipSpans; ///< Every clip on the track, sorted by start (refreshed in resized())
+
+    std::shared_ptr<const ArrangementTileCache::Lane> lane; ///< What paint() draws under the clip components
 
     double pixelsPerBeat = 100.0; ///< Horizontal zoom level (pixels per beat)
     t::BeatPosition viewStartBeat = t::BeatPosition::fromBeats(0.0); ///< Horizontal scroll position (beat at left edge)
@@ -257,5 +302,38 @@ private:
      */
     void rebuildAndRefreshHighlight();
 
+    /** Creates the AudioClipComponents for an audio track's clips that are wide enough at @p ppb. */
+    void rebuildAudioClips (double ppb);
+
+    /** Collects every clip on the track into clipSpans, without components. */
+    void collectClipSpans();
+
+    /** Reconverts each span's clip position to beats, in one batched tempo pass. */
+    void updateClipSpanBeats();
+
+    /** True if a clip is wide enough at @p ppb to get its own component. */
+    static bool isWideEnough (const ClipSpan& span, double ppb) noexcept
+    {
+        return (span.endBeat - span.startBeat) * ppb >= minClipComponentWidth;
+    }
+
+    /** True if the current zoom disagrees with which clips have components. */
+    bool needsClipComponentsRebuild() const;
+
+    /** Rebuilds the lane snapshot the tiles are painted from; gives it a new version if anything changed. */
+    void updateLane();
+
+    /** A clip component's content changed (notes edited, waveform loaded): refreshes the lane. */
+    void clipContentChanged();
+
+    /** The tile content of a clip that has a component: placement, name and preview. */
+    ArrangementTileCache::Clip describeClip (const ClipSpan& span, double pixelsPerBeat, double viewStartBeats) const;
+
+    /** Beat under local x, snapped to the 1/4-beat clip grid. */
+    double xToSnappedBeat (int x) const;
+
+    /** True if @p range overlaps an audio clip on this track other than @p ignore. */
+    bool wouldAudioClipOverlap (t::TimeRange range, const te::WaveAudioClip* ignore) const;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TrackComponent)
 };
@@ -57,6 +57,13 @@ TrackEditView::TrackEditView (AppEngine& engine, TransportBar& transport, Groove
         trackList->setViewStartBeat(viewStartBeat);
         trackList->resized(); // Trigger layout update to position new track
     };
+    menuBar->onNewAudioTrack = [this] {
+        const int index = appEngine->addAudioTrack();
+        trackList->addNewTrack(index);
+        trackList->setPixelsPerBeat(pixelsPerBeat);
+        trackList->setViewStartBeat(viewStartBeat);
+        trackList->resized(); // Trigger layout update to position new track
+    };
 
     appEngine->onEditLoaded = [this] {
         trackList = std::make_unique<TrackListComponent> (appEngine);
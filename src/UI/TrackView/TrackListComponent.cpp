@@ -11,10 +11,19 @@ TrackListComponent::TrackListComponent (const std::shared_ptr<AppEngine>& engine
       playhead (engine->getEdit(),
           engine->getEditViewState(),
           *engine),
-      loopRangeComponent (engine->getEdit())
+      loopRangeComponent (engine->getTempoMap()),
+      tempoTrack (engine->getTempoMap())
 {
     //Add initial track pair
     //addNewTrack();
+
+    // Repaint just the column that arrived
+    tileCache.onTileReady = [this] (int trackIndex, juce::Rectangle<int> area)
+    {
+        if (trackIndex >= 0 && trackIndex < tracks.size())
+            if (auto* track = tracks[trackIndex])
+                track->repaint (area);
+    };
     setWantsKeyboardFocus (true); // setting keyboard focus?
     addAndMakeVisible (playhead);
     playhead.setAlwaysOnTop (true);
@@ -31,13 +40,23 @@ TrackListComponent::TrackListComponent (const std::shared_ptr<AppEngine>& engine
     loopRangeComponent.setViewStartBeat(t::BeatPosition::fromBeats(0.0));
 
     // Set up timeline with beat-based coordinates
-    timeline = std::make_unique<ui::TimelineComponent>(appEngine->getEdit());
+    timeline = std::make_unique<ui::TimelineComponent>(appEngine->getEdit(), appEngine->getTempoMap());
     addAndMakeVisible (timeline.get());
     timeline->setPixelsPerBeat (100.0);
     timeline->setViewStartBeat (t::BeatPosition::fromBeats (0.0));
     timeline->setEditForSnap(&appEngine->getEdit());
     timeline->setSnapToBeats(true);
 
+    // Tempo lane sits between the ruler and the tracks
+    addAndMakeVisible (tempoTrack);
+    tempoTrack.setPixelsPerBeat (100.0);
+    tempoTrack.setViewStartBeat (t::BeatPosition::fromBeats (0.0));
+
+    addAndMakeVisible (tempoTrackLabel);
+    tempoTrackLabel.setFont (juce::Font (juce::FontOptions (12.0f)));
+    tempoTrackLabel.setColour (juce::Label::textColourId, juce::Colours::white.withAlpha (0.7f));
+    tempoTrackLabel.setJustificationType (juce::Justification::centredLeft);
+
     addAndMakeVisible(loopButton);
     loopButton.setClickingTogglesState(true);
 
@@ -65,7 +84,7 @@ TrackListComponent::TrackListComponent (const std::shared_ptr<AppEngine>& engine
             {
                 // seed ONCE (4 beats = 1 bar)
                 const double startBeats = timeline->getViewStartBeat().inBeats();
-                const double start = appEngine->getEdit().tempoSequence.toTime(t::BeatPosition::fromBeats(startBeats)).inSeconds();
+                const double start = appEngine->getTempoMap().toTime(t::BeatPosition::fromBeats(startBeats)).inSeconds();
                 r = t::TimeRange(t::TimePosition::fromSeconds(start),
                                          t::TimePosition::fromSeconds(start + 4.0));
                 timeline->setLoopRange(r);
@@ -148,48 +167,8 @@ TrackListComponent::TrackListComponent (const std::shared_ptr<AppEngine>& engine
         }
     };
 
-    // Handle BPM changes: maintain beat positions for loop range and playhead
-    appEngine->onBpmChanged = [this](double oldBpm, double newBpm, t::TimeRange oldLoopRange, t::TimePosition oldPlayheadPos)
-    {
-        auto& tr = appEngine->getEdit().getTransport();
-        auto& tempoSeq = appEngine->getEdit().tempoSequence;
-
-        // Update loop range to maintain beat positions
-        // Use the ORIGINAL loop range values (before Tracktion adjusted them)
-        if (oldLoopRange.getLength().inSeconds() > 0.0)
-        {
-            // Convert original time to beats using old BPM (manual calculation)
-            // At a given BPM: beats = seconds * (BPM / 60)
-            const double startBeats = oldLoopRange.getStart().inSeconds() * (oldBpm / 60.0);
-            const double endBeats = oldLoopRange.getEnd().inSeconds() * (oldBpm / 60.0);
-
-            // Convert beats back to time using new tempo sequence
-            const auto startTime = tempoSeq.toTime(t::BeatPosition::fromBeats(startBeats));
-            const auto endTime = tempoSeq.toTime(t::BeatPosition::fromBeats(endBeats));
-            const auto newLoopRange = t::TimeRange(startTime, endTime);
-
-            // Update both transport and timeline
-            tr.setLoopRange(newLoopRange);
-            if (timeline)
-                timeline->setLoopRange(newLoopRange);
-            loopRangeComponent.setLoopRange(newLoopRange);
-        }
-
-        // Update playhead position to maintain beat position (only if not playing)
-        // Use the ORIGINAL playhead position (before Tracktion adjusted it)
-        if (!tr.isPlaying())
-        {
-            // Convert original position to beats using old BPM
-            const double posBeats = oldPlayheadPos.inSeconds() * (oldBpm / 60.0);
-
-            // Convert back to time using new tempo
-            const auto newPos = tempoSeq.toTime(t::BeatPosition::fromBeats(posBeats));
-
-            tr.setPosition(newPos);
-        }
-
-        repaint();
-    };
+    // Tempo edits keep the loop range on its beats (see TempoMap); just mirror it
+    appEngine->getTempoMap().addChangeListener (this);
 }
 
 /**
@@ -201,12 +180,12 @@ TrackListComponent::TrackListComponent (const std::shared_ptr<AppEngine>& engine
  * segmentation fault.
  *
  * **Bug History**: BPM change crashed with segfault when external plugins loaded (Nov 19, 2025).
- * Root cause: onBpmChanged callback captured `this` pointer that became dangling when
+ * Root cause: the BPM change callback captured `this` pointer that became dangling when
  * TrackListComponent was destroyed but AppEngine remained alive.
  *
- * **Pattern**: All UI components registering AppEngine callbacks should follow this pattern.
+ * **Pattern**: All UI components registering AppEngine callbacks (or listeners on objects
+ * AppEngine owns, like the TempoMap) should follow this pattern.
  *
- * @see AppEngine::onBpmChanged
  * @see AppEngine::onArmedTrackChanged
  */
 TrackListComponent::~TrackListComponent()
@@ -214,11 +193,27 @@ TrackListComponent::~TrackListComponent()
     // Clear callbacks to prevent use-after-free when AppEngine outlives this component
     if (appEngine)
     {
-        appEngine->onBpmChanged = nullptr;
+        appEngine->getTempoMap().removeChangeListener (this);
         appEngine->onArmedTrackChanged = nullptr;
     }
 }
 
+void TrackListComponent::changeListenerCallback (juce::ChangeBroadcaster*)
+{
+    // Tempo changed: clips and playhead are drawn in beats so they don't move; only
+    // the time-based loop range views need the transport's (already remapped) range.
+    const auto& tr = appEngine->getEdit().getTransport();
+
+    if (tr.getLoopRange().getLength().inSeconds() > 0.0)
+    {
+        if (timeline)
+            timeline->setLoopRange (tr.getLoopRange());
+        loopRangeComponent.setLoopRange (tr.getLoopRange());
+    }
+
+    repaint();
+}
+
 void TrackListComponent::paint (juce::Graphics& g)
 {
     g.fillAll (juce::Colour (0xFF343A40)); // Dark background for track area
@@ -228,11 +223,10 @@ void TrackListComponent::paint (juce::Graphics& g)
 void TrackListComponent::resized()
 {
     constexpr int headerWidth    = 140;
-    constexpr int trackHeight    = 125;
     constexpr int addButtonSpace = 30;
 
     const int numTracks = juce::jmin(headers.size(), tracks.size());
-    const int contentH  = numTracks * trackHeight + addButtonSpace;
+    const int contentH  = getTrackRowTop(numTracks) - tracksTop + addButtonSpace;
 
     // 1) First pass: lay out timeline, headers, and tracks
     auto bounds = getLocalBounds();
@@ -249,13 +243,24 @@ void TrackListComponent::resized()
             timeline->setBounds(timelineRow);
     }
 
+    // tempo lane
+    {
+        auto tempoRow = bounds.removeFromTop(tempoTrackHeight);
+        tempoTrackLabel.setBounds(tempoRow.removeFromLeft(headerWidth).reduced(6, 0));
+        tempoTrack.setBounds(tempoRow);
+    }
+
     bounds.removeFromBottom(addButtonSpace);
 
     // rows
     for (int i = 0; i < numTracks; ++i)
     {
         constexpr int margin = 2;
-        auto row = bounds.removeFromTop(trackHeight);
+        auto row = bounds.removeFromTop(getTrackRowHeight(i));
+
+        // automation lane under the track, aligned with the tempo lane
+        if (auto* lane = automationLanes[i])
+            lane->setBounds(row.removeFromBottom(automationLaneHeight).withTrimmedLeft(headerWidth));
 
         if (headers[i] != nullptr)
             headers[i]->setBounds(row.removeFromLeft(headerWidth).reduced(margin));
@@ -268,7 +273,7 @@ void TrackListComponent::resized()
     const auto overlayBounds = getLocalBounds()
                                    // .withTrimmedBottom(addButtonSpace)
                                    .withTrimmedLeft(headerWidth)
-                                   .withTrimmedTop (timelineHeight);
+                                   .withTrimmedTop (tracksTop);
 
     playhead.setBounds(overlayBounds);
     playhead.toFront(false);
@@ -292,7 +297,7 @@ void TrackListComponent::resized()
     // Calculate width based on beat length instead of time length
     const auto editLengthTime = appEngine->getEdit().getLength();
     const auto editEndPos = t::TimePosition::fromSeconds(editLengthTime.inSeconds());
-    const double beats = appEngine->getEdit().tempoSequence.toBeats(editEndPos).inBeats();
+    const double beats = appEngine->getTempoMap().toBeats(editEndPos).inBeats();
     const double ppb = timeline ? timeline->getPixelsPerBeat() : 100.0;
     const int widthByEdit = (int) juce::roundToInt(beats * ppb);
     const int    parentW     = getParentComponent() ? getParentComponent()->getWidth() : getWidth();
@@ -300,11 +305,11 @@ void TrackListComponent::resized()
     const int bodyMinW = std::max({ widthByEdit, rightmostClipPx, parentW - headerWidth });
     const int desiredW = headerWidth + std::max(bodyMinW, 800);
 
-    // Calculate total height needed: timeline + tracks + button space
+    // Calculate total height needed: timeline + tempo lane + tracks + button space
     // Use the GREATER of contentH+timeline or parent height to:
     // - Fill viewport when few tracks exist (prevents grey gap, playhead fills space)
     // - Extend beyond viewport when many tracks exist (prevents squishing)
-    const int totalContentH = timelineHeight + contentH;
+    const int totalContentH = tracksTop + contentH;
     const int parentH = getParentComponent() ? getParentComponent()->getHeight() : getHeight();
     const int desiredH = std::max(totalContentH, parentH);
 
@@ -350,6 +355,7 @@ void TrackListComponent::addNewTrack (int engineIdx)
                                  : TrackHeaderComponent::TrackType::Instrument);
 
     tracks.add (newTrack);
+    automationLanes.add (nullptr);
 
     addAndMakeVisible (header);
     addAndMakeVisible (newTrack);
@@ -371,8 +377,11 @@ void TrackListComponent::addNewTrack (int engineIdx)
                 removeChildComponent (headers[uiIndex]);
             if (tracks[uiIndex] != nullptr)
                 removeChildComponent (tracks[uiIndex]);
+            if (automationLanes[uiIndex] != nullptr)
+                removeChildComponent (automationLanes[uiIndex]);
             headers.remove (uiIndex);
             tracks.remove (uiIndex);
+            automationLanes.remove (uiIndex);
             appEngine->deleteMidiTrack (uiIndex);
             updateTrackIndexes();
             refreshTrackStates(); // Refresh solo/mute/arm states after track deletion
@@ -381,6 +390,10 @@ void TrackListComponent::addNewTrack (int engineIdx)
 
     };
 
+    newTrack->onRequestShowAutomation = [this] (int uiIndex, te::AutomatableParameter* param) {
+        showAutomationLane (uiIndex, param);
+    };
+
     newTrack->onRequestOpenPianoRoll = [this] (te::MidiClip* clip) {
         if (auto* parent = findParentComponentOfClass<TrackEditView>())
             parent->showPianoRoll (clip);
@@ -440,12 +453,23 @@ void TrackListComponent::refreshTrackStates() const
     for (int i = 0; i < headers.size(); ++i)
     {
         if (headers[i] != nullptr)
-            headers[i]->setArmed (appEngine->getArmedTrackIndex() == i);
+            headers[i]->setArmed (appEngine->getArmedTrackIndex() == i || appEngine->isAudioTrackArmed (i));
     }
 }
 
 void TrackListComponent::armTrack (int trackIndex, bool shouldBeArmed)
 {
+    // Audio tracks arm independently, so several can record at once
+    if (appEngine->isAudioTrack (trackIndex))
+    {
+        if (! shouldBeArmed && appEngine->getArmedTrackIndex() == trackIndex)
+            appEngine->setArmedTrack (-1);
+
+        appEngine->setAudioTrackArmed (trackIndex, shouldBeArmed);
+        refreshTrackStates();
+        return;
+    }
+
     const int newIndex = shouldBeArmed ? trackIndex : -1;
     if (appEngine->getArmedTrackIndex() != newIndex)
         appEngine->setArmedTrack (newIndex);
@@ -474,9 +498,12 @@ void TrackListComponent::repaintTrack(int trackIndex)
 
 void TrackListComponent::setPixelsPerBeat (double ppb)
 {
-    // Update all components to use beat-based coordinates
-    for (auto* t : tracks) if (t) t->setPixelsPerBeat (ppb);
+    // Update all components to use beat-based coordinates. The timeline goes first:
+    // tracks read the zoom back through getPixelsPerBeat() while laying out.
     if (timeline) timeline->setPixelsPerBeat (ppb);
+    for (auto* t : tracks) if (t) t->setPixelsPerBeat (ppb);
+    for (auto* lane : automationLanes) if (lane) lane->setPixelsPerBeat (ppb);
+    tempoTrack.setPixelsPerBeat (ppb);
     playhead.setPixelsPerBeat(ppb);
     loopRangeComponent.setPixelsPerBeat(ppb);
     repaint();
@@ -485,8 +512,10 @@ void TrackListComponent::setPixelsPerBeat (double ppb)
 void TrackListComponent::setViewStartBeat (t::BeatPosition b)
 {
     // Update all components to use beat-based coordinates
-    for (auto* tc : tracks) if (tc) tc->setViewStartBeat (b);
     if (timeline) timeline->setViewStartBeat (b);
+    for (auto* tc : tracks) if (tc) tc->setViewStartBeat (b);
+    for (auto* lane : automationLanes) if (lane) lane->setViewStartBeat (b);
+    tempoTrack.setViewStartBeat (b);
     playhead.setViewStartBeat(b);
     loopRangeComponent.setViewStartBeat(b);
     repaint();
@@ -496,7 +525,9 @@ void TrackListComponent::rebuildFromEngine()
 {
     for (auto* h : headers) removeChildComponent(h);
     for (auto* t : tracks)  removeChildComponent(t);
-    headers.clear(); tracks.clear();
+    for (auto* l : automationLanes) if (l) removeChildComponent(l);
+    headers.clear(); tracks.clear(); automationLanes.clear();
+    tileCache.clear();
 
     const int n = appEngine->getNumTracks();
     for (int i = 0; i < n; ++i)
@@ -554,40 +585,87 @@ bool TrackListComponent::wouldClipOverlap (te::MidiClip* clipToMove, int targetT
     if (!appEngine || !clipToMove)
         return false;
 
-    // Get all MIDI clips from target track
-    auto clips = appEngine->getMidiClipsFromTrack (targetTrack);
+    // Called on every drag move: an index lookup, skipping the clip being moved
+    return appEngine->wouldClipOverlap (targetTrack, range, clipToMove);
+}
 
-    for (auto* existingClip : clips)
+int TrackListComponent::getTrackIndexAtY (int y) const
+{
+    // Account for timeline and tempo lane at top
+    if (y < tracksTop)
+        return -1;
+
+    // A row's automation lane counts as its track
+    const int numTracks = appEngine->getNumTracks();
+    for (int i = 0, top = tracksTop; i < numTracks; ++i)
     {
-        // Skip the clip being moved
-        if (existingClip == clipToMove)
-            continue;
-
-        // Check if time ranges overlap
-        auto existingRange = existingClip->getPosition().time;
-        if (range.overlaps (existingRange))
-            return true;
+        top += getTrackRowHeight (i);
+        if (y < top)
+            return i;
     }
 
-    return false;
+    return -1;
 }
 
-int TrackListComponent::getTrackIndexAtY (int y) const
+int TrackListComponent::getTrackRowTop (int trackIndex) const
 {
-    constexpr int trackHeight = 125;
+    int top = tracksTop;
+    for (int i = 0; i < trackIndex; ++i)
+        top += getTrackRowHeight (i);
 
-    // Account for timeline at top
-    const int yRelative = y - timelineHeight;
-    if (yRelative < 0)
-        return -1;
+    return top;
+}
 
-    const int index = yRelative / trackHeight;
+int TrackListComponent::getTrackRowHeight (int trackIndex) const
+{
+    return trackHeight + (automationLanes[trackIndex] != nullptr ? automationLaneHeight : 0);
+}
 
-    // Validate index
-    if (index < 0 || index >= appEngine->getNumTracks())
-        return -1;
+void TrackListComponent::showAutomationLane (int trackIndex, te::AutomatableParameter* param)
+{
+    if (trackIndex < 0 || trackIndex >= automationLanes.size())
+        return;
+
+    if (auto* existing = automationLanes[trackIndex])
+    {
+        if (param == &existing->getParameter())
+            return;
+
+        removeChildComponent (existing);
+    }
+
+    AutomationLaneComponent* lane = nullptr;
+
+    if (param != nullptr)
+    {
+        lane = new AutomationLaneComponent (appEngine->getEdit(), appEngine->getTempoMap(), *param);
+        lane->setPixelsPerBeat (getPixelsPerBeat());
+        lane->setViewStartBeat (getViewStartBeat());
+
+        lane->onHideRequested = [this, lane]
+        {
+            // Deferred: the lane is still inside its own menu callback
+            juce::MessageManager::callAsync ([safeThis = juce::Component::SafePointer<TrackListComponent> (this),
+                                              safeLane = juce::Component::SafePointer<AutomationLaneComponent> (lane)]
+            {
+                if (safeThis != nullptr && safeLane != nullptr)
+                    safeThis->showAutomationLane (safeThis->automationLanes.indexOf (safeLane.getComponent()), nullptr);
+            });
+        };
+
+        addAndMakeVisible (lane);
+    }
+
+    automationLanes.set (trackIndex, lane, true);
+    resized();
+}
+
+te::AutomatableParameter* TrackListComponent::getAutomationLaneParameter (int trackIndex) const
+{
+    if (auto* lane = automationLanes[trackIndex])
+        return &lane->getParameter();
 
-    return index;
+    return nullptr;
 }
 
 // Ghost clip management - Written by Claude Code (fixed seconds/beats conversion)
@@ -602,20 +680,19 @@ void TrackListComponent::showGhostClip (int trackIndex, t::TimePosition time,
     }
 
     // Calculate ghost bounds using same logic as TrackComponent::resized()
-    constexpr int trackHeight = 125;
     const double pixelsPerBeat = getPixelsPerBeat();
     const double viewStartBeats = getViewStartBeat().inBeats();
 
     // Convert time positions to beat positions for layout
-    auto& tempoSeq = appEngine->getEdit().tempoSequence;
-    const double clipStartBeats = tempoSeq.toBeats (time).inBeats();
+    const auto& tempoMap = appEngine->getTempoMap();
+    const double clipStartBeats = tempoMap.toBeats (time).inBeats();
     const auto clipEndTime = time + length;
-    const double clipEndBeats = tempoSeq.toBeats (clipEndTime).inBeats();
+    const double clipEndBeats = tempoMap.toBeats (clipEndTime).inBeats();
     const double clipLenBeats = clipEndBeats - clipStartBeats;
 
     const int timelineX = static_cast<int> (juce::roundToIntAccurate ((clipStartBeats - viewStartBeats) * pixelsPerBeat));
     const int w = static_cast<int> (juce::roundToIntAccurate (clipLenBeats * pixelsPerBeat));
-    const int y = timelineHeight + (trackIndex * trackHeight) + 5; // +5 for inner margin
+    const int y = getTrackRowTop (trackIndex) + 5; // +5 for inner margin
     const int h = trackHeight - 10; // Account for margins
 
     // Ghost is positioned in TrackListComponent coordinates, so add headerWidth offset (Written by Claude Code)
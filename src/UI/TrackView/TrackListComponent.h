@@ -4,10 +4,13 @@
 #include "PlayheadComponent.h"
 #include "LoopRangeComponent.h"
 #include "TrackComponent.h"
+#include "ArrangementTileCache.h"
 #include "TrackHeaderComponent.h"
 #include "GhostClipComponent.h"
 #include <juce_gui_basics/juce_gui_basics.h>
 #include "TimelineComponent.h"
+#include "TempoTrackComponent.h"
+#include "AutomationLaneComponent.h"
 
 namespace te = tracktion::engine;
 namespace t = tracktion;
@@ -18,8 +21,10 @@ namespace t = tracktion;
  * TrackListComponent is the core track editing surface in GrooveKit's TrackEditView. It manages
  * the layout and interaction between multiple UI components:
  *  - TimelineComponent (beat/bar ruler at top)
+ *  - TempoTrackComponent (tempo lane under the ruler)
  *  - TrackHeaderComponent array (track names, mute/solo/arm buttons on left)
  *  - TrackComponent array (MIDI clip lanes on right)
+ *  - AutomationLaneComponent per track, when shown (under the track's row)
  *  - PlayheadComponent (vertical playback position indicator)
  *  - LoopRangeComponent (visual loop range overlay)
  *
@@ -28,6 +33,7 @@ namespace t = tracktion;
  *  - Rebuilds track UI via rebuildFromEngine() when track configuration changes
  *  - Coordinates zoom (pixelsPerBeat) and scroll (viewStartBeat) across all child components
  *  - Uses OwnedArray for automatic memory management of dynamic track UI elements
+ *  - Owns the ArrangementTileCache the track lanes paint from
  *
  * Clip Drag System:
  *  - Validates clip movement between tracks via canClipMoveToTrack()
@@ -46,7 +52,8 @@ namespace t = tracktion;
  *  - Call setViewStartBeat() to update horizontal scroll position
  *  - Use getTrackIndexAtY() to convert mouse Y to track index for drag/drop
  */
-class TrackListComponent final : public juce::Component
+class TrackListComponent final : public juce::Component,
+                                 private juce::ChangeListener
 {
 public:
     //==============================================================================
@@ -148,9 +155,25 @@ public:
      */
     void updateClipEditState (int trackIndex, te::MidiClip* editedClip);
 
+    /**
+     * @brief Shows an automation lane for @p param under a track, or hides it.
+     *
+     * Each track has at most one lane; showing another parameter replaces it.
+     *
+     * @param trackIndex Track index
+     * @param param      Parameter to show, or nullptr to hide the lane
+     */
+    void showAutomationLane (int trackIndex, te::AutomatableParameter* param);
+
+    /** The parameter shown under a track, or nullptr. */
+    te::AutomatableParameter* getAutomationLaneParameter (int trackIndex) const;
+
     /**
      * @brief Arms or disarms a track for recording.
      *
+     * Instrument tracks arm one at a time (MIDI follows the armed track); audio
+     * tracks arm independently for multitrack recording.
+     *
      * @param trackIndex Track index to arm
      * @param shouldBeArmed True to arm, false to disarm
      */
@@ -199,6 +222,9 @@ public:
         return timeline ? timeline->getViewStartBeat() : t::BeatPosition::fromBeats(0.0);
     }
 
+    /** Tiles of the tracks' static lane content, rendered on worker threads. */
+    ArrangementTileCache& getTileCache() noexcept { return tileCache; }
+
     //==============================================================================
     // Clip Drag Validation
 
@@ -252,6 +278,21 @@ public:
      */
     void hideGhostClip();
 
+    //==============================================================================
+    // Layout
+
+    static constexpr int timelineHeight   = 24; ///< Height of timeline in pixels
+    static constexpr int tempoTrackHeight = 28; ///< Height of the tempo lane in pixels
+    static constexpr int tracksTop = timelineHeight + tempoTrackHeight; ///< Y of the first track row
+    static constexpr int trackHeight      = 125; ///< Height of a track row without its automation lane
+    static constexpr int automationLaneHeight = 60; ///< Height of an automation lane under a track
+
+    /** Y of a track's row (tracksTop for the first). */
+    int getTrackRowTop (int trackIndex) const;
+
+    /** Height of a track's row, including its automation lane if shown. */
+    int getTrackRowHeight (int trackIndex) const;
+
 private:
     //==============================================================================
     // Member Variables
@@ -259,14 +300,17 @@ private:
     const std::shared_ptr<AppEngine> appEngine; ///< Shared pointer to global engine (non-owning wrapper)
 
     std::unique_ptr<ui::TimelineComponent> timeline; ///< Owned timeline ruler component
-    static constexpr int timelineHeight = 24; ///< Height of timeline in pixels
     static constexpr int headerWidth    = 140; ///< Width of track headers in pixels
 
     PlayheadComponent playhead; ///< Playback position indicator
     LoopRangeComponent loopRangeComponent; ///< Visual loop range overlay
+    TempoTrackComponent tempoTrack; ///< Tempo lane under the timeline
+    juce::Label tempoTrackLabel { {}, "Tempo" }; ///< Header cell for the tempo lane
 
+    ArrangementTileCache tileCache; ///< Lane tiles for every track (declared before tracks: they paint from it)
     juce::OwnedArray<TrackComponent> tracks; ///< Owned track lane components (MIDI clips)
     juce::OwnedArray<TrackHeaderComponent> headers; ///< Owned track header components (buttons/names)
+    juce::OwnedArray<AutomationLaneComponent> automationLanes; ///< One per track, nullptr while hidden
     juce::Array<juce::Colour> trackColors {
         juce::Colour::fromString ("#ff6b6b"),
         juce::Colour::fromString ("#f06595"),
@@ -286,6 +330,9 @@ private:
     //==============================================================================
     // Internal Methods
 
+    /** Tempo map changed: refreshes the loop range views from the transport. */
+    void changeListenerCallback (juce::ChangeBroadcaster*) override;
+
     /**
      * @brief Updates track index values in all headers.
      *
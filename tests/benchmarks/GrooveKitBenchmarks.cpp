@@ -0,0 +1,504 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/benchmark/catch_constructor.hpp>
+
+#include "AppEngine/AppEngine.h"
+#include "AppEngine/AudioRecorder.h"
+#include "AppEngine/ProjectGenerator.h"
+#include "UI/MainComponent.h"
+#include "UI/Plugins/Synthesizer/MorphSynthPlugin.h"
+#include "UI/Plugins/Synthesizer/MorphVoice.h"
+#include "UI/PopupWindows/PianoRollComponents/GridStyleSheet.h"
+#include "UI/PopupWindows/PianoRollComponents/NoteGridComponent.h"
+#include "UI/TrackView/TrackListComponent.h"
+
+#include <array>
+
+// Hot-path benchmarks. Run via the `run_benchmarks` target to get XML results
+// (build/groovekit_benchmarks.xml) for trend tracking.
+
+namespace
+{
+    /** One AppEngine shared by every benchmark (it owns the te::Engine and devices). */
+    AppEngine& sharedApp()
+    {
+        static juce::ScopedJuceInitialiser_GUI juceInit;
+        static AppEngine app;
+        return app;
+    }
+
+    /** MorphSynth defaults, served to voices without a te::Plugin behind them. */
+    struct DefaultPatch : MorphVoice::ParamsView
+    {
+        using PID = MorphVoice::ParamID;
+
+        DefaultPatch()
+        {
+            set (PID::morph, 0.5f);   set (PID::pulseWidth, 0.5f);
+            set (PID::cutoff, 1200.f); set (PID::resonance, 0.7f);
+            set (PID::aA, 0.01f); set (PID::dA, 0.12f); set (PID::sA, 0.8f); set (PID::rA, 0.2f);
+            set (PID::aF, 0.01f); set (PID::dF, 0.2f);  set (PID::sF, 0.0f); set (PID::rF, 0.25f);
+            set (PID::fEnvAmt, 0.5f);
+            set (PID::lfoRate, 5.f);  set (PID::lfoDepth, 0.3f); set (PID::lfoTarget, 1.f);
+            set (PID::oscAType, 0.f); set (PID::oscBType, 2.f);
+        }
+
+        void set (PID id, float v)         { values[(size_t) id] = v; }
+        float get (PID id) const override  { return values[(size_t) id]; }
+        int choice (PID id) const override { return (int) std::round (values[(size_t) id]); }
+
+        std::array<float, (size_t) PID::numParams> values {};
+    };
+
+    /** Writes a type-1 MIDI file with @p numNotes notes spread over 16 tracks. */
+    juce::File writeLargeMidiFile (int numNotes)
+    {
+        auto file = juce::File::getSpecialLocation (juce::File::tempDirectory)
+                        .getChildFile ("gk_bench_" + juce::String (numNotes) + ".mid");
+
+        if (file.existsAsFile())
+            return file;
+
+        constexpr int ppq = 960;
+        juce::MidiFile mf;
+        mf.setTicksPerQuarterNote (ppq);
+
+        juce::Random rng (1234);
+        const int perTrack = numNotes / 16;
+
+        for (int trk = 0; trk < 16; ++trk)
+        {
+            juce::MidiMessageSequence seq;
+            for (int i = 0; i < perTrack; ++i)
+            {
+                const double start = (double) (i * ppq / 4);
+                const int note     = 36 + rng.nextInt (48);
+                seq.addEvent (juce::MidiMessage::noteOn (1, note, (juce::uint8) 100), start);
+                seq.addEvent (juce::MidiMessage::noteOff (1, note), start + ppq / 8);
+            }
+            seq.updateMatchedPairs();
+            mf.addTrack (seq);
+        }
+
+        juce::FileOutputStream out (file);
+        mf.writeTo (out);
+        return file;
+    }
+
+    void removeAllClips (te::AudioTrack& track)
+    {
+        const juce::Array<te::Clip*> clips (track.getClips());
+        for (auto* c : clips)
+            c->removeFromParent();
+    }
+}
+
+//==============================================================================
+TEST_CASE("MorphOsc waveforms", "[!benchmark][dsp]")
+{
+    constexpr int blockSize = 512;
+    const char* names[] = { "Sine", "Triangle", "Saw", "Pulse" };
+
+    for (int type = 0; type < 4; ++type)
+    {
+        MorphOsc osc;
+        osc.prepare (48000.0);
+        osc.setFrequency (220.0);
+        osc.setTypes (type, type);
+
+        BENCHMARK (juce::String ("MorphOsc " + juce::String (names[type]) + " x512").toStdString())
+        {
+            float acc = 0.0f;
+            for (int i = 0; i < blockSize; ++i)
+                acc += osc.next();
+            return acc;
+        };
+    }
+
+    MorphOsc morphing;
+    morphing.prepare (48000.0);
+    morphing.setFrequency (220.0);
+    morphing.setTypes (MorphOsc::Saw, MorphOsc::Pulse);
+    morphing.setMorph (0.5f);
+
+    BENCHMARK ("MorphOsc Saw->Pulse morph x512")
+    {
+        float acc = 0.0f;
+        for (int i = 0; i < blockSize; ++i)
+            acc += morphing.next();
+        return acc;
+    };
+}
+
+TEST_CASE("MorphVoice rendering", "[!benchmark][dsp]")
+{
+    constexpr int blockSize = 512;
+    DefaultPatch patch;
+    juce::AudioBuffer<float> out (2, blockSize);
+
+    MorphVoice voice;
+    voice.prepare (48000.0, blockSize, &patch);
+    voice.startNote (60, 0.8f, nullptr, 8192);
+
+    BENCHMARK ("MorphVoice renderNextBlock (1 voice, 512 samples)")
+    {
+        out.clear();
+        voice.renderNextBlock (out, 0, blockSize);
+        return out.getSample (0, blockSize - 1);
+    };
+}
+
+TEST_CASE("MorphSynth MPE rendering", "[!benchmark][dsp]")
+{
+    auto& app = sharedApp();
+    app.newUntitledEdit();
+
+    auto plugin = app.getEdit().getPluginCache().createNewPlugin (MorphSynthPlugin::pluginType, {});
+    auto* morph = dynamic_cast<MorphSynthPlugin*> (plugin.get());
+    REQUIRE(morph != nullptr);
+
+    constexpr int blockSize = 512;
+    te::PluginInitialisationInfo info;
+    info.sampleRate       = 48000.0;
+    info.blockSizeSamples = blockSize;
+
+    morph->mpe->setParameter ((float) MorphVoice::mpeLowerZone, juce::sendNotificationSync);
+    morph->initialise (info);
+
+    juce::AudioBuffer<float> buffer (2, blockSize);
+    te::MidiMessageArray midi;
+    const auto source = te::createUniqueMPESourceID();
+
+    // A full lower zone: one held note on each member channel 2..16
+    for (int ch = 2; ch <= 16; ++ch)
+        midi.addMidiMessage (juce::MidiMessage::noteOn (ch, 40 + ch * 2, (juce::uint8) 100), 0.0, source);
+
+    te::PluginRenderContext first (&buffer, juce::AudioChannelSet::stereo(), 0, blockSize,
+                                   &midi, 0.0, {}, true, false, false, false);
+    morph->applyToBuffer (first);
+
+    int block = 0;
+
+    BENCHMARK ("MorphSynth 15 MPE voices, bend + pressure + slide per block (512 samples)")
+    {
+        buffer.clear();
+        midi.clear();
+        ++block;
+
+        for (int ch = 2; ch <= 16; ++ch)
+        {
+            midi.addMidiMessage (juce::MidiMessage::pitchWheel (ch, 8192 + ((block + ch) % 64) * 64), 0.0, source);
+            midi.addMidiMessage (juce::MidiMessage::channelPressureChange (ch, (block + ch) % 128), 0.0, source);
+            midi.addMidiMessage (juce::MidiMessage::controllerEvent (ch, 74, (block * 3 + ch) % 128), 0.0, source);
+        }
+
+        te::PluginRenderContext rc (&buffer, juce::AudioChannelSet::stereo(), 0, blockSize,
+                                    &midi, 0.0, {}, true, false, false, false);
+        morph->applyToBuffer (rc);
+        return buffer.getSample (0, 0);
+    };
+
+    morph->deinitialise();
+}
+
+TEST_CASE("MIDI import", "[!benchmark][midi]")
+{
+    auto& app = sharedApp();
+    app.newUntitledEdit();
+    const int trackIndex = app.getTrackManager().addInstrumentTrack();
+    auto& track = *app.getTrackManager().getTrack (trackIndex);
+
+    const auto file = writeLargeMidiFile (20000);
+
+    BENCHMARK ("MIDIEngine::importMidiFileToTrack (20k notes, incl. clip removal)")
+    {
+        const bool ok = app.getMidiEngine().importMidiFileToTrack (file, trackIndex, t::TimePosition());
+        removeAllClips (track);
+        return ok;
+    };
+}
+
+TEST_CASE("MIDI recording", "[!benchmark][midi]")
+{
+    auto& app = sharedApp();
+    app.newUntitledEdit();
+    const int trackIndex = app.getTrackManager().addInstrumentTrack();
+    auto& edit  = app.getEdit();
+    auto& track = *app.getTrackManager().getTrack (trackIndex);
+
+    constexpr int numNotes = 2000;
+    MidiRecorder recorder (edit.engine);
+
+    BENCHMARK ("MidiRecorder record + createClipFromRecording (2k notes)")
+    {
+        auto& transport = edit.getTransport();
+        transport.setPosition (t::TimePosition());
+        recorder.startRecording (edit, trackIndex, app.getClipIndex());
+
+        for (int i = 0; i < numNotes; ++i)
+        {
+            const int note = 48 + (i % 24);
+            transport.setPosition (t::TimePosition::fromSeconds (i * 0.05));
+            recorder.handleNoteOn (nullptr, 1, note, 0.8f);
+            transport.setPosition (t::TimePosition::fromSeconds (i * 0.05 + 0.04));
+            recorder.handleNoteOff (nullptr, 1, note, 0.0f);
+        }
+
+        const bool ok = recorder.stopRecording (edit);
+        transport.stop (false, false);
+        removeAllClips (track);
+        return ok;
+    };
+}
+
+TEST_CASE("Audio recording", "[!benchmark][io]")
+{
+    auto& app = sharedApp();
+    AudioRecorder recorder (app.getEdit().engine);
+
+    constexpr int numTracks = 16, blockSize = 512;
+    constexpr double sampleRate = 48000.0;
+    constexpr double seconds = 20.0, speed = 4.0;   // 20 s of audio, fed 4x faster than a device would
+
+    juce::AudioBuffer<float> block (numTracks * 2, blockSize);
+    juce::Random rng (99);
+    for (int c = 0; c < block.getNumChannels(); ++c)
+        for (int i = 0; i < blockSize; ++i)
+            block.setSample (c, i, rng.nextFloat() * 2.0f - 1.0f);
+
+    std::vector<AudioRecorder::Input> inputs;
+    for (int trk = 0; trk < numTracks; ++trk)
+        inputs.push_back ({ trk, trk * 2, 2 });
+
+    const auto dir = juce::File::getSpecialLocation (juce::File::tempDirectory).getChildFile ("gk_bench_recording");
+    dir.deleteRecursively();
+
+    // Sustained throughput: the writer has to keep up with 32 channels without
+    // dropping a block, paced like device callbacks
+    REQUIRE (recorder.startExternalRecording (inputs, dir, sampleRate));
+
+    const int numBlocks = (int) (seconds * sampleRate / blockSize);
+    const double blockMs = 1000.0 * blockSize / sampleRate / speed;
+    const double startMs = juce::Time::getMillisecondCounterHiRes();
+
+    for (int b = 0; b < numBlocks; ++b)
+    {
+        recorder.pushInputBlock (block.getArrayOfReadPointers(), block.getNumChannels(), blockSize);
+        juce::Time::waitForMillisecondCounter ((juce::uint32) (startMs + (b + 1) * blockMs));
+    }
+
+    for (const auto& status : recorder.getStreamStatus())
+    {
+        INFO ("Track " << status.trackIndex << ", peak FIFO fill " << status.peakFillLevel);
+        CHECK (status.overruns == 0);
+    }
+
+    const auto takes = recorder.stopRecording();
+    REQUIRE ((int) takes.size() == numTracks);
+
+    juce::WavAudioFormat wav;
+    for (const auto& take : takes)
+    {
+        std::unique_ptr<juce::AudioFormatReader> reader (wav.createReaderFor (take.file.createInputStream().release(), true));
+        REQUIRE (reader != nullptr);
+        CHECK (reader->lengthInSamples == (juce::int64) numBlocks * blockSize);
+    }
+
+    dir.deleteRecursively();
+}
+
+TEST_CASE("Clip drag", "[!benchmark][ui]")
+{
+    // What a drag asks on every mouse move, on a track with thousands of clips
+    auto& app = sharedApp();
+    app.newUntitledEdit();
+    const int trackIndex = app.getTrackManager().addInstrumentTrack();
+    auto& track = *app.getTrackManager().getTrack (trackIndex);
+
+    constexpr int numClips = 5000;
+    for (int i = 0; i < numClips; ++i)
+        track.insertMIDIClip ("Clip", { t::TimePosition::fromSeconds (i * 2.0), t::TimePosition::fromSeconds (i * 2.0 + 1.0) }, nullptr);
+
+    auto* moving = track.getClips().getFirst();
+    juce::Random rng (99);
+
+    BENCHMARK ("AppEngine::wouldClipOverlap x1000 (5k clips)")
+    {
+        int overlaps = 0;
+        for (int i = 0; i < 1000; ++i)
+        {
+            const auto start = t::TimePosition::fromSeconds (rng.nextDouble() * numClips * 2.0);
+            overlaps += app.wouldClipOverlap (trackIndex, { start, start + t::TimeDuration::fromSeconds (0.5) }, moving) ? 1 : 0;
+        }
+        return overlaps;
+    };
+
+    removeAllClips (track);
+}
+
+TEST_CASE("Arrangement zoom", "[!benchmark][ui]")
+{
+    // A full song zoomed out: most clips are a pixel or two wide
+    auto& app = sharedApp();
+    app.newUntitledEdit();
+
+    constexpr int numTracks = 8;
+    constexpr int clipsPerTrack = 1000;
+    for (int i = 0; i < numTracks; ++i)
+    {
+        auto& track = *app.getTrackManager().getTrack (app.getTrackManager().addInstrumentTrack());
+        for (int c = 0; c < clipsPerTrack; ++c)
+            track.insertMIDIClip ("Clip", { t::TimePosition::fromSeconds (c * 0.5), t::TimePosition::fromSeconds (c * 0.5 + 0.25) }, nullptr);
+    }
+
+    // Non-owning: the shared AppEngine outlives the list
+    TrackListComponent list (std::shared_ptr<AppEngine> (&app, [] (AppEngine*) {}));
+    list.rebuildFromEngine();
+    list.setSize (1600, 1200);
+
+    juce::Image canvas (juce::Image::ARGB, 1600, 1200, true);
+    int step = 0;
+
+    BENCHMARK ("TrackListComponent zoom + paint, zoomed out (8k clips)")
+    {
+        list.setPixelsPerBeat ((step++ & 1) ? 3.0 : 4.0);
+        juce::Graphics g (canvas);
+        list.paintEntireComponent (g, false);
+        return canvas.getWidth();
+    };
+
+    for (int i = app.getNumTracks(); --i >= 0;)
+        removeAllClips (*app.getTrackManager().getTrack (i));
+}
+
+TEST_CASE("Quantize", "[!benchmark][midi]")
+{
+    // Whole-project scale: the packed-array passes alone, without the MidiList write-back
+    constexpr int numNotes = 200000;
+    juce::Random random (1);
+
+    QuantizeEngine::NoteArrays source;
+    source.reserve ((size_t) numNotes);
+    for (int i = 0; i < numNotes; ++i)
+    {
+        const double start = i * 0.25 + (random.nextDouble() - 0.5) * 0.1;
+        source.addNote (start, start + 0.2, 100.0f);
+    }
+
+    QuantizeEngine::Settings settings;
+    settings.strength = 0.8f;
+    settings.swing = 0.5f;
+    settings.humanizeBeats = 0.01;
+
+    BENCHMARK ("QuantizeEngine::process (200k notes, swing + humanize)")
+    {
+        auto notes = source;
+        QuantizeEngine::process (settings, notes);
+        return notes.start.back();
+    };
+}
+
+TEST_CASE("Edit save/load", "[!benchmark][io]")
+{
+    auto& app = sharedApp();
+    const auto stats = ProjectGenerator::generate (app, ProjectGenerator::Spec::customerScale());
+    INFO(stats.toString());
+
+    const auto file = juce::File::getSpecialLocation (juce::File::tempDirectory)
+                          .getChildFile ("gk_bench_customer_scale.tracktionedit");
+
+    BENCHMARK ("AppEngine::writeEditToFile (customer scale)")
+    {
+        return app.writeEditToFile (file);
+    };
+
+    REQUIRE(file.existsAsFile());
+
+    BENCHMARK ("AppEngine::loadEditFromFile (customer scale)")
+    {
+        return app.loadEditFromFile (file);
+    };
+}
+
+TEST_CASE("Tempo change", "[!benchmark][midi]")
+{
+    auto& app = sharedApp();
+    const auto stats = ProjectGenerator::generate (app, ProjectGenerator::Spec::customerScale());
+    INFO(stats.toString());
+
+    auto& tempoMap = app.getTempoMap();
+    int step = 0;
+
+    // One edit: every clip is moved back onto its beats
+    BENCHMARK ("AppEngine::setBpm (customer scale)")
+    {
+        app.setBpm (++step % 2 == 0 ? 120.0 : 121.0);
+        return app.getBpm();
+    };
+
+    // A tempo drag: 60 steps, clips moved once on release
+    BENCHMARK ("TempoMap drag gesture, 60 steps (customer scale)")
+    {
+        tempoMap.beginGesture();
+
+        for (int i = 0; i < 60; ++i)
+            tempoMap.setTempoChangeBpm (0, 120.0 + i * 0.5);
+
+        tempoMap.endGesture();
+        return tempoMap.getNumKnots();
+    };
+}
+
+TEST_CASE("Piano roll paint", "[!benchmark][ui]")
+{
+    auto& app = sharedApp();
+    app.newUntitledEdit();
+    const int trackIndex = app.getTrackManager().addInstrumentTrack();
+
+    constexpr int numBars  = 64;
+    constexpr int numNotes = 10000;
+    app.addMidiClipToTrackAt (trackIndex, t::TimePosition(), t::BeatDuration::fromBeats (numBars * 4.0));
+
+    auto* clip = app.getMidiClipFromTrack (trackIndex);
+    REQUIRE(clip != nullptr);
+
+    juce::Random rng (42);
+    for (int i = 0; i < numNotes; ++i)
+        clip->getSequence().addNote (rng.nextInt (128),
+                                     t::BeatPosition::fromBeats (rng.nextDouble() * (numBars * 4.0 - 0.25)),
+                                     t::BeatDuration::fromBeats (0.25),
+                                     100, 0, nullptr);
+
+    GridStyleSheet sheet;
+    NoteGridComponent grid (sheet, app, clip);
+    grid.setupGrid (25.0f, 8.0f, numBars);
+    grid.resized();
+
+    juce::Image canvas (juce::Image::ARGB, grid.getWidth(), grid.getHeight(), true);
+
+    BENCHMARK ("NoteGridComponent paint (10k notes)")
+    {
+        juce::Graphics g (canvas);
+        grid.paintEntireComponent (g, false);
+        return canvas.getWidth();
+    };
+}
+
+TEST_CASE("Startup", "[!benchmark][startup]")
+{
+    sharedApp(); // JUCE initialised and one engine already alive, as in a running app
+
+    // Critical path only: engine + empty edit. Devices/plugins/samples are deferred stages.
+    BENCHMARK_ADVANCED ("AppEngine construction (engine + empty edit)") (Catch::Benchmark::Chronometer meter)
+    {
+        std::vector<Catch::Benchmark::storage_for<AppEngine>> engines ((size_t) meter.runs());
+        meter.measure ([&] (int i) { engines[(size_t) i].construct(); });
+    };
+
+    // Time to interactive: everything MainComponent does before the window can be shown
+    BENCHMARK_ADVANCED ("Time to interactive (MainComponent)") (Catch::Benchmark::Chronometer meter)
+    {
+        std::vector<Catch::Benchmark::storage_for<MainComponent>> windows ((size_t) meter.runs());
+        meter.measure ([&] (int i) { windows[(size_t) i].construct(); });
+    };
+}
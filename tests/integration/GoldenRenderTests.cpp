@@ -0,0 +1,319 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "AppEngine/AppEngine.h"
+#include "SharedAppEngine.h"
+#include "DrumSamplerEngine/DefaultSampleLibrary.h"
+#include "UI/Plugins/Synthesizer/MorphSynthPlugin.h"
+
+#include <cmath>
+#include <functional>
+#include <vector>
+
+// Golden-audio regression tests: small edits are built in code, rendered offline
+// through AppEngine::exportAudio at a fixed rate, and compared against reference
+// WAVs in tests/integration/golden/ using level, envelope and spectral tolerances
+// (not bit-exactness, so harmless float reordering in DSP refactors still passes).
+//
+// The scenes are hidden until the references are committed, so ctest stays green
+// on a clean checkout; run them by tag. A scene without a reference is skipped.
+//
+// Regenerate references after an intentional sound change with:
+//     GROOVEKIT_UPDATE_GOLDEN=1 ./groovekit_tests "[golden]"
+
+namespace
+{
+    constexpr double renderRate            = 48000.0;
+    constexpr int    lengthToleranceSamples = 1024;   // render tail rounding
+    constexpr float  levelToleranceDb      = 0.5f;    // whole-file RMS
+    constexpr float  envelopeToleranceDb   = 1.5f;    // per 50 ms window
+    constexpr float  spectralToleranceDb   = 1.5f;    // per log-spaced band
+    constexpr float  silenceFloorDb        = -60.0f;  // ignore windows/bands below this
+
+    juce::File referenceDir()     { return juce::File (GROOVEKIT_GOLDEN_DIR); }
+    bool shouldUpdateReferences() { return juce::SystemStats::getEnvironmentVariable ("GROOVEKIT_UPDATE_GOLDEN", {}).isNotEmpty(); }
+
+    float toDb (double power) { return (float) (10.0 * std::log10 (power + 1.0e-20)); }
+
+    //==============================================================================
+    /** Level/envelope/spectrum summary of a mono mixdown; this is what gets compared. */
+    struct AudioProfile
+    {
+        double sampleRate = 0.0;
+        int numSamples = 0;
+        float rmsDb = -200.0f;
+        std::vector<float> envelopeDb;
+        std::vector<float> bandDb;
+    };
+
+    AudioProfile analyse (const juce::File& file)
+    {
+        AudioProfile profile;
+
+        juce::AudioFormatManager formats;
+        formats.registerBasicFormats();
+        std::unique_ptr<juce::AudioFormatReader> reader (formats.createReaderFor (file));
+        REQUIRE(reader != nullptr);
+
+        const int numSamples = (int) reader->lengthInSamples;
+        const int numChans   = (int) reader->numChannels;
+        juce::AudioBuffer<float> buffer (numChans, numSamples);
+        reader->read (&buffer, 0, numSamples, 0, true, true);
+
+        std::vector<float> mono ((size_t) numSamples, 0.0f);
+        for (int ch = 0; ch < numChans; ++ch)
+            for (int i = 0; i < numSamples; ++i)
+                mono[(size_t) i] += buffer.getSample (ch, i) / (float) numChans;
+
+        profile.sampleRate = reader->sampleRate;
+        profile.numSamples = numSamples;
+
+        // Whole-file and windowed RMS
+        double total = 0.0;
+        const int window = (int) (0.05 * reader->sampleRate);
+        for (int start = 0; start < numSamples; start += window)
+        {
+            double sum = 0.0;
+            const int end = juce::jmin (numSamples, start + window);
+            for (int i = start; i < end; ++i)
+                sum += (double) mono[(size_t) i] * mono[(size_t) i];
+
+            total += sum;
+            profile.envelopeDb.push_back (toDb (sum / juce::jmax (1, end - start)));
+        }
+        profile.rmsDb = toDb (total / juce::jmax (1, numSamples));
+
+        // Long-term average spectrum, folded into log-spaced bands
+        constexpr int fftOrder = 11;
+        constexpr int fftSize  = 1 << fftOrder;
+        constexpr int numBands = 24;
+        constexpr double lowHz = 50.0, highHz = 16000.0;
+
+        juce::dsp::FFT fft (fftOrder);
+        juce::dsp::WindowingFunction<float> hann (fftSize, juce::dsp::WindowingFunction<float>::hann, false);
+        std::vector<float> frame ((size_t) fftSize * 2);
+        std::vector<double> power ((size_t) fftSize / 2 + 1, 0.0);
+
+        int numFrames = 0;
+        for (int start = 0; start + fftSize <= numSamples; start += fftSize / 2, ++numFrames)
+        {
+            std::fill (frame.begin(), frame.end(), 0.0f);
+            std::copy_n (mono.begin() + start, fftSize, frame.begin());
+            hann.multiplyWithWindowingTable (frame.data(), fftSize);
+            fft.performFrequencyOnlyForwardTransform (frame.data());
+
+            for (size_t bin = 0; bin < power.size(); ++bin)
+                power[bin] += (double) frame[bin] * frame[bin];
+        }
+
+        profile.bandDb.assign (numBands, -200.0f);
+        if (numFrames == 0)
+            return profile;
+
+        const double binHz = reader->sampleRate / fftSize;
+        for (int band = 0; band < numBands; ++band)
+        {
+            const double lo = lowHz * std::pow (highHz / lowHz, (double) band / numBands);
+            const double hi = lowHz * std::pow (highHz / lowHz, (double) (band + 1) / numBands);
+
+            double sum = 0.0;
+            for (size_t bin = (size_t) std::ceil (lo / binHz); bin < power.size() && bin * binHz < hi; ++bin)
+                sum += power[bin];
+
+            profile.bandDb[(size_t) band] = toDb (sum / (numFrames * (double) fftSize * fftSize));
+        }
+
+        return profile;
+    }
+
+    /** Largest |a - b| over entries where the reference is above the silence floor. */
+    float maxDeviationDb (const std::vector<float>& rendered, const std::vector<float>& reference, int& worstIndex)
+    {
+        float worst = 0.0f;
+        worstIndex = -1;
+
+        for (size_t i = 0; i < reference.size(); ++i)
+        {
+            const float ref = reference[i];
+            const float got = i < rendered.size() ? rendered[i] : -200.0f;
+
+            if (ref < silenceFloorDb && got < silenceFloorDb)
+                continue;
+
+            const float dev = std::abs (got - juce::jmax (ref, silenceFloorDb));
+            if (dev > worst)
+            {
+                worst = dev;
+                worstIndex = (int) i;
+            }
+        }
+
+        return worst;
+    }
+
+    //==============================================================================
+    /** Builds a fresh edit with @p build, renders it and diffs it against the named reference. */
+    void checkAgainstGolden (const juce::String& name, const std::function<void (AppEngine&)>& build)
+    {
+        auto& app = sharedAppEngine();
+        app.newUntitledEdit();
+        build (app);
+
+        const auto rendered = juce::File::getSpecialLocation (juce::File::tempDirectory)
+                                  .getChildFile ("gk_golden_" + name + ".wav");
+        rendered.deleteFile();
+        REQUIRE(app.exportAudio (rendered, renderRate));
+        REQUIRE(rendered.existsAsFile());
+
+        const auto reference = referenceDir().getChildFile (name + ".wav");
+
+        if (shouldUpdateReferences())
+        {
+            referenceDir().createDirectory();
+            REQUIRE(rendered.copyFileTo (reference));
+            WARN("Updated golden reference " << reference.getFullPathName());
+            return;
+        }
+
+        // Reported as skipped, not passed: the scene checks nothing until it has a reference
+        if (! reference.existsAsFile())
+            SKIP("No golden reference for '" << name << "'; run with GROOVEKIT_UPDATE_GOLDEN=1 to create it");
+
+        const auto got = analyse (rendered);
+        const auto ref = analyse (reference);
+
+        INFO("golden: " << name);
+        REQUIRE(got.sampleRate == ref.sampleRate);
+        CHECK(std::abs (got.numSamples - ref.numSamples) <= lengthToleranceSamples);
+        CHECK(std::abs (got.rmsDb - ref.rmsDb) <= levelToleranceDb);
+
+        int worstWindow = -1;
+        const float envelopeDev = maxDeviationDb (got.envelopeDb, ref.envelopeDb, worstWindow);
+        INFO("worst envelope window: " << worstWindow << " (" << envelopeDev << " dB)");
+        CHECK(envelopeDev <= envelopeToleranceDb);
+
+        int worstBand = -1;
+        const float spectralDev = maxDeviationDb (got.bandDb, ref.bandDb, worstBand);
+        INFO("worst spectral band: " << worstBand << " (" << spectralDev << " dB)");
+        CHECK(spectralDev <= spectralToleranceDb);
+    }
+
+    //==============================================================================
+    // Scene helpers
+
+    te::MidiClip* addClip (AppEngine& app, int trackIndex, double lengthBeats)
+    {
+        REQUIRE(app.addMidiClipToTrackAt (trackIndex, t::TimePosition(), t::BeatDuration::fromBeats (lengthBeats)));
+        auto* clip = app.getMidiClipFromTrack (trackIndex);
+        REQUIRE(clip != nullptr);
+        return clip;
+    }
+
+    void addNote (te::MidiClip& clip, int note, double startBeat, double lengthBeats, int velocity = 100)
+    {
+        clip.getSequence().addNote (note,
+                                    t::BeatPosition::fromBeats (startBeat),
+                                    t::BeatDuration::fromBeats (lengthBeats),
+                                    velocity, 0, nullptr);
+    }
+
+    void setParam (te::Plugin* plugin, const char* paramID, float value)
+    {
+        auto* synth = dynamic_cast<MorphSynthPlugin*> (plugin);
+        REQUIRE(synth != nullptr);
+
+        auto* param = synth->getParameterFromID (paramID);
+        REQUIRE(param != nullptr);
+        param->setParameter (value, juce::dontSendNotification);
+    }
+
+    /** First default sample in @p category (e.g. "Kicks"), in path order. */
+    juce::File defaultSample (const juce::String& category)
+    {
+        DefaultSampleLibrary::ensureInstalled();
+
+        auto files = DefaultSampleLibrary::listAll();
+        files.sort();
+
+        for (const auto& f : files)
+            if (f.getParentDirectory().getFileName() == category)
+                return DefaultSampleLibrary::materialise (f);
+
+        return {};
+    }
+}
+
+//==============================================================================
+TEST_CASE("Golden render: MorphSynth default patch chords", "[.golden][integration]")
+{
+    checkAgainstGolden ("morphsynth_default_chords", [] (AppEngine& app)
+    {
+        auto& tm = app.getTrackManager();
+        const int idx = tm.addInstrumentTrack();
+        REQUIRE(tm.insertMorphSynth (idx) != nullptr);
+
+        auto* clip = addClip (app, idx, 16.0);
+
+        // C - F - G - Am, one bar each
+        const int chords[4][3] = { { 60, 64, 67 }, { 60, 65, 69 }, { 59, 62, 67 }, { 57, 60, 64 } };
+        for (int bar = 0; bar < 4; ++bar)
+            for (int note : chords[bar])
+                addNote (*clip, note, bar * 4.0, 3.5);
+    });
+}
+
+TEST_CASE("Golden render: MorphSynth modulated lead", "[.golden][integration]")
+{
+    checkAgainstGolden ("morphsynth_modulated_lead", [] (AppEngine& app)
+    {
+        auto& tm = app.getTrackManager();
+        const int idx = tm.addInstrumentTrack();
+        auto* synth = tm.insertMorphSynth (idx);
+        REQUIRE(synth != nullptr);
+
+        setParam (synth, "oscAType",  2.0f);   // Saw
+        setParam (synth, "oscBType",  3.0f);   // Pulse
+        setParam (synth, "morph",     0.6f);
+        setParam (synth, "pulseWidth", 0.3f);
+        setParam (synth, "cutoff",    900.0f);
+        setParam (synth, "resonance", 1.0f);
+        setParam (synth, "fEnvAmt",   0.8f);
+        setParam (synth, "glide",     60.0f);
+        setParam (synth, "lfoTarget", 3.0f);   // Cutoff
+        setParam (synth, "lfoDepth",  0.5f);
+        setParam (synth, "lfoRate",   3.0f);
+
+        auto* clip = addClip (app, idx, 8.0);
+
+        const int line[] = { 48, 55, 60, 63, 67, 63, 60, 55, 50, 57, 62, 65, 69, 65, 62, 57 };
+        for (int i = 0; i < 16; ++i)
+            addNote (*clip, line[i], i * 0.5, 0.45, 80 + (i % 4) * 10);
+    });
+}
+
+TEST_CASE("Golden render: default drum kit pattern", "[.golden][integration]")
+{
+    checkAgainstGolden ("drumkit_default_pattern", [] (AppEngine& app)
+    {
+        auto& tm = app.getTrackManager();
+        const int idx = tm.addDrumTrack();
+        auto* drums = tm.getDrumAdapter (idx);
+        REQUIRE(drums != nullptr);
+
+        const juce::String kit[] = { "Kicks", "Snares", "HiHats" };
+        for (int pad = 0; pad < 3; ++pad)
+        {
+            const auto sample = defaultSample (kit[pad]);
+            REQUIRE(sample.existsAsFile());
+            drums->loadSampleIntoSlot (pad, sample);
+        }
+
+        auto* clip = addClip (app, idx, 8.0);
+
+        for (int beat = 0; beat < 8; ++beat)
+        {
+            addNote (*clip, padToMidiNote (beat % 2 == 0 ? 0 : 1), beat, 0.25, 110);
+            addNote (*clip, padToMidiNote (2), beat,       0.125, 90);
+            addNote (*clip, padToMidiNote (2), beat + 0.5, 0.125, 60);
+        }
+    });
+}
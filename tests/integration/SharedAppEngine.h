@@ -0,0 +1,15 @@
+#pragma once
+
+#include "AppEngine/AppEngine.h"
+
+/**
+ * One AppEngine (and te::Engine) for the whole integration test run; each test
+ * starts from newUntitledEdit(). Creating an engine per test is slow and Tracktion
+ * doesn't expect several in one process.
+ */
+inline AppEngine& sharedAppEngine()
+{
+    static juce::ScopedJuceInitialiser_GUI juceInit;
+    static AppEngine app;
+    return app;
+}
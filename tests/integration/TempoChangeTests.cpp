@@ -0,0 +1,125 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include "AppEngine/AppEngine.h"
+#include "SharedAppEngine.h"
+
+#include <vector>
+
+// Changing the project tempo must leave everything where it is in bars/beats:
+// clip starts and lengths, the notes inside them, the loop range and a stopped
+// playhead. Only their positions in seconds should follow the new tempo.
+
+namespace
+{
+    using Catch::Matchers::WithinAbs;
+
+    constexpr double beatTolerance = 1.0e-6;
+
+    struct ClipBeats
+    {
+        double start, end, firstNote;
+    };
+
+    std::vector<ClipBeats> snapshotClips (AppEngine& app, int trackIndex)
+    {
+        auto& tempoMap = app.getTempoMap();
+        std::vector<ClipBeats> result;
+
+        for (auto* clip : app.getMidiClipsFromTrack (trackIndex))
+        {
+            const auto pos = clip->getPosition();
+            const auto& notes = clip->getSequence().getNotes();
+
+            result.push_back ({ tempoMap.toBeats (pos.getStart()).inBeats(),
+                                tempoMap.toBeats (pos.getEnd()).inBeats(),
+                                notes.isEmpty() ? 0.0 : notes.getFirst()->getStartBeat().inBeats() });
+        }
+
+        return result;
+    }
+}
+
+//==============================================================================
+TEST_CASE("Clips stay on their beats across 100 BPM changes", "[tempo][integration]")
+{
+    auto& app = sharedAppEngine();
+    app.newUntitledEdit();
+    app.setBpm (120.0);
+
+    auto& tempoMap = app.getTempoMap();
+    const int idx = app.getTrackManager().addInstrumentTrack();
+
+    // Clips at bars 1, 3 and 6 with a note a beat into each
+    for (double startBeat : { 0.0, 8.0, 20.0 })
+    {
+        REQUIRE(app.addMidiClipToTrackAt (idx, tempoMap.toTime (t::BeatPosition::fromBeats (startBeat)),
+                                          t::BeatDuration::fromBeats (4.0)));
+    }
+
+    for (auto* clip : app.getMidiClipsFromTrack (idx))
+        clip->getSequence().addNote (60, t::BeatPosition::fromBeats (1.0), t::BeatDuration::fromBeats (0.5), 100, 0, nullptr);
+
+    auto& transport = app.getEdit().getTransport();
+    transport.setLoopRange ({ tempoMap.toTime (t::BeatPosition::fromBeats (4.0)),
+                              tempoMap.toTime (t::BeatPosition::fromBeats (12.0)) });
+    transport.setPosition (tempoMap.toTime (t::BeatPosition::fromBeats (6.0)));
+
+    const auto before = snapshotClips (app, idx);
+    REQUIRE(before.size() == 3);
+
+    juce::Random rng (0x6b1d);
+    for (int i = 0; i < 100; ++i)
+        app.setBpm (60.0 + rng.nextInt (140));
+
+    app.setBpm (90.0);
+    REQUIRE_THAT(app.getBpm(), WithinAbs (90.0, 1.0e-9));
+
+    const auto after = snapshotClips (app, idx);
+    REQUIRE(after.size() == before.size());
+
+    for (size_t i = 0; i < before.size(); ++i)
+    {
+        INFO("clip " << i);
+        CHECK_THAT(after[i].start,     WithinAbs (before[i].start, beatTolerance));
+        CHECK_THAT(after[i].end,       WithinAbs (before[i].end, beatTolerance));
+        CHECK_THAT(after[i].firstNote, WithinAbs (before[i].firstNote, beatTolerance));
+    }
+
+    // Seconds follow the tempo: bar 3 at 90 BPM is 8 beats * (60 / 90) s
+    CHECK_THAT(app.getMidiClipsFromTrack (idx)[1]->getPosition().getStart().inSeconds(), WithinAbs (8.0 * 60.0 / 90.0, 1.0e-6));
+
+    CHECK_THAT(tempoMap.toBeats (transport.getLoopRange().getStart()).inBeats(), WithinAbs (4.0, beatTolerance));
+    CHECK_THAT(tempoMap.toBeats (transport.getLoopRange().getEnd()).inBeats(),   WithinAbs (12.0, beatTolerance));
+    CHECK_THAT(tempoMap.toBeats (transport.getPosition()).inBeats(),             WithinAbs (6.0, beatTolerance));
+}
+
+TEST_CASE("A tempo drag moves clips once, when it ends", "[tempo][integration]")
+{
+    auto& app = sharedAppEngine();
+    app.newUntitledEdit();
+    app.setBpm (120.0);
+
+    auto& tempoMap = app.getTempoMap();
+    const int idx = app.getTrackManager().addInstrumentTrack();
+
+    REQUIRE(app.addMidiClipToTrackAt (idx, tempoMap.toTime (t::BeatPosition::fromBeats (8.0)),
+                                      t::BeatDuration::fromBeats (4.0)));
+    auto* clip = app.getMidiClipFromTrack (idx);
+    REQUIRE(clip != nullptr);
+
+    const double startSeconds = clip->getPosition().getStart().inSeconds();
+
+    tempoMap.beginGesture();
+    for (int i = 0; i < 20; ++i)
+        tempoMap.setTempoChangeBpm (0, 120.0 + i * 2.0);
+
+    // Mid-drag only the tempo has moved
+    CHECK_THAT(clip->getPosition().getStart().inSeconds(), WithinAbs (startSeconds, 1.0e-9));
+
+    tempoMap.endGesture();
+    REQUIRE_FALSE(tempoMap.isInGesture());
+
+    CHECK_THAT(tempoMap.toBeats (clip->getPosition().getStart()).inBeats(), WithinAbs (8.0, beatTolerance));
+    CHECK_THAT(clip->getPosition().getStart().inSeconds(), WithinAbs (8.0 * 60.0 / 158.0, 1.0e-6));
+}
@@ -0,0 +1,112 @@
+#include <catch2/catch_test_macros.hpp>
+#include "AudioEngine/AsyncLog.h"
+
+#include <thread>
+
+namespace
+{
+    /** Collects the sink's lines for one test and restores juce::Logger afterwards. */
+    struct CapturedLog
+    {
+        CapturedLog()
+        {
+            AsyncLog::getInstance().flush();
+            AsyncLog::getInstance().setSink ([this] (const juce::String& line)
+            {
+                const std::lock_guard<std::mutex> sl (lock);
+                lines.add (line);
+            });
+        }
+
+        ~CapturedLog()
+        {
+            AsyncLog::getInstance().setSink (nullptr);
+        }
+
+        juce::StringArray flush()
+        {
+            AsyncLog::getInstance().flush();
+            const std::lock_guard<std::mutex> sl (lock);
+            return lines;
+        }
+
+        std::mutex lock;
+        juce::StringArray lines;
+    };
+}
+
+TEST_CASE("AsyncLog formats lines without juce::String", "[asynclog]")
+{
+    const auto oldLevel = AsyncLog::getLevel();
+    AsyncLog::setLevel (AsyncLog::Level::info);
+    CapturedLog log;
+
+    GROOVEKIT_LOG (info, "MidiRecorder", "NOTE ON: Note=" << 60 << " Velocity=" << AsyncLog::fixed (0.787, 2)
+                                         << " Channel=" << (size_t) 1 << " " << -1.5f << " " << true);
+    GROOVEKIT_LOG (warning, "Audio", "Device not found: " << juce::String ("Built-in"));
+    GROOVEKIT_LOG (debug, "Audio", "filtered out at runtime");
+
+    const auto lines = log.flush();
+    AsyncLog::setLevel (oldLevel);
+
+    REQUIRE(lines.size() == 2);
+    CHECK(lines[0] == "[MidiRecorder] NOTE ON: Note=60 Velocity=0.79 Channel=1 -1.500 true");
+    CHECK(lines[1] == "[Audio] WARNING: Device not found: Built-in");
+}
+
+TEST_CASE("AsyncLog keeps every line of concurrent threads, in order", "[asynclog]")
+{
+    const auto oldLevel = AsyncLog::getLevel();
+    AsyncLog::setLevel (AsyncLog::Level::info);
+    CapturedLog log;
+
+    const auto droppedBefore = AsyncLog::getInstance().getStats().dropped;
+
+    // Two producers at once; ringSize - 1 lines each fit even if the drain never runs
+    auto produce = [] (const char* tag)
+    {
+        const AsyncLog::ThreadScope scope;
+
+        for (int i = 0; i < AsyncLog::ringSize - 1; ++i)
+            GROOVEKIT_LOG (info, tag, i);
+    };
+
+    std::thread a (produce, "A"), b (produce, "B");
+    a.join();
+    b.join();
+
+    auto lines = log.flush();
+    CHECK(lines.size() == 2 * (AsyncLog::ringSize - 1));
+
+    for (auto* tag : { "[A] ", "[B] " })
+    {
+        int expected = 0;
+        for (auto& line : lines)
+            if (line.startsWith (tag))
+                CHECK(line.fromFirstOccurrenceOf (" ", false, false).getIntValue() == expected++);
+
+        CHECK(expected == AsyncLog::ringSize - 1);
+    }
+
+    CHECK(AsyncLog::getInstance().getStats().dropped == droppedBefore);
+    AsyncLog::setLevel (oldLevel);
+}
+
+TEST_CASE("AsyncLog rings go back when their thread detaches", "[asynclog]")
+{
+    const int before = AsyncLog::getInstance().getStats().threads;
+
+    int whileAttached = 0;
+
+    // Catch's assertions aren't thread-safe: only read the count on the thread
+    std::thread t ([&whileAttached]
+    {
+        AsyncLog::attachThread();
+        whileAttached = AsyncLog::getInstance().getStats().threads;
+        AsyncLog::detachThread();
+    });
+    t.join();
+
+    CHECK(whileAttached == before + 1);
+    CHECK(AsyncLog::getInstance().getStats().threads == before);
+}
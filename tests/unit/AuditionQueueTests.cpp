@@ -0,0 +1,56 @@
+#include <catch2/catch_test_macros.hpp>
+#include "MIDIEngine/AuditionQueue.h"
+
+#include <vector>
+
+namespace
+{
+    struct Event
+    {
+        juce::int64 sample;
+        bool isOn;
+        int note;
+    };
+}
+
+TEST_CASE("Audition queue plays each drag step within one block and ends it in samples", "[audition]")
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int    blockSize  = 512;
+
+    AuditionQueue queue;
+
+    // A drag across three pitches, 2 ms apart, all before the next block
+    REQUIRE(queue.post (60, 100, 0.1, true, 1000.0));
+    REQUIRE(queue.post (61, 100, 0.1, true, 1002.0));
+    REQUIRE(queue.post (62, 100, 0.1, true, 1004.0));
+
+    std::vector<Event> events;
+    juce::MidiBuffer block;
+    block.ensureSize (1024);
+
+    for (int b = 0; b < 12; ++b)
+    {
+        block.clear();
+        queue.render (block, 0, blockSize, sampleRate);
+
+        for (const auto meta : block)
+        {
+            const auto m = meta.getMessage();
+            events.push_back ({ (juce::int64) b * blockSize + meta.samplePosition, m.isNoteOn(), m.getNoteNumber() });
+        }
+    }
+
+    REQUIRE(events.size() == 6);
+
+    // Each step chokes the one before it at its own offset (2 ms = 96 samples)
+    REQUIRE((events[0].isOn && events[0].note == 60 && events[0].sample == 0));
+    REQUIRE((! events[1].isOn && events[1].note == 60 && events[1].sample == 96));
+    REQUIRE((events[2].isOn && events[2].note == 61 && events[2].sample == 96));
+    REQUIRE((! events[3].isOn && events[3].note == 61 && events[3].sample == 192));
+    REQUIRE((events[4].isOn && events[4].note == 62 && events[4].sample == 192));
+
+    // The last one runs its full length across blocks
+    REQUIRE((! events[5].isOn && events[5].note == 62 && events[5].sample == 192 + 4800));
+    REQUIRE_FALSE(queue.isSounding());
+}
@@ -0,0 +1,81 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "AppEngine/AutomationRecorder.h"
+#include "UI/TrackView/AutomationLaneComponent.h"
+
+#include <cmath>
+
+TEST_CASE("Recorded automation is thinned within tolerance", "[automation]")
+{
+    // A knob swept up in a straight line, then held, one point per millisecond
+    std::vector<AutomationRecorder::Point> take;
+    for (int i = 0; i <= 1000; ++i)
+        take.push_back ({ i * 0.001, i < 500 ? (float) i / 500.0f : 1.0f });
+
+    constexpr float tolerance = 0.005f;
+    const auto thinned = AutomationRecorder::simplify (take, tolerance);
+
+    // Ramp start, corner, end of the hold
+    REQUIRE(thinned.size() == 3);
+    REQUIRE(thinned.front().time == take.front().time);
+    REQUIRE(thinned.back().time == take.back().time);
+
+    // A wobble larger than the tolerance keeps its shape
+    std::vector<AutomationRecorder::Point> wobble;
+    for (int i = 0; i <= 400; ++i)
+        wobble.push_back ({ i * 0.001, 0.5f + 0.25f * (float) std::sin (i * 0.05) });
+
+    const auto kept = AutomationRecorder::simplify (wobble, tolerance);
+    REQUIRE(kept.size() < wobble.size() / 4);
+
+    for (size_t k = 1; k < kept.size(); ++k)
+    {
+        for (const auto& p : wobble)
+        {
+            if (p.time <= kept[k - 1].time || p.time >= kept[k].time)
+                continue;
+
+            const double proportion = (p.time - kept[k - 1].time) / (kept[k].time - kept[k - 1].time);
+            const auto line = (float) (kept[k - 1].value + (kept[k].value - kept[k - 1].value) * proportion);
+            REQUIRE(std::abs (p.value - line) <= tolerance);
+        }
+    }
+}
+
+TEST_CASE("Automation lane decimates a curve to min/max per pixel column", "[automation]")
+{
+    using Lane = AutomationLaneComponent;
+
+    // Ramp 0 -> 1 over beats 1..2, spike at beat 3, then hold
+    const std::vector<Lane::Point> points { { 1.0, 0.0f }, { 2.0, 1.0f }, { 3.0, 0.2f }, { 3.01, 0.9f }, { 3.02, 0.2f } };
+    constexpr double ppb = 10.0;
+
+    const auto columns = Lane::decimate (points, ppb, 0, 50);
+    REQUIRE(columns.size() == 50);
+
+    // Held at the first value before the first point
+    REQUIRE(columns[0].min == 0.0f);
+    REQUIRE(columns[0].max == 0.0f);
+
+    // Mid-ramp column spans its edge values
+    REQUIRE(columns[15].min == Catch::Approx (0.5f));
+    REQUIRE(columns[15].max == Catch::Approx (0.6f));
+
+    // The spike is narrower than a pixel but still shows in full
+    REQUIRE(columns[30].max == Catch::Approx (0.9f));
+    REQUIRE(columns[30].min == Catch::Approx (0.2f));
+
+    // Held at the last value after the last point
+    REQUIRE(columns[49].min == Catch::Approx (0.2f));
+    REQUIRE(columns[49].max == Catch::Approx (0.2f));
+
+    // A window further along matches the same columns of the full pass
+    const auto window = Lane::decimate (points, ppb, 12, 25);
+    REQUIRE(window.size() == 25);
+
+    for (size_t i = 0; i < window.size(); ++i)
+    {
+        REQUIRE(window[i].min == Catch::Approx (columns[i + 12].min));
+        REQUIRE(window[i].max == Catch::Approx (columns[i + 12].max));
+    }
+}
@@ -0,0 +1,56 @@
+#include <catch2/catch_test_macros.hpp>
+#include "AppEngine/ClipIndex.h"
+#include "../integration/SharedAppEngine.h"
+
+namespace
+{
+    t::TimeRange seconds (double start, double end)
+    {
+        return { t::TimePosition::fromSeconds (start), t::TimePosition::fromSeconds (end) };
+    }
+}
+
+TEST_CASE("Clip index answers overlap, position and free-slot queries", "[clipindex]")
+{
+    auto& app = sharedAppEngine();
+    app.newUntitledEdit();
+    auto& edit = app.getEdit();
+
+    edit.ensureNumberOfAudioTracks (1);
+    auto& track = *te::getAudioTracks (edit).getFirst();
+
+    // Clips at 0-1, 2-3 and 5-6 s
+    auto a = track.insertMIDIClip ("A", seconds (0.0, 1.0), nullptr);
+    auto b = track.insertMIDIClip ("B", seconds (2.0, 3.0), nullptr);
+    auto c = track.insertMIDIClip ("C", seconds (5.0, 6.0), nullptr);
+    REQUIRE((a != nullptr && b != nullptr && c != nullptr));
+
+    ClipIndex index (edit);
+
+    CHECK(index.overlaps (track, seconds (0.5, 1.5)));
+    CHECK_FALSE(index.overlaps (track, seconds (1.0, 2.0)));            // touching isn't overlapping
+    CHECK_FALSE(index.overlaps (track, seconds (2.5, 2.8), b.get()));   // the clip being moved is skipped
+    CHECK(index.getOverlapping (track, seconds (0.5, 5.5)) == juce::Array<te::Clip*> { a.get(), b.get(), c.get() });
+
+    CHECK(index.getClipAt (track, t::TimePosition::fromSeconds (2.0)) == b.get());
+    CHECK(index.getClipAt (track, t::TimePosition::fromSeconds (3.0)) == nullptr);
+
+    CHECK(index.getNextClipStart (track, t::TimePosition::fromSeconds (0.0)) == t::TimePosition::fromSeconds (2.0));
+    CHECK(index.getNextClipStart (track, t::TimePosition::fromSeconds (2.0), b.get()) == t::TimePosition::fromSeconds (5.0));
+    CHECK_FALSE(index.getNextClipStart (track, t::TimePosition::fromSeconds (5.0)).has_value());
+
+    // 1.5 s doesn't fit in the 1-2 s gap but does between B and C; 2 s only fits after C
+    CHECK(index.findFreeSlot (track, t::TimePosition::fromSeconds (0.5), t::TimeDuration::fromSeconds (1.5))
+          == t::TimePosition::fromSeconds (3.0));
+    CHECK(index.findFreeSlot (track, t::TimePosition::fromSeconds (3.5), t::TimeDuration::fromSeconds (2.0))
+          == t::TimePosition::fromSeconds (6.0));
+
+    // Edits reach the index: moving B away frees its slot, deleting C frees the rest
+    b->setStart (t::TimePosition::fromSeconds (10.0), false, true);
+    CHECK(index.getClipAt (track, t::TimePosition::fromSeconds (2.0)) == nullptr);
+    CHECK(index.getClipAt (track, t::TimePosition::fromSeconds (10.5)) == b.get());
+
+    c->removeFromParent();
+    CHECK(index.findFreeSlot (track, t::TimePosition::fromSeconds (3.5), t::TimeDuration::fromSeconds (2.0))
+          == t::TimePosition::fromSeconds (3.5));
+}
@@ -0,0 +1,68 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "MIDIEngine/MacroBank.h"
+
+#include <map>
+
+namespace
+{
+    std::map<int, float> evaluate (const MacroBank& bank)
+    {
+        std::map<int, float> values;
+        bank.evaluate ([&values] (int slot, float value) { values[slot] = value; });
+        return values;
+    }
+}
+
+TEST_CASE("Macro bank evaluates every target from its table", "[macro]")
+{
+    MacroBank bank;
+    REQUIRE(evaluate (bank).empty());
+
+    bank.setTargets ({
+        { 0, 1, 0.2f, 0.8f, MacroBank::Curve::linear, {} },
+        { 0, 2, 1.0f, 0.0f, MacroBank::Curve::exponential, {} },
+        { 1, 3, 0.0f, 1.0f, MacroBank::Curve::linear, [] (float v) { return 20.0f + v * 100.0f; } },
+        { MacroBank::numMacros, 4, 0.0f, 1.0f, MacroBank::Curve::linear, {} }     // no such macro: ignored
+    });
+
+    auto values = evaluate (bank);
+    REQUIRE(values.size() == 3);
+    REQUIRE(values[1] == Catch::Approx (0.2f));
+    REQUIRE(values[2] == Catch::Approx (1.0f));
+    REQUIRE(values[3] == Catch::Approx (20.0f));
+
+    // One value moves every target on that macro, each along its own range and curve
+    bank.setMacroValue (0, 0.5f);
+    values = evaluate (bank);
+    REQUIRE(values[1] == Catch::Approx (0.5f));
+    REQUIRE(values[2] == Catch::Approx (0.75f));
+    REQUIRE(values[3] == Catch::Approx (20.0f));
+
+    // Between table entries the value is interpolated; past the ends it holds
+    bank.setMacroValue (1, 0.3f);
+    REQUIRE(evaluate (bank)[3] == Catch::Approx (50.0f).margin (1.0e-3));
+
+    bank.setMacroValue (1, 2.0f);
+    REQUIRE(bank.getMacroValue (1) == 1.0f);
+    REQUIRE(evaluate (bank)[3] == Catch::Approx (120.0f));
+
+    bank.setTargets ({});
+    REQUIRE(evaluate (bank).empty());
+}
+
+TEST_CASE("Macro curves keep their ends and their shape", "[macro]")
+{
+    using Curve = MacroBank::Curve;
+
+    for (auto curve : { Curve::linear, Curve::exponential, Curve::logarithmic, Curve::sCurve })
+    {
+        REQUIRE(MacroBank::shape (curve, 0.0f) == 0.0f);
+        REQUIRE(MacroBank::shape (curve, 1.0f) == 1.0f);
+    }
+
+    REQUIRE(MacroBank::shape (Curve::exponential, 0.5f) < 0.5f);
+    REQUIRE(MacroBank::shape (Curve::logarithmic, 0.5f) > 0.5f);
+    REQUIRE(MacroBank::shape (Curve::sCurve, 0.5f) == Catch::Approx (0.5f));
+    REQUIRE(MacroBank::shape (Curve::sCurve, 0.25f) < 0.25f);
+}
@@ -0,0 +1,144 @@
+#include <catch2/catch_test_macros.hpp>
+#include "MIDIEngine/MidiFxProcessor.h"
+
+#include <vector>
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int    blockSize  = 512;
+    constexpr double bpm        = 120.0;
+    constexpr double beatsPerSample = bpm / 60.0 / sampleRate;   // 24000 samples per beat
+
+    struct Event
+    {
+        juce::int64 sample;
+        bool isOn;
+        int note;
+    };
+
+    /** Runs @p numBlocks blocks from beat 0. @p input holds absolute-sample events. */
+    std::vector<Event> run (MidiFxProcessor& fx, const MidiFxProcessor::Settings& settings,
+                            const std::vector<std::pair<juce::int64, juce::MidiMessage>>& input, int numBlocks)
+    {
+        std::vector<Event> out;
+        juce::MidiBuffer in, result;
+        result.ensureSize (8192);
+
+        for (int b = 0; b < numBlocks; ++b)
+        {
+            const juce::int64 blockStart = (juce::int64) b * blockSize;
+
+            in.clear();
+            for (auto& [sample, msg] : input)
+                if (sample >= blockStart && sample < blockStart + blockSize)
+                    in.addEvent (msg, (int) (sample - blockStart));
+
+            fx.process (settings, in, result, blockSize, (double) blockStart * beatsPerSample, beatsPerSample);
+
+            for (const auto meta : result)
+            {
+                const auto m = meta.getMessage();
+                if (m.isNoteOnOrOff())
+                    out.push_back ({ blockStart + meta.samplePosition, m.isNoteOn(), m.getNoteNumber() });
+            }
+        }
+
+        return out;
+    }
+}
+
+TEST_CASE("MIDI FX chord mode plays and releases the whole chord", "[midifx]")
+{
+    MidiFxProcessor fx;
+    MidiFxProcessor::Settings s;
+    s.mode  = MidiFxProcessor::Mode::off;
+    s.chord = MidiFxProcessor::Chord::minor;
+
+    const auto events = run (fx, s, { { 100,  juce::MidiMessage::noteOn  (1, 60, (juce::uint8) 100) },
+                                      { 2000, juce::MidiMessage::noteOff (1, 60) } }, 8);
+
+    REQUIRE(events.size() == 6);
+    for (int i = 0; i < 3; ++i)
+    {
+        REQUIRE(events[(size_t) i].isOn);
+        REQUIRE(events[(size_t) i].sample == 100);
+        REQUIRE_FALSE(events[(size_t) i + 3].isOn);
+        REQUIRE(events[(size_t) i + 3].sample == 2000);
+    }
+
+    REQUIRE(events[0].note == 60);
+    REQUIRE(events[1].note == 63);
+    REQUIRE(events[2].note == 67);
+    REQUIRE(fx.getNumSoundingNotes() == 0);
+}
+
+TEST_CASE("MIDI FX arpeggiator steps are sample-accurate on the beat grid", "[midifx]")
+{
+    MidiFxProcessor fx;
+    MidiFxProcessor::Settings s;
+    s.mode      = MidiFxProcessor::Mode::arpeggiator;
+    s.pattern   = MidiFxProcessor::Pattern::up;
+    s.stepBeats = 0.25;
+    s.gate      = 0.5f;
+
+    // C-E-G held (played out of order) for two beats
+    const juce::int64 release = 48000;
+    const auto events = run (fx, s, { { 0, juce::MidiMessage::noteOn (1, 67, (juce::uint8) 100) },
+                                      { 0, juce::MidiMessage::noteOn (1, 60, (juce::uint8) 100) },
+                                      { 0, juce::MidiMessage::noteOn (1, 64, (juce::uint8) 100) },
+                                      { release, juce::MidiMessage::noteOff (1, 60) },
+                                      { release, juce::MidiMessage::noteOff (1, 64) },
+                                      { release, juce::MidiMessage::noteOff (1, 67) } }, 120);
+
+    std::vector<Event> ons;
+    for (auto& e : events)
+        if (e.isOn)
+            ons.push_back (e);
+
+    // Two beats of 1/16ths, lowest note first
+    REQUIRE(ons.size() == 8);
+
+    const int expectedNotes[] = { 60, 64, 67, 60, 64, 67, 60, 64 };
+    for (size_t i = 0; i < ons.size(); ++i)
+    {
+        REQUIRE(ons[i].sample == (juce::int64) i * 6000);   // 1/16 at 120 BPM / 48 kHz
+        REQUIRE(ons[i].note == expectedNotes[i]);
+    }
+
+    // Every note ends after half a step, and nothing is left hanging
+    int numOffs = 0;
+    for (auto& e : events)
+        if (! e.isOn)
+        {
+            REQUIRE((e.sample - 3000) % 6000 == 0);
+            ++numOffs;
+        }
+
+    REQUIRE(numOffs == 8);
+    REQUIRE(fx.getNumSoundingNotes() == 0);
+    REQUIRE(fx.getNumHeldNotes() == 0);
+}
+
+TEST_CASE("MIDI FX note repeat retriggers held notes every step", "[midifx]")
+{
+    MidiFxProcessor fx;
+    MidiFxProcessor::Settings s;
+    s.mode      = MidiFxProcessor::Mode::noteRepeat;
+    s.stepBeats = 0.5;
+
+    const auto events = run (fx, s, { { 0, juce::MidiMessage::noteOn (1, 36, (juce::uint8) 110) },
+                                      { 24000, juce::MidiMessage::noteOff (1, 36) } }, 60);
+
+    int ons = 0;
+    for (auto& e : events)
+        if (e.isOn)
+        {
+            REQUIRE(e.note == 36);
+            REQUIRE(e.sample % 12000 == 0);
+            ++ons;
+        }
+
+    REQUIRE(ons == 2);
+    REQUIRE(fx.getNumSoundingNotes() == 0);
+}
@@ -0,0 +1,52 @@
+#include <catch2/catch_test_macros.hpp>
+#include "AppEngine/MidiLearn.h"
+#include "../integration/SharedAppEngine.h"
+
+TEST_CASE("MIDI learn routes mapped controllers to their parameter, smoothed", "[midi][learn]")
+{
+    auto& app = sharedAppEngine();
+    app.newUntitledEdit();
+    auto& edit = app.getEdit();
+
+    auto master = edit.getMasterVolumePlugin();
+    REQUIRE(master != nullptr);
+
+    auto& volume = *master->volParam;
+    auto& pan = *master->panParam;
+
+    auto& learn = app.getMidiLearn();
+    learn.clearMappings();
+
+    REQUIRE(learn.addMapping (1, 7, volume));
+    REQUIRE_FALSE(learn.addMapping (17, 7, volume));
+    REQUIRE_FALSE(learn.addMapping (1, 128, volume));
+
+    volume.setNormalisedParameter (1.0f, juce::sendNotificationSync);
+
+    // Other channels and controllers go nowhere
+    learn.handleController (2, 7, 0);
+    learn.handleController (1, 8, 0);
+    learn.applyControllerValues();
+    REQUIRE(volume.getCurrentNormalisedValue() == 1.0f);
+
+    // A jump is spread over several ticks, then lands exactly
+    learn.handleController (1, 7, 0);
+    learn.applyControllerValues();
+    const float firstStep = volume.getCurrentNormalisedValue();
+    REQUIRE(firstStep < 1.0f);
+    REQUIRE(firstStep > 0.0f);
+
+    for (int i = 0; i < 200; ++i)
+        learn.applyControllerValues();
+    REQUIRE(volume.getCurrentNormalisedValue() == 0.0f);
+
+    // Mapping the CC elsewhere replaces the old mapping
+    REQUIRE(learn.addMapping (1, 7, pan));
+    REQUIRE(learn.getMappings().size() == 1);
+    REQUIRE(learn.getMappings().front().param.get() == &pan);
+
+    learn.clearMappings();
+    learn.handleController (1, 7, 127);
+    learn.applyControllerValues();
+    REQUIRE(volume.getCurrentNormalisedValue() == 0.0f);
+}
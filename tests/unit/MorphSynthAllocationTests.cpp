@@ -0,0 +1,199 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../integration/SharedAppEngine.h"
+#include "UI/Plugins/Synthesizer/MorphSynthPlugin.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Global allocation hooks: only allocations made while `countThisThread` is set
+// on the calling thread are counted, so setup/teardown and other threads are ignored.
+//
+// juce::MidiBuffer and juce::HeapBlock grow with std::malloc/std::realloc, not
+// operator new, so on glibc the C allocator itself is interposed (forwarding to
+// glibc's own entry points) and operator new is counted through it. Elsewhere
+// only operator new is seen, and the C-allocator check below is skipped.
+namespace
+{
+    thread_local bool countThisThread = false;
+    std::atomic<long> allocationCount { 0 };
+
+    struct ScopedAllocationCounter
+    {
+        ScopedAllocationCounter()  { countThisThread = true; }
+        ~ScopedAllocationCounter() { countThisThread = false; }
+    };
+
+   #if defined (__GLIBC__)
+    constexpr bool countsCAllocator = true;
+   #else
+    constexpr bool countsCAllocator = false;
+   #endif
+}
+
+#if defined (__GLIBC__)
+extern "C"
+{
+    void* __libc_malloc (std::size_t) noexcept;
+    void* __libc_calloc (std::size_t, std::size_t) noexcept;
+    void* __libc_realloc (void*, std::size_t) noexcept;
+
+    void* malloc (std::size_t size) noexcept
+    {
+        if (countThisThread)
+            ++allocationCount;
+
+        return __libc_malloc (size);
+    }
+
+    void* calloc (std::size_t num, std::size_t size) noexcept
+    {
+        if (countThisThread)
+            ++allocationCount;
+
+        return __libc_calloc (num, size);
+    }
+
+    void* realloc (void* p, std::size_t size) noexcept
+    {
+        if (countThisThread)
+            ++allocationCount;
+
+        return __libc_realloc (p, size);
+    }
+}
+#endif
+
+void* operator new (std::size_t size)
+{
+    // With the C allocator interposed, the malloc below is what gets counted
+    if (countThisThread && ! countsCAllocator)
+        ++allocationCount;
+
+    if (auto* p = std::malloc (size > 0 ? size : 1))
+        return p;
+
+    throw std::bad_alloc();
+}
+
+void operator delete (void* p) noexcept                 { std::free (p); }
+void operator delete (void* p, std::size_t) noexcept    { std::free (p); }
+
+TEST_CASE("MorphSynth render path does not allocate", "[morphsynth][realtime]")
+{
+    auto& app = sharedAppEngine();
+    app.newUntitledEdit();
+
+    auto plugin = app.getEdit().getPluginCache().createNewPlugin (MorphSynthPlugin::pluginType, {});
+    auto* morph = dynamic_cast<MorphSynthPlugin*> (plugin.get());
+    REQUIRE(morph != nullptr);
+
+    constexpr double sampleRate = 48000.0;
+    constexpr int    blockSize  = 512;
+    constexpr int    numBlocks  = (int) (2.0 * 60.0 * sampleRate / blockSize); // two minutes
+
+    te::PluginInitialisationInfo info;
+    info.sampleRate       = sampleRate;
+    info.blockSizeSamples = blockSize;
+    morph->initialise (info);
+
+    // Everything the "audio thread" touches is allocated up front.
+    juce::AudioBuffer<float> buffer (2, blockSize);
+    te::MidiMessageArray midi;
+    const auto source = te::createUniqueMPESourceID();
+
+    // Warm-up block so any one-off lazy init inside JUCE/TE happens before counting.
+    {
+        midi.addMidiMessage (juce::MidiMessage::noteOn (1, 60, (juce::uint8) 100), 0.0, source);
+        te::PluginRenderContext rc (&buffer, juce::AudioChannelSet::stereo(), 0, blockSize,
+                                    &midi, 0.0, {}, true, false, false, false);
+        morph->applyToBuffer (rc);
+    }
+
+    float peak = 0.0f;
+    allocationCount = 0;
+
+    for (int block = 0; block < numBlocks; ++block)
+    {
+        buffer.clear();
+        midi.clear();
+
+        // Dense MIDI: four note-ons and four note-offs per block, spread across the block.
+        for (int i = 0; i < 4; ++i)
+        {
+            const int onNote  = 36 + ((block * 4 + i) % 48);
+            const int offNote = 36 + (((block - 2) * 4 + i + 48) % 48);
+            const double onTime  = (i * 2)     * (blockSize / 8) / sampleRate;
+            const double offTime = (i * 2 + 1) * (blockSize / 8) / sampleRate;
+
+            midi.addMidiMessage (juce::MidiMessage::noteOff (1, offNote), offTime, source);
+            midi.addMidiMessage (juce::MidiMessage::noteOn (1, onNote, (juce::uint8) 100), onTime, source);
+        }
+
+        // Expression on the same channel: bend, pressure and slide every block
+        const double exprTime = (blockSize / 2) / sampleRate;
+        midi.addMidiMessage (juce::MidiMessage::pitchWheel (1, 8192 + (block % 64) * 64), exprTime, source);
+        midi.addMidiMessage (juce::MidiMessage::channelPressureChange (1, block % 128), exprTime, source);
+        midi.addMidiMessage (juce::MidiMessage::controllerEvent (1, 74, (block * 3) % 128), exprTime, source);
+
+        te::PluginRenderContext rc (&buffer, juce::AudioChannelSet::stereo(), 0, blockSize,
+                                    &midi, 0.0, {}, true, false, false, false);
+
+        {
+            ScopedAllocationCounter counter;
+            morph->applyToBuffer (rc);
+        }
+
+        peak = juce::jmax (peak, buffer.getMagnitude (0, blockSize));
+    }
+
+    morph->deinitialise();
+
+    REQUIRE(allocationCount.load() == 0);
+    REQUIRE(peak > 0.0f); // sanity: the synth actually rendered something
+}
+
+TEST_CASE("Allocation counter sees MIDI scratch growing past its reserve", "[morphsynth][realtime]")
+{
+    if (! countsCAllocator)
+        SKIP("The C allocator is only counted on glibc");
+
+    auto& app = sharedAppEngine();
+    app.newUntitledEdit();
+
+    auto plugin = app.getEdit().getPluginCache().createNewPlugin (MorphSynthPlugin::pluginType, {});
+    auto* morph = dynamic_cast<MorphSynthPlugin*> (plugin.get());
+    REQUIRE(morph != nullptr);
+
+    constexpr double sampleRate = 48000.0;
+    constexpr int    blockSize  = 512;
+
+    te::PluginInitialisationInfo info;
+    info.sampleRate       = sampleRate;
+    info.blockSizeSamples = blockSize;
+    morph->initialise (info);
+
+    juce::AudioBuffer<float> buffer (2, blockSize);
+    te::MidiMessageArray midi;
+    const auto source = te::createUniqueMPESourceID();
+
+    // Four times the events initialise() reserved room for (one per sample): the
+    // scratch buffer has to realloc, which operator new never sees
+    for (int i = 0; i < blockSize * 4; ++i)
+        midi.addMidiMessage (juce::MidiMessage::channelPressureChange (1, i % 128),
+                             (i % blockSize) / sampleRate, source);
+
+    te::PluginRenderContext rc (&buffer, juce::AudioChannelSet::stereo(), 0, blockSize,
+                                &midi, 0.0, {}, true, false, false, false);
+
+    allocationCount = 0;
+
+    {
+        ScopedAllocationCounter counter;
+        morph->applyToBuffer (rc);
+    }
+
+    morph->deinitialise();
+
+    REQUIRE(allocationCount.load() > 0);
+}
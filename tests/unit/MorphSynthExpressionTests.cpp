@@ -0,0 +1,93 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include "../integration/SharedAppEngine.h"
+#include "UI/Plugins/Synthesizer/MorphSynthPlugin.h"
+
+using Catch::Approx;
+
+TEST_CASE("MPE expression moves only the voices it addresses", "[morphsynth][mpe]")
+{
+    auto& app = sharedAppEngine();
+    app.newUntitledEdit();
+
+    auto plugin = app.getEdit().getPluginCache().createNewPlugin (MorphSynthPlugin::pluginType, {});
+    auto* morph = dynamic_cast<MorphSynthPlugin*> (plugin.get());
+    REQUIRE(morph != nullptr);
+
+    constexpr double sampleRate = 48000.0;
+    constexpr int    blockSize  = 512;
+
+    te::PluginInitialisationInfo info;
+    info.sampleRate       = sampleRate;
+    info.blockSizeSamples = blockSize;
+    morph->initialise (info);
+
+    juce::AudioBuffer<float> buffer (2, blockSize);
+    te::MidiMessageArray midi;
+    const auto source = te::createUniqueMPESourceID();
+
+    // Sends the messages at the start of the first block, then renders long enough
+    // (about 0.2 s) for the expression smoothing to settle
+    const auto render = [&] (std::initializer_list<juce::MidiMessage> messages)
+    {
+        for (int block = 0; block < 20; ++block)
+        {
+            buffer.clear();
+            midi.clear();
+
+            if (block == 0)
+                for (const auto& m : messages)
+                    midi.addMidiMessage (m, 0.0, source);
+
+            te::PluginRenderContext rc (&buffer, juce::AudioChannelSet::stereo(), 0, blockSize,
+                                        &midi, 0.0, {}, true, false, false, false);
+            morph->applyToBuffer (rc);
+        }
+    };
+
+    using Expr = MorphExpression;
+    using Msg  = juce::MidiMessage;
+
+    morph->mpe->setParameter ((float) MorphVoice::mpeLowerZone, juce::sendNotificationSync);
+    const float zoneBendRange = morph->bendRange->getCurrentValue();
+
+    // One note on each of member channels 2 and 3; free voices are taken in order
+    render ({ Msg::noteOn (2, 60, (juce::uint8) 100), Msg::noteOn (3, 64, (juce::uint8) 100) });
+
+    SECTION("Member channel bend and pressure reach only that channel's voice")
+    {
+        render ({ Msg::pitchWheel (2, 16383), Msg::channelPressureChange (3, 127) });
+
+        CHECK(morph->getVoiceExpression (Expr::pitch, 0) == Approx (MorphVoice::mpeMemberBendRange).margin (0.1));
+        CHECK(morph->getVoiceExpression (Expr::pitch, 1) == Approx (0.0f).margin (1.0e-3));
+        CHECK(morph->getVoiceExpression (Expr::pressure, 0) == Approx (0.0f).margin (1.0e-3));
+        CHECK(morph->getVoiceExpression (Expr::pressure, 1) == Approx (1.0f).margin (1.0e-3));
+        CHECK(morph->getMasterBend() == Approx (0.0f).margin (1.0e-3));
+    }
+
+    SECTION("Master channel bend moves every voice")
+    {
+        render ({ Msg::pitchWheel (1, 16383) });
+
+        CHECK(morph->getMasterBend() == Approx (zoneBendRange).margin (0.01));
+        CHECK(morph->getVoiceExpression (Expr::pitch, 0) == Approx (0.0f).margin (1.0e-3));
+        CHECK(morph->getVoiceExpression (Expr::pitch, 1) == Approx (0.0f).margin (1.0e-3));
+    }
+
+    SECTION("The upper zone's master is channel 16, and a mode change drops its bend")
+    {
+        morph->mpe->setParameter ((float) MorphVoice::mpeUpperZone, juce::sendNotificationSync);
+
+        render ({ Msg::pitchWheel (1, 16383) });
+        CHECK(morph->getMasterBend() == Approx (0.0f).margin (1.0e-3));
+
+        render ({ Msg::pitchWheel (16, 16383) });
+        CHECK(morph->getMasterBend() == Approx (zoneBendRange).margin (0.01));
+
+        morph->mpe->setParameter ((float) MorphVoice::mpeOff, juce::sendNotificationSync);
+        render ({});
+        CHECK(morph->getMasterBend() == Approx (0.0f).margin (1.0e-3));
+    }
+
+    morph->deinitialise();
+}
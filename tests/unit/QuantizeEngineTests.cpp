@@ -0,0 +1,105 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include "MIDIEngine/QuantizeEngine.h"
+
+namespace
+{
+    using Catch::Matchers::WithinAbs;
+
+    constexpr double tolerance = 1.0e-9;
+}
+
+TEST_CASE("Quantize pulls starts towards the grid by strength and keeps lengths", "[quantize]")
+{
+    QuantizeEngine::NoteArrays notes;
+    notes.addNote (0.10, 0.30, 100.0f);
+    notes.addNote (0.60, 1.10, 100.0f);
+
+    QuantizeEngine::Settings s;
+    s.gridBeats = 0.25;
+    s.strength  = 0.5f;
+
+    QuantizeEngine::process (s, notes);
+
+    REQUIRE_THAT(notes.start[0], WithinAbs (0.05, tolerance));
+    REQUIRE_THAT(notes.start[1], WithinAbs (0.55, tolerance));
+    REQUIRE_THAT(notes.end[0] - notes.start[0], WithinAbs (0.20, tolerance));
+    REQUIRE_THAT(notes.end[1] - notes.start[1], WithinAbs (0.50, tolerance));
+
+    s.strength = 1.0f;
+    QuantizeEngine::process (s, notes);
+
+    REQUIRE_THAT(notes.start[0], WithinAbs (0.0, tolerance));
+    REQUIRE_THAT(notes.start[1], WithinAbs (0.5, tolerance));
+}
+
+TEST_CASE("Quantize swing delays every other grid line", "[quantize]")
+{
+    QuantizeEngine::NoteArrays notes;
+    notes.addNote (0.45, 0.60, 100.0f);     // nearest straight line is the off-beat
+    notes.addNote (1.05, 1.20, 100.0f);     // on-beat lines never move
+
+    QuantizeEngine::Settings s;
+    s.gridBeats = 0.5;
+    s.swing     = 1.0f;                     // off-beats a full half step late
+
+    QuantizeEngine::process (s, notes);
+
+    REQUIRE_THAT(notes.start[0], WithinAbs (0.75, tolerance));
+    REQUIRE_THAT(notes.start[1], WithinAbs (1.0, tolerance));
+}
+
+TEST_CASE("Quantize to a groove template follows its timing and accents", "[quantize]")
+{
+    // Late, quieter off-beats, two periods of them
+    const auto groove = QuantizeEngine::GrooveTemplate::fromOnsets ({ 0.0, 0.55, 1.0, 1.55 },
+                                                                    { 1.0f, 0.5f, 1.0f, 0.5f }, 1.0, 0.5);
+    REQUIRE(groove.isValid());
+    REQUIRE(groove.positions.size() == 2);
+    REQUIRE_THAT(groove.positions[1], WithinAbs (0.55, tolerance));
+    REQUIRE(groove.accents[0] == 1.0f);
+    REQUIRE(groove.accents[1] == 0.5f);
+
+    QuantizeEngine::NoteArrays notes;
+    notes.addNote (2.48, 2.70, 120.0f);
+    notes.addNote (2.97, 3.20, 120.0f);
+
+    QuantizeEngine::Settings s;
+    s.groove = &groove;
+    s.grooveVelocity = 1.0f;
+
+    QuantizeEngine::process (s, notes);
+
+    REQUIRE_THAT(notes.start[0], WithinAbs (2.55, tolerance));
+    REQUIRE_THAT(notes.start[1], WithinAbs (3.0, tolerance));
+    REQUIRE_THAT((double) notes.velocity[0], WithinAbs (63.5, 1.0e-4));
+    REQUIRE_THAT((double) notes.velocity[1], WithinAbs (127.0, 1.0e-4));
+}
+
+TEST_CASE("Humanize is bounded and repeatable for a seed", "[quantize]")
+{
+    QuantizeEngine::NoteArrays source;
+    for (int i = 0; i < 64; ++i)
+        source.addNote (1.0 + i * 0.25, 1.2 + i * 0.25, 100.0f);
+
+    QuantizeEngine::Settings s;
+    s.strength         = 0.0f;
+    s.humanizeBeats    = 0.02;
+    s.humanizeVelocity = 10.0f;
+    s.seed             = 42;
+
+    auto a = source;
+    auto b = source;
+    QuantizeEngine::process (s, a);
+    QuantizeEngine::process (s, b);
+
+    for (size_t i = 0; i < source.size(); ++i)
+    {
+        REQUIRE(a.start[i] == b.start[i]);
+        REQUIRE(a.velocity[i] == b.velocity[i]);
+        REQUIRE(std::abs (a.start[i] - source.start[i]) <= s.humanizeBeats);
+        REQUIRE(std::abs (a.velocity[i] - source.velocity[i]) <= s.humanizeVelocity);
+        REQUIRE_THAT(a.end[i] - a.start[i], WithinAbs (0.2, tolerance));
+    }
+}
@@ -0,0 +1,92 @@
+#include <catch2/catch_test_macros.hpp>
+#include "PluginManager/SandboxTransport.h"
+
+#include <thread>
+
+namespace
+{
+    constexpr int blockSize = 64;
+
+    void fillBlock (juce::AudioBuffer<float>& buffer, int blockIndex)
+    {
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample (ch, i, (float) (blockIndex * blockSize + i) * 0.001f + (float) ch);
+    }
+}
+
+TEST_CASE("Sandbox transport returns the worker's output one block later", "[sandbox]")
+{
+    auto host = SandboxTransport::createHost (2);
+    REQUIRE(host != nullptr);
+    host->prepareHost (blockSize);
+    REQUIRE(host->getLatencySamples() == blockSize);
+
+    // The "worker process" is a thread mapping the same file
+    auto worker = SandboxTransport::openWorker (host->getFile());
+    REQUIRE(worker != nullptr);
+    worker->prepareWorker (2);
+
+    std::atomic<bool> stop { false };
+    std::thread workerThread ([&]
+    {
+        const SandboxTransport::ProcessCallback process = [] (juce::AudioBuffer<float>& audio, juce::MidiBuffer&)
+        {
+            audio.applyGain (2.0f);
+        };
+
+        while (! stop)
+            if (! worker->workerProcessNext (process))
+                std::this_thread::yield();
+    });
+
+    juce::AudioBuffer<float> block (2, blockSize), expected (2, blockSize);
+
+    for (int b = 0; b < 8; ++b)
+    {
+        fillBlock (block, b);
+        host->hostProcess (block, 0, blockSize, nullptr, 48000.0, true);
+
+        if (b == 0)
+        {
+            REQUIRE(block.getMagnitude (0, blockSize) == 0.0f);     // primed silence
+            continue;
+        }
+
+        fillBlock (expected, b - 1);
+        expected.applyGain (2.0f);
+
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < blockSize; ++i)
+                REQUIRE(block.getSample (ch, i) == expected.getSample (ch, i));
+    }
+
+    stop = true;
+    workerThread.join();
+
+    const auto stats = host->getStats();
+    REQUIRE(stats.blocks == 8);
+    REQUIRE(stats.lateBlocks == 0);
+}
+
+TEST_CASE("Sandbox transport plays silence instead of waiting on a stalled worker", "[sandbox]")
+{
+    auto host = SandboxTransport::createHost (2);
+    REQUIRE(host != nullptr);
+    host->prepareHost (blockSize);
+
+    // Nobody is processing: every block after the first is late
+    juce::AudioBuffer<float> block (2, blockSize);
+    for (int b = 0; b < 4; ++b)
+    {
+        fillBlock (block, b);
+        host->hostProcess (block, 0, blockSize, nullptr, 48000.0, false);
+        REQUIRE(block.getMagnitude (0, blockSize) == 0.0f);
+    }
+
+    REQUIRE(host->isWorkerBusy());
+
+    const auto stats = host->getStats();
+    REQUIRE(stats.blocks == 1);
+    REQUIRE(stats.lateBlocks == 4);     // the one published block, then three never sent
+}
@@ -0,0 +1,86 @@
+#include <catch2/catch_test_macros.hpp>
+#include "AppEngine/SilenceGate.h"
+#include "../integration/SharedAppEngine.h"
+
+TEST_CASE("Silence gate suspends inserts past their tail and wakes them on sound", "[silence]")
+{
+    auto& app = sharedAppEngine();
+    app.newUntitledEdit();
+
+    auto reverb = app.getEdit().getPluginCache().createNewPlugin (te::ReverbPlugin::xmlTypeName, {});
+    REQUIRE(reverb != nullptr);
+
+    constexpr double sampleRate = 48000.0;
+    constexpr int    blockSize  = 480;          // 10 ms
+
+    SilenceGate gate;
+    gate.setInserts ({ reverb.get() }, 0.1, sampleRate);
+
+    // Ten silent blocks only reach the tail: still running
+    for (int i = 0; i < 10; ++i)
+        gate.instrumentBlock (false, blockSize);
+    gate.applyState();
+    REQUIRE(reverb->isProcessingEnabled());
+
+    // The audio thread only reports; the switch happens on the next applyState()
+    gate.instrumentBlock (false, blockSize);
+    REQUIRE(reverb->isProcessingEnabled());
+
+    gate.applyState();
+    REQUIRE_FALSE(reverb->isProcessingEnabled());
+    REQUIRE(gate.getStats().suspended);
+
+    gate.instrumentBlock (true, blockSize);
+    gate.applyState();
+    REQUIRE(reverb->isProcessingEnabled());
+
+    const auto stats = gate.getStats();
+    REQUIRE_FALSE(stats.suspended);
+    REQUIRE(stats.numInserts == 1);
+    REQUIRE(stats.idleFraction > stats.suspendedFraction);
+    REQUIRE(stats.suspendedFraction == 0.0);    // suspended blocks are counted from the next one on
+
+    // An insert the user switched off stays off when the chain resumes
+    for (int i = 0; i < 20; ++i)
+        gate.instrumentBlock (false, blockSize);
+    gate.applyState();
+    REQUIRE_FALSE(reverb->isProcessingEnabled());
+
+    gate.resume();
+    REQUIRE(reverb->isProcessingEnabled());
+
+    reverb->setProcessingEnabled (false);
+    gate.applyState();
+    gate.instrumentBlock (true, blockSize);
+    gate.applyState();
+    REQUIRE_FALSE(reverb->isProcessingEnabled());
+    reverb->setProcessingEnabled (true);
+
+    // A sound on its way resumes the chain before the synth makes it
+    for (int i = 0; i < 20; ++i)
+        gate.instrumentBlock (false, blockSize);
+    gate.applyState();
+    REQUIRE_FALSE(reverb->isProcessingEnabled());
+
+    gate.applyState (true);
+    REQUIRE(reverb->isProcessingEnabled());
+
+    // Nothing came after all: the silence still stands
+    gate.applyState();
+    REQUIRE_FALSE(reverb->isProcessingEnabled());
+
+    // resume() starts the silence over, so the chain waits out a whole tail again
+    gate.resume();
+    gate.instrumentBlock (false, blockSize);
+    gate.applyState();
+    REQUIRE(reverb->isProcessingEnabled());
+
+    // Dropping an insert from the list never leaves it switched off
+    for (int i = 0; i < 20; ++i)
+        gate.instrumentBlock (false, blockSize);
+    gate.applyState();
+    REQUIRE_FALSE(reverb->isProcessingEnabled());
+
+    gate.setInserts ({}, 0.0, sampleRate);
+    REQUIRE(reverb->isProcessingEnabled());
+}